@@ -101,6 +101,8 @@
 #include <arvinterface.h>
 #include <arvmisc.h>
 #include <arvrealtime.h>
+#include <arvrecorder.h>
+#include <arvrecordingreader.h>
 #include <arvstream.h>
 #include <arvstr.h>
 #include <arvsystem.h>
@@ -0,0 +1,495 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#include <arvdebugprivate.h>
+#include <arv.h>
+#include <stdlib.h>
+#include <stdio.h>
+#ifndef G_OS_WIN32
+#include <sys/resource.h>
+#endif
+
+#define ARV_BENCH_N_BUFFERS		32
+#define ARV_BENCH_MAX_CAMERAS		64
+
+static int arv_option_n_cameras = 1;
+static char *arv_option_frame_rates = NULL;
+static char *arv_option_packet_sizes = NULL;
+static int arv_option_width = 1024;
+static int arv_option_height = 1024;
+static double arv_option_duration_s = 2.0;
+static gboolean arv_option_no_packet_resend = FALSE;
+static gboolean arv_option_no_packet_socket = FALSE;
+static gboolean arv_option_realtime = FALSE;
+static char *arv_option_impairment = NULL;
+static char *arv_option_debug_domains = NULL;
+static gboolean arv_option_show_version = FALSE;
+
+/* clang-format off */
+static const GOptionEntry arv_option_entries[] =
+{
+	{
+		"n-cameras",				'n', 0, G_OPTION_ARG_INT,
+		&arv_option_n_cameras,			"Number of fake cameras",
+		"<n>"
+	},
+	{
+		"frame-rates",				'f', 0, G_OPTION_ARG_STRING,
+		&arv_option_frame_rates,		"Comma separated list of frame rates, per camera",
+		"<Hz,...>"
+	},
+	{
+		"packet-sizes",				's', 0, G_OPTION_ARG_STRING,
+		&arv_option_packet_sizes,		"Comma separated list of packet sizes",
+		"<bytes,...>"
+	},
+	{
+		"width", 				'w', 0, G_OPTION_ARG_INT,
+		&arv_option_width,			"Width",
+		"<n_pixels>"
+	},
+	{
+		"height", 				'h', 0, G_OPTION_ARG_INT,
+		&arv_option_height, 			"Height",
+		"<n_pixels>"
+	},
+	{
+		"duration",				't', 0, G_OPTION_ARG_DOUBLE,
+		&arv_option_duration_s,			"Duration of each step",
+		"<s>"
+	},
+	{
+		"no-packet-resend",			'r', 0, G_OPTION_ARG_NONE,
+		&arv_option_no_packet_resend,		"No packet resend",
+		NULL
+	},
+	{
+		"no-packet-socket",			'\0', 0, G_OPTION_ARG_NONE,
+		&arv_option_no_packet_socket,		"Disable use of packet socket",
+		NULL
+	},
+	{
+		"realtime",				'\0', 0, G_OPTION_ARG_NONE,
+		&arv_option_realtime,			"Make stream threads realtime",
+		NULL
+	},
+	{
+		"impairment",				'm', 0, G_OPTION_ARG_STRING,
+		&arv_option_impairment,			"Network impairment profile of the fake cameras",
+		"key=value[,...]"
+	},
+	{
+		"debug", 				'd', 0, G_OPTION_ARG_STRING,
+		&arv_option_debug_domains, 		NULL,
+		"{<category>[:<level>][,...]|help}"
+	},
+	{
+		"version",				'v', 0, G_OPTION_ARG_NONE,
+		&arv_option_show_version,		"Show version",
+		NULL
+	},
+	{ NULL }
+};
+/* clang-format on */
+
+static const char
+description_content[] =
+"This tool starts fake GigEVision cameras on the loopback interface, streams from all of\n"
+"them at each requested frame rate and packet size, and reports the achieved throughput,\n"
+"the latency between the reception of the frame leader and the delivery of the buffer to\n"
+"the application, the CPU time per transferred GB and the packet loss and resend counts.\n"
+"\n"
+"The fake cameras run in the same process, their CPU time is included in the CPU usage.\n"
+"\n"
+"The impairment option applies a seeded network impairment profile to the fake camera\n"
+"streams (see arv-fake-gv-camera), and the recovery column gives the mean delay between\n"
+"the end of a frame transmission and the last packet resent for this frame.\n"
+"\n"
+"Examples:\n"
+"\n"
+"arv-bench-" ARAVIS_API_VERSION " -n 4 -f 50,100,200 -s 1500,9000\n"
+"arv-bench-" ARAVIS_API_VERSION " -m seed=1,burst-start=0.001,burst-end=0.3,resend-latency=500\n";
+
+typedef struct {
+	ArvGvFakeCamera *simulator;
+	ArvCamera *camera;
+	ArvStream *stream;
+	GThread *thread;
+
+	gint64 deadline;
+	guint64 n_frames;
+	guint64 n_bytes;
+	GArray *latencies_us;
+} ArvBenchCamera;
+
+static void
+stream_cb (void *user_data, ArvStreamCallbackType type, ArvBuffer *buffer)
+{
+	if (type == ARV_STREAM_CALLBACK_TYPE_INIT && arv_option_realtime) {
+		if (!arv_make_thread_realtime (10))
+			printf ("Failed to make stream thread realtime\n");
+	}
+}
+
+static void *
+_receive_thread (void *user_data)
+{
+	ArvBenchCamera *bench_camera = user_data;
+
+	while (g_get_monotonic_time () < bench_camera->deadline) {
+		ArvBuffer *buffer;
+
+		buffer = arv_stream_timeout_pop_buffer (bench_camera->stream, 100000);
+		if (buffer == NULL)
+			continue;
+
+		if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+			double latency_us;
+			size_t size = 0;
+
+			latency_us = (g_get_real_time () * 1000LL -
+				      (gint64) arv_buffer_get_system_timestamp (buffer)) / 1000.0;
+			g_array_append_val (bench_camera->latencies_us, latency_us);
+
+			arv_buffer_get_data (buffer, &size);
+			bench_camera->n_frames++;
+			bench_camera->n_bytes += size;
+		}
+
+		arv_stream_push_buffer (bench_camera->stream, buffer);
+	}
+
+	return NULL;
+}
+
+static double
+_get_cpu_time_s (void)
+{
+#ifndef G_OS_WIN32
+	struct rusage usage;
+
+	if (getrusage (RUSAGE_SELF, &usage) != 0)
+		return 0.0;
+
+	return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+		(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#else
+	return 0.0;
+#endif
+}
+
+static int
+_compare_double (const void *a, const void *b)
+{
+	double da = *(const double *) a;
+	double db = *(const double *) b;
+
+	return da < db ? -1 : da > db ? 1 : 0;
+}
+
+static double
+_get_percentile (GArray *values, double percentile)
+{
+	if (values->len == 0)
+		return 0.0;
+
+	return g_array_index (values, double, MIN (values->len - 1, (guint) (percentile * values->len)));
+}
+
+static guint
+_parse_list (const char *string, const char *default_string, double **values)
+{
+	char **tokens;
+	guint n_values = 0;
+	guint i;
+
+	tokens = g_strsplit_set (string != NULL ? string : default_string, ",; ", -1);
+	*values = g_new0 (double, g_strv_length (tokens));
+
+	for (i = 0; tokens[i] != NULL; i++) {
+		double value;
+
+		value = g_ascii_strtod (tokens[i], NULL);
+		if (value > 0.0)
+			(*values)[n_values++] = value;
+	}
+
+	g_strfreev (tokens);
+
+	return n_values;
+}
+
+static gboolean
+_run_step (ArvBenchCamera *cameras, guint n_cameras, double frame_rate, guint packet_size)
+{
+	GArray *latencies_us;
+	GError *error = NULL;
+	guint64 n_frames = 0;
+	guint64 n_bytes = 0;
+	guint64 n_missing_packets = 0;
+	guint64 n_resend_requests = 0;
+	guint64 n_resent_packets = 0;
+	guint64 n_failures = 0;
+	guint64 n_resent_frames = 0;
+	guint64 recovery_time_us = 0;
+	gint64 start_time;
+	gint64 deadline;
+	double elapsed_s;
+	double cpu_time_s;
+	guint i, j;
+
+	for (i = 0; i < n_cameras && error == NULL; i++) {
+		ArvBenchCamera *bench_camera = &cameras[i];
+		size_t payload = 0;
+
+		arv_camera_gv_set_packet_size (bench_camera->camera, packet_size, &error);
+
+		/* Bypass the frame rate limit of the Genicam description */
+		if (error == NULL)
+			arv_device_write_register (arv_camera_get_device (bench_camera->camera),
+						   ARV_FAKE_CAMERA_REGISTER_ACQUISITION_FRAME_PERIOD_US,
+						   MAX (1, (guint32) (1000000.0 / frame_rate + 0.5)), &error);
+
+		if (error == NULL)
+			payload = arv_camera_get_payload (bench_camera->camera, &error);
+		if (error == NULL)
+			bench_camera->stream = arv_camera_create_stream (bench_camera->camera, stream_cb, NULL, &error);
+		if (error != NULL)
+			break;
+
+		if (arv_option_no_packet_resend)
+			g_object_set (bench_camera->stream, "packet-resend", ARV_GV_STREAM_PACKET_RESEND_NEVER, NULL);
+
+		for (j = 0; j < ARV_BENCH_N_BUFFERS; j++)
+			arv_stream_push_buffer (bench_camera->stream, arv_buffer_new (payload, NULL));
+
+		bench_camera->n_frames = 0;
+		bench_camera->n_bytes = 0;
+		bench_camera->latencies_us = g_array_new (FALSE, FALSE, sizeof (double));
+	}
+
+	if (error != NULL) {
+		printf ("Failed to configure the cameras: %s\n", error->message);
+		g_clear_error (&error);
+		for (i = 0; i < n_cameras; i++) {
+			g_clear_object (&cameras[i].stream);
+			g_clear_pointer (&cameras[i].latencies_us, g_array_unref);
+		}
+		return FALSE;
+	}
+
+	for (i = 0; i < n_cameras; i++) {
+		n_resent_frames -= arv_gv_fake_camera_get_info_uint64_by_name (cameras[i].simulator, "n_resent_frames");
+		recovery_time_us -= arv_gv_fake_camera_get_info_uint64_by_name (cameras[i].simulator,
+										 "resend_recovery_time_us");
+	}
+
+	cpu_time_s = _get_cpu_time_s ();
+	start_time = g_get_monotonic_time ();
+	deadline = start_time + arv_option_duration_s * 1000000.0;
+
+	for (i = 0; i < n_cameras; i++) {
+		cameras[i].deadline = deadline;
+		arv_camera_start_acquisition (cameras[i].camera, NULL);
+		cameras[i].thread = g_thread_new ("arv_bench", _receive_thread, &cameras[i]);
+	}
+
+	latencies_us = g_array_new (FALSE, FALSE, sizeof (double));
+
+	for (i = 0; i < n_cameras; i++) {
+		ArvBenchCamera *bench_camera = &cameras[i];
+
+		g_thread_join (bench_camera->thread);
+		bench_camera->thread = NULL;
+
+		arv_camera_stop_acquisition (bench_camera->camera, NULL);
+
+		n_frames += bench_camera->n_frames;
+		n_bytes += bench_camera->n_bytes;
+		n_failures += arv_stream_get_info_uint64_by_name (bench_camera->stream, "n_failures");
+		n_missing_packets += arv_stream_get_info_uint64_by_name (bench_camera->stream, "n_missing_packets");
+		n_resend_requests += arv_stream_get_info_uint64_by_name (bench_camera->stream, "n_resend_requests");
+		n_resent_packets += arv_stream_get_info_uint64_by_name (bench_camera->stream, "n_resent_packets");
+		n_resent_frames += arv_gv_fake_camera_get_info_uint64_by_name (bench_camera->simulator, "n_resent_frames");
+		recovery_time_us += arv_gv_fake_camera_get_info_uint64_by_name (bench_camera->simulator,
+										 "resend_recovery_time_us");
+
+		g_array_append_vals (latencies_us, bench_camera->latencies_us->data, bench_camera->latencies_us->len);
+
+		g_clear_pointer (&bench_camera->latencies_us, g_array_unref);
+		g_clear_object (&bench_camera->stream);
+	}
+
+	elapsed_s = (g_get_monotonic_time () - start_time) / 1e6;
+	cpu_time_s = _get_cpu_time_s () - cpu_time_s;
+
+	qsort (latencies_us->data, latencies_us->len, sizeof (double), _compare_double);
+
+	printf ("%7.1f %6u %9.1f %8.3f %8.3f %8.3f %8.3f %9.2f %9" G_GUINT64_FORMAT " %9" G_GUINT64_FORMAT
+		" %9" G_GUINT64_FORMAT " %9" G_GUINT64_FORMAT " %9.3f\n",
+		frame_rate, packet_size,
+		n_frames / elapsed_s,
+		n_bytes * 8.0 / elapsed_s / 1e9,
+		_get_percentile (latencies_us, 0.50) / 1000.0,
+		_get_percentile (latencies_us, 0.99) / 1000.0,
+		_get_percentile (latencies_us, 1.00) / 1000.0,
+		n_bytes > 0 ? cpu_time_s / (n_bytes / 1e9) : 0.0,
+		n_failures, n_missing_packets, n_resend_requests, n_resent_packets,
+		n_resent_frames > 0 ? recovery_time_us / 1000.0 / n_resent_frames : 0.0);
+
+	g_array_unref (latencies_us);
+
+	return TRUE;
+}
+
+int
+main (int argc, char **argv)
+{
+	ArvBenchCamera *cameras;
+	GOptionContext *context;
+	GError *error = NULL;
+	double *frame_rates;
+	double *packet_sizes;
+	guint n_frame_rates;
+	guint n_packet_sizes;
+	guint n_cameras;
+	guint i, j;
+	int status = EXIT_SUCCESS;
+
+	context = g_option_context_new (NULL);
+	g_option_context_set_summary (context, "Receive throughput benchmark using fake GigEVision cameras.");
+	g_option_context_set_description (context, description_content);
+	g_option_context_add_main_entries (context, arv_option_entries, NULL);
+
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_option_context_free (context);
+		g_print ("Option parsing failed: %s\n", error->message);
+		g_error_free (error);
+		return EXIT_FAILURE;
+	}
+
+	g_option_context_free (context);
+
+	if (arv_option_show_version) {
+		printf ("%u.%u.%u\n",
+			arv_get_major_version (),
+			arv_get_minor_version (),
+			arv_get_micro_version ());
+		return EXIT_SUCCESS;
+	}
+
+	if (!arv_debug_enable (arv_option_debug_domains)) {
+		if (g_strcmp0 (arv_option_debug_domains, "help") != 0)
+			printf ("Invalid debug selection\n");
+		else
+			arv_debug_print_infos ();
+		return EXIT_FAILURE;
+	}
+
+	if (arv_option_n_cameras < 1 || arv_option_n_cameras > ARV_BENCH_MAX_CAMERAS) {
+		printf ("Invalid number of cameras (1 to %d)\n", ARV_BENCH_MAX_CAMERAS);
+		return EXIT_FAILURE;
+	}
+
+	n_frame_rates = _parse_list (arv_option_frame_rates, "25,50,100,200,400", &frame_rates);
+	n_packet_sizes = _parse_list (arv_option_packet_sizes, "1500,8000", &packet_sizes);
+
+	if (n_frame_rates == 0 || n_packet_sizes == 0) {
+		printf ("Invalid frame rate or packet size list\n");
+		g_free (frame_rates);
+		g_free (packet_sizes);
+		return EXIT_FAILURE;
+	}
+
+	n_cameras = arv_option_n_cameras;
+	cameras = g_new0 (ArvBenchCamera, n_cameras);
+
+	for (i = 0; i < n_cameras && status == EXIT_SUCCESS; i++) {
+		char *address;
+		char *serial_number;
+
+		/* Each fake camera listens on its own loopback address */
+		address = g_strdup_printf ("127.0.0.%u", i + 1);
+		serial_number = g_strdup_printf ("Bench%02u", i);
+
+		cameras[i].simulator = arv_gv_fake_camera_new (address, serial_number);
+		/* The sender must not be the bottleneck */
+		g_object_set (cameras[i].simulator,
+			      "gvsp-high-rate", TRUE,
+			      "gvsp-impairment", arv_option_impairment,
+			      NULL);
+		if (!arv_gv_fake_camera_is_running (cameras[i].simulator)) {
+			printf ("Failed to start the fake camera on %s\n", address);
+			status = EXIT_FAILURE;
+		} else {
+			cameras[i].camera = arv_camera_new (address, &error);
+			if (error == NULL)
+				arv_camera_set_region (cameras[i].camera, 0, 0,
+						       arv_option_width, arv_option_height, &error);
+			if (error == NULL)
+				arv_camera_set_acquisition_mode (cameras[i].camera,
+								 ARV_ACQUISITION_MODE_CONTINUOUS, &error);
+			if (error == NULL) {
+				arv_camera_gv_set_packet_size_adjustment (cameras[i].camera,
+									  ARV_GV_PACKET_SIZE_ADJUSTMENT_NEVER);
+				arv_camera_gv_set_stream_options (cameras[i].camera,
+								  arv_option_no_packet_socket ?
+								  ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED :
+								  ARV_GV_STREAM_OPTION_NONE);
+			}
+			if (error != NULL) {
+				printf ("Failed to open the fake camera at %s: %s\n", address, error->message);
+				g_clear_error (&error);
+				status = EXIT_FAILURE;
+			}
+		}
+
+		g_free (address);
+		g_free (serial_number);
+	}
+
+	if (status == EXIT_SUCCESS) {
+		printf ("%u camera%s, %dx%d Mono8, %g s per step\n\n",
+			n_cameras, n_cameras > 1 ? "s" : "", arv_option_width, arv_option_height, arv_option_duration_s);
+		printf ("%7s %6s %9s %8s %8s %8s %8s %9s %9s %9s %9s %9s %9s\n",
+			"rate", "packet", "fps", "Gbps", "p50 ms", "p99 ms", "max ms", "cpu s/GB",
+			"failures", "missing", "resend", "resent", "recov ms");
+
+		for (i = 0; i < n_packet_sizes && status == EXIT_SUCCESS; i++)
+			for (j = 0; j < n_frame_rates && status == EXIT_SUCCESS; j++)
+				if (!_run_step (cameras, n_cameras, frame_rates[j], (guint) packet_sizes[i]))
+					status = EXIT_FAILURE;
+	}
+
+	for (i = 0; i < n_cameras; i++) {
+		g_clear_object (&cameras[i].camera);
+		g_clear_object (&cameras[i].simulator);
+	}
+
+	g_free (cameras);
+	g_free (frame_rates);
+	g_free (packet_sizes);
+
+	arv_shutdown ();
+
+	return status;
+}
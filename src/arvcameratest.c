@@ -24,6 +24,7 @@ static double arv_option_packet_request_ratio = -1.0;
 static unsigned int arv_option_initial_packet_timeout = ARV_GV_STREAM_INITIAL_PACKET_TIMEOUT_US_DEFAULT / 1000;
 static unsigned int arv_option_packet_timeout = ARV_GV_STREAM_PACKET_TIMEOUT_US_DEFAULT / 1000;
 static unsigned int arv_option_frame_retention = ARV_GV_STREAM_FRAME_RETENTION_US_DEFAULT / 1000;
+static char *arv_option_pcap_filename = NULL;
 static int arv_option_gv_stream_channel = -1;
 static int arv_option_gv_packet_delay = -1;
 static int arv_option_gv_packet_size = -1;
@@ -135,6 +136,11 @@ static const GOptionEntry arv_option_entries[] =
 		&arv_option_frame_retention, 		"Frame retention",
 	        "<ms>"
 	},
+	{
+		"pcap",					'\0', 0, G_OPTION_ARG_FILENAME,
+		&arv_option_pcap_filename,		"Capture GigEVision traffic to a pcap file",
+		"<filename>"
+	},
 	{
 		"gv-stream-channel",			'c', 0, G_OPTION_ARG_INT,
 		&arv_option_gv_stream_channel,		"GigEVision stream channel id",
@@ -666,6 +672,13 @@ main (int argc, char **argv)
 						  "packet-timeout", (unsigned) arv_option_packet_timeout * 1000,
 						  "frame-retention", (unsigned) arv_option_frame_retention * 1000,
 						  NULL);
+
+				    if (arv_option_pcap_filename != NULL &&
+					!arv_gv_stream_start_pcap_capture (ARV_GV_STREAM (stream),
+									   arv_option_pcap_filename, TRUE, &error)) {
+					    printf ("Failed to start pcap capture: %s\n", error->message);
+					    g_clear_error (&error);
+				    }
 			    }
 
 			    for (i = 0; i < 50; i++)
@@ -41,6 +41,7 @@
 #include <arvgcstring.h>
 #include <arvstream.h>
 #include <arvdebug.h>
+#include <string.h>
 
 enum {
 	ARV_DEVICE_SIGNAL_CONTROL_LOST,
@@ -57,6 +58,16 @@ arv_device_error_quark (void)
 
 typedef struct {
 	GError *init_error;
+
+	guint batch_depth;
+	GArray *batch_addresses;
+	GArray *batch_values;
+	GError *batch_error;
+
+	GMutex io_mutex;
+	GQueue io_queue;
+	gboolean io_busy;
+	GThreadPool *io_pool;
 } ArvDevicePrivate;
 
 static void arv_device_initable_iface_init (GInitableIface *iface);
@@ -65,6 +76,38 @@ G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvDevice, arv_device, G_TYPE_OBJECT,
 				  G_ADD_PRIVATE (ArvDevice)
 				  G_IMPLEMENT_INTERFACE (G_TYPE_INITABLE, arv_device_initable_iface_init))
 
+static GQuark
+arv_device_io_functions_quark (void)
+{
+	return g_quark_from_static_string ("arv-device-io-functions-quark");
+}
+
+/* io_functions must stay valid for the lifetime of the type, a static constant structure is expected. */
+
+void
+arv_device_class_set_io_functions (ArvDeviceClass *device_class, const ArvDeviceIOFunctions *io_functions)
+{
+	g_return_if_fail (G_TYPE_CHECK_CLASS_TYPE (device_class, ARV_TYPE_DEVICE));
+
+	g_type_set_qdata (G_TYPE_FROM_CLASS (device_class), arv_device_io_functions_quark (), (gpointer) io_functions);
+}
+
+static const ArvDeviceIOFunctions *
+_get_io_functions (ArvDevice *device)
+{
+	GType type;
+
+	for (type = G_TYPE_FROM_INSTANCE (device); type != 0 && type != ARV_TYPE_DEVICE; type = g_type_parent (type)) {
+		const ArvDeviceIOFunctions *io_functions;
+
+		io_functions = g_type_get_qdata (type, arv_device_io_functions_quark ());
+		if (io_functions != NULL)
+			return io_functions;
+	}
+
+	return NULL;
+}
+
 /**
  * arv_device_create_stream: (skip)
  * @device: a #ArvDevice
@@ -110,6 +153,51 @@ arv_device_create_stream_full (ArvDevice *device, ArvStreamCallback callback, vo
 	return ARV_DEVICE_GET_CLASS (device)->create_stream (device, callback, user_data, destroy, error);
 }
 
+static gboolean
+_write_registers (ArvDevice *device, const guint64 *addresses, const guint32 *values, guint n_registers,
+		  GError **error)
+{
+	ArvDeviceClass *device_class = ARV_DEVICE_GET_CLASS (device);
+	const ArvDeviceIOFunctions *io_functions = _get_io_functions (device);
+	guint i;
+
+	if (io_functions != NULL && io_functions->write_registers != NULL)
+		return io_functions->write_registers (device, addresses, values, n_registers, error);
+
+	for (i = 0; i < n_registers; i++)
+		if (!device_class->write_register (device, addresses[i], values[i], error))
+			return FALSE;
+
+	return TRUE;
+}
+
+/* Sends the pending batched register writes. Errors are kept until the end of the batch. */
+
+static void
+_flush_batch (ArvDevice *device)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+	GError *local_error = NULL;
+
+	if (priv->batch_addresses == NULL || priv->batch_addresses->len == 0)
+		return;
+
+	_write_registers (device,
+			  (guint64 *) priv->batch_addresses->data,
+			  (guint32 *) priv->batch_values->data,
+			  priv->batch_addresses->len, &local_error);
+
+	g_array_set_size (priv->batch_addresses, 0);
+	g_array_set_size (priv->batch_values, 0);
+
+	if (local_error != NULL) {
+		if (priv->batch_error == NULL)
+			priv->batch_error = local_error;
+		else
+			g_clear_error (&local_error);
+	}
+}
+
 /**
  * arv_device_read_memory:
  * @device: a #ArvDevice
@@ -133,6 +221,8 @@ arv_device_read_memory (ArvDevice *device, guint64 address, guint32 size, void *
 	g_return_val_if_fail (size > 0, FALSE);
 	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
 
+	_flush_batch (device);
+
 	return ARV_DEVICE_GET_CLASS (device)->read_memory (device, address, size, buffer, error);
 }
 
@@ -159,6 +249,8 @@ arv_device_write_memory (ArvDevice *device, guint64 address, guint32 size, void
 	g_return_val_if_fail (size > 0, FALSE);
 	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
 
+	_flush_batch (device);
+
 	return ARV_DEVICE_GET_CLASS (device)->write_memory (device, address, size, buffer, error);
 }
 
@@ -183,6 +275,8 @@ arv_device_read_register (ArvDevice *device, guint64 address, guint32 *value, GE
 	g_return_val_if_fail (value != NULL, FALSE);
 	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
 
+	_flush_batch (device);
+
 	return ARV_DEVICE_GET_CLASS (device)->read_register (device, address, value, error);
 }
 
@@ -193,7 +287,8 @@ arv_device_read_register (ArvDevice *device, guint64 address, guint32 *value, GE
  * @value: value to write
  * @error: (out) (allow-none): a #GError placeholder
  *
- * Writes @value to a device register.
+ * Writes @value to a device register. Inside a batch, see arv_device_begin_batch(), the write is deferred until the
+ * next batch flush.
  *
  * Return value: (skip): TRUE on success.
  *
@@ -203,12 +298,186 @@ arv_device_read_register (ArvDevice *device, guint64 address, guint32 *value, GE
 gboolean
 arv_device_write_register (ArvDevice *device, guint64 address, guint32 value, GError **error)
 {
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+
 	g_return_val_if_fail (ARV_IS_DEVICE (device), FALSE);
 	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
 
+	if (priv->batch_depth > 0) {
+		g_array_append_val (priv->batch_addresses, address);
+		g_array_append_val (priv->batch_values, value);
+		return TRUE;
+	}
+
 	return ARV_DEVICE_GET_CLASS (device)->write_register (device, address, value, error);
 }
 
+/**
+ * arv_device_read_registers:
+ * @device: a #ArvDevice
+ * @addresses: (array length=n_registers): register addresses
+ * @values: (out caller-allocates) (array length=n_registers): placeholder for the read values
+ * @n_registers: number of registers
+ * @error: (out) (allow-none): a #GError placeholder
+ *
+ * Reads the value of several device registers. When the protocol allows it, the registers are read using as few
+ * commands as possible.
+ *
+ * Return value: (skip): TRUE on success.
+ *
+ * Since: 0.8.32
+ **/
+
+gboolean
+arv_device_read_registers (ArvDevice *device, const guint64 *addresses, guint32 *values, guint n_registers,
+			   GError **error)
+{
+	const ArvDeviceIOFunctions *io_functions;
+	ArvDeviceClass *device_class;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), FALSE);
+	g_return_val_if_fail (addresses != NULL || n_registers == 0, FALSE);
+	g_return_val_if_fail (values != NULL || n_registers == 0, FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	if (n_registers == 0)
+		return TRUE;
+
+	_flush_batch (device);
+
+	device_class = ARV_DEVICE_GET_CLASS (device);
+	io_functions = _get_io_functions (device);
+
+	if (io_functions != NULL && io_functions->read_registers != NULL)
+		return io_functions->read_registers (device, addresses, values, n_registers, error);
+
+	for (i = 0; i < n_registers; i++)
+		if (!device_class->read_register (device, addresses[i], &values[i], error))
+			return FALSE;
+
+	return TRUE;
+}
+
+/**
+ * arv_device_write_registers:
+ * @device: a #ArvDevice
+ * @addresses: (array length=n_registers): register addresses
+ * @values: (array length=n_registers): values to write
+ * @n_registers: number of registers
+ * @error: (out) (allow-none): a #GError placeholder
+ *
+ * Writes several device registers, in order. When the protocol allows it, the registers are written using as few
+ * commands as possible. Inside a batch, the writes are deferred until the next batch flush.
+ *
+ * Return value: (skip): TRUE on success.
+ *
+ * Since: 0.8.32
+ **/
+
+gboolean
+arv_device_write_registers (ArvDevice *device, const guint64 *addresses, const guint32 *values, guint n_registers,
+			    GError **error)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), FALSE);
+	g_return_val_if_fail (addresses != NULL || n_registers == 0, FALSE);
+	g_return_val_if_fail (values != NULL || n_registers == 0, FALSE);
+	g_return_val_if_fail (error == NULL || *error == NULL, FALSE);
+
+	if (n_registers == 0)
+		return TRUE;
+
+	if (priv->batch_depth > 0) {
+		g_array_append_vals (priv->batch_addresses, addresses, n_registers);
+		g_array_append_vals (priv->batch_values, values, n_registers);
+		return TRUE;
+	}
+
+	return _write_registers (device, addresses, values, n_registers, error);
+}
+
+/**
+ * arv_device_begin_batch:
+ * @device: a #ArvDevice
+ *
+ * Starts a register batch. Until the matching arv_device_end_batch() call, register writes are queued, and sent
+ * together using as few commands as the protocol allows. This includes the register writes done by the Genicam
+ * features of GigEVision devices. The queue is flushed before any other device access, so read accesses always see
+ * the previous writes. Batches can be nested, the queue being sent at the end of the outermost one.
+ *
+ * As errors are only known when the queue is flushed, they are reported by arv_device_end_batch().
+ *
+ * A batch is not thread safe, and must not be used if the device is accessed by several threads.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_begin_batch (ArvDevice *device)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+
+	if (priv->batch_depth == 0) {
+		if (priv->batch_addresses == NULL) {
+			priv->batch_addresses = g_array_new (FALSE, FALSE, sizeof (guint64));
+			priv->batch_values = g_array_new (FALSE, FALSE, sizeof (guint32));
+		}
+		g_clear_error (&priv->batch_error);
+	}
+
+	priv->batch_depth++;
+}
+
+/**
+ * arv_device_end_batch:
+ * @device: a #ArvDevice
+ * @error: (out) (allow-none): a #GError placeholder
+ *
+ * Ends a register batch started by arv_device_begin_batch(). At the end of the outermost batch, the queued register
+ * writes are sent to the device.
+ *
+ * Return value: %TRUE if all the batched writes succeeded. Only the first error is reported.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_end_batch (ArvDevice *device, GError **error)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), FALSE);
+	g_return_val_if_fail (priv->batch_depth > 0, FALSE);
+
+	priv->batch_depth--;
+	if (priv->batch_depth > 0)
+		return TRUE;
+
+	_flush_batch (device);
+
+	if (priv->batch_error != NULL) {
+		g_propagate_error (error, priv->batch_error);
+		priv->batch_error = NULL;
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+gboolean
+arv_device_is_batch_active (ArvDevice *device)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+
+	g_return_val_if_fail (ARV_IS_DEVICE (device), FALSE);
+
+	return priv->batch_depth > 0;
+}
+
 /**
  * arv_device_get_genicam:
  * @device: a #ArvDevice
@@ -992,6 +1261,9 @@ arv_device_set_features_from_string (ArvDevice *device, const char *string, GErr
 			     "(?:\\=((?<Value>[^\\s\"']+)|\"(?<Value>[^\"]*)\"|'(?<Value>[^']*)'))?",
 			     G_REGEX_DUPNAMES, 0, NULL);
 
+	/* Consecutive register writes are sent together */
+	arv_device_begin_batch (device);
+
 	if (g_regex_match (regex, string, 0, &match_info)) {
 		while (g_match_info_matches (match_info) && local_error == NULL) {
 			ArvGcNode *feature;
@@ -1050,6 +1322,11 @@ arv_device_set_features_from_string (ArvDevice *device, const char *string, GErr
 
 	g_regex_unref (regex);
 
+	if (local_error == NULL)
+		arv_device_end_batch (device, &local_error);
+	else
+		arv_device_end_batch (device, NULL);
+
 	if (local_error != NULL) {
 		g_propagate_error (error, local_error);
 		return FALSE;
@@ -1058,89 +1335,1005 @@ arv_device_set_features_from_string (ArvDevice *device, const char *string, GErr
 	return TRUE;
 }
 
-/**
- * arv_device_set_register_cache_policy:
+static void
+arv_device_io_operation_free (ArvDeviceIOOperation *operation)
+{
+	if (operation->buffer_owned)
+		g_free (operation->buffer);
+	g_free (operation->feature);
+	g_free (operation->string_value);
+	g_free (operation);
+}
+
+static void
+_io_pool_func (gpointer data, gpointer user_data)
+{
+	GTask *task = data;
+	ArvDevice *device = g_task_get_source_object (task);
+	ArvDeviceIOOperation *operation = g_task_get_task_data (task);
+	ArvDeviceClass *device_class = ARV_DEVICE_GET_CLASS (device);
+	GError *error = NULL;
+
+	/* Memory and register operations bypass the write batch, which belongs to the calling thread */
+
+	switch (operation->type) {
+		case ARV_DEVICE_IO_OPERATION_READ_MEMORY:
+			device_class->read_memory (device, operation->address, operation->size, operation->buffer,
+						   &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_WRITE_MEMORY:
+			device_class->write_memory (device, operation->address, operation->size, operation->buffer,
+						    &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_READ_REGISTER:
+			device_class->read_register (device, operation->address, &operation->register_value, &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_WRITE_REGISTER:
+			device_class->write_register (device, operation->address, operation->register_value, &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_EXECUTE_COMMAND:
+			arv_device_execute_command (device, operation->feature, &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_GET_INTEGER:
+			operation->integer_value = arv_device_get_integer_feature_value (device, operation->feature,
+											 &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_SET_INTEGER:
+			arv_device_set_integer_feature_value (device, operation->feature, operation->integer_value,
+							      &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_GET_FLOAT:
+			operation->float_value = arv_device_get_float_feature_value (device, operation->feature,
+										     &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_SET_FLOAT:
+			arv_device_set_float_feature_value (device, operation->feature, operation->float_value,
+							    &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_GET_BOOLEAN:
+			operation->boolean_value = arv_device_get_boolean_feature_value (device, operation->feature,
+											 &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_SET_BOOLEAN:
+			arv_device_set_boolean_feature_value (device, operation->feature, operation->boolean_value,
+							      &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_GET_STRING:
+			operation->string_value = g_strdup (arv_device_get_string_feature_value (device,
+												 operation->feature,
+												 &error));
+			break;
+		case ARV_DEVICE_IO_OPERATION_SET_STRING:
+			arv_device_set_string_feature_value (device, operation->feature, operation->string_value,
+							     &error);
+			break;
+		case ARV_DEVICE_IO_OPERATION_SET_FEATURES_FROM_STRING:
+			arv_device_set_features_from_string (device, operation->string_value, &error);
+			break;
+	}
+
+	arv_device_complete_io_operation (device, task, error);
+}
+
+/* Operations are queued per device and started one at a time, which keeps them in order and serialized. Memory and
+ * register operations are handed to the private start_io_operation function of the device type, see
+ * arv_device_class_set_io_functions(), which runs them without blocking in the thread default main context of the
+ * caller. The other operations, and all operations of devices not implementing it, use the blocking accessors in a
+ * per device pool limited to one thread, without dedicating a thread to each request. Completion callbacks are
+ * invoked in the thread default main context of the caller. */
+
+static void
+_start_io_operation (ArvDevice *device, GTask *task)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+	const ArvDeviceIOFunctions *io_functions = _get_io_functions (device);
+	ArvDeviceIOOperation *operation = g_task_get_task_data (task);
+	GError *error = NULL;
+
+	if (g_cancellable_set_error_if_cancelled (g_task_get_cancellable (task), &error)) {
+		arv_device_complete_io_operation (device, task, error);
+		return;
+	}
+
+	switch (operation->type) {
+		case ARV_DEVICE_IO_OPERATION_READ_MEMORY:
+		case ARV_DEVICE_IO_OPERATION_WRITE_MEMORY:
+		case ARV_DEVICE_IO_OPERATION_READ_REGISTER:
+		case ARV_DEVICE_IO_OPERATION_WRITE_REGISTER:
+			if (io_functions != NULL &&
+			    io_functions->start_io_operation != NULL &&
+			    io_functions->start_io_operation (device, task))
+				return;
+			break;
+		default:
+			break;
+	}
+
+	g_mutex_lock (&priv->io_mutex);
+	if (priv->io_pool == NULL)
+		priv->io_pool = g_thread_pool_new (_io_pool_func, NULL, 1, FALSE, &error);
+	if (priv->io_pool != NULL)
+		g_thread_pool_push (priv->io_pool, task, &error);
+	g_mutex_unlock (&priv->io_mutex);
+
+	if (error != NULL)
+		arv_device_complete_io_operation (device, task, error);
+}
+
+/*
+ * arv_device_complete_io_operation:
  * @device: a #ArvDevice
- * @policy: cache policy
- *
- * Sets the register cache policy.
- *
- * <warning><para>Be aware that some camera may have wrong Cachable properties defined in their Genicam metadata, which
- * may lead to incorrect readouts. Using the debug cache policy, and activating genicam debug output (export
- * ARV_DEBUG=genicam), can help you to check the cache validity. In this mode, every time the cache content is not in
- * sync with the actual register value, a debug message is printed on the console.</para></warning>
+ * @task: (transfer full): the task of the current asynchronous operation
+ * @error: (transfer full) (nullable): the operation error
  *
- * Since: 0.8.0
+ * Returns the result of the current asynchronous operation, and starts the next queued one.
  */
 
 void
-arv_device_set_register_cache_policy (ArvDevice *device, ArvRegisterCachePolicy policy)
+arv_device_complete_io_operation (ArvDevice *device, GTask *task, GError *error)
 {
-	ArvGc *genicam;
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+	GTask *next_task;
 
-	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_object_ref (device);
 
-	genicam = arv_device_get_genicam (device);
-	arv_gc_set_register_cache_policy (genicam, policy);
+	if (error != NULL)
+		g_task_return_error (task, error);
+	else
+		g_task_return_boolean (task, TRUE);
+	g_object_unref (task);
+
+	g_mutex_lock (&priv->io_mutex);
+	next_task = g_queue_pop_head (&priv->io_queue);
+	if (next_task == NULL)
+		priv->io_busy = FALSE;
+	g_mutex_unlock (&priv->io_mutex);
+
+	if (next_task != NULL)
+		_start_io_operation (device, next_task);
+
+	g_object_unref (device);
+}
+
+static void
+_queue_io_operation (ArvDevice *device, ArvDeviceIOOperation *operation, gpointer source_tag,
+		     GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
+{
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+	GTask *task;
+	gboolean start;
+
+	task = g_task_new (device, cancellable, callback, user_data);
+	g_task_set_source_tag (task, source_tag);
+	g_task_set_task_data (task, operation, (GDestroyNotify) arv_device_io_operation_free);
+
+	g_mutex_lock (&priv->io_mutex);
+	start = !priv->io_busy;
+	if (start)
+		priv->io_busy = TRUE;
+	else
+		g_queue_push_tail (&priv->io_queue, task);
+	g_mutex_unlock (&priv->io_mutex);
+
+	if (start)
+		_start_io_operation (device, task);
+}
+
+static ArvDeviceIOOperation *
+_finish_io_operation (ArvDevice *device, GAsyncResult *result, gpointer source_tag, GError **error)
+{
+	g_return_val_if_fail (g_task_is_valid (result, device), NULL);
+	g_return_val_if_fail (g_task_get_source_tag (G_TASK (result)) == source_tag, NULL);
+
+	if (!g_task_propagate_boolean (G_TASK (result), error))
+		return NULL;
+
+	return g_task_get_task_data (G_TASK (result));
+}
+
+static ArvDeviceIOOperation *
+_new_feature_operation (ArvDeviceIOOperationType type, const char *feature)
+{
+	ArvDeviceIOOperation *operation;
+
+	operation = g_new0 (ArvDeviceIOOperation, 1);
+	operation->type = type;
+	operation->feature = g_strdup (feature);
+
+	return operation;
 }
 
 /**
- * arv_device_set_range_check_policy:
+ * arv_device_read_memory_async:
  * @device: a #ArvDevice
- * @policy: range check policy
+ * @address: memory address
+ * @size: number of bytes to read
+ * @buffer: (array length=size) (element-type guint8): a buffer for the storage of the read data
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
  *
- * Sets the range check policy. When enabled, before being set, the value of all nodes with an #ArvGcFloat or
- * #ArvGcInteger interface will be checked against their Min and Max properties.
+ * Asynchronously reads @size bytes from the device memory. @buffer must stay valid until @callback is called, which
+ * happens in the thread default main context of the caller. Call arv_device_read_memory_finish() from @callback to
+ * get the result of the operation.
  *
- * <warning><para>Be aware that some camera may have wrong definition of Min and Max, as this check is defined as not
- * mandatory in the Genicam specification. If this is the case, it will not possible to set the value of the features
- * with faulty Min or Max definition. Range check is disabled by default.</para></warning>
+ * Asynchronous operations on a device are executed in order, without blocking the caller. They are not part of any
+ * batch started with arv_device_begin_batch().
  *
- * Since: 0.8.6
+ * Since: 0.8.32
  */
 
 void
-arv_device_set_range_check_policy (ArvDevice *device, ArvRangeCheckPolicy policy)
+arv_device_read_memory_async (ArvDevice *device, guint64 address, guint32 size, void *buffer,
+			      GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
 {
-	ArvGc *genicam;
+	ArvDeviceIOOperation *operation;
 
 	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (buffer != NULL);
 
-	genicam = arv_device_get_genicam (device);
-	arv_gc_set_range_check_policy (genicam, policy);
+	operation = g_new0 (ArvDeviceIOOperation, 1);
+	operation->type = ARV_DEVICE_IO_OPERATION_READ_MEMORY;
+	operation->address = address;
+	operation->size = size;
+	operation->buffer = buffer;
+
+	_queue_io_operation (device, operation, arv_device_read_memory_async, cancellable, callback, user_data);
 }
 
 /**
- * arv_device_set_access_check_policy:
+ * arv_device_read_memory_finish:
  * @device: a #ArvDevice
- * @policy: access check policy
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
  *
- * Sets the feature access check policy. When enabled, before being accessed, the actual read/write access of register
- * is checked using AccessMode properties. On some devices, it helps to avoid forbidden writes to registers that may put
- * the device in a bad state.
+ * Finishes an operation started with arv_device_read_memory_async().
  *
- * <warning><para>Access check is disabled by default.</para></warning>
+ * Returns: %TRUE on success.
  *
- * Since: 0.8.22
+ * Since: 0.8.32
  */
 
-void
-arv_device_set_access_check_policy (ArvDevice *device, ArvAccessCheckPolicy policy)
+gboolean
+arv_device_read_memory_finish (ArvDevice *device, GAsyncResult *result, GError **error)
 {
-	ArvGc *genicam;
-
-	g_return_if_fail (ARV_IS_DEVICE (device));
-
-	genicam = arv_device_get_genicam (device);
-	arv_gc_set_access_check_policy (genicam, policy);
+	return _finish_io_operation (device, result, arv_device_read_memory_async, error) != NULL;
 }
 
+/**
+ * arv_device_write_memory_async:
+ * @device: a #ArvDevice
+ * @address: memory address
+ * @size: number of bytes to write
+ * @buffer: (array length=size) (element-type guint8): data to write
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously writes @size bytes to the device memory. @buffer is copied and can be released as soon as this
+ * function returns.
+ *
+ * Since: 0.8.32
+ */
+
 void
-arv_device_emit_control_lost_signal (ArvDevice *device)
+arv_device_write_memory_async (ArvDevice *device, guint64 address, guint32 size, const void *buffer,
+			       GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
 {
+	ArvDeviceIOOperation *operation;
+
 	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (buffer != NULL);
 
-	g_signal_emit (device, arv_device_signals[ARV_DEVICE_SIGNAL_CONTROL_LOST], 0);
+	operation = g_new0 (ArvDeviceIOOperation, 1);
+	operation->type = ARV_DEVICE_IO_OPERATION_WRITE_MEMORY;
+	operation->address = address;
+	operation->size = size;
+	operation->buffer = g_malloc (size);
+	operation->buffer_owned = TRUE;
+	memcpy (operation->buffer, buffer, size);
+
+	_queue_io_operation (device, operation, arv_device_write_memory_async, cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_write_memory_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_write_memory_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_write_memory_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	return _finish_io_operation (device, result, arv_device_write_memory_async, error) != NULL;
+}
+
+/**
+ * arv_device_read_register_async:
+ * @device: a #ArvDevice
+ * @address: register address
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously reads the value of a device register.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_read_register_async (ArvDevice *device, guint64 address,
+				GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
+{
+	ArvDeviceIOOperation *operation;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+
+	operation = g_new0 (ArvDeviceIOOperation, 1);
+	operation->type = ARV_DEVICE_IO_OPERATION_READ_REGISTER;
+	operation->address = address;
+
+	_queue_io_operation (device, operation, arv_device_read_register_async, cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_read_register_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @value: (out): a placeholder for the read value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_read_register_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_read_register_finish (ArvDevice *device, GAsyncResult *result, guint32 *value, GError **error)
+{
+	ArvDeviceIOOperation *operation;
+
+	operation = _finish_io_operation (device, result, arv_device_read_register_async, error);
+
+	if (value != NULL)
+		*value = operation != NULL ? operation->register_value : 0;
+
+	return operation != NULL;
+}
+
+/**
+ * arv_device_write_register_async:
+ * @device: a #ArvDevice
+ * @address: register address
+ * @value: new register value
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously writes a device register.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_write_register_async (ArvDevice *device, guint64 address, guint32 value,
+				 GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
+{
+	ArvDeviceIOOperation *operation;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+
+	operation = g_new0 (ArvDeviceIOOperation, 1);
+	operation->type = ARV_DEVICE_IO_OPERATION_WRITE_REGISTER;
+	operation->address = address;
+	operation->register_value = value;
+
+	_queue_io_operation (device, operation, arv_device_write_register_async, cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_write_register_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_write_register_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_write_register_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	return _finish_io_operation (device, result, arv_device_write_register_async, error) != NULL;
+}
+
+/**
+ * arv_device_execute_command_async:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously executes a genicam command.
+ *
+ * Feature operations are evaluated outside of the calling thread. They are serialized with the other asynchronous
+ * operations of @device, but must not run concurrently with synchronous feature accesses from another thread.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_execute_command_async (ArvDevice *device, const char *feature,
+				  GCancellable *cancellable, GAsyncReadyCallback callback, gpointer user_data)
+{
+	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (feature != NULL);
+
+	_queue_io_operation (device, _new_feature_operation (ARV_DEVICE_IO_OPERATION_EXECUTE_COMMAND, feature),
+			     arv_device_execute_command_async, cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_execute_command_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_execute_command_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_execute_command_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	return _finish_io_operation (device, result, arv_device_execute_command_async, error) != NULL;
+}
+
+/**
+ * arv_device_get_integer_feature_value_async:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously reads an integer feature value.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_get_integer_feature_value_async (ArvDevice *device, const char *feature,
+					    GCancellable *cancellable, GAsyncReadyCallback callback,
+					    gpointer user_data)
+{
+	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (feature != NULL);
+
+	_queue_io_operation (device, _new_feature_operation (ARV_DEVICE_IO_OPERATION_GET_INTEGER, feature),
+			     arv_device_get_integer_feature_value_async, cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_get_integer_feature_value_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_get_integer_feature_value_async().
+ *
+ * Returns: the integer feature value, 0 on error.
+ *
+ * Since: 0.8.32
+ */
+
+gint64
+arv_device_get_integer_feature_value_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	ArvDeviceIOOperation *operation;
+
+	operation = _finish_io_operation (device, result, arv_device_get_integer_feature_value_async, error);
+
+	return operation != NULL ? operation->integer_value : 0;
+}
+
+/**
+ * arv_device_set_integer_feature_value_async:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @value: new feature value
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously sets an integer feature value.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_set_integer_feature_value_async (ArvDevice *device, const char *feature, gint64 value,
+					    GCancellable *cancellable, GAsyncReadyCallback callback,
+					    gpointer user_data)
+{
+	ArvDeviceIOOperation *operation;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (feature != NULL);
+
+	operation = _new_feature_operation (ARV_DEVICE_IO_OPERATION_SET_INTEGER, feature);
+	operation->integer_value = value;
+
+	_queue_io_operation (device, operation, arv_device_set_integer_feature_value_async,
+			     cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_set_integer_feature_value_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_set_integer_feature_value_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_set_integer_feature_value_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	return _finish_io_operation (device, result, arv_device_set_integer_feature_value_async, error) != NULL;
+}
+
+/**
+ * arv_device_get_float_feature_value_async:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously reads a float feature value.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_get_float_feature_value_async (ArvDevice *device, const char *feature,
+					  GCancellable *cancellable, GAsyncReadyCallback callback,
+					  gpointer user_data)
+{
+	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (feature != NULL);
+
+	_queue_io_operation (device, _new_feature_operation (ARV_DEVICE_IO_OPERATION_GET_FLOAT, feature),
+			     arv_device_get_float_feature_value_async, cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_get_float_feature_value_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_get_float_feature_value_async().
+ *
+ * Returns: the float feature value, 0.0 on error.
+ *
+ * Since: 0.8.32
+ */
+
+double
+arv_device_get_float_feature_value_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	ArvDeviceIOOperation *operation;
+
+	operation = _finish_io_operation (device, result, arv_device_get_float_feature_value_async, error);
+
+	return operation != NULL ? operation->float_value : 0.0;
+}
+
+/**
+ * arv_device_set_float_feature_value_async:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @value: new feature value
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously sets a float feature value.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_set_float_feature_value_async (ArvDevice *device, const char *feature, double value,
+					  GCancellable *cancellable, GAsyncReadyCallback callback,
+					  gpointer user_data)
+{
+	ArvDeviceIOOperation *operation;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (feature != NULL);
+
+	operation = _new_feature_operation (ARV_DEVICE_IO_OPERATION_SET_FLOAT, feature);
+	operation->float_value = value;
+
+	_queue_io_operation (device, operation, arv_device_set_float_feature_value_async,
+			     cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_set_float_feature_value_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_set_float_feature_value_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_set_float_feature_value_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	return _finish_io_operation (device, result, arv_device_set_float_feature_value_async, error) != NULL;
+}
+
+/**
+ * arv_device_get_boolean_feature_value_async:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously reads a boolean feature value.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_get_boolean_feature_value_async (ArvDevice *device, const char *feature,
+					    GCancellable *cancellable, GAsyncReadyCallback callback,
+					    gpointer user_data)
+{
+	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (feature != NULL);
+
+	_queue_io_operation (device, _new_feature_operation (ARV_DEVICE_IO_OPERATION_GET_BOOLEAN, feature),
+			     arv_device_get_boolean_feature_value_async, cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_get_boolean_feature_value_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @value: (out): a placeholder for the feature value
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_get_boolean_feature_value_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_get_boolean_feature_value_finish (ArvDevice *device, GAsyncResult *result, gboolean *value,
+					     GError **error)
+{
+	ArvDeviceIOOperation *operation;
+
+	operation = _finish_io_operation (device, result, arv_device_get_boolean_feature_value_async, error);
+
+	if (value != NULL)
+		*value = operation != NULL ? operation->boolean_value : FALSE;
+
+	return operation != NULL;
+}
+
+/**
+ * arv_device_set_boolean_feature_value_async:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @value: new feature value
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously sets a boolean feature value.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_set_boolean_feature_value_async (ArvDevice *device, const char *feature, gboolean value,
+					    GCancellable *cancellable, GAsyncReadyCallback callback,
+					    gpointer user_data)
+{
+	ArvDeviceIOOperation *operation;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (feature != NULL);
+
+	operation = _new_feature_operation (ARV_DEVICE_IO_OPERATION_SET_BOOLEAN, feature);
+	operation->boolean_value = value;
+
+	_queue_io_operation (device, operation, arv_device_set_boolean_feature_value_async,
+			     cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_set_boolean_feature_value_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_set_boolean_feature_value_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_set_boolean_feature_value_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	return _finish_io_operation (device, result, arv_device_set_boolean_feature_value_async, error) != NULL;
+}
+
+/**
+ * arv_device_get_string_feature_value_async:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously reads a string feature value.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_get_string_feature_value_async (ArvDevice *device, const char *feature,
+					   GCancellable *cancellable, GAsyncReadyCallback callback,
+					   gpointer user_data)
+{
+	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (feature != NULL);
+
+	_queue_io_operation (device, _new_feature_operation (ARV_DEVICE_IO_OPERATION_GET_STRING, feature),
+			     arv_device_get_string_feature_value_async, cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_get_string_feature_value_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_get_string_feature_value_async().
+ *
+ * Returns: (transfer full): a newly allocated copy of the feature value, %NULL on error.
+ *
+ * Since: 0.8.32
+ */
+
+char *
+arv_device_get_string_feature_value_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	ArvDeviceIOOperation *operation;
+
+	operation = _finish_io_operation (device, result, arv_device_get_string_feature_value_async, error);
+
+	return operation != NULL ? g_strdup (operation->string_value) : NULL;
+}
+
+/**
+ * arv_device_set_string_feature_value_async:
+ * @device: a #ArvDevice
+ * @feature: feature name
+ * @value: new feature value
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronously sets a string feature value.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_set_string_feature_value_async (ArvDevice *device, const char *feature, const char *value,
+					   GCancellable *cancellable, GAsyncReadyCallback callback,
+					   gpointer user_data)
+{
+	ArvDeviceIOOperation *operation;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+	g_return_if_fail (feature != NULL);
+
+	operation = _new_feature_operation (ARV_DEVICE_IO_OPERATION_SET_STRING, feature);
+	operation->string_value = g_strdup (value);
+
+	_queue_io_operation (device, operation, arv_device_set_string_feature_value_async,
+			     cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_set_string_feature_value_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_set_string_feature_value_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_set_string_feature_value_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	return _finish_io_operation (device, result, arv_device_set_string_feature_value_async, error) != NULL;
+}
+
+/**
+ * arv_device_set_features_from_string_async:
+ * @device: a #ArvDevice
+ * @string: a space separated list of features assignments
+ * @cancellable: (allow-none): a #GCancellable, %NULL to ignore
+ * @callback: (scope async): a #GAsyncReadyCallback to call when the request is satisfied
+ * @user_data: (closure): the data to pass to @callback
+ *
+ * Asynchronous version of arv_device_set_features_from_string().
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_device_set_features_from_string_async (ArvDevice *device, const char *string,
+					   GCancellable *cancellable, GAsyncReadyCallback callback,
+					   gpointer user_data)
+{
+	ArvDeviceIOOperation *operation;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+
+	operation = g_new0 (ArvDeviceIOOperation, 1);
+	operation->type = ARV_DEVICE_IO_OPERATION_SET_FEATURES_FROM_STRING;
+	operation->string_value = g_strdup (string);
+
+	_queue_io_operation (device, operation, arv_device_set_features_from_string_async,
+			     cancellable, callback, user_data);
+}
+
+/**
+ * arv_device_set_features_from_string_finish:
+ * @device: a #ArvDevice
+ * @result: a #GAsyncResult
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Finishes an operation started with arv_device_set_features_from_string_async().
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_device_set_features_from_string_finish (ArvDevice *device, GAsyncResult *result, GError **error)
+{
+	return _finish_io_operation (device, result, arv_device_set_features_from_string_async, error) != NULL;
+}
+
+/**
+ * arv_device_set_register_cache_policy:
+ * @device: a #ArvDevice
+ * @policy: cache policy
+ *
+ * Sets the register cache policy.
+ *
+ * <warning><para>Be aware that some camera may have wrong Cachable properties defined in their Genicam metadata, which
+ * may lead to incorrect readouts. Using the debug cache policy, and activating genicam debug output (export
+ * ARV_DEBUG=genicam), can help you to check the cache validity. In this mode, every time the cache content is not in
+ * sync with the actual register value, a debug message is printed on the console.</para></warning>
+ *
+ * Since: 0.8.0
+ */
+
+void
+arv_device_set_register_cache_policy (ArvDevice *device, ArvRegisterCachePolicy policy)
+{
+	ArvGc *genicam;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+
+	genicam = arv_device_get_genicam (device);
+	arv_gc_set_register_cache_policy (genicam, policy);
+}
+
+/**
+ * arv_device_set_range_check_policy:
+ * @device: a #ArvDevice
+ * @policy: range check policy
+ *
+ * Sets the range check policy. When enabled, before being set, the value of all nodes with an #ArvGcFloat or
+ * #ArvGcInteger interface will be checked against their Min and Max properties.
+ *
+ * <warning><para>Be aware that some camera may have wrong definition of Min and Max, as this check is defined as not
+ * mandatory in the Genicam specification. If this is the case, it will not possible to set the value of the features
+ * with faulty Min or Max definition. Range check is disabled by default.</para></warning>
+ *
+ * Since: 0.8.6
+ */
+
+void
+arv_device_set_range_check_policy (ArvDevice *device, ArvRangeCheckPolicy policy)
+{
+	ArvGc *genicam;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+
+	genicam = arv_device_get_genicam (device);
+	arv_gc_set_range_check_policy (genicam, policy);
+}
+
+/**
+ * arv_device_set_access_check_policy:
+ * @device: a #ArvDevice
+ * @policy: access check policy
+ *
+ * Sets the feature access check policy. When enabled, before being accessed, the actual read/write access of register
+ * is checked using AccessMode properties. On some devices, it helps to avoid forbidden writes to registers that may put
+ * the device in a bad state.
+ *
+ * <warning><para>Access check is disabled by default.</para></warning>
+ *
+ * Since: 0.8.22
+ */
+
+void
+arv_device_set_access_check_policy (ArvDevice *device, ArvAccessCheckPolicy policy)
+{
+	ArvGc *genicam;
+
+	g_return_if_fail (ARV_IS_DEVICE (device));
+
+	genicam = arv_device_get_genicam (device);
+	arv_gc_set_access_check_policy (genicam, policy);
+}
+
+void
+arv_device_emit_control_lost_signal (ArvDevice *device)
+{
+	g_return_if_fail (ARV_IS_DEVICE (device));
+
+	g_signal_emit (device, arv_device_signals[ARV_DEVICE_SIGNAL_CONTROL_LOST], 0);
 }
 
 
@@ -1157,6 +2350,9 @@ void arv_device_take_init_error (ArvDevice *device, GError *error)
 static void
 arv_device_init (ArvDevice *device)
 {
+	ArvDevicePrivate *priv = arv_device_get_instance_private (device);
+
+	g_mutex_init (&priv->io_mutex);
 }
 
 static void
@@ -1165,6 +2361,15 @@ arv_device_finalize (GObject *object)
 	ArvDevicePrivate *priv = arv_device_get_instance_private (ARV_DEVICE (object));
 
 	g_clear_error (&priv->init_error);
+	g_clear_error (&priv->batch_error);
+	g_clear_pointer (&priv->batch_addresses, g_array_unref);
+	g_clear_pointer (&priv->batch_values, g_array_unref);
+
+	/* Each pending operation holds a reference on the device, the queue and the pool are idle at this point.
+	 * Finalization may happen in a pool thread, don't wait for it. */
+	if (priv->io_pool != NULL)
+		g_thread_pool_free (priv->io_pool, TRUE, FALSE);
+	g_mutex_clear (&priv->io_mutex);
 
 	G_OBJECT_CLASS (arv_device_parent_class)->finalize (object);
 }
@@ -32,6 +32,7 @@
 #include <arvtypes.h>
 #include <arvstream.h>
 #include <arvchunkparser.h>
+#include <gio/gio.h>
 
 G_BEGIN_DECLS
 
@@ -104,6 +105,13 @@ ARV_API gboolean	arv_device_read_memory			(ArvDevice *device, guint64 address, g
 ARV_API gboolean	arv_device_write_memory			(ArvDevice *device, guint64 address, guint32 size, void *buffer, GError **error);
 ARV_API gboolean	arv_device_read_register		(ArvDevice *device, guint64 address, guint32 *value, GError **error);
 ARV_API gboolean	arv_device_write_register		(ArvDevice *device, guint64 address, guint32 value, GError **error);
+ARV_API gboolean	arv_device_read_registers		(ArvDevice *device, const guint64 *addresses, guint32 *values,
+								 guint n_registers, GError **error);
+ARV_API gboolean	arv_device_write_registers		(ArvDevice *device, const guint64 *addresses,
+								 const guint32 *values, guint n_registers, GError **error);
+
+ARV_API void		arv_device_begin_batch			(ArvDevice *device);
+ARV_API gboolean	arv_device_end_batch			(ArvDevice *device, GError **error);
 
 ARV_API const char *	arv_device_get_genicam_xml		(ArvDevice *device, size_t *size);
 ARV_API ArvGc *		arv_device_get_genicam			(ArvDevice *device);
@@ -147,6 +155,74 @@ ARV_API gboolean	arv_device_is_enumeration_entry_available				(ArvDevice *device
 
 ARV_API gboolean	arv_device_set_features_from_string	(ArvDevice *device, const char *string, GError **error);
 
+ARV_API void		arv_device_read_memory_async		(ArvDevice *device, guint64 address, guint32 size, void *buffer,
+								 GCancellable *cancellable, GAsyncReadyCallback callback,
+								 gpointer user_data);
+ARV_API gboolean	arv_device_read_memory_finish		(ArvDevice *device, GAsyncResult *result, GError **error);
+ARV_API void		arv_device_write_memory_async		(ArvDevice *device, guint64 address, guint32 size,
+								 const void *buffer, GCancellable *cancellable,
+								 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API gboolean	arv_device_write_memory_finish		(ArvDevice *device, GAsyncResult *result, GError **error);
+ARV_API void		arv_device_read_register_async		(ArvDevice *device, guint64 address,
+								 GCancellable *cancellable, GAsyncReadyCallback callback,
+								 gpointer user_data);
+ARV_API gboolean	arv_device_read_register_finish		(ArvDevice *device, GAsyncResult *result, guint32 *value,
+								 GError **error);
+ARV_API void		arv_device_write_register_async		(ArvDevice *device, guint64 address, guint32 value,
+								 GCancellable *cancellable, GAsyncReadyCallback callback,
+								 gpointer user_data);
+ARV_API gboolean	arv_device_write_register_finish	(ArvDevice *device, GAsyncResult *result, GError **error);
+
+ARV_API void		arv_device_execute_command_async	(ArvDevice *device, const char *feature,
+								 GCancellable *cancellable, GAsyncReadyCallback callback,
+								 gpointer user_data);
+ARV_API gboolean	arv_device_execute_command_finish	(ArvDevice *device, GAsyncResult *result, GError **error);
+ARV_API void		arv_device_get_integer_feature_value_async	(ArvDevice *device, const char *feature,
+									 GCancellable *cancellable,
+									 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API gint64		arv_device_get_integer_feature_value_finish	(ArvDevice *device, GAsyncResult *result,
+									 GError **error);
+ARV_API void		arv_device_set_integer_feature_value_async	(ArvDevice *device, const char *feature, gint64 value,
+									 GCancellable *cancellable,
+									 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API gboolean	arv_device_set_integer_feature_value_finish	(ArvDevice *device, GAsyncResult *result,
+									 GError **error);
+ARV_API void		arv_device_get_float_feature_value_async	(ArvDevice *device, const char *feature,
+									 GCancellable *cancellable,
+									 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API double		arv_device_get_float_feature_value_finish	(ArvDevice *device, GAsyncResult *result,
+									 GError **error);
+ARV_API void		arv_device_set_float_feature_value_async	(ArvDevice *device, const char *feature, double value,
+									 GCancellable *cancellable,
+									 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API gboolean	arv_device_set_float_feature_value_finish	(ArvDevice *device, GAsyncResult *result,
+									 GError **error);
+ARV_API void		arv_device_get_boolean_feature_value_async	(ArvDevice *device, const char *feature,
+									 GCancellable *cancellable,
+									 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API gboolean	arv_device_get_boolean_feature_value_finish	(ArvDevice *device, GAsyncResult *result,
+									 gboolean *value, GError **error);
+ARV_API void		arv_device_set_boolean_feature_value_async	(ArvDevice *device, const char *feature,
+									 gboolean value, GCancellable *cancellable,
+									 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API gboolean	arv_device_set_boolean_feature_value_finish	(ArvDevice *device, GAsyncResult *result,
+									 GError **error);
+ARV_API void		arv_device_get_string_feature_value_async	(ArvDevice *device, const char *feature,
+									 GCancellable *cancellable,
+									 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API char *		arv_device_get_string_feature_value_finish	(ArvDevice *device, GAsyncResult *result,
+									 GError **error);
+ARV_API void		arv_device_set_string_feature_value_async	(ArvDevice *device, const char *feature,
+									 const char *value, GCancellable *cancellable,
+									 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API gboolean	arv_device_set_string_feature_value_finish	(ArvDevice *device, GAsyncResult *result,
+									 GError **error);
+ARV_API void		arv_device_set_features_from_string_async	(ArvDevice *device, const char *string,
+									 GCancellable *cancellable,
+									 GAsyncReadyCallback callback, gpointer user_data);
+ARV_API gboolean	arv_device_set_features_from_string_finish	(ArvDevice *device, GAsyncResult *result,
+									 GError **error);
+
 ARV_API void		arv_device_set_register_cache_policy	(ArvDevice *device, ArvRegisterCachePolicy policy);
 ARV_API void		arv_device_set_range_check_policy	(ArvDevice *device, ArvRangeCheckPolicy policy);
 ARV_API void            arv_device_set_access_check_policy      (ArvDevice *device, ArvAccessCheckPolicy policy);
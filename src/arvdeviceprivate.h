@@ -31,8 +31,57 @@
 
 G_BEGIN_DECLS
 
+typedef enum {
+	ARV_DEVICE_IO_OPERATION_READ_MEMORY,
+	ARV_DEVICE_IO_OPERATION_WRITE_MEMORY,
+	ARV_DEVICE_IO_OPERATION_READ_REGISTER,
+	ARV_DEVICE_IO_OPERATION_WRITE_REGISTER,
+	ARV_DEVICE_IO_OPERATION_EXECUTE_COMMAND,
+	ARV_DEVICE_IO_OPERATION_GET_INTEGER,
+	ARV_DEVICE_IO_OPERATION_SET_INTEGER,
+	ARV_DEVICE_IO_OPERATION_GET_FLOAT,
+	ARV_DEVICE_IO_OPERATION_SET_FLOAT,
+	ARV_DEVICE_IO_OPERATION_GET_BOOLEAN,
+	ARV_DEVICE_IO_OPERATION_SET_BOOLEAN,
+	ARV_DEVICE_IO_OPERATION_GET_STRING,
+	ARV_DEVICE_IO_OPERATION_SET_STRING,
+	ARV_DEVICE_IO_OPERATION_SET_FEATURES_FROM_STRING
+} ArvDeviceIOOperationType;
+
+typedef struct {
+	ArvDeviceIOOperationType type;
+
+	guint64 address;
+	guint32 size;
+	void *buffer;
+	gboolean buffer_owned;
+
+	char *feature;
+	char *string_value;
+	gint64 integer_value;
+	double float_value;
+	gboolean boolean_value;
+	guint32 register_value;
+} ArvDeviceIOOperation;
+
+/* Private virtual functions, registered per device type with arv_device_class_set_io_functions() in order to keep
+ * them out of the public ArvDeviceClass structure. */
+
+typedef struct {
+	gboolean	(*read_registers)	(ArvDevice *device, const guint64 *addresses, guint32 *values,
+						 guint n_registers, GError **error);
+	gboolean	(*write_registers)	(ArvDevice *device, const guint64 *addresses, const guint32 *values,
+						 guint n_registers, GError **error);
+	gboolean	(*start_io_operation)	(ArvDevice *device, GTask *task);
+} ArvDeviceIOFunctions;
+
 void 		arv_device_emit_control_lost_signal 	(ArvDevice *device);
 void		arv_device_take_init_error		(ArvDevice *device, GError *error);
+gboolean	arv_device_is_batch_active		(ArvDevice *device);
+void		arv_device_complete_io_operation	(ArvDevice *device, GTask *task, GError *error);
+
+void		arv_device_class_set_io_functions	(ArvDeviceClass *device_class,
+							 const ArvDeviceIOFunctions *io_functions);
 
 G_END_DECLS
 
@@ -26,11 +26,12 @@
 #include <arvgc.h>
 #include <string.h>
 
+/* Devices may be opened concurrently, document_types is protected by document_types_mutex */
+static GMutex document_types_mutex;
 static GHashTable *document_types = NULL;
 
-void
-arv_dom_implementation_add_document_type (const char *qualified_name,
-					  GType document_type)
+static void
+_add_document_type_unlocked (const char *qualified_name, GType document_type)
 {
 	GType *document_type_ptr;
 
@@ -43,6 +44,15 @@ arv_dom_implementation_add_document_type (const char *qualified_name,
 	g_hash_table_insert (document_types, g_strdup (qualified_name), document_type_ptr);
 }
 
+void
+arv_dom_implementation_add_document_type (const char *qualified_name,
+					  GType document_type)
+{
+	g_mutex_lock (&document_types_mutex);
+	_add_document_type_unlocked (qualified_name, document_type);
+	g_mutex_unlock (&document_types_mutex);
+}
+
 /**
  * arv_dom_implementation_create_document:
  * @namespace_uri: namespace URI
@@ -57,30 +67,35 @@ ArvDomDocument *
 arv_dom_implementation_create_document (const char *namespace_uri,
 					const char *qualified_name)
 {
-	GType *document_type;
+	GType *document_type_ptr;
+	GType document_type = G_TYPE_INVALID;
 
 	g_return_val_if_fail (qualified_name != NULL, NULL);
 
-	if (document_types == NULL) {
-		arv_dom_implementation_add_document_type ("RegisterDescription", ARV_TYPE_GC);
-	}
+	g_mutex_lock (&document_types_mutex);
+
+	if (document_types == NULL)
+		_add_document_type_unlocked ("RegisterDescription", ARV_TYPE_GC);
 
-	document_type = g_hash_table_lookup (document_types, qualified_name);
-	if (document_type == NULL) {
+	document_type_ptr = g_hash_table_lookup (document_types, qualified_name);
+	if (document_type_ptr != NULL)
+		document_type = *document_type_ptr;
+
+	g_mutex_unlock (&document_types_mutex);
+
+	if (document_type == G_TYPE_INVALID) {
 		arv_info_dom ("[ArvDomImplementation::create_document] Unknown document type (%s)",
 			       qualified_name);
 		return NULL;
 	}
 
-	return g_object_new (*document_type, NULL);
+	return g_object_new (document_type, NULL);
 }
 
 void
 arv_dom_implementation_cleanup (void)
 {
-	if (document_types == NULL)
-		return;
-
-	g_hash_table_unref (document_types);
-	document_types = NULL;
+	g_mutex_lock (&document_types_mutex);
+	g_clear_pointer (&document_types, g_hash_table_unref);
+	g_mutex_unlock (&document_types_mutex);
 }
@@ -26,6 +26,7 @@
 #include <arvdomnode.h>
 #include <arvdomelement.h>
 #include <arvdomparser.h>
+#include <arvdomparserprivate.h>
 #include <arvstr.h>
 #include <libxml/parser.h>
 #include <gio/gio.h>
@@ -35,6 +36,144 @@ typedef enum {
 	STATE
 } ArvDomSaxParserStateEnum;
 
+/*
+ * Compiled document layout. All integers are 32 bit little endian.
+ *
+ * +---------------------------+ 0
+ * | ArvDomCompiledHeader      |
+ * +---------------------------+ string_offsets_offset
+ * | guint32 offsets[n]        | string offsets, relative to string_data_offset
+ * +---------------------------+ string_data_offset
+ * | null terminated strings   |
+ * +---------------------------+ records_offset
+ * | guint32 records[n]        |
+ * +---------------------------+
+ *
+ * Records are the sequence of the parser events which resulted in a node in the document, with interned strings:
+ *
+ * ELEMENT name n_attributes (attribute_name attribute_value)*
+ * TEXT data
+ * END
+ *
+ * Text and elements refused by the document are not recorded, and a compiled document is loaded without any XML
+ * parsing or string allocation.
+ */
+
+#define ARV_DOM_COMPILED_MAGIC		"ARVDOMC\0"
+#define ARV_DOM_COMPILED_VERSION	1
+
+#define ARV_DOM_COMPILED_ALIGN(size)	((((guint32) (size)) + 3) & ~((guint32) 3))
+
+typedef enum {
+	ARV_DOM_COMPILED_RECORD_ELEMENT = 1,
+	ARV_DOM_COMPILED_RECORD_TEXT,
+	ARV_DOM_COMPILED_RECORD_END
+} ArvDomCompiledRecord;
+
+#pragma pack(push,1)
+
+typedef struct {
+	char magic[8];
+	guint32 version;
+	guint32 n_strings;
+	guint32 string_offsets_offset;
+	guint32 string_data_offset;
+	guint32 string_data_size;
+	guint32 records_offset;
+	guint32 n_records;
+	guint32 reserved;
+} ArvDomCompiledHeader;
+
+#pragma pack(pop)
+
+struct _ArvDomCompiler {
+	GHashTable *string_ids;
+	GArray *string_offsets;
+	GByteArray *string_data;
+	GArray *records;
+};
+
+static ArvDomCompiler *
+arv_dom_compiler_new (void)
+{
+	ArvDomCompiler *compiler = g_new0 (ArvDomCompiler, 1);
+
+	compiler->string_ids = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
+	compiler->string_offsets = g_array_new (FALSE, FALSE, sizeof (guint32));
+	compiler->string_data = g_byte_array_new ();
+	compiler->records = g_array_new (FALSE, FALSE, sizeof (guint32));
+
+	return compiler;
+}
+
+static void
+arv_dom_compiler_free (ArvDomCompiler *compiler)
+{
+	g_hash_table_unref (compiler->string_ids);
+	g_array_unref (compiler->string_offsets);
+	g_byte_array_unref (compiler->string_data);
+	g_array_unref (compiler->records);
+	g_free (compiler);
+}
+
+static void
+arv_dom_compiler_add_record (ArvDomCompiler *compiler, guint32 value)
+{
+	value = GUINT32_TO_LE (value);
+	g_array_append_val (compiler->records, value);
+}
+
+static void
+arv_dom_compiler_add_string (ArvDomCompiler *compiler, const char *string)
+{
+	gpointer id;
+
+	if (!g_hash_table_lookup_extended (compiler->string_ids, string, NULL, &id)) {
+		guint32 offset = GUINT32_TO_LE (compiler->string_data->len);
+
+		id = GUINT_TO_POINTER (compiler->string_offsets->len);
+		g_array_append_val (compiler->string_offsets, offset);
+		g_byte_array_append (compiler->string_data, (const guint8 *) string, strlen (string) + 1);
+		g_hash_table_insert (compiler->string_ids, g_strdup (string), id);
+	}
+
+	arv_dom_compiler_add_record (compiler, GPOINTER_TO_UINT (id));
+}
+
+static GBytes *
+arv_dom_compiler_steal_bytes (ArvDomCompiler *compiler)
+{
+	static const guint8 padding[sizeof (guint32)] = {0};
+	ArvDomCompiledHeader header = {0};
+	GByteArray *data;
+	guint32 string_data_offset;
+	guint32 records_offset;
+
+	string_data_offset = sizeof (header) + compiler->string_offsets->len * sizeof (guint32);
+	records_offset = string_data_offset + ARV_DOM_COMPILED_ALIGN (compiler->string_data->len);
+
+	memcpy (header.magic, ARV_DOM_COMPILED_MAGIC, sizeof (header.magic));
+	header.version = GUINT32_TO_LE (ARV_DOM_COMPILED_VERSION);
+	header.n_strings = GUINT32_TO_LE (compiler->string_offsets->len);
+	header.string_offsets_offset = GUINT32_TO_LE (sizeof (header));
+	header.string_data_offset = GUINT32_TO_LE (string_data_offset);
+	header.string_data_size = GUINT32_TO_LE (compiler->string_data->len);
+	header.records_offset = GUINT32_TO_LE (records_offset);
+	header.n_records = GUINT32_TO_LE (compiler->records->len);
+
+	data = g_byte_array_sized_new (records_offset + compiler->records->len * sizeof (guint32));
+
+	g_byte_array_append (data, (const guint8 *) &header, sizeof (header));
+	g_byte_array_append (data, (const guint8 *) compiler->string_offsets->data,
+			     compiler->string_offsets->len * sizeof (guint32));
+	g_byte_array_append (data, compiler->string_data->data, compiler->string_data->len);
+	g_byte_array_append (data, padding, records_offset - string_data_offset - compiler->string_data->len);
+	g_byte_array_append (data, (const guint8 *) compiler->records->data,
+			     compiler->records->len * sizeof (guint32));
+
+	return g_byte_array_free_to_bytes (data);
+}
+
 typedef struct {
 	ArvDomSaxParserStateEnum state;
 
@@ -46,6 +185,8 @@ typedef struct {
 	int error_depth;
 
 	GHashTable *entities;
+
+	ArvDomCompiler *compiler;
 } ArvDomSaxParserState;
 
 static void
@@ -110,6 +251,20 @@ arv_dom_parser_start_element(void *user_data,
 							       (char *) attrs[i],
 							       (char *) attrs[i+1]);
 
+		if (state->compiler != NULL) {
+			int n_attributes = 0;
+
+			if (attrs != NULL)
+				for (i = 0; attrs[i] != NULL && attrs[i+1] != NULL; i += 2)
+					n_attributes++;
+
+			arv_dom_compiler_add_record (state->compiler, ARV_DOM_COMPILED_RECORD_ELEMENT);
+			arv_dom_compiler_add_string (state->compiler, (char *) name);
+			arv_dom_compiler_add_record (state->compiler, n_attributes);
+			for (i = 0; i < 2 * n_attributes; i++)
+				arv_dom_compiler_add_string (state->compiler, (char *) attrs[i]);
+		}
+
 		state->current_node = node;
 		state->is_error = FALSE;
 		state->error_depth = 0;
@@ -136,6 +291,9 @@ arv_dom_parser_end_element (void *user_data,
 	}
 
 	state->current_node = arv_dom_node_get_parent_node (state->current_node);
+
+	if (state->compiler != NULL)
+		arv_dom_compiler_add_record (state->compiler, ARV_DOM_COMPILED_RECORD_END);
 }
 
 static void
@@ -150,7 +308,10 @@ arv_dom_parser_characters (void *user_data, const xmlChar *ch, int len)
 		text = g_strndup ((char *) ch, len);
 		node = ARV_DOM_NODE (arv_dom_document_create_text_node (ARV_DOM_DOCUMENT (state->document), text));
 
-		arv_dom_node_append_child (state->current_node, node);
+		if (arv_dom_node_append_child (state->current_node, node) != NULL && state->compiler != NULL) {
+			arv_dom_compiler_add_record (state->compiler, ARV_DOM_COMPILED_RECORD_TEXT);
+			arv_dom_compiler_add_string (state->compiler, text);
+		}
 
 		g_free (text);
 	}
@@ -214,16 +375,18 @@ arv_dom_document_error_quark (void)
 #define ARV_DOM_DOCUMENT_ERROR arv_dom_document_error_quark ()
 
 typedef enum {
-	ARV_DOM_DOCUMENT_ERROR_INVALID_XML
+	ARV_DOM_DOCUMENT_ERROR_INVALID_XML,
+	ARV_DOM_DOCUMENT_ERROR_INVALID_COMPILED_DATA
 } ArvDomDocumentError;
 
 static ArvDomDocument *
 _parse_memory (ArvDomDocument *document, ArvDomNode *node,
-	       const void *buffer, int size, GError **error)
+	       const void *buffer, int size, ArvDomCompiler *compiler, GError **error)
 {
-	static ArvDomSaxParserState state;
+	ArvDomSaxParserState state = {0};
 
 	state.document = document;
+	state.compiler = compiler;
 	if (node != NULL)
 		state.current_node = node;
 	else
@@ -248,6 +411,96 @@ _parse_memory (ArvDomDocument *document, ArvDomNode *node,
 	return state.document;
 }
 
+struct _ArvDomPushParser {
+	ArvDomSaxParserState state;
+	xmlParserCtxtPtr context;
+	gboolean is_failed;
+};
+
+/*
+ * arv_dom_push_parser_new:
+ *
+ * Creates a parser for xml data received in chunks, see arv_dom_push_parser_push().
+ */
+
+ArvDomPushParser *
+arv_dom_push_parser_new (void)
+{
+	ArvDomPushParser *parser;
+
+	parser = g_new0 (ArvDomPushParser, 1);
+	parser->context = xmlCreatePushParserCtxt (&sax_handler, &parser->state, NULL, 0, NULL);
+	parser->is_failed = parser->context == NULL;
+
+	return parser;
+}
+
+/*
+ * arv_dom_push_parser_push:
+ * @parser: a #ArvDomPushParser
+ * @data: a chunk of xml data
+ * @size: size of @data, in bytes
+ *
+ * Parses a chunk of xml data. Chunk boundaries don't need to match the xml syntax.
+ */
+
+void
+arv_dom_push_parser_push (ArvDomPushParser *parser, const void *data, size_t size)
+{
+	g_return_if_fail (parser != NULL);
+
+	while (size > 0 && !parser->is_failed) {
+		int n = MIN (size, G_MAXINT);
+
+		if (xmlParseChunk (parser->context, data, n, 0) != 0)
+			parser->is_failed = TRUE;
+
+		data = (const char *) data + n;
+		size -= n;
+	}
+}
+
+/*
+ * arv_dom_push_parser_finish:
+ * @parser: a #ArvDomPushParser
+ * @error: an error placeholder
+ *
+ * Terminates the parsing, and frees @parser.
+ *
+ * Returns: (transfer full): the parsed document, %NULL on error.
+ */
+
+ArvDomDocument *
+arv_dom_push_parser_finish (ArvDomPushParser *parser, GError **error)
+{
+	ArvDomDocument *document;
+
+	g_return_val_if_fail (parser != NULL, NULL);
+
+	if (!parser->is_failed && xmlParseChunk (parser->context, NULL, 0, 1) != 0)
+		parser->is_failed = TRUE;
+
+	if (parser->context != NULL)
+		xmlFreeParserCtxt (parser->context);
+
+	document = parser->state.document;
+
+	if (parser->is_failed) {
+		g_clear_object (&document);
+
+		arv_warning_dom ("[ArvDomParser::push] Invalid document");
+
+		g_set_error (error,
+			     ARV_DOM_DOCUMENT_ERROR,
+			     ARV_DOM_DOCUMENT_ERROR_INVALID_XML,
+			     "Invalid document");
+	}
+
+	g_free (parser);
+
+	return document;
+}
+
 /**
  * arv_dom_document_append_from_memory:
  * @document: a #ArvDomDocument
@@ -270,7 +523,7 @@ arv_dom_document_append_from_memory (ArvDomDocument *document, ArvDomNode *node,
 	g_return_if_fail (ARV_IS_DOM_NODE (node) || node == NULL);
 	g_return_if_fail (buffer != NULL);
 
-	_parse_memory (document, node, buffer, size, error);
+	_parse_memory (document, node, buffer, size, NULL, error);
 }
 
 ArvDomDocument *
@@ -278,7 +531,199 @@ arv_dom_document_new_from_memory (const void *buffer, int size, GError **error)
 {
 	g_return_val_if_fail (buffer != NULL, NULL);
 
-	return _parse_memory (NULL, NULL, buffer, size, error);
+	return _parse_memory (NULL, NULL, buffer, size, NULL, error);
+}
+
+/*
+ * arv_dom_document_new_from_memory_compiled:
+ * @buffer: a memory buffer holding xml data
+ * @size: size of the xml data, in bytes
+ * @compiled: (out): placeholder for the compiled document
+ * @error: an error placeholder
+ *
+ * Parses an xml document, and also returns its compiled form, which can be loaded by
+ * arv_dom_document_new_from_compiled().
+ */
+
+ArvDomDocument *
+arv_dom_document_new_from_memory_compiled (const void *buffer, int size, GBytes **compiled, GError **error)
+{
+	ArvDomCompiler *compiler;
+	ArvDomDocument *document;
+
+	g_return_val_if_fail (buffer != NULL, NULL);
+	g_return_val_if_fail (compiled != NULL, NULL);
+
+	compiler = arv_dom_compiler_new ();
+
+	document = _parse_memory (NULL, NULL, buffer, size, compiler, error);
+	*compiled = document != NULL ? arv_dom_compiler_steal_bytes (compiler) : NULL;
+
+	arv_dom_compiler_free (compiler);
+
+	return document;
+}
+
+static gboolean
+_get_compiled_string (const char *string_data, guint32 string_data_size, const guint32 *string_offsets,
+		      guint32 n_strings, const guint32 *records, guint32 n_records, guint32 *index,
+		      const char **string)
+{
+	guint32 id;
+	guint32 offset;
+
+	if (*index >= n_records)
+		return FALSE;
+
+	id = GUINT32_FROM_LE (records[(*index)++]);
+	if (id >= n_strings)
+		return FALSE;
+
+	offset = GUINT32_FROM_LE (string_offsets[id]);
+	if (offset >= string_data_size)
+		return FALSE;
+
+	*string = string_data + offset;
+
+	return TRUE;
+}
+
+/*
+ * arv_dom_document_new_from_compiled:
+ * @data: compiled document data
+ * @size: size of @data, in bytes
+ * @error: an error placeholder
+ *
+ * Loads a document compiled by arv_dom_document_new_from_memory_compiled(). The compiled data is replayed through
+ * the same code path as the xml parser events, which gives an identical document. @data is not referenced after the
+ * function returns, and may be a memory mapped file.
+ */
+
+ArvDomDocument *
+arv_dom_document_new_from_compiled (const void *data, size_t size, GError **error)
+{
+	ArvDomSaxParserState state = {0};
+	ArvDomCompiledHeader header;
+	const guint32 *string_offsets;
+	const guint32 *records;
+	const char *string_data;
+	const xmlChar **attrs = NULL;
+	guint32 n_attrs_allocated = 0;
+	guint32 index = 0;
+	guint32 string_data_size;
+	guint32 n_strings;
+	guint32 n_records;
+	gint64 depth = 0;
+	gboolean success = TRUE;
+
+	g_return_val_if_fail (data != NULL, NULL);
+
+	if (size < sizeof (header))
+		goto invalid;
+
+	memcpy (&header, data, sizeof (header));
+
+	n_strings = GUINT32_FROM_LE (header.n_strings);
+	n_records = GUINT32_FROM_LE (header.n_records);
+	string_data_size = GUINT32_FROM_LE (header.string_data_size);
+
+	if (memcmp (header.magic, ARV_DOM_COMPILED_MAGIC, sizeof (header.magic)) != 0 ||
+	    GUINT32_FROM_LE (header.version) != ARV_DOM_COMPILED_VERSION ||
+	    GUINT32_FROM_LE (header.string_offsets_offset) % sizeof (guint32) != 0 ||
+	    GUINT32_FROM_LE (header.records_offset) % sizeof (guint32) != 0 ||
+	    (guint64) GUINT32_FROM_LE (header.string_offsets_offset) + (guint64) n_strings * sizeof (guint32) > size ||
+	    (guint64) GUINT32_FROM_LE (header.string_data_offset) + string_data_size > size ||
+	    (guint64) GUINT32_FROM_LE (header.records_offset) + (guint64) n_records * sizeof (guint32) > size ||
+	    string_data_size == 0)
+		goto invalid;
+
+	string_offsets = (const guint32 *) ((const char *) data + GUINT32_FROM_LE (header.string_offsets_offset));
+	string_data = (const char *) data + GUINT32_FROM_LE (header.string_data_offset);
+	records = (const guint32 *) ((const char *) data + GUINT32_FROM_LE (header.records_offset));
+
+	/* All strings are null terminated inside the string data */
+	if (string_data[string_data_size - 1] != '\0')
+		goto invalid;
+
+	arv_dom_parser_start_document (&state);
+
+	while (success && index < n_records) {
+		guint32 record = GUINT32_FROM_LE (records[index++]);
+		const char *name;
+		const char *text;
+		guint32 n_attributes;
+		guint32 i;
+
+		switch (record) {
+			case ARV_DOM_COMPILED_RECORD_ELEMENT:
+				if (!_get_compiled_string (string_data, string_data_size, string_offsets, n_strings,
+							   records, n_records, &index, &name) ||
+				    index >= n_records) {
+					success = FALSE;
+					break;
+				}
+
+				n_attributes = GUINT32_FROM_LE (records[index++]);
+				if (n_attributes > (n_records - index) / 2) {
+					success = FALSE;
+					break;
+				}
+
+				if (2 * n_attributes + 1 > n_attrs_allocated) {
+					n_attrs_allocated = 2 * n_attributes + 1;
+					attrs = g_renew (const xmlChar *, attrs, n_attrs_allocated);
+				}
+
+				for (i = 0; i < 2 * n_attributes && success; i++)
+					success = _get_compiled_string (string_data, string_data_size,
+									string_offsets, n_strings,
+									records, n_records, &index,
+									(const char **) &attrs[i]);
+				attrs[2 * n_attributes] = NULL;
+
+				if (success) {
+					arv_dom_parser_start_element (&state, (const xmlChar *) name, attrs);
+					depth++;
+					success = state.document != NULL;
+				}
+				break;
+			case ARV_DOM_COMPILED_RECORD_TEXT:
+				success = depth > 0 &&
+					_get_compiled_string (string_data, string_data_size, string_offsets, n_strings,
+							      records, n_records, &index, &text);
+				if (success)
+					arv_dom_parser_characters (&state, (const xmlChar *) text, strlen (text));
+				break;
+			case ARV_DOM_COMPILED_RECORD_END:
+				success = depth > 0;
+				if (success) {
+					arv_dom_parser_end_element (&state, NULL);
+					depth--;
+				}
+				break;
+			default:
+				success = FALSE;
+				break;
+		}
+	}
+
+	arv_dom_parser_end_document (&state);
+	g_free (attrs);
+
+	if (success && depth == 0 && state.document != NULL)
+		return state.document;
+
+	g_clear_object (&state.document);
+
+invalid:
+	arv_warning_dom ("[ArvDomParser::from_compiled] Invalid compiled document");
+
+	g_set_error (error,
+		     ARV_DOM_DOCUMENT_ERROR,
+		     ARV_DOM_DOCUMENT_ERROR_INVALID_COMPILED_DATA,
+		     "Invalid compiled document");
+
+	return NULL;
 }
 
 static ArvDomDocument *
@@ -0,0 +1,44 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_DOM_PARSER_PRIVATE_H
+#define ARV_DOM_PARSER_PRIVATE_H
+
+#include <arvdomparser.h>
+
+G_BEGIN_DECLS
+
+typedef struct _ArvDomCompiler ArvDomCompiler;
+typedef struct _ArvDomPushParser ArvDomPushParser;
+
+ArvDomDocument *	arv_dom_document_new_from_memory_compiled	(const void *buffer, int size, GBytes **compiled,
+									 GError **error);
+ArvDomDocument *	arv_dom_document_new_from_compiled		(const void *data, size_t size, GError **error);
+
+ArvDomPushParser *	arv_dom_push_parser_new				(void);
+void			arv_dom_push_parser_push			(ArvDomPushParser *parser, const void *data,
+									 size_t size);
+ArvDomDocument *	arv_dom_push_parser_finish			(ArvDomPushParser *parser, GError **error);
+
+G_END_DECLS
+
+#endif
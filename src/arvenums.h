@@ -127,9 +127,11 @@ typedef guint32 ArvPixelFormat;
 
 #define	ARV_PIXEL_FORMAT_MONO_10		((ArvPixelFormat) 0x01100003u)
 #define ARV_PIXEL_FORMAT_MONO_10_PACKED		((ArvPixelFormat) 0x010c0004u)
+#define ARV_PIXEL_FORMAT_MONO_10P		((ArvPixelFormat) 0x010a0046u)
 
 #define ARV_PIXEL_FORMAT_MONO_12		((ArvPixelFormat) 0x01100005u)
 #define ARV_PIXEL_FORMAT_MONO_12_PACKED		((ArvPixelFormat) 0x010c0006u)
+#define ARV_PIXEL_FORMAT_MONO_12P		((ArvPixelFormat) 0x010c0047u)
 
 #define ARV_PIXEL_FORMAT_MONO_14		((ArvPixelFormat) 0x01100025u)
 
@@ -52,10 +52,14 @@ typedef enum {
 	ARV_EVALUATOR_STATUS_FORBIDDEN_RECUSRION
 } ArvEvaluatorStatus;
 
+typedef struct _ArvEvaluatorProgram ArvEvaluatorProgram;
+
 typedef struct {
 	char *expression;
 	GSList *rpn_stack;
 	ArvEvaluatorStatus parsing_status;
+	ArvEvaluatorProgram *double_program;
+	ArvEvaluatorProgram *int64_program;
 	GHashTable *variables;
 	GHashTable *sub_expressions;
 	GHashTable *constants;
@@ -221,6 +225,34 @@ typedef struct {
 	ArvValue value;
 } ArvEvaluatorValuesStackItem;
 
+/* Variable slot. The slots are owned by the variable hash table and are never reallocated, which allows the compiled
+ * programs to keep a direct reference to them. A slot is created unset when a program references a variable that
+ * was not assigned yet. */
+
+typedef struct {
+	ArvValue value;
+	gboolean is_set;
+} ArvEvaluatorVariable;
+
+/* Compiled form of the RPN token list: a flat instruction array, with constant sub-expressions folded and variables
+ * bound to their slots. */
+
+typedef struct {
+	ArvEvaluatorTokenId token_id;
+	gint32 parenthesis_level;
+	union {
+		double			v_double;
+		gint64			v_int64;
+		ArvEvaluatorVariable *	variable;
+	} data;
+} ArvEvaluatorInstruction;
+
+struct _ArvEvaluatorProgram {
+	ArvEvaluatorStatus status;
+	ArvEvaluatorInstruction *instructions;
+	guint n_instructions;
+};
+
 static ArvEvaluatorToken *
 arv_evaluator_token_new (ArvEvaluatorTokenId token_id)
 {
@@ -269,36 +301,32 @@ arv_evaluator_token_free (ArvEvaluatorToken *token)
 }
 
 static void
-arv_evaluator_token_debug (ArvEvaluatorToken *token, GHashTable *variables)
+arv_evaluator_instruction_debug (const ArvEvaluatorInstruction *instruction)
 {
-	ArvValue *value;
-
-	g_return_if_fail (token != NULL);
+	ArvEvaluatorVariable *variable;
 
-	switch (token->token_id) {
+	switch (instruction->token_id) {
 		case ARV_EVALUATOR_TOKEN_VARIABLE:
-			value = g_hash_table_lookup (variables, token->data.name);
-                        if (value != NULL && arv_value_holds_double (value))
-                                arv_debug_evaluator ("(var) %s = %g (double)",
-                                                     token->data.name,
-                                                     arv_value_get_double (value));
-                        else if (value != NULL && arv_value_holds_int64 (value))
-                                arv_debug_evaluator ("(var) %s = 0x%016" G_GINT64_MODIFIER "x %" G_GINT64_FORMAT" (int64)",
-                                                     token->data.name,
-                                                     arv_value_get_int64 (value),
-                                                     arv_value_get_int64 (value));
-                        else
-                                arv_debug_evaluator ("(var) %s not found", token->data.name);
-                        break;
-                case ARV_EVALUATOR_TOKEN_CONSTANT_INT64:
-                        arv_debug_evaluator ("(int64) %" G_GINT64_FORMAT, token->data.v_int64);
-                        break;
-                case ARV_EVALUATOR_TOKEN_CONSTANT_DOUBLE:
-                        arv_debug_evaluator ("(double) %g", token->data.v_double);
-                        break;
-                default:
-                        arv_debug_evaluator ("(operator) %s", arv_evaluator_token_infos[token->token_id].tag);
-        }
+			variable = instruction->data.variable;
+			if (variable->is_set && arv_value_holds_double (&variable->value))
+				arv_debug_evaluator ("(var) %g (double)",
+						     arv_value_get_double (&variable->value));
+			else if (variable->is_set && arv_value_holds_int64 (&variable->value))
+				arv_debug_evaluator ("(var) 0x%016" G_GINT64_MODIFIER "x %" G_GINT64_FORMAT" (int64)",
+						     arv_value_get_int64 (&variable->value),
+						     arv_value_get_int64 (&variable->value));
+			else
+				arv_debug_evaluator ("(var) not set");
+			break;
+		case ARV_EVALUATOR_TOKEN_CONSTANT_INT64:
+			arv_debug_evaluator ("(int64) %" G_GINT64_FORMAT, instruction->data.v_int64);
+			break;
+		case ARV_EVALUATOR_TOKEN_CONSTANT_DOUBLE:
+			arv_debug_evaluator ("(double) %g", instruction->data.v_double);
+			break;
+		default:
+			arv_debug_evaluator ("(operator) %s", arv_evaluator_token_infos[instruction->token_id].tag);
+	}
 }
 
 static gboolean
@@ -553,42 +581,41 @@ get_arguments_count(ArvEvaluatorValuesStackItem * stack, int current_index)
 	return arguments_count;
 }
 
+/* Evaluation in double mode. Values keep their type, integer operations are used when all the operands are integers.
+ * The arity of the round function depends on the parenthesis levels of the stacked values, which makes the stack
+ * checks dynamic. */
+
 static ArvEvaluatorStatus
-evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v_double)
+evaluate_double (const ArvEvaluatorInstruction *instructions, guint n_instructions,
+		 ArvEvaluatorValuesStackItem *result)
 {
-	ArvEvaluatorToken *token;
+	const ArvEvaluatorInstruction *token;
 	ArvEvaluatorStatus status;
-	GSList *iter;
 	ArvEvaluatorValuesStackItem stack[ARV_EVALUATOR_STACK_SIZE];
-	ArvValue *value;
+	ArvEvaluatorVariable *variable;
+	gboolean debug;
 	int index = -1;
-	gboolean integer_mode;
-
-	g_assert (v_int64 != NULL || v_double != NULL);
+	guint i;
 
-	integer_mode = v_int64 != NULL;
+	debug = arv_debug_check (ARV_DEBUG_CATEGORY_EVALUATOR, ARV_DEBUG_LEVEL_DEBUG);
 
-	for (iter = token_stack; iter != NULL; iter = iter->next) {
+	for (i = 0; i < n_instructions; i++) {
 		int actual_arguments_count;
 
-		token = iter->data;
+		token = &instructions[i];
 
 		if (index < (arv_evaluator_token_infos[token->token_id].n_args - 1)) {
 			status = ARV_EVALUATOR_STATUS_MISSING_ARGUMENTS;
 			goto CLEANUP;
 		}
 
-		if (arv_evaluator_token_infos[token->token_id].double_only && integer_mode) {
-			status = ARV_EVALUATOR_STATUS_INVALID_DOUBLE_FUNCTION;
-			goto CLEANUP;
-		}
-
 		if (index >= ARV_EVALUATOR_STACK_SIZE - 1) {
 			status = ARV_EVALUATOR_STATUS_STACK_OVERFLOW;
 			goto CLEANUP;
 		}
 
-		arv_evaluator_token_debug (token, variables);
+		if (debug)
+			arv_evaluator_instruction_debug (token);
 
 		actual_arguments_count = arv_evaluator_token_infos[token->token_id].n_args;
 
@@ -629,9 +656,8 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_EQUAL:
-				if (integer_mode ||
-				    (arv_value_holds_int64 (&stack[index-1].value) &&
-				     arv_value_holds_int64 (&stack[index].value)))
+				if (arv_value_holds_int64 (&stack[index-1].value) &&
+				    arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index-1].value,
 							     arv_value_get_int64 (&stack[index-1].value) ==
 							     arv_value_get_int64 (&stack[index].value));
@@ -642,9 +668,8 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_NOT_EQUAL:
-				if (integer_mode ||
-				    (arv_value_holds_int64 (&stack[index-1].value) &&
-				     arv_value_holds_int64 (&stack[index].value)))
+				if (arv_value_holds_int64 (&stack[index-1].value) &&
+				    arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index-1].value,
 							     arv_value_get_int64 (&stack[index-1].value) !=
 							     arv_value_get_int64 (&stack[index].value));
@@ -655,9 +680,8 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_LESS_OR_EQUAL:
-				if (integer_mode ||
-				    (arv_value_holds_int64 (&stack[index-1].value) &&
-				     arv_value_holds_int64 (&stack[index].value)))
+				if (arv_value_holds_int64 (&stack[index-1].value) &&
+				    arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index-1].value,
 							     arv_value_get_int64 (&stack[index-1].value) <=
 							     arv_value_get_int64 (&stack[index].value));
@@ -668,9 +692,8 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_GREATER_OR_EQUAL:
-				if (integer_mode ||
-				    (arv_value_holds_int64 (&stack[index-1].value) &&
-				     arv_value_holds_int64 (&stack[index].value)))
+				if (arv_value_holds_int64 (&stack[index-1].value) &&
+				    arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index-1].value,
 							     arv_value_get_int64 (&stack[index-1].value) >=
 							     arv_value_get_int64 (&stack[index].value));
@@ -681,9 +704,8 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_LESS:
-				if (integer_mode ||
-				    (arv_value_holds_int64 (&stack[index-1].value) &&
-				     arv_value_holds_int64 (&stack[index].value)))
+				if (arv_value_holds_int64 (&stack[index-1].value) &&
+				    arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index-1].value,
 							     arv_value_get_int64 (&stack[index-1].value) <
 							     arv_value_get_int64 (&stack[index].value));
@@ -694,9 +716,8 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_GREATER:
-				if (integer_mode ||
-				    (arv_value_holds_int64 (&stack[index-1].value) &&
-				     arv_value_holds_int64 (&stack[index].value)))
+				if (arv_value_holds_int64 (&stack[index-1].value) &&
+				    arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index-1].value,
 							     arv_value_get_int64 (&stack[index-1].value) >
 							     arv_value_get_int64 (&stack[index].value));
@@ -719,9 +740,8 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_SUBSTRACTION:
-				if (integer_mode ||
-				    (arv_value_holds_int64 (&stack[index-1].value) &&
-				     arv_value_holds_int64 (&stack[index].value)))
+				if (arv_value_holds_int64 (&stack[index-1].value) &&
+				    arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index-1].value,
 							     arv_value_get_int64 (&stack[index-1].value) -
 							     arv_value_get_int64 (&stack[index].value));
@@ -732,9 +752,8 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_ADDITION:
-				if (integer_mode ||
-				    (arv_value_holds_int64 (&stack[index-1].value) &&
-				     arv_value_holds_int64 (&stack[index].value)))
+				if (arv_value_holds_int64 (&stack[index-1].value) &&
+				    arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index-1].value,
 							     arv_value_get_int64 (&stack[index-1].value) +
 							     arv_value_get_int64 (&stack[index].value));
@@ -755,29 +774,18 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_DIVISION:
-				if (integer_mode) {
-					if (arv_value_get_int64 (&stack[index].value) == 0) {
-						status = ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
-						goto CLEANUP;
-					}
-					arv_value_set_int64 (&stack[index-1].value,
-							     arv_value_get_int64 (&stack[index-1].value) /
-							     arv_value_get_int64 (&stack[index].value));
-				} else {
-					if (arv_value_get_double (&stack[index].value) == 0.0) {
-						status = ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
-						goto CLEANUP;
-					}
-					arv_value_set_double (&stack[index-1].value,
-							      arv_value_get_double (&stack[index-1].value) /
-							      arv_value_get_double (&stack[index].value));
+				if (arv_value_get_double (&stack[index].value) == 0.0) {
+					status = ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
+					goto CLEANUP;
 				}
+				arv_value_set_double (&stack[index-1].value,
+						      arv_value_get_double (&stack[index-1].value) /
+						      arv_value_get_double (&stack[index].value));
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_MULTIPLICATION:
-				if (integer_mode ||
-				    (arv_value_holds_int64 (&stack[index-1].value) &&
-				     arv_value_holds_int64 (&stack[index].value)))
+				if (arv_value_holds_int64 (&stack[index-1].value) &&
+				    arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index-1].value,
 							     arv_value_get_int64 (&stack[index-1].value) *
 							     arv_value_get_int64 (&stack[index].value));
@@ -788,18 +796,13 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_POWER:
-				if (integer_mode)
-					arv_value_set_int64 (&stack[index-1].value,
-							     pow (arv_value_get_int64(&stack[index-1].value),
-								  arv_value_get_int64(&stack[index].value)));
-				else
-					arv_value_set_double (&stack[index-1].value,
-							      pow (arv_value_get_double(&stack[index-1].value),
-								   arv_value_get_double(&stack[index].value)));
+				arv_value_set_double (&stack[index-1].value,
+						      pow (arv_value_get_double(&stack[index-1].value),
+							   arv_value_get_double(&stack[index].value)));
 				stack[index-1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_MINUS:
-				if (integer_mode || arv_value_holds_int64 (&stack[index].value))
+				if (arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index].value,
 							     -arv_value_get_int64 (&stack[index].value));
 				else
@@ -818,7 +821,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_SGN:
-				if (integer_mode || arv_value_holds_int64 (&stack[index].value)) {
+				if (arv_value_holds_int64 (&stack[index].value)) {
 					gint64 int_value = arv_value_get_int64 (&stack[index].value);
 					if (int_value < 0)
 						arv_value_set_int64 (&stack[index].value, -1);
@@ -838,7 +841,7 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_FUNCTION_NEG:
-				if (integer_mode || arv_value_holds_int64 (&stack[index].value))
+				if (arv_value_holds_int64 (&stack[index].value))
 					arv_value_set_int64 (&stack[index].value,
 							     -arv_value_get_int64 (&stack[index].value));
 				else
@@ -929,16 +932,13 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 				stack[index+1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_CONSTANT_DOUBLE:
-				if (integer_mode)
-					arv_value_set_int64 (&stack[index+1].value, token->data.v_double);
-				else
-					arv_value_set_double (&stack[index+1].value, token->data.v_double);
+				arv_value_set_double (&stack[index+1].value, token->data.v_double);
 				stack[index+1].parenthesis_level = token->parenthesis_level;
 				break;
 			case ARV_EVALUATOR_TOKEN_VARIABLE:
-				value = g_hash_table_lookup (variables, token->data.name);
-				if (value != NULL) {
-					arv_value_copy (&stack[index+1].value, value);
+				variable = token->data.variable;
+				if (variable->is_set) {
+					arv_value_copy (&stack[index+1].value, &variable->value);
 					stack[index+1].parenthesis_level = token->parenthesis_level;
 				} else {
 					status = ARV_EVALUATOR_STATUS_UNKNOWN_VARIABLE;
@@ -969,24 +969,155 @@ evaluate (GSList *token_stack, GHashTable *variables, gint64 *v_int64, double *v
 		goto CLEANUP;
 	}
 
-	if (v_double != NULL)
-		*v_double = arv_value_get_double (&stack[0].value);
-
-	if (v_int64 != NULL)
-		*v_int64 = arv_value_get_int64 (&stack[0].value);
+	*result = stack[0];
 
-	if (arv_value_holds_int64 (&stack[0].value))
-		arv_debug_evaluator ("[Evaluator::evaluate] Result = (int64) %" G_GINT64_FORMAT, arv_value_get_int64 (&stack[0].value));
-	else
-		arv_debug_evaluator ("[Evaluator::evaluate] Result = (double) %g", arv_value_get_double (&stack[0].value));
+	if (debug) {
+		if (arv_value_holds_int64 (&stack[0].value))
+			arv_debug_evaluator ("[Evaluator::evaluate] Result = (int64) %" G_GINT64_FORMAT,
+					     arv_value_get_int64 (&stack[0].value));
+		else
+			arv_debug_evaluator ("[Evaluator::evaluate] Result = (double) %g",
+					     arv_value_get_double (&stack[0].value));
+	}
 
 	return ARV_EVALUATOR_STATUS_SUCCESS;
 CLEANUP:
-	if (v_double != NULL)
-		*v_double = 0.0;
+	arv_value_set_double (&result->value, 0.0);
+	result->parenthesis_level = 0;
+
+	return status;
+}
+
+/* Evaluation in integer mode. All the values are 64 bit integers, and the program was validated at compilation time:
+ * double only functions are rejected, and the stack depth is known for each instruction. Only the runtime errors
+ * remain to be checked. */
+
+static ArvEvaluatorStatus
+evaluate_int64 (const ArvEvaluatorInstruction *instructions, guint n_instructions, gint64 *result)
+{
+	const ArvEvaluatorInstruction *token;
+	ArvEvaluatorStatus status;
+	gint64 stack[ARV_EVALUATOR_STACK_SIZE];
+	gboolean debug;
+	int index = -1;
+	guint i;
 
-	if (v_int64 != NULL)
-		*v_int64 = 0.0;
+	debug = arv_debug_check (ARV_DEBUG_CATEGORY_EVALUATOR, ARV_DEBUG_LEVEL_DEBUG);
+
+	for (i = 0; i < n_instructions; i++) {
+		token = &instructions[i];
+
+		if (debug)
+			arv_evaluator_instruction_debug (token);
+
+		switch (token->token_id) {
+			case ARV_EVALUATOR_TOKEN_LOGICAL_AND:
+				stack[index-1] = stack[index-1] && stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_LOGICAL_OR:
+				stack[index-1] = stack[index-1] || stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_BITWISE_NOT:
+				stack[index] = ~stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_BITWISE_AND:
+				stack[index-1] = stack[index-1] & stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_BITWISE_OR:
+				stack[index-1] = stack[index-1] | stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_BITWISE_XOR:
+				stack[index-1] = stack[index-1] ^ stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_EQUAL:
+				stack[index-1] = stack[index-1] == stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_NOT_EQUAL:
+				stack[index-1] = stack[index-1] != stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_LESS_OR_EQUAL:
+				stack[index-1] = stack[index-1] <= stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_GREATER_OR_EQUAL:
+				stack[index-1] = stack[index-1] >= stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_LESS:
+				stack[index-1] = stack[index-1] < stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_GREATER:
+				stack[index-1] = stack[index-1] > stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_SHIFT_RIGHT:
+				stack[index-1] = stack[index-1] >> stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_SHIFT_LEFT:
+				stack[index-1] = stack[index-1] << stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_SUBSTRACTION:
+				stack[index-1] = stack[index-1] - stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_ADDITION:
+				stack[index-1] = stack[index-1] + stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_REMAINDER:
+				if (stack[index] == 0) {
+					status = ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
+					goto CLEANUP;
+				}
+				stack[index-1] = stack[index-1] % stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_DIVISION:
+				if (stack[index] == 0) {
+					status = ARV_EVALUATOR_STATUS_DIVISION_BY_ZERO;
+					goto CLEANUP;
+				}
+				stack[index-1] = stack[index-1] / stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_MULTIPLICATION:
+				stack[index-1] = stack[index-1] * stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_POWER:
+				stack[index-1] = pow (stack[index-1], stack[index]);
+				break;
+			case ARV_EVALUATOR_TOKEN_MINUS:
+			case ARV_EVALUATOR_TOKEN_FUNCTION_NEG:
+				stack[index] = -stack[index];
+				break;
+			case ARV_EVALUATOR_TOKEN_PLUS:
+			case ARV_EVALUATOR_TOKEN_TERNARY_COLON:
+				break;
+			case ARV_EVALUATOR_TOKEN_FUNCTION_SGN:
+				stack[index] = stack[index] < 0 ? -1 : (stack[index] > 0 ? 1 : 0);
+				break;
+			case ARV_EVALUATOR_TOKEN_CONSTANT_INT64:
+				stack[index+1] = token->data.v_int64;
+				break;
+			case ARV_EVALUATOR_TOKEN_VARIABLE:
+				if (!token->data.variable->is_set) {
+					status = ARV_EVALUATOR_STATUS_UNKNOWN_VARIABLE;
+					goto CLEANUP;
+				}
+				stack[index+1] = arv_value_get_int64 (&token->data.variable->value);
+				break;
+			case ARV_EVALUATOR_TOKEN_TERNARY_QUESTION_MARK:
+				stack[index-2] = stack[index-2] != 0 ? stack[index-1] : stack[index];
+				break;
+			default:
+				status = ARV_EVALUATOR_STATUS_UNKNOWN_OPERATOR;
+				goto CLEANUP;
+				break;
+		}
+		index = index - arv_evaluator_token_infos[token->token_id].n_args + 1;
+	}
+
+	*result = stack[0];
+
+	if (debug)
+		arv_debug_evaluator ("[Evaluator::evaluate] Result = (int64) %" G_GINT64_FORMAT, stack[0]);
+
+	return ARV_EVALUATOR_STATUS_SUCCESS;
+CLEANUP:
+	*result = 0;
 
 	return status;
 }
@@ -1130,6 +1261,16 @@ CLEANUP:
 	return status;
 }
 
+static void
+free_program (ArvEvaluatorProgram *program)
+{
+	if (program == NULL)
+		return;
+
+	g_free (program->instructions);
+	g_free (program);
+}
+
 static void
 free_rpn_stack (ArvEvaluator *evaluator)
 {
@@ -1139,6 +1280,11 @@ free_rpn_stack (ArvEvaluator *evaluator)
 		arv_evaluator_token_free (iter->data);
 	g_slist_free (evaluator->priv->rpn_stack);
 	evaluator->priv->rpn_stack = NULL;
+
+	free_program (evaluator->priv->double_program);
+	evaluator->priv->double_program = NULL;
+	free_program (evaluator->priv->int64_program);
+	evaluator->priv->int64_program = NULL;
 }
 
 static ArvEvaluatorStatus
@@ -1202,6 +1348,153 @@ CLEANUP:
 	return status;
 }
 
+static ArvEvaluatorVariable *
+get_variable (ArvEvaluator *evaluator, const char *name)
+{
+	ArvEvaluatorVariable *variable;
+
+	variable = g_hash_table_lookup (evaluator->priv->variables, name);
+	if (variable == NULL) {
+		variable = g_new0 (ArvEvaluatorVariable, 1);
+		g_hash_table_insert (evaluator->priv->variables, g_strdup (name), variable);
+	}
+
+	return variable;
+}
+
+/* Replace an operator and its constant operands by the result of their evaluation. On evaluation error, the
+ * instructions are left untouched, in order to get the error at runtime. */
+
+static gboolean
+fold_instructions (ArvEvaluatorInstruction *instructions, guint n_instructions, gboolean integer_mode)
+{
+	ArvEvaluatorValuesStackItem item;
+	gint64 v_int64;
+
+	if (integer_mode) {
+		if (evaluate_int64 (instructions, n_instructions, &v_int64) != ARV_EVALUATOR_STATUS_SUCCESS)
+			return FALSE;
+
+		instructions[0].token_id = ARV_EVALUATOR_TOKEN_CONSTANT_INT64;
+		instructions[0].parenthesis_level = instructions[n_instructions - 1].parenthesis_level;
+		instructions[0].data.v_int64 = v_int64;
+
+		return TRUE;
+	}
+
+	if (evaluate_double (instructions, n_instructions, &item) != ARV_EVALUATOR_STATUS_SUCCESS)
+		return FALSE;
+
+	if (arv_value_holds_int64 (&item.value)) {
+		instructions[0].token_id = ARV_EVALUATOR_TOKEN_CONSTANT_INT64;
+		instructions[0].data.v_int64 = arv_value_get_int64 (&item.value);
+	} else {
+		instructions[0].token_id = ARV_EVALUATOR_TOKEN_CONSTANT_DOUBLE;
+		instructions[0].data.v_double = arv_value_get_double (&item.value);
+	}
+	instructions[0].parenthesis_level = item.parenthesis_level;
+
+	return TRUE;
+}
+
+/* Translate the RPN token list into a flat instruction array. In integer mode, the stack usage and the function
+ * types are entirely checked here. In double mode, the number of arguments of the round function is only known at
+ * runtime, which prevents any static analysis after the first round instruction. */
+
+static ArvEvaluatorProgram *
+compile_program (ArvEvaluator *evaluator, gboolean integer_mode)
+{
+	ArvEvaluatorProgram *program;
+	ArvEvaluatorInstruction *instruction;
+	ArvEvaluatorToken *token;
+	gboolean is_constant[ARV_EVALUATOR_STACK_SIZE];
+	gboolean is_static = TRUE;
+	GSList *iter;
+	int index = -1;
+	int n_args;
+	int i;
+
+	program = g_new0 (ArvEvaluatorProgram, 1);
+	program->status = ARV_EVALUATOR_STATUS_SUCCESS;
+	program->instructions = g_new (ArvEvaluatorInstruction, g_slist_length (evaluator->priv->rpn_stack));
+
+	for (iter = evaluator->priv->rpn_stack; iter != NULL; iter = iter->next) {
+		token = iter->data;
+		n_args = arv_evaluator_token_infos[token->token_id].n_args;
+
+		if (integer_mode) {
+			if (index < n_args - 1)
+				program->status = ARV_EVALUATOR_STATUS_MISSING_ARGUMENTS;
+			else if (arv_evaluator_token_infos[token->token_id].double_only)
+				program->status = ARV_EVALUATOR_STATUS_INVALID_DOUBLE_FUNCTION;
+			else if (index >= ARV_EVALUATOR_STACK_SIZE - 1)
+				program->status = ARV_EVALUATOR_STATUS_STACK_OVERFLOW;
+
+			if (program->status != ARV_EVALUATOR_STATUS_SUCCESS)
+				break;
+		} else if (index < n_args - 1 ||
+			   index >= ARV_EVALUATOR_STACK_SIZE - 1 ||
+			   token->token_id == ARV_EVALUATOR_TOKEN_FUNCTION_ROUND)
+			is_static = FALSE;
+
+		instruction = &program->instructions[program->n_instructions++];
+		instruction->token_id = token->token_id;
+		instruction->parenthesis_level = token->parenthesis_level;
+
+		switch (token->token_id) {
+			case ARV_EVALUATOR_TOKEN_CONSTANT_INT64:
+				instruction->data.v_int64 = token->data.v_int64;
+				break;
+			case ARV_EVALUATOR_TOKEN_CONSTANT_DOUBLE:
+				if (integer_mode) {
+					instruction->token_id = ARV_EVALUATOR_TOKEN_CONSTANT_INT64;
+					instruction->data.v_int64 = token->data.v_double;
+				} else
+					instruction->data.v_double = token->data.v_double;
+				break;
+			case ARV_EVALUATOR_TOKEN_VARIABLE:
+				instruction->data.variable = get_variable (evaluator, token->data.name);
+				break;
+			default:
+				break;
+		}
+
+		if (!is_static)
+			continue;
+
+		if (n_args == 0) {
+			is_constant[index + 1] = token->token_id != ARV_EVALUATOR_TOKEN_VARIABLE;
+		} else {
+			gboolean constant_arguments = token->token_id != ARV_EVALUATOR_TOKEN_UNKNOWN;
+
+			for (i = 0; i < n_args && constant_arguments; i++)
+				constant_arguments = is_constant[index - i];
+
+			/* Constant operands are always single instructions, at the end of the array */
+			if (constant_arguments &&
+			    fold_instructions (&program->instructions[program->n_instructions - n_args - 1], n_args + 1,
+					       integer_mode))
+				program->n_instructions -= n_args;
+			else
+				constant_arguments = FALSE;
+
+			is_constant[index - n_args + 1] = constant_arguments;
+		}
+
+		index = index - n_args + 1;
+	}
+
+	if (integer_mode && program->status == ARV_EVALUATOR_STATUS_SUCCESS && index != 0)
+		program->status = ARV_EVALUATOR_STATUS_REMAINING_OPERANDS;
+
+	arv_debug_evaluator ("[Evaluator::compile_program] %u instructions for %u tokens in %s mode (%s)",
+			     program->n_instructions, g_slist_length (evaluator->priv->rpn_stack),
+			     integer_mode ? "integer" : "double",
+			     arv_evaluator_status_strings[program->status]);
+
+	return program;
+}
+
 static void
 arv_evaluator_set_error (GError **error, ArvEvaluatorStatus status)
 {
@@ -1221,7 +1514,7 @@ double
 arv_evaluator_evaluate_as_double (ArvEvaluator *evaluator, GError **error)
 {
 	ArvEvaluatorStatus status;
-	double value;
+	ArvEvaluatorValuesStackItem result;
 
 	g_return_val_if_fail (ARV_IS_EVALUATOR (evaluator), 0.0);
 
@@ -1239,14 +1532,23 @@ arv_evaluator_evaluate_as_double (ArvEvaluator *evaluator, GError **error)
 		return 0.0;
 	}
 
-	status = evaluate (evaluator->priv->rpn_stack, evaluator->priv->variables, NULL, &value);
+	if (evaluator->priv->double_program == NULL)
+		evaluator->priv->double_program = compile_program (evaluator, FALSE);
+
+	if (evaluator->priv->double_program->status != ARV_EVALUATOR_STATUS_SUCCESS) {
+		arv_evaluator_set_error (error, evaluator->priv->double_program->status);
+		return 0.0;
+	}
+
+	status = evaluate_double (evaluator->priv->double_program->instructions,
+				  evaluator->priv->double_program->n_instructions, &result);
 
 	if (status != ARV_EVALUATOR_STATUS_SUCCESS) {
 		arv_evaluator_set_error (error, status);
 		return 0.0;
 	}
 
-	return value;
+	return arv_value_get_double (&result.value);
 }
 
 gint64
@@ -1271,7 +1573,16 @@ arv_evaluator_evaluate_as_int64 (ArvEvaluator *evaluator, GError **error)
 		return 0.0;
 	}
 
-	status = evaluate (evaluator->priv->rpn_stack, evaluator->priv->variables, &value, NULL);
+	if (evaluator->priv->int64_program == NULL)
+		evaluator->priv->int64_program = compile_program (evaluator, TRUE);
+
+	if (evaluator->priv->int64_program->status != ARV_EVALUATOR_STATUS_SUCCESS) {
+		arv_evaluator_set_error (error, evaluator->priv->int64_program->status);
+		return 0.0;
+	}
+
+	status = evaluate_int64 (evaluator->priv->int64_program->instructions,
+				 evaluator->priv->int64_program->n_instructions, &value);
 
 	if (status != ARV_EVALUATOR_STATUS_SUCCESS) {
 
@@ -1426,18 +1737,17 @@ arv_evaluator_get_constant (ArvEvaluator *evaluator, const char *name)
 void
 arv_evaluator_set_double_variable (ArvEvaluator *evaluator, const char *name, double v_double)
 {
-	ArvValue *old_value;
+	ArvEvaluatorVariable *variable;
 
 	g_return_if_fail (ARV_IS_EVALUATOR (evaluator));
 	g_return_if_fail (name != NULL);
 
-	old_value = g_hash_table_lookup (evaluator->priv->variables, name);
-	if (old_value != NULL && (arv_value_get_double (old_value) == v_double))
+	variable = get_variable (evaluator, name);
+	if (variable->is_set && (arv_value_get_double (&variable->value) == v_double))
 		return;
 
-        g_hash_table_replace (evaluator->priv->variables,
-                              g_strdup (name),
-                              arv_value_new_double (v_double));
+	arv_value_set_double (&variable->value, v_double);
+	variable->is_set = TRUE;
 
 	arv_debug_evaluator ("[Evaluator::set_double_variable] %s = %g",
 			   name, v_double);
@@ -1446,18 +1756,17 @@ arv_evaluator_set_double_variable (ArvEvaluator *evaluator, const char *name, do
 void
 arv_evaluator_set_int64_variable (ArvEvaluator *evaluator, const char *name, gint64 v_int64)
 {
-	ArvValue *old_value;
+	ArvEvaluatorVariable *variable;
 
 	g_return_if_fail (ARV_IS_EVALUATOR (evaluator));
 	g_return_if_fail (name != NULL);
 
-	old_value = g_hash_table_lookup (evaluator->priv->variables, name);
-	if (old_value != NULL && (arv_value_get_int64 (old_value) == v_int64))
+	variable = get_variable (evaluator, name);
+	if (variable->is_set && (arv_value_get_int64 (&variable->value) == v_int64))
 		return;
 
-        g_hash_table_replace (evaluator->priv->variables,
-                              g_strdup (name),
-                              arv_value_new_int64 (v_int64));
+	arv_value_set_int64 (&variable->value, v_int64);
+	variable->is_set = TRUE;
 
 	arv_debug_evaluator ("[Evaluator::set_int64_variable] %s = %" G_GINT64_FORMAT, name, v_int64);
 }
@@ -1490,7 +1799,9 @@ arv_evaluator_init (ArvEvaluator *evaluator)
 
 	evaluator->priv->expression = NULL;
 	evaluator->priv->rpn_stack = NULL;
-	evaluator->priv->variables = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, (GDestroyNotify) arv_value_free);
+	evaluator->priv->double_program = NULL;
+	evaluator->priv->int64_program = NULL;
+	evaluator->priv->variables = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 	evaluator->priv->sub_expressions = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 	evaluator->priv->constants = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
 
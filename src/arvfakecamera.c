@@ -31,11 +31,13 @@
  */
 
 #include <arvfakecamera.h>
+#include <arvfakecameraprivate.h>
 #include <arvversion.h>
 #include <arvgc.h>
 #include <arvgcregisternode.h>
 #include <arvgvcpprivate.h>
 #include <arvbufferprivate.h>
+#include <arvrecordingreader.h>
 #include <arvdebug.h>
 #include <arvmiscprivate.h>
 #include <string.h>
@@ -64,6 +66,33 @@ arv_get_fake_camera_genicam_filename (void)
 	return arv_fake_camera_genicam_filename;
 }
 
+/*
+ * The diagonal ramp value only depends on (x + y + frame_id) modulo the ramp period. Each image row is a copy of a
+ * segment of a precomputed line, which is only rebuilt when the width, pixel format, exposure time or gain change.
+ *
+ * A row starting at ramp offset s is copied from the line of phase s % n_phases, which starts at ramp pixel phase.
+ * There is one phase per pixel of a packed group, one per pixel parity for the Bayer and YUV formats, and a second
+ * set of lines for the odd rows of the Bayer formats. Packed formats are packed pixel by pixel from the unpacked
+ * values when the width is not a multiple of the pixel group.
+ */
+
+typedef struct {
+	ArvPixelFormat pixel_format;
+	guint32 width;
+	guint32 exposure_time_us;
+	guint32 gain;
+
+	guint32 period;
+	guint pixel_group;
+	size_t group_size;
+	guint n_phases;
+	gboolean row_parity;
+
+	guint n_lines;
+	guint8 *lines[4];
+	guint16 *values;
+} ArvFakeCameraDiagonalRamp;
+
 typedef struct {
 	void *memory;
 
@@ -71,13 +100,25 @@ typedef struct {
 	size_t genicam_xml_size;
         char *genicam_xml_url;
 
-	guint32 frame_id;
+	guint64 frame_id;
 	double trigger_frequency;
 
 	GMutex fill_pattern_mutex;
 
 	ArvFakeCameraFillPattern fill_pattern_callback;
 	void *fill_pattern_data;
+	ArvFakeCameraDiagonalRamp diagonal_ramp;
+
+	ArvRecordingReader *replay_reader;
+	gboolean replay_original_timing;
+	guint64 replay_n_frames;
+	guint64 replay_index;
+	size_t replay_payload;
+	guint64 replay_last_frame_us;
+	guint64 replay_next_frame_us;
+
+	/* Number of memory and register reads, for the tests */
+	gint n_memory_reads;
 } ArvFakeCameraPrivate;
 
 struct _ArvFakeCamera {
@@ -103,6 +144,8 @@ arv_fake_camera_read_memory (ArvFakeCamera *camera, guint32 address, guint32 siz
 	g_return_val_if_fail (buffer != NULL, FALSE);
 	g_return_val_if_fail (size > 0, FALSE);
 
+	g_atomic_int_inc (&camera->priv->n_memory_reads);
+
 	if (address < ARV_FAKE_CAMERA_MEMORY_SIZE) {
 		read_size = MIN (address  + size, ARV_FAKE_CAMERA_MEMORY_SIZE) - address;
 
@@ -126,6 +169,18 @@ arv_fake_camera_read_memory (ArvFakeCamera *camera, guint32 address, guint32 siz
 	return TRUE;
 }
 
+/*
+ * Returns the number of memory and register reads since the camera creation.
+ */
+
+guint
+arv_fake_camera_get_n_memory_reads (ArvFakeCamera *camera)
+{
+	g_return_val_if_fail (ARV_IS_FAKE_CAMERA (camera), 0);
+
+	return g_atomic_int_get (&camera->priv->n_memory_reads);
+}
+
 gboolean
 arv_fake_camera_write_memory (ArvFakeCamera *camera, guint32 address, guint32 size, const void *buffer)
 {
@@ -188,6 +243,38 @@ _get_register (ArvFakeCamera *camera, guint32 address)
 	return GUINT32_FROM_BE (value);
 }
 
+/* Number of parts of the payload, 1 if the multipart mode is disabled */
+
+static guint
+_get_n_parts (ArvFakeCamera *camera)
+{
+	if (_get_register (camera, ARV_FAKE_CAMERA_REGISTER_MULTIPART) == 0)
+		return 1;
+
+	return CLAMP (_get_register (camera, ARV_FAKE_CAMERA_REGISTER_MULTIPART_N_PARTS), 1, ARV_FAKE_CAMERA_N_PARTS_MAX);
+}
+
+/* Size of the chunk data appended to the image, including the chunk header of the image itself. Chunks are not
+ * supported in multipart mode. */
+
+static size_t
+_get_chunk_data_size (ArvFakeCamera *camera)
+{
+	size_t size;
+	unsigned int i;
+
+	if (_get_register (camera, ARV_FAKE_CAMERA_REGISTER_CHUNK_MODE_ACTIVE) == 0 ||
+	    _get_register (camera, ARV_FAKE_CAMERA_REGISTER_MULTIPART) != 0)
+		return 0;
+
+	size = 2 * sizeof (guint32);
+	for (i = 0; i < ARV_FAKE_CAMERA_N_CHUNKS; i++)
+		if (_get_register (camera, ARV_FAKE_CAMERA_REGISTER_CHUNK_ENABLE + 4 * i) != 0)
+			size += 3 * sizeof (guint32);
+
+	return size;
+}
+
 size_t
 arv_fake_camera_get_payload (ArvFakeCamera *camera)
 {
@@ -195,11 +282,62 @@ arv_fake_camera_get_payload (ArvFakeCamera *camera)
 
 	g_return_val_if_fail (ARV_IS_FAKE_CAMERA (camera), 0);
 
+	g_mutex_lock (&camera->priv->fill_pattern_mutex);
+	if (camera->priv->replay_reader != NULL) {
+		size_t payload = camera->priv->replay_payload;
+
+		g_mutex_unlock (&camera->priv->fill_pattern_mutex);
+		return payload;
+	}
+	g_mutex_unlock (&camera->priv->fill_pattern_mutex);
+
 	width = _get_register (camera, ARV_FAKE_CAMERA_REGISTER_WIDTH);
 	height = _get_register (camera, ARV_FAKE_CAMERA_REGISTER_HEIGHT);
         pixel_format = _get_register (camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT);
 
-	return width * height * ARV_PIXEL_FORMAT_BIT_PER_PIXEL(pixel_format)/8;
+	return width * height * ARV_PIXEL_FORMAT_BIT_PER_PIXEL(pixel_format)/8 * _get_n_parts (camera) +
+		_get_chunk_data_size (camera);
+}
+
+static guint64
+_get_replay_frame_timestamp_ns (ArvFakeCamera *camera, guint64 index, gboolean use_system_timestamp)
+{
+	guint64 timestamp_ns = 0;
+	guint64 system_timestamp_ns = 0;
+
+	arv_recording_reader_get_frame_infos (camera->priv->replay_reader, index, NULL,
+					      &timestamp_ns, &system_timestamp_ns);
+
+	return use_system_timestamp ? system_timestamp_ns : timestamp_ns;
+}
+
+/* Interval between the previously sent recorded frame and the next one. When the replay loops, the first interval of
+ * the recording is used. */
+
+static guint64
+_get_replay_frame_period_us (ArvFakeCamera *camera)
+{
+	guint64 index;
+	guint64 previous_ns, next_ns;
+
+	if (camera->priv->replay_n_frames < 2)
+		return _get_register (camera, ARV_FAKE_CAMERA_REGISTER_ACQUISITION_FRAME_PERIOD_US);
+
+	index = camera->priv->replay_index > 0 ? camera->priv->replay_index : 1;
+
+	previous_ns = _get_replay_frame_timestamp_ns (camera, index - 1, FALSE);
+	next_ns = _get_replay_frame_timestamp_ns (camera, index, FALSE);
+
+	/* Fall back on the host timestamps if the device ones are not usable */
+	if (previous_ns == 0 || next_ns <= previous_ns) {
+		previous_ns = _get_replay_frame_timestamp_ns (camera, index - 1, TRUE);
+		next_ns = _get_replay_frame_timestamp_ns (camera, index, TRUE);
+	}
+
+	if (next_ns <= previous_ns)
+		return 0;
+
+	return (next_ns - previous_ns) / 1000;
 }
 
 /**
@@ -219,6 +357,32 @@ arv_fake_camera_get_sleep_time_for_next_frame (ArvFakeCamera *camera, guint64 *n
 
 	g_return_val_if_fail (ARV_IS_FAKE_CAMERA (camera), 0);
 
+	g_mutex_lock (&camera->priv->fill_pattern_mutex);
+	if (camera->priv->replay_reader != NULL &&
+	    _get_register (camera, ARV_FAKE_CAMERA_REGISTER_TRIGGER_MODE) != 1) {
+		guint64 next_frame_us;
+
+		time_us = g_get_real_time ();
+
+		if (camera->priv->replay_original_timing && camera->priv->replay_last_frame_us != 0)
+			next_frame_us = camera->priv->replay_last_frame_us + _get_replay_frame_period_us (camera);
+		else
+			next_frame_us = time_us;
+
+		/* Don't try to catch up with frames delayed by a stopped acquisition */
+		if (next_frame_us < time_us)
+			next_frame_us = time_us;
+
+		camera->priv->replay_next_frame_us = next_frame_us;
+		g_mutex_unlock (&camera->priv->fill_pattern_mutex);
+
+		if (next_timestamp_us != NULL)
+			*next_timestamp_us = next_frame_us;
+
+		return next_frame_us - time_us;
+	}
+	g_mutex_unlock (&camera->priv->fill_pattern_mutex);
+
 	if (_get_register (camera, ARV_FAKE_CAMERA_REGISTER_TRIGGER_MODE) == 1)
 		frame_period_time_us = 1000000L / camera->priv->trigger_frequency;
 	else
@@ -508,211 +672,346 @@ static struct {
    {128,     0,   0},
   };
 
+static guint8
+_jet_colormap_channel (unsigned int index, guint channel)
+{
+	switch (channel) {
+		case 0:
+			return jet_colormap [index].r;
+		case 1:
+			return jet_colormap [index].g;
+		default:
+			return jet_colormap [index].b;
+	}
+}
+
+/* Full range ITU-R BT.601 conversion */
+
 static void
-arv_fake_camera_diagonal_ramp (ArvBuffer *buffer, void *fill_pattern_data,
-			       guint32 exposure_time_us,
-			       guint32 gain,
-			       ArvPixelFormat pixel_format)
+_jet_colormap_yuv (unsigned int index, guint8 *y, guint8 *u, guint8 *v)
+{
+	double r = jet_colormap [index].r;
+	double g = jet_colormap [index].g;
+	double b = jet_colormap [index].b;
+
+	*y = CLAMP (0.299 * r + 0.587 * g + 0.114 * b + 0.5, 0, 255);
+	*u = CLAMP (128.5 - 0.168736 * r - 0.331264 * g + 0.5 * b, 0, 255);
+	*v = CLAMP (128.5 + 0.5 * r - 0.418688 * g - 0.081312 * b, 0, 255);
+}
+
+static guint8
+_diagonal_ramp_index (guint32 i, double scale)
 {
 	double pixel_value;
-	double scale;
-	guint32 x, y;
-	guint32 width;
-	guint32 height;
 
-        g_return_if_fail (buffer != NULL);
-        g_return_if_fail (buffer->priv->n_parts == 1);
+	pixel_value = i % 255;
+	pixel_value *= scale;
 
-	width = buffer->priv->parts[0].width;
-	height = buffer->priv->parts[0].height;
+	return CLAMP (pixel_value, 0, 255);
+}
 
-	scale = 1.0 + gain + log10 ((double) exposure_time_us / 10000.0);
+static guint16
+_diagonal_ramp_value_16 (guint32 i, double scale)
+{
+	double pixel_value;
 
-	switch (pixel_format)
-	{
-		case ARV_PIXEL_FORMAT_MONO_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned char *pixel = &buffer->priv->data [y * width + x];
+	pixel_value = (256 * i) % 65535;
+	pixel_value *= scale;
 
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
+	return CLAMP (pixel_value, 0, 65535);
+}
 
-						*pixel = CLAMP (pixel_value, 0, 255);
-					}
-				}
-                                buffer->priv->received_size = height * width;
-			}
+/* Packs a group of pixels, the GigE Vision formats store the most significant bits of each pixel in a byte, PFNC
+ * formats are a little endian bit stream */
+
+static void
+_pack_pixels (ArvPixelFormat pixel_format, const guint16 *values, guint8 *data)
+{
+	switch (pixel_format) {
+		case ARV_PIXEL_FORMAT_MONO_10P:
+			data[0] = values[0];
+			data[1] = (values[0] >> 8) | (values[1] << 2);
+			data[2] = (values[1] >> 6) | (values[2] << 4);
+			data[3] = (values[2] >> 4) | (values[3] << 6);
+			data[4] = values[3] >> 2;
+			break;
+		case ARV_PIXEL_FORMAT_MONO_12P:
+			data[0] = values[0];
+			data[1] = (values[0] >> 8) | (values[1] << 4);
+			data[2] = values[1] >> 4;
+			break;
+		case ARV_PIXEL_FORMAT_MONO_10_PACKED:
+			data[0] = values[0] >> 2;
+			data[1] = (values[0] & 0x03) | ((values[1] & 0x03) << 4);
+			data[2] = values[1] >> 2;
 			break;
+		case ARV_PIXEL_FORMAT_MONO_12_PACKED:
+			data[0] = values[0] >> 4;
+			data[1] = (values[0] & 0x0f) | ((values[1] & 0x0f) << 4);
+			data[2] = values[1] >> 4;
+			break;
+		default:
+			g_assert_not_reached ();
+	}
+}
 
-		case ARV_PIXEL_FORMAT_MONO_16:
-			if (2 * height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned short *pixel = (unsigned short *)&buffer->priv->data [2*y * width + 2*x];
+static void
+_diagonal_ramp_clear (ArvFakeCameraDiagonalRamp *ramp)
+{
+	guint i;
 
-						pixel_value = (256*x + 256*buffer->priv->frame_id + 256*y) % 65535;
-						pixel_value *= scale;
+	for (i = 0; i < G_N_ELEMENTS (ramp->lines); i++)
+		g_clear_pointer (&ramp->lines[i], g_free);
+	g_clear_pointer (&ramp->values, g_free);
 
-						*pixel = CLAMP (pixel_value, 0, 65535);
-					}
-				}
-                                buffer->priv->received_size = 2 * height * width;
-			}
-			break;
+	ramp->n_lines = 0;
+}
+
+static gboolean
+_diagonal_ramp_update (ArvFakeCameraDiagonalRamp *ramp,
+		       guint32 width,
+		       guint32 exposure_time_us,
+		       guint32 gain,
+		       ArvPixelFormat pixel_format)
+{
+	/* Colormap channel (0: red, 1: green, 2: blue) indexed by 2 * (y & 1) + (x & 1) */
+	static const guint8 bayer_bg_channels[4] = {0, 1, 1, 2};
+	static const guint8 bayer_gb_channels[4] = {1, 2, 0, 1};
+	static const guint8 bayer_gr_channels[4] = {1, 0, 2, 1};
+	static const guint8 bayer_rg_channels[4] = {2, 1, 1, 0};
+	const guint8 *bayer_channels = NULL;
+	double scale;
+	guint32 n_values;
+	guint32 n_groups;
+	guint32 i, j;
+	guint depth = 0;
+	guint l;
+
+	if (ramp->n_lines > 0 &&
+	    ramp->pixel_format == pixel_format &&
+	    ramp->width == width &&
+	    ramp->exposure_time_us == exposure_time_us &&
+	    ramp->gain == gain)
+		return TRUE;
+
+	_diagonal_ramp_clear (ramp);
 
+	ramp->period = 255;
+	ramp->pixel_group = 1;
+	ramp->n_phases = 1;
+	ramp->row_parity = FALSE;
+
+	switch (pixel_format) {
+		case ARV_PIXEL_FORMAT_MONO_8:
+			ramp->group_size = 1;
+			break;
+		case ARV_PIXEL_FORMAT_MONO_16:
+			ramp->period = 65535;
+			ramp->group_size = 2;
+			break;
+		case ARV_PIXEL_FORMAT_MONO_10P:
+			depth = 10;
+			ramp->pixel_group = 4;
+			ramp->group_size = 5;
+			break;
+		case ARV_PIXEL_FORMAT_MONO_10_PACKED:
+			depth = 10;
+			ramp->pixel_group = 2;
+			ramp->group_size = 3;
+			break;
+		case ARV_PIXEL_FORMAT_MONO_12P:
+		case ARV_PIXEL_FORMAT_MONO_12_PACKED:
+			depth = 12;
+			ramp->pixel_group = 2;
+			ramp->group_size = 3;
+			break;
 		case ARV_PIXEL_FORMAT_BAYER_BG_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned int index;
-						unsigned char *pixel;
-
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
-						index = CLAMP (pixel_value, 0, 255);
-
-						// BG
-						// GR
-						pixel = &buffer->priv->data [y * width + x];
-						if (x & 1) {
-							if (y & 1)
-								*pixel = jet_colormap [index].b;
-							else
-								*pixel = jet_colormap [index].g;
-						} else {
-							if (y & 1)
-								*pixel = jet_colormap [index].g;
-							else
-								*pixel = jet_colormap [index].r;
-						}
-					}
-				}
-                                buffer->priv->received_size = height * width;
-			}
+			bayer_channels = bayer_bg_channels;
 			break;
-
 		case ARV_PIXEL_FORMAT_BAYER_GB_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned int index;
-						unsigned char *pixel;
-
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
-						index = CLAMP (pixel_value, 0, 255);
-
-						// GB
-						// RG
-						pixel = &buffer->priv->data [y * width + x];
-						if (x & 1) {
-							if (y & 1)
-								*pixel = jet_colormap [index].g;
-							else
-								*pixel = jet_colormap [index].b;
-						} else {
-							if (y & 1)
-								*pixel = jet_colormap [index].r;
-							else
-								*pixel = jet_colormap [index].g;
-						}
-					}
-				}
-                                buffer->priv->received_size = height * width;
-			}
+			bayer_channels = bayer_gb_channels;
 			break;
-
 		case ARV_PIXEL_FORMAT_BAYER_GR_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned int index;
-						unsigned char *pixel;
-
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
-						index = CLAMP (pixel_value, 0, 255);
-
-						// GR
-						// BG
-						pixel = &buffer->priv->data [y * width + x];
-						if (x & 1) {
-							if (y & 1)
-								*pixel = jet_colormap [index].g;
-							else
-								*pixel = jet_colormap [index].r;
-						} else {
-							if (y & 1)
-								*pixel = jet_colormap [index].b;
-							else
-								*pixel = jet_colormap [index].g;
-						}
-					}
-				}
-                                buffer->priv->received_size = height * width;
-			}
+			bayer_channels = bayer_gr_channels;
 			break;
-
 		case ARV_PIXEL_FORMAT_BAYER_RG_8:
-			if (height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned int index;
-						unsigned char *pixel;
-
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
-						index = CLAMP (pixel_value, 0, 255);
-
-						// RG
-						// GB
-						pixel = &buffer->priv->data [y * width + x];
-						if (x & 1) {
-							if (y & 1)
-								*pixel = jet_colormap [index].r;
-							else
-								*pixel = jet_colormap [index].g;
-						} else {
-							if (y & 1)
-								*pixel = jet_colormap [index].g;
-							else
-								*pixel = jet_colormap [index].b;
-						}
-					}
-				}
-                                buffer->priv->received_size = height * width;
-			}
+			bayer_channels = bayer_rg_channels;
 			break;
-
 		case ARV_PIXEL_FORMAT_RGB_8_PACKED:
-			if (3 * height * width <= buffer->priv->allocated_size) {
-				for (y = 0; y < height; y++) {
-					for (x = 0; x < width; x++) {
-						unsigned char *pixel = &buffer->priv->data [3 * (y * width + x)];
-						unsigned int index;
+			ramp->group_size = 3;
+			break;
+		case ARV_PIXEL_FORMAT_YUV_422_PACKED:
+		case ARV_PIXEL_FORMAT_YUV_422_YUYV_PACKED:
+			/* The chroma sample depends on the pixel parity */
+			ramp->group_size = 2;
+			ramp->n_phases = 2;
+			break;
+		default:
+			return FALSE;
+	}
 
-						pixel_value = (x + buffer->priv->frame_id + y) % 255;
-						pixel_value *= scale;
+	/* The color filter depends on the row and pixel parities */
+	if (bayer_channels != NULL) {
+		ramp->group_size = 1;
+		ramp->n_phases = 2;
+		ramp->row_parity = TRUE;
+	}
+
+	/* Packed pixels are stored with the full 16 bit ramp shifted to their depth */
+	if (depth > 0) {
+		ramp->period = 65535;
+		ramp->n_phases = ramp->pixel_group;
+	}
 
-						index = CLAMP (pixel_value, 0, 255);
+	ramp->pixel_format = pixel_format;
+	ramp->width = width;
+	ramp->exposure_time_us = exposure_time_us;
+	ramp->gain = gain;
+	ramp->n_lines = ramp->row_parity ? 2 * ramp->n_phases : ramp->n_phases;
+
+	scale = 1.0 + gain + log10 ((double) exposure_time_us / 10000.0);
 
-						pixel[0] = jet_colormap [index].r;
-						pixel[1] = jet_colormap [index].g;
-						pixel[2] = jet_colormap [index].b;
-					}
+	/* The line of phase p starts at ramp pixel p, and must cover the offsets up to the ramp period */
+	n_groups = (width + ramp->period + ramp->pixel_group - 1) / ramp->pixel_group;
+	n_values = ramp->n_phases + n_groups * ramp->pixel_group;
+
+	if (depth > 0) {
+		ramp->values = g_new (guint16, n_values);
+		for (i = 0; i < n_values; i++)
+			ramp->values[i] = _diagonal_ramp_value_16 (i, scale) >> (16 - depth);
+	}
+
+	for (l = 0; l < ramp->n_lines; l++) {
+		guint row_parity = l / ramp->n_phases;
+		guint phase = l % ramp->n_phases;
+		guint8 *line;
+
+		line = ramp->lines[l] = g_malloc (n_groups * ramp->group_size);
+
+		for (j = 0; j < n_groups; j++) {
+			guint8 *pixel = &line[j * ramp->group_size];
+			guint8 y, u, v, even_y;
+
+			i = phase + j * ramp->pixel_group;
+
+			if (depth > 0) {
+				_pack_pixels (pixel_format, &ramp->values[i], pixel);
+			} else if (bayer_channels != NULL) {
+				*pixel = _jet_colormap_channel (_diagonal_ramp_index (i, scale),
+								bayer_channels[2 * row_parity + (j & 1)]);
+			} else if (pixel_format == ARV_PIXEL_FORMAT_MONO_8) {
+				*pixel = _diagonal_ramp_index (i, scale);
+			} else if (pixel_format == ARV_PIXEL_FORMAT_MONO_16) {
+				*((guint16 *) pixel) = _diagonal_ramp_value_16 (i, scale);
+			} else if (pixel_format == ARV_PIXEL_FORMAT_RGB_8_PACKED) {
+				unsigned int index = _diagonal_ramp_index (i, scale);
+
+				pixel[0] = jet_colormap [index].r;
+				pixel[1] = jet_colormap [index].g;
+				pixel[2] = jet_colormap [index].b;
+			} else {
+				/* Pixel pairs share the chroma of the even pixel */
+				_jet_colormap_yuv (_diagonal_ramp_index (i, scale), &y, &u, &v);
+				if ((j & 1) != 0)
+					_jet_colormap_yuv (_diagonal_ramp_index (i - 1, scale), &even_y, &u, &v);
+
+				if (pixel_format == ARV_PIXEL_FORMAT_YUV_422_PACKED) {
+					pixel[0] = (j & 1) != 0 ? v : u;
+					pixel[1] = y;
+				} else {
+					pixel[0] = y;
+					pixel[1] = (j & 1) != 0 ? v : u;
 				}
-                                buffer->priv->received_size = 3 * height * width;
 			}
-			break;
+		}
+	}
 
-		default:
-			g_critical ("Unsupported pixel format");
-			break;
+	return TRUE;
+}
+
+/* Packs a whole frame when the rows are not aligned on pixel groups */
+
+static void
+_diagonal_ramp_pack_frame (ArvFakeCameraDiagonalRamp *ramp, guint32 offset, guint32 height, guint8 *data,
+			   size_t size)
+{
+	guint16 values[4] = {0};
+	guint8 group[5];
+	guint64 n = 0;
+	guint32 x, y;
+
+	for (y = 0; y < height; y++) {
+		for (x = 0; x < ramp->width; x++, n++) {
+			values[n % ramp->pixel_group] = ramp->values[x + offset];
+			if (n % ramp->pixel_group == ramp->pixel_group - 1)
+				_pack_pixels (ramp->pixel_format, values,
+					      &data[(n / ramp->pixel_group) * ramp->group_size]);
+		}
+		offset = offset + 1 < ramp->period ? offset + 1 : 0;
+	}
+
+	if (n % ramp->pixel_group != 0) {
+		size_t group_offset = (n / ramp->pixel_group) * ramp->group_size;
+
+		for (; n % ramp->pixel_group != 0; n++)
+			values[n % ramp->pixel_group] = 0;
+		_pack_pixels (ramp->pixel_format, values, group);
+		memcpy (&data[group_offset], group, size - group_offset);
 	}
 }
 
+static void
+arv_fake_camera_diagonal_ramp (ArvBuffer *buffer, void *fill_pattern_data,
+			       guint32 exposure_time_us,
+			       guint32 gain,
+			       ArvPixelFormat pixel_format)
+{
+	ArvFakeCameraDiagonalRamp *ramp = fill_pattern_data;
+	size_t row_size;
+	size_t size;
+	guint32 offset;
+	guint32 y;
+	guint32 width;
+	guint32 height;
+
+        g_return_if_fail (buffer != NULL);
+        g_return_if_fail (buffer->priv->n_parts == 1);
+	g_return_if_fail (ramp != NULL);
+
+	width = buffer->priv->parts[0].width;
+	height = buffer->priv->parts[0].height;
+
+	if (!_diagonal_ramp_update (ramp, width, exposure_time_us, gain, pixel_format)) {
+		g_critical ("Unsupported pixel format");
+		return;
+	}
+
+	size = (size_t) width * height * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (pixel_format) / 8;
+	if (size > buffer->priv->allocated_size)
+		return;
+
+	/* Pixel (x, y) has the value of the ramp pixel at x + (y + frame_id) % period */
+	offset = buffer->priv->frame_id % ramp->period;
+
+	if (width % ramp->pixel_group != 0) {
+		_diagonal_ramp_pack_frame (ramp, offset, height, buffer->priv->data, size);
+	} else {
+		row_size = width / ramp->pixel_group * ramp->group_size;
+
+		for (y = 0; y < height; y++) {
+			guint phase = offset % ramp->n_phases;
+			guint l = ramp->row_parity && (y & 1) != 0 ? ramp->n_phases + phase : phase;
+
+			memcpy (&buffer->priv->data[y * row_size],
+				&ramp->lines[l][(offset - phase) / ramp->pixel_group * ramp->group_size], row_size);
+
+			offset = offset + 1 < ramp->period ? offset + 1 : 0;
+		}
+	}
+
+	buffer->priv->received_size = size;
+}
+
 /**
  * arv_fake_camera_set_fill_pattern:
  * @camera: a #ArvFakeCamera
@@ -736,10 +1035,245 @@ arv_fake_camera_set_fill_pattern (ArvFakeCamera *camera,
 		camera->priv->fill_pattern_data = fill_pattern_data;
 	} else {
 		camera->priv->fill_pattern_callback = arv_fake_camera_diagonal_ramp;
-		camera->priv->fill_pattern_data = NULL;
+		camera->priv->fill_pattern_data = &camera->priv->diagonal_ramp;
+	}
+
+	g_mutex_unlock (&camera->priv->fill_pattern_mutex);
+}
+
+/**
+ * arv_fake_camera_set_replay:
+ * @camera: a #ArvFakeCamera
+ * @filename: (nullable): a recording file written by #ArvRecorder, %NULL to go back to the synthetic images
+ * @original_timing: %TRUE to replay the frames at their recorded inter-frame timing, %FALSE to send them as fast as
+ * possible
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Replaces the generated test images by the frames of a recording, which is replayed in a loop. Payload data, chunks
+ * and part layout are sent unmodified, frame ids and timestamps are regenerated. The camera width, height and pixel
+ * format registers are set from the first frame of the recording.
+ *
+ * In trigger mode, the replay is paced by the trigger frequency or the software trigger.
+ *
+ * Returns: %TRUE on success
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_fake_camera_set_replay (ArvFakeCamera *camera, const char *filename, gboolean original_timing, GError **error)
+{
+	ArvRecordingReader *reader = NULL;
+	ArvBuffer *first_buffer = NULL;
+	size_t payload = 0;
+	guint64 n_frames = 0;
+
+	g_return_val_if_fail (ARV_IS_FAKE_CAMERA (camera), FALSE);
+
+	if (filename != NULL) {
+		guint64 i;
+
+		reader = arv_recording_reader_new (filename, error);
+		if (reader == NULL)
+			return FALSE;
+
+		n_frames = arv_recording_reader_get_n_frames (reader);
+		if (n_frames == 0) {
+			g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+				     "Recording '%s' doesn't contain any frame", filename);
+			g_object_unref (reader);
+			return FALSE;
+		}
+
+		/* Validate all the records up front, and find the buffer size needed for the largest frame */
+		for (i = 0; i < n_frames; i++) {
+			ArvBuffer *buffer;
+
+			buffer = arv_recording_reader_get_buffer (reader, i, error);
+			if (buffer == NULL) {
+				g_clear_object (&first_buffer);
+				g_object_unref (reader);
+				return FALSE;
+			}
+
+			payload = MAX (payload, buffer->priv->received_size);
+
+			if (i == 0)
+				first_buffer = buffer;
+			else
+				g_object_unref (buffer);
+		}
+
+		if (first_buffer->priv->n_parts > 0 &&
+		    first_buffer->priv->parts[0].data_type == ARV_BUFFER_PART_DATA_TYPE_2D_IMAGE) {
+			arv_fake_camera_write_register (camera, ARV_FAKE_CAMERA_REGISTER_WIDTH,
+							first_buffer->priv->parts[0].width);
+			arv_fake_camera_write_register (camera, ARV_FAKE_CAMERA_REGISTER_HEIGHT,
+							first_buffer->priv->parts[0].height);
+			arv_fake_camera_write_register (camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT,
+							first_buffer->priv->parts[0].pixel_format);
+		}
+
+		g_object_unref (first_buffer);
+
+		arv_info_misc ("[FakeCamera::set_replay] Replay %" G_GUINT64_FORMAT " frames from '%s'%s",
+			       n_frames, filename, original_timing ? "" : " as fast as possible");
 	}
 
+	g_mutex_lock (&camera->priv->fill_pattern_mutex);
+
+	g_clear_object (&camera->priv->replay_reader);
+	camera->priv->replay_reader = reader;
+	camera->priv->replay_original_timing = original_timing;
+	camera->priv->replay_n_frames = n_frames;
+	camera->priv->replay_index = 0;
+	camera->priv->replay_payload = payload;
+	camera->priv->replay_last_frame_us = 0;
+	camera->priv->replay_next_frame_us = 0;
+
 	g_mutex_unlock (&camera->priv->fill_pattern_mutex);
+
+	return TRUE;
+}
+
+static guint64
+_get_next_frame_id (ArvFakeCamera *camera)
+{
+	guint64 frame_id;
+
+	/* frame id is a 16 bit value, or a 64 bit value in extended id mode, 0 is invalid */
+	frame_id = camera->priv->frame_id + 1;
+	if (_get_register (camera, ARV_FAKE_CAMERA_REGISTER_EXTENDED_ID_MODE) == 0 &&
+	    _get_register (camera, ARV_FAKE_CAMERA_REGISTER_MULTIPART) == 0)
+		frame_id %= 65536;
+	if (frame_id == 0)
+		frame_id = 1;
+
+	return frame_id;
+}
+
+/* Appends a chunk to the buffer data. If @data is %NULL, the chunk data are the last @size bytes of the buffer. */
+
+static void
+_append_chunk (ArvBuffer *buffer, guint32 chunk_id, const void *data, guint32 size)
+{
+	guint32 infos[2];
+
+	if (data != NULL) {
+		memcpy (buffer->priv->data + buffer->priv->received_size, data, size);
+		buffer->priv->received_size += size;
+	}
+
+	infos[0] = GUINT32_TO_BE (chunk_id);
+	infos[1] = GUINT32_TO_BE (size);
+	memcpy (buffer->priv->data + buffer->priv->received_size, infos, sizeof (infos));
+	buffer->priv->received_size += sizeof (infos);
+}
+
+/* Turns the generated image into an image followed by the enabled chunks. The image is itself a chunk. */
+
+static void
+_append_chunks (ArvFakeCamera *camera, ArvBuffer *buffer)
+{
+	static const guint32 chunk_ids[ARV_FAKE_CAMERA_N_CHUNKS] = {
+		ARV_FAKE_CAMERA_CHUNK_ID_WIDTH,
+		ARV_FAKE_CAMERA_CHUNK_ID_HEIGHT
+	};
+	guint32 values[ARV_FAKE_CAMERA_N_CHUNKS];
+	unsigned int i;
+
+	if (buffer->priv->received_size + _get_chunk_data_size (camera) > buffer->priv->allocated_size) {
+		buffer->priv->status = ARV_BUFFER_STATUS_SIZE_MISMATCH;
+		return;
+	}
+
+	values[ARV_FAKE_CAMERA_CHUNK_WIDTH] = GUINT32_TO_BE (buffer->priv->parts[0].width);
+	values[ARV_FAKE_CAMERA_CHUNK_HEIGHT] = GUINT32_TO_BE (buffer->priv->parts[0].height);
+
+	_append_chunk (buffer, ARV_FAKE_CAMERA_CHUNK_ID_IMAGE, NULL, buffer->priv->received_size);
+
+	for (i = 0; i < ARV_FAKE_CAMERA_N_CHUNKS; i++)
+		if (_get_register (camera, ARV_FAKE_CAMERA_REGISTER_CHUNK_ENABLE + 4 * i) != 0)
+			_append_chunk (buffer, chunk_ids[i], &values[i], sizeof (guint32));
+
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_EXTENDED_CHUNK_DATA;
+	buffer->priv->has_chunks = TRUE;
+}
+
+/* Turns the generated image into a multipart payload, made of copies of the image */
+
+static void
+_replicate_parts (ArvBuffer *buffer, guint n_parts)
+{
+	ArvBufferPartInfos part;
+	unsigned int i;
+
+	part = buffer->priv->parts[0];
+
+	if (part.size * n_parts > buffer->priv->allocated_size) {
+		buffer->priv->status = ARV_BUFFER_STATUS_SIZE_MISMATCH;
+		return;
+	}
+
+	arv_buffer_set_n_parts (buffer, n_parts);
+
+	for (i = 0; i < n_parts; i++) {
+		buffer->priv->parts[i] = part;
+		buffer->priv->parts[i].data_offset = i * part.size;
+		buffer->priv->parts[i].component_id = i;
+		if (i > 0)
+			memcpy (buffer->priv->data + i * part.size, buffer->priv->data, part.size);
+	}
+
+	buffer->priv->received_size = n_parts * part.size;
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_MULTIPART;
+}
+
+/* Called with fill_pattern_mutex locked */
+
+static void
+_fill_buffer_from_replay (ArvFakeCamera *camera, ArvBuffer *buffer)
+{
+	ArvBuffer *recorded;
+	GError *error = NULL;
+	guint i;
+
+	recorded = arv_recording_reader_get_buffer (camera->priv->replay_reader, camera->priv->replay_index, &error);
+	if (recorded == NULL) {
+		arv_warning_misc ("[FakeCamera::fill_buffer] Failed to read recorded frame %" G_GUINT64_FORMAT ": %s",
+				  camera->priv->replay_index, error != NULL ? error->message : "Unknown reason");
+		g_clear_error (&error);
+		buffer->priv->status = ARV_BUFFER_STATUS_ABORTED;
+		return;
+	}
+
+	if (buffer->priv->allocated_size < recorded->priv->received_size) {
+		buffer->priv->status = ARV_BUFFER_STATUS_SIZE_MISMATCH;
+		g_object_unref (recorded);
+		return;
+	}
+
+	camera->priv->frame_id = _get_next_frame_id (camera);
+	camera->priv->replay_index = (camera->priv->replay_index + 1) % camera->priv->replay_n_frames;
+	camera->priv->replay_last_frame_us = camera->priv->replay_next_frame_us != 0 ?
+		camera->priv->replay_next_frame_us : (guint64) g_get_real_time ();
+
+	memcpy (buffer->priv->data, recorded->priv->data, recorded->priv->received_size);
+
+	buffer->priv->received_size = recorded->priv->received_size;
+	buffer->priv->payload_type = recorded->priv->payload_type;
+	buffer->priv->has_chunks = recorded->priv->has_chunks;
+	buffer->priv->chunk_endianness = recorded->priv->chunk_endianness;
+	buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
+	buffer->priv->timestamp_ns = g_get_real_time () * 1000;
+	buffer->priv->system_timestamp_ns = buffer->priv->timestamp_ns;
+	buffer->priv->frame_id = camera->priv->frame_id;
+
+	arv_buffer_set_n_parts (buffer, recorded->priv->n_parts);
+	for (i = 0; i < recorded->priv->n_parts; i++)
+		buffer->priv->parts[i] = recorded->priv->parts[i];
+
+	g_object_unref (recorded);
 }
 
 /**
@@ -764,6 +1298,20 @@ arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *
 	if (camera == NULL || buffer == NULL)
 		return;
 
+	if (packet_size != NULL)
+		*packet_size =
+			(_get_register (camera, ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_OFFSET) >>
+			 ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_POS) &
+			ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_MASK;
+
+	g_mutex_lock (&camera->priv->fill_pattern_mutex);
+	if (camera->priv->replay_reader != NULL) {
+		_fill_buffer_from_replay (camera, buffer);
+		g_mutex_unlock (&camera->priv->fill_pattern_mutex);
+		return;
+	}
+	g_mutex_unlock (&camera->priv->fill_pattern_mutex);
+
         arv_buffer_set_n_parts(buffer, 1);
 
 	width = _get_register (camera, ARV_FAKE_CAMERA_REGISTER_WIDTH);
@@ -775,12 +1323,10 @@ arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *
 		return;
 	}
 
-	/* frame id is a 16 bit value, 0 is invalid */
-	camera->priv->frame_id = (camera->priv->frame_id + 1) % 65536;
-	if (camera->priv->frame_id == 0)
-		camera->priv->frame_id = 1;
+	camera->priv->frame_id = _get_next_frame_id (camera);
 
 	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_IMAGE;
+	buffer->priv->has_chunks = FALSE;
 	buffer->priv->chunk_endianness = G_BIG_ENDIAN;
 	buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
 	buffer->priv->timestamp_ns = g_get_real_time () * 1000;
@@ -810,11 +1356,10 @@ arv_fake_camera_fill_buffer (ArvFakeCamera *camera, ArvBuffer *buffer, guint32 *
 
         buffer->priv->parts[0].size = buffer->priv->received_size;
 
-	if (packet_size != NULL)
-		*packet_size =
-			(_get_register (camera, ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_OFFSET) >>
-			 ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_POS) &
-			ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_MASK;
+	if (_get_register (camera, ARV_FAKE_CAMERA_REGISTER_MULTIPART) != 0)
+		_replicate_parts (buffer, _get_n_parts (camera));
+	else if (_get_register (camera, ARV_FAKE_CAMERA_REGISTER_CHUNK_MODE_ACTIVE) != 0)
+		_append_chunks (camera, buffer);
 }
 
 void
@@ -989,7 +1534,7 @@ arv_fake_camera_new_full (const char *serial_number, const char *genicam_filenam
 
 	g_mutex_init (&fake_camera->priv->fill_pattern_mutex);
 	fake_camera->priv->fill_pattern_callback = arv_fake_camera_diagonal_ramp;
-	fake_camera->priv->fill_pattern_data = NULL;
+	fake_camera->priv->fill_pattern_data = &fake_camera->priv->diagonal_ramp;
 
 	if (genicam_filename != NULL)
 		filename = g_strdup (genicam_filename);
@@ -1070,6 +1615,13 @@ arv_fake_camera_new_full (const char *serial_number, const char *genicam_filenam
 	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_GAIN_RAW, 0);
 	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_GAIN_MODE, 1);
 
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_CHUNK_MODE_ACTIVE, 0);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_CHUNK_SELECTOR, 0);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_MULTIPART, 0);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_MULTIPART_N_PARTS,
+					ARV_FAKE_CAMERA_N_PARTS_DEFAULT);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_EXTENDED_ID_MODE, 0);
+
 	arv_fake_camera_write_register (fake_camera, ARV_GVBS_HEARTBEAT_TIMEOUT_OFFSET, 3000);
 	arv_fake_camera_write_register (fake_camera, ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_HIGH_OFFSET, 0);
 	arv_fake_camera_write_register (fake_camera, ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_LOW_OFFSET, 1000000000);
@@ -1106,6 +1658,8 @@ arv_fake_camera_finalize (GObject *object)
 {
 	ArvFakeCamera *fake_camera = ARV_FAKE_CAMERA (object);
 
+	g_clear_object (&fake_camera->priv->replay_reader);
+	_diagonal_ramp_clear (&fake_camera->priv->diagonal_ramp);
 	g_mutex_clear (&fake_camera->priv->fill_pattern_mutex);
 	g_clear_pointer (&fake_camera->priv->memory, g_free);
 	g_clear_pointer (&fake_camera->priv->genicam_xml, g_free);
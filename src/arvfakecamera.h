@@ -86,6 +86,29 @@ ARV_API void			arv_set_fake_camera_genicam_filename (const char *filename);
 #define ARV_FAKE_CAMERA_REGISTER_GAIN_RAW		0x110
 #define ARV_FAKE_CAMERA_REGISTER_GAIN_MODE		0x114
 
+/* Chunk data control */
+
+#define ARV_FAKE_CAMERA_REGISTER_CHUNK_MODE_ACTIVE	0x340
+#define ARV_FAKE_CAMERA_REGISTER_CHUNK_SELECTOR		0x344
+#define ARV_FAKE_CAMERA_REGISTER_CHUNK_ENABLE		0x348	/* One register per chunk, indexed by ChunkSelector */
+
+#define ARV_FAKE_CAMERA_CHUNK_WIDTH			0
+#define ARV_FAKE_CAMERA_CHUNK_HEIGHT			1
+#define ARV_FAKE_CAMERA_N_CHUNKS			2
+
+#define ARV_FAKE_CAMERA_CHUNK_ID_IMAGE			0x00000001
+#define ARV_FAKE_CAMERA_CHUNK_ID_WIDTH			0x00000101
+#define ARV_FAKE_CAMERA_CHUNK_ID_HEIGHT			0x00000102
+
+/* Stream format */
+
+#define ARV_FAKE_CAMERA_REGISTER_MULTIPART		0x350
+#define ARV_FAKE_CAMERA_REGISTER_MULTIPART_N_PARTS	0x354
+#define ARV_FAKE_CAMERA_REGISTER_EXTENDED_ID_MODE	0x358
+
+#define ARV_FAKE_CAMERA_N_PARTS_DEFAULT			2
+#define ARV_FAKE_CAMERA_N_PARTS_MAX			4
+
 #define ARV_TYPE_FAKE_CAMERA             (arv_fake_camera_get_type ())
 ARV_API G_DECLARE_FINAL_TYPE (ArvFakeCamera, arv_fake_camera, ARV, FAKE_CAMERA, GObject)
 
@@ -118,6 +141,8 @@ ARV_API guint32			arv_fake_camera_get_heartbeat_timeout		(ArvFakeCamera *camera)
 ARV_API void			arv_fake_camera_set_fill_pattern	(ArvFakeCamera *camera,
 									 ArvFakeCameraFillPattern fill_pattern_callback,
 									 void *fill_pattern_data);
+ARV_API gboolean		arv_fake_camera_set_replay		(ArvFakeCamera *camera, const char *filename,
+									 gboolean original_timing, GError **error);
 ARV_API void			arv_fake_camera_set_trigger_frequency	(ArvFakeCamera *camera, double frequency);
 ARV_API gboolean		arv_fake_camera_is_in_free_running_mode (ArvFakeCamera *camera);
 ARV_API gboolean		arv_fake_camera_is_in_software_trigger_mode (ArvFakeCamera *camera);
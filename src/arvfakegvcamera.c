@@ -21,6 +21,8 @@
  */
 
 #include <arvdebugprivate.h>
+#include <arvgvfakeimpairmentprivate.h>
+#include <arvgvfakecameraprivate.h>
 #include <arv.h>
 #include <stdlib.h>
 #include <stdio.h>
@@ -37,6 +39,13 @@ static char *arv_option_interface_name = NULL;
 static char *arv_option_serial_number = NULL;
 static char *arv_option_genicam_file = NULL;
 static double arv_option_gvsp_lost_ratio = 0.0;
+static char *arv_option_replay_file = NULL;
+static gboolean arv_option_replay_fast = FALSE;
+static gboolean arv_option_high_rate = FALSE;
+static double arv_option_bit_rate = 0.0;
+static char *arv_option_impairment = NULL;
+static int arv_option_n_cameras = 1;
+static int arv_option_n_threads = 0;
 static char *arv_option_debug_domains = NULL;
 
 static const GOptionEntry arv_option_entries[] =
@@ -49,6 +58,20 @@ static const GOptionEntry arv_option_entries[] =
 	        &arv_option_genicam_file, 	"XML Genicam file to use", "genicam_filename"},
 	{ "gvsp-lost-ratio",    'r', 0, G_OPTION_ARG_DOUBLE,
 	        &arv_option_gvsp_lost_ratio,	"GVSP lost packet ratio", "packet_per_thousand"},
+	{ "replay",             'p', 0, G_OPTION_ARG_FILENAME,
+	        &arv_option_replay_file,	"Replay the frames of a recording", "recording_filename"},
+	{ "replay-fast",        'f', 0, G_OPTION_ARG_NONE,
+	        &arv_option_replay_fast,	"Replay as fast as possible instead of the original timing", NULL},
+	{ "high-rate",          'H', 0, G_OPTION_ARG_NONE,
+	        &arv_option_high_rate,		"Send pregenerated frames in paced packet batches", NULL},
+	{ "bit-rate",           'b', 0, G_OPTION_ARG_DOUBLE,
+	        &arv_option_bit_rate,		"Stream bit rate limit in high rate mode", "Mbit/s"},
+	{ "impairment",         'm', 0, G_OPTION_ARG_STRING,
+	        &arv_option_impairment,		"GVSP network impairment profile", "key=value[,...]"},
+	{ "n-cameras",          'n', 0, G_OPTION_ARG_INT,
+	        &arv_option_n_cameras,		"Number of fake cameras", "n_cameras"},
+	{ "threads",            't', 0, G_OPTION_ARG_INT,
+	        &arv_option_n_threads,		"Number of threads shared by the fake cameras", "n_threads"},
 	{
 		"debug", 			'd', 0, G_OPTION_ARG_STRING,
 		&arv_option_debug_domains, 	NULL,
@@ -63,18 +86,75 @@ description_content[] =
 "any arbitrary genicam data, as the declared features must match the registers\n"
 "of the fake device.\n"
 "\n"
+"The replay parameter streams the frames of a file written by ArvRecorder in\n"
+"a loop, at their original inter-frame timing, or as fast as possible with\n"
+"the replay-fast option.\n"
+"\n"
+"The high-rate parameter streams a cycle of pregenerated frames, in batches of\n"
+"packets paced by the GevSCPD packet delay and by the bit-rate limit, in order\n"
+"to load test the receivers.\n"
+"\n"
+"The impairment parameter applies a seeded, reproducible network impairment to\n"
+"the stream packets. It is a comma separated list of settings:\n"
+"  seed=<n>             random generator seed\n"
+"  loss=<ratio>         packet loss ratio\n"
+"  burst-start=<p>      probability of a loss burst start, per packet\n"
+"  burst-end=<p>        probability of a loss burst end, per packet\n"
+"  burst-loss=<ratio>   packet loss ratio during bursts (default 1)\n"
+"  reorder=<ratio>      ratio of packets delayed by up to reorder-window packets\n"
+"  reorder-window=<n>   maximum reordering distance (default 8)\n"
+"  duplicate=<ratio>    duplicated packet ratio\n"
+"  truncate=<ratio>     truncated data packet ratio\n"
+"  leader-delay=<n>     leader delay, in packets\n"
+"  trailer-delay=<µs>   trailer delay\n"
+"  resend-latency=<µs>  packet resend request latency\n"
+"\n"
+"The n-cameras parameter serves several fake cameras from this process, on\n"
+"consecutive loopback addresses starting at the interface address, which must\n"
+"be a loopback address. The serial numbers are the serial parameter followed\n"
+"by the camera index, GV01, GV02... by default. All the cameras answer the\n"
+"discovery requests. With the threads parameter, the cameras share a pool of\n"
+"sender threads, instead of having one thread each.\n"
+"\n"
 "Examples:\n"
 "\n"
 "arv-fake-gv-camera-" ARAVIS_API_VERSION " -i eth0\n"
 "arv-fake-gv-camera-" ARAVIS_API_VERSION " -i 127.0.0.1\n"
-"arv-fake-gv-camera-" ARAVIS_API_VERSION " -s GV02 -d all\n";
+"arv-fake-gv-camera-" ARAVIS_API_VERSION " -s GV02 -d all\n"
+"arv-fake-gv-camera-" ARAVIS_API_VERSION " -i 127.0.0.1 -p capture.arvrec -f\n"
+"arv-fake-gv-camera-" ARAVIS_API_VERSION " -i eth0 -H -b 5000\n"
+"arv-fake-gv-camera-" ARAVIS_API_VERSION " -m seed=1,burst-start=0.001,burst-end=0.3,resend-latency=500\n"
+"arv-fake-gv-camera-" ARAVIS_API_VERSION " -i 127.0.1.1 -n 32 -t 4 -H\n";
+
+/* Returns the address of the camera of the given index, or NULL if it is not a loopback address */
+
+static char *
+_get_camera_address (GInetAddress *first_address, guint index)
+{
+	const guint8 *bytes;
+	guint32 address;
+
+	bytes = g_inet_address_to_bytes (first_address);
+	address = ((guint32) bytes[0] << 24 | bytes[1] << 16 | bytes[2] << 8 | bytes[3]) + index;
+
+	if ((address >> 24) != 127)
+		return NULL;
+
+	return g_strdup_printf ("%u.%u.%u.%u", address >> 24, (address >> 16) & 0xff, (address >> 8) & 0xff,
+				address & 0xff);
+}
 
 int
 main (int argc, char **argv)
 {
-	ArvGvFakeCamera *gv_camera;
+	ArvGvFakeCamera **gv_cameras;
+	ArvGvFakeCameraPool *pool = NULL;
+	GInetAddress *first_address = NULL;
 	GOptionContext *context;
 	GError *error = NULL;
+	guint n_cameras;
+	guint i;
+	int status = EXIT_SUCCESS;
 
 	context = g_option_context_new (NULL);
 	g_option_context_set_summary (context, "Fake GigEVision camera.");
@@ -98,19 +178,93 @@ main (int argc, char **argv)
 		return EXIT_FAILURE;
 	}
 
-	gv_camera = arv_gv_fake_camera_new_full (arv_option_interface_name, arv_option_serial_number, arv_option_genicam_file);
+	if (arv_option_impairment != NULL) {
+		ArvGvFakeImpairmentSettings settings;
 
-	g_object_set (gv_camera, "gvsp-lost-ratio", arv_option_gvsp_lost_ratio / 1000.0, NULL);
+		if (!arv_gv_fake_impairment_settings_parse (&settings, arv_option_impairment, &error)) {
+			printf ("Invalid impairment profile: %s\n", error->message);
+			g_clear_error (&error);
+			return EXIT_FAILURE;
+		}
+	}
+
+	n_cameras = MAX (arv_option_n_cameras, 1);
 
-	signal (SIGINT, set_cancel);
+	if (n_cameras > 1) {
+		first_address = g_inet_address_new_from_string (arv_option_interface_name != NULL ?
+								arv_option_interface_name :
+								ARV_GV_FAKE_CAMERA_DEFAULT_INTERFACE);
+		if (first_address == NULL ||
+		    g_inet_address_get_family (first_address) != G_SOCKET_FAMILY_IPV4 ||
+		    !g_inet_address_get_is_loopback (first_address)) {
+			printf ("Several fake cameras require a loopback interface address\n");
+			g_clear_object (&first_address);
+			return EXIT_FAILURE;
+		}
+	}
+
+	gv_cameras = g_new0 (ArvGvFakeCamera *, n_cameras);
+
+	for (i = 0; i < n_cameras && status == EXIT_SUCCESS; i++) {
+		char *address;
+		char *serial_number;
+
+		if (n_cameras > 1) {
+			address = _get_camera_address (first_address, i);
+			serial_number = g_strdup_printf ("%s%02u", arv_option_serial_number != NULL ?
+							 arv_option_serial_number : "GV", i + 1);
+		} else {
+			address = g_strdup (arv_option_interface_name);
+			serial_number = g_strdup (arv_option_serial_number);
+		}
+
+		if (n_cameras > 1 && address == NULL) {
+			printf ("Not enough loopback addresses for %u cameras\n", n_cameras);
+			g_free (serial_number);
+			status = EXIT_FAILURE;
+			break;
+		}
+
+		gv_cameras[i] = arv_gv_fake_camera_new_full (address, serial_number, arv_option_genicam_file);
+
+		g_object_set (gv_cameras[i],
+			      "gvsp-lost-ratio", arv_option_gvsp_lost_ratio / 1000.0,
+			      "gvsp-high-rate", arv_option_high_rate,
+			      "gvsp-bit-rate", MAX (arv_option_bit_rate, 0.0) * 1e6,
+			      "gvsp-impairment", arv_option_impairment,
+			      NULL);
+
+		if (!arv_gv_fake_camera_is_running (gv_cameras[i])) {
+			printf ("Failed to start camera%s%s\n", address != NULL ? " on " : "", address != NULL ? address : "");
+			status = EXIT_FAILURE;
+		} else if (arv_option_replay_file != NULL &&
+			   !arv_fake_camera_set_replay (arv_gv_fake_camera_get_fake_camera (gv_cameras[i]),
+							arv_option_replay_file, !arv_option_replay_fast, &error)) {
+			printf ("Failed to load recording: %s\n", error->message);
+			g_clear_error (&error);
+			status = EXIT_FAILURE;
+		}
+
+		g_free (address);
+		g_free (serial_number);
+	}
+
+	if (status == EXIT_SUCCESS) {
+		if (arv_option_n_threads > 0)
+			pool = arv_gv_fake_camera_pool_new (gv_cameras, n_cameras, arv_option_n_threads);
+
+		signal (SIGINT, set_cancel);
 
-	if (arv_gv_fake_camera_is_running (gv_camera))
 		while (!cancel)
 			g_usleep (1000000);
-	else
-		printf ("Failed to start camera\n");
 
-	g_object_unref (gv_camera);
+		arv_gv_fake_camera_pool_free (pool);
+	}
+
+	for (i = 0; i < n_cameras; i++)
+		g_clear_object (&gv_cameras[i]);
+	g_free (gv_cameras);
+	g_clear_object (&first_address);
 
-	return EXIT_SUCCESS;
+	return status;
 }
@@ -31,7 +31,7 @@
 
 #include <arvgcprivate.h>
 #include <arvgcnode.h>
-#include <arvgcpropertynode.h>
+#include <arvgcpropertynodeprivate.h>
 #include <arvgcindexnode.h>
 #include <arvgcvalueindexednode.h>
 #include <arvgcinvalidatornode.h>
@@ -42,7 +42,7 @@
 #include <arvgcenumentry.h>
 #include <arvgcintegernode.h>
 #include <arvgcfloatnode.h>
-#include <arvgcregisternode.h>
+#include <arvgcregisternodeprivate.h>
 #include <arvgcintregnode.h>
 #include <arvgcmaskedintregnode.h>
 #include <arvgcfloatregnode.h>
@@ -58,16 +58,17 @@
 #include <arvgcintswissknifenode.h>
 #include <arvgcconverternode.h>
 #include <arvgcintconverternode.h>
-#include <arvgcport.h>
+#include <arvgcportprivate.h>
 #include <arvbuffer.h>
 #include <arvdebugprivate.h>
-#include <arvdomparser.h>
+#include <arvdomparserprivate.h>
 #include <string.h>
 #include <stdarg.h>
 #include <stdio.h>
 
 typedef struct {
 	GHashTable *nodes;
+	guint nodes_revision;
 	ArvDevice *device;
 	ArvBuffer *buffer;
 
@@ -76,6 +77,9 @@ typedef struct {
 	ArvAccessCheckPolicy access_check_policy;
 
         unsigned n_register_cache_errors;
+
+	guint64 change_count;
+	guint64 n_volatile_reads;
 } ArvGcPrivate;
 
 struct _ArvGc {
@@ -339,10 +343,29 @@ arv_gc_register_feature_node (ArvGc *genicam, ArvGcFeatureNode *node)
 	g_hash_table_remove (genicam->priv->nodes, (char *) name);
 	g_hash_table_insert (genicam->priv->nodes, (char *) name, node);
 
+	genicam->priv->nodes_revision++;
+	genicam->priv->change_count++;
+
 	arv_debug_genicam ("[Gc::register_feature_node] Register node '%s' [%s]", name,
 			 arv_dom_node_get_node_name (ARV_DOM_NODE (node)));
 }
 
+/*
+ * arv_gc_get_nodes_revision:
+ * @genicam: a #ArvGc object
+ *
+ * Returns: a counter incremented each time a node is registered, which allows to detect when the node pointers
+ * retrieved by name become obsolete.
+ */
+
+guint
+arv_gc_get_nodes_revision (ArvGc *genicam)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), 0);
+
+	return genicam->priv->nodes_revision;
+}
+
 void
 arv_gc_set_default_node_data (ArvGc *genicam, const char *node_name, ...)
 {
@@ -372,6 +395,7 @@ arv_gc_set_register_cache_policy (ArvGc *genicam, ArvRegisterCachePolicy policy)
 	g_return_if_fail (ARV_IS_GC (genicam));
 
 	genicam->priv->cache_policy = policy;
+	genicam->priv->change_count++;
 }
 
 ArvRegisterCachePolicy
@@ -434,6 +458,7 @@ arv_gc_set_buffer (ArvGc *genicam, ArvBuffer *buffer)
 	g_object_weak_ref (G_OBJECT (buffer), _weak_notify_cb, genicam);
 
 	genicam->priv->buffer = buffer;
+	genicam->priv->change_count++;
 }
 
 /**
@@ -453,6 +478,304 @@ arv_gc_get_buffer (ArvGc *genicam)
 	return genicam->priv->buffer;
 }
 
+/* Register prefetch */
+
+#define ARV_GC_PREFETCH_SIZE_MAX		512
+/* Larger ranges are read using a memory read */
+#define ARV_GC_PREFETCH_REGISTER_RANGE_MAX	32
+
+typedef struct {
+	ArvGcRegisterNode *node;
+	ArvGcNode *port;
+	gint64 address;
+	gint64 length;
+} ArvGcPrefetchEntry;
+
+/* Registers of the entries from first to last - 1, merged in a contiguous address range */
+typedef struct {
+	guint first;
+	guint last;
+	gint64 address;
+	gint64 end;
+} ArvGcPrefetchRange;
+
+typedef struct {
+	GArray *entries;
+	guint8 *buffer;
+	guint n_registers;
+	guint n_transfers;
+} ArvGcPrefetchData;
+
+static gint
+_prefetch_entry_compare (gconstpointer a, gconstpointer b)
+{
+	const ArvGcPrefetchEntry *entry_a = a;
+	const ArvGcPrefetchEntry *entry_b = b;
+
+	if (entry_a->port != entry_b->port)
+		return entry_a->port < entry_b->port ? -1 : 1;
+	if (entry_a->address != entry_b->address)
+		return entry_a->address < entry_b->address ? -1 : 1;
+
+	return 0;
+}
+
+static void
+_collect_registers (ArvDomNode *node, GHashTable *visited, GArray *entries)
+{
+	ArvDomNode *iter;
+
+	if (node == NULL || g_hash_table_contains (visited, node))
+		return;
+
+	g_hash_table_add (visited, node);
+
+	if (ARV_IS_GC_REGISTER_NODE (node)) {
+		ArvGcPrefetchEntry entry;
+
+		entry.node = ARV_GC_REGISTER_NODE (node);
+		if (arv_gc_register_node_get_prefetch_range (entry.node, &entry.port, &entry.address, &entry.length))
+			g_array_append_val (entries, entry);
+	} else if (ARV_IS_GC_STRUCT_ENTRY_NODE (node)) {
+		_collect_registers (arv_dom_node_get_parent_node (node), visited, entries);
+	}
+
+	for (iter = arv_dom_node_get_first_child (node); iter != NULL; iter = arv_dom_node_get_next_sibling (iter)) {
+		if (ARV_IS_GC_PROPERTY_NODE (iter)) {
+			/* Invalidators point to the nodes modifying the register, not to the register dependencies */
+			if (arv_gc_property_node_get_node_type (ARV_GC_PROPERTY_NODE (iter)) !=
+			    ARV_GC_PROPERTY_NODE_TYPE_P_INVALIDATOR)
+				_collect_registers (ARV_DOM_NODE (arv_gc_property_node_get_linked_node
+								  (ARV_GC_PROPERTY_NODE (iter))),
+						    visited, entries);
+		} else if (ARV_IS_GC_FEATURE_NODE (iter)) {
+			_collect_registers (iter, visited, entries);
+		}
+	}
+}
+
+static void
+_prefetch_set_range_data (ArvGcPrefetchData *data, const ArvGcPrefetchRange *range, const guint8 *range_data)
+{
+	guint i;
+
+	for (i = range->first; i < range->last; i++) {
+		ArvGcPrefetchEntry *entry = &g_array_index (data->entries, ArvGcPrefetchEntry, i);
+
+		arv_gc_register_node_set_prefetched_data (entry->node, entry->address, entry->length,
+							  range_data + (entry->address - range->address));
+		data->n_registers++;
+	}
+}
+
+static void
+_prefetch_read_range (ArvGcPrefetchData *data, const ArvGcPrefetchRange *range)
+{
+	ArvGcPrefetchEntry *first = &g_array_index (data->entries, ArvGcPrefetchEntry, range->first);
+	GError *local_error = NULL;
+
+	arv_gc_port_read (ARV_GC_PORT (first->port), data->buffer, range->address, range->end - range->address,
+			  &local_error);
+	data->n_transfers++;
+
+	if (local_error != NULL) {
+		arv_debug_genicam ("[Gc::prefetch_features] Failed to read 0x%" G_GINT64_MODIFIER "x-0x%"
+				   G_GINT64_MODIFIER "x (%s)", range->address, range->end, local_error->message);
+		g_clear_error (&local_error);
+		return;
+	}
+
+	_prefetch_set_range_data (data, range, data->buffer);
+}
+
+/* Returns G_BIG_ENDIAN if all the registers of the range are big endian */
+
+static guint
+_prefetch_range_endianness (ArvGcPrefetchData *data, const ArvGcPrefetchRange *range)
+{
+	guint i;
+
+	for (i = range->first; i < range->last; i++)
+		if (arv_gc_register_node_get_endianness (g_array_index (data->entries, ArvGcPrefetchEntry, i).node) !=
+		    G_BIG_ENDIAN)
+			return G_LITTLE_ENDIAN;
+
+	return G_BIG_ENDIAN;
+}
+
+/*
+ * Reads the queued small ranges of a port at once, using multi register reads. If the device refuses the command,
+ * for example because one of the addresses is not readable, the ranges are read one by one.
+ */
+
+static void
+_prefetch_read_register_ranges (ArvGcPrefetchData *data, GArray *ranges)
+{
+	ArvGcPrefetchEntry *first;
+	GError *local_error = NULL;
+	GArray *addresses;
+	guint8 *values;
+	gsize offset;
+	guint i;
+
+	if (ranges->len == 0)
+		return;
+
+	if (ranges->len == 1) {
+		_prefetch_read_range (data, &g_array_index (ranges, ArvGcPrefetchRange, 0));
+		g_array_set_size (ranges, 0);
+		return;
+	}
+
+	first = &g_array_index (data->entries, ArvGcPrefetchEntry, g_array_index (ranges, ArvGcPrefetchRange, 0).first);
+
+	addresses = g_array_new (FALSE, FALSE, sizeof (guint64));
+	for (i = 0; i < ranges->len; i++) {
+		ArvGcPrefetchRange *range = &g_array_index (ranges, ArvGcPrefetchRange, i);
+		guint64 address;
+
+		for (address = range->address; address < range->end; address += 4)
+			g_array_append_val (addresses, address);
+	}
+
+	values = g_malloc (addresses->len * sizeof (guint32));
+
+	arv_gc_port_read_registers (ARV_GC_PORT (first->port), values, (const guint64 *) addresses->data,
+				    addresses->len, &local_error);
+	data->n_transfers++;
+
+	if (local_error != NULL) {
+		arv_debug_genicam ("[Gc::prefetch_features] Failed to read %u registers (%s)",
+				   addresses->len, local_error->message);
+		g_clear_error (&local_error);
+
+		for (i = 0; i < ranges->len; i++)
+			_prefetch_read_range (data, &g_array_index (ranges, ArvGcPrefetchRange, i));
+	} else {
+		for (i = 0, offset = 0; i < ranges->len; i++) {
+			ArvGcPrefetchRange *range = &g_array_index (ranges, ArvGcPrefetchRange, i);
+
+			_prefetch_set_range_data (data, range, values + offset);
+			offset += range->end - range->address;
+		}
+	}
+
+	g_free (values);
+	g_array_unref (addresses);
+	g_array_set_size (ranges, 0);
+}
+
+/**
+ * arv_gc_prefetch_features:
+ * @genicam: a #ArvGc object
+ * @features: (array length=n_features): a list of feature names
+ * @n_features: number of features
+ *
+ * Fills the register cache of the given features and of all the features they depend on, using as few port
+ * transfers as possible. Registers located in contiguous address ranges are read by a single transfer. On GigEVision
+ * devices, the small 32 bit aligned ranges of big endian registers are also gathered in multi register reads. For a
+ * category, the registers of all the features of the category tree are prefetched.
+ *
+ * This is only an optimization for the subsequent feature reads, which will be served from the register cache.
+ * Unknown features, non cachable registers and registers which can not be read by a coalesced transfer are
+ * ignored, they will be read as usual on access. Nothing is done if the register cache is disabled.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_gc_prefetch_features (ArvGc *genicam, const char **features, guint n_features)
+{
+	ArvGcPrefetchData data;
+	GHashTable *visited;
+	GArray *entries;
+	GArray *register_ranges;
+	ArvGcNode *port = NULL;
+	guint i, j;
+
+	g_return_if_fail (ARV_IS_GC (genicam));
+	g_return_if_fail (features != NULL || n_features == 0);
+
+	if (genicam->priv->cache_policy == ARV_REGISTER_CACHE_POLICY_DISABLE)
+		return;
+
+	visited = g_hash_table_new (g_direct_hash, g_direct_equal);
+	entries = g_array_new (FALSE, FALSE, sizeof (ArvGcPrefetchEntry));
+
+	for (i = 0; i < n_features; i++) {
+		ArvGcNode *node;
+
+		node = arv_gc_get_node (genicam, features[i]);
+		if (node == NULL)
+			arv_debug_genicam ("[Gc::prefetch_features] Unknown feature '%s'", features[i]);
+		else
+			_collect_registers (ARV_DOM_NODE (node), visited, entries);
+	}
+
+	g_array_sort (entries, _prefetch_entry_compare);
+
+	data.entries = entries;
+	data.buffer = g_malloc (ARV_GC_PREFETCH_SIZE_MAX);
+	data.n_registers = 0;
+	data.n_transfers = 0;
+
+	register_ranges = g_array_new (FALSE, FALSE, sizeof (ArvGcPrefetchRange));
+
+	for (i = 0; i < entries->len; i = j) {
+		ArvGcPrefetchEntry *first = &g_array_index (entries, ArvGcPrefetchEntry, i);
+		ArvGcPrefetchRange range;
+		gint64 end = first->address + first->length;
+
+		if (first->length > ARV_GC_PREFETCH_SIZE_MAX) {
+			j = i + 1;
+			continue;
+		}
+
+		/* Merge the following registers of the same port, as long as they are contiguous or overlapping */
+		for (j = i + 1; j < entries->len; j++) {
+			ArvGcPrefetchEntry *entry = &g_array_index (entries, ArvGcPrefetchEntry, j);
+			gint64 entry_end = entry->address + entry->length;
+
+			if (entry->port != first->port ||
+			    entry->address > end ||
+			    MAX (end, entry_end) - first->address > ARV_GC_PREFETCH_SIZE_MAX)
+				break;
+
+			end = MAX (end, entry_end);
+		}
+
+		range.first = i;
+		range.last = j;
+		range.address = first->address;
+		range.end = end;
+
+		if (first->port != port) {
+			_prefetch_read_register_ranges (&data, register_ranges);
+			port = first->port;
+		}
+
+		if ((range.address & 0x3) == 0 && (range.end & 0x3) == 0 &&
+		    range.end - range.address <= ARV_GC_PREFETCH_REGISTER_RANGE_MAX &&
+		    arv_gc_port_has_register_reads (ARV_GC_PORT (port), _prefetch_range_endianness (&data, &range)))
+			g_array_append_val (register_ranges, range);
+		else
+			_prefetch_read_range (&data, &range);
+	}
+
+	_prefetch_read_register_ranges (&data, register_ranges);
+
+	arv_info_genicam ("[Gc::prefetch_features] %u registers prefetched using %u transfers",
+			  data.n_registers, data.n_transfers);
+
+	/* The computed nodes must be evaluated again using the new register values */
+	genicam->priv->change_count++;
+
+	g_free (data.buffer);
+	g_array_unref (register_ranges);
+	g_array_unref (entries);
+	g_hash_table_unref (visited);
+}
+
 guint64
 arv_gc_register_cache_error_add (ArvGc *genicam, guint64 n_errors)
 {
@@ -463,6 +786,116 @@ arv_gc_register_cache_error_add (ArvGc *genicam, guint64 n_errors)
         return genicam->priv->n_register_cache_errors;
 }
 
+/*
+ * Computed node value cache
+ *
+ * The value of a computed node (SwissKnife, Converter) can be reused as long as none of the nodes of its dependency
+ * tree has changed. Instead of walking this tree, a genicam wide change counter is incremented each time a feature
+ * value is written, or the document or the register cache policy is modified. A computed value is only kept if no
+ * volatile register was read during its evaluation, that is a register which value will not be served from the
+ * register cache the next time it is read.
+ */
+
+void
+arv_gc_increment_change_count (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	genicam->priv->change_count++;
+}
+
+void
+arv_gc_volatile_read_add (ArvGc *genicam)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+
+	genicam->priv->n_volatile_reads++;
+}
+
+gboolean
+arv_gc_value_cache_lookup (ArvGc *genicam, ArvGcValueCache *cache)
+{
+	g_return_val_if_fail (ARV_IS_GC (genicam), FALSE);
+	g_return_val_if_fail (cache != NULL, FALSE);
+
+	return cache->is_valid && cache->change_count == genicam->priv->change_count;
+}
+
+void
+arv_gc_value_cache_begin (ArvGc *genicam, ArvGcValueCache *cache)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+	g_return_if_fail (cache != NULL);
+
+	cache->is_valid = FALSE;
+	cache->change_count = genicam->priv->change_count;
+	cache->n_volatile_reads = genicam->priv->n_volatile_reads;
+}
+
+static gboolean
+_value_cache_end (ArvGc *genicam, ArvGcValueCache *cache)
+{
+	cache->is_valid = (cache->change_count == genicam->priv->change_count &&
+			   cache->n_volatile_reads == genicam->priv->n_volatile_reads);
+
+	return cache->is_valid;
+}
+
+void
+arv_gc_value_cache_set_int64 (ArvGc *genicam, ArvGcValueCache *cache, gint64 value)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+	g_return_if_fail (cache != NULL);
+
+	if (_value_cache_end (genicam, cache))
+		cache->v_int64 = value;
+}
+
+void
+arv_gc_value_cache_set_double (ArvGc *genicam, ArvGcValueCache *cache, double value)
+{
+	g_return_if_fail (ARV_IS_GC (genicam));
+	g_return_if_fail (cache != NULL);
+
+	if (_value_cache_end (genicam, cache))
+		cache->v_double = value;
+}
+
+static guint
+_check_links (ArvDomNode *node)
+{
+	ArvDomNode *iter;
+	guint n_errors = 0;
+
+	for (iter = arv_dom_node_get_first_child (node); iter != NULL; iter = arv_dom_node_get_next_sibling (iter)) {
+		if (ARV_IS_GC_PROPERTY_NODE (iter)) {
+			GError *error = NULL;
+
+			if (!arv_gc_property_node_check_link (ARV_GC_PROPERTY_NODE (iter), &error)) {
+				arv_warning_genicam ("[Gc::check_links] %s", error->message);
+				g_clear_error (&error);
+				n_errors++;
+			}
+		} else
+			n_errors += _check_links (iter);
+	}
+
+	return n_errors;
+}
+
+/* Resolve all the node pointers once the document is complete, which reports the dangling ones up front and saves
+ * the name lookups at runtime. */
+
+static void
+_resolve_links (ArvGc *genicam)
+{
+	guint n_errors;
+
+	n_errors = _check_links (ARV_DOM_NODE (genicam));
+	if (n_errors > 0)
+		arv_info_genicam ("[Gc::resolve_links] %u unresolved node pointers", n_errors);
+}
+
 ArvGc *
 arv_gc_new (ArvDevice *device, const void *xml, size_t size)
 {
@@ -479,6 +912,171 @@ arv_gc_new (ArvDevice *device, const void *xml, size_t size)
 	genicam = ARV_GC (document);
 	genicam->priv->device = device;
 
+	_resolve_links (genicam);
+
+	return genicam;
+}
+
+static ArvGc *
+_document_to_genicam (ArvDevice *device, ArvDomDocument *document, GError **error)
+{
+	ArvGc *genicam;
+
+	if (!ARV_IS_GC (document)) {
+		if (document != NULL) {
+			g_object_unref (document);
+			g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_INVALID_SYNTAX, "Not a Genicam document");
+		}
+		return NULL;
+	}
+
+	genicam = ARV_GC (document);
+	genicam->priv->device = device;
+
+	_resolve_links (genicam);
+
+	return genicam;
+}
+
+/*
+ * arv_gc_new_from_document:
+ * @device: a #ArvDevice
+ * @document: (transfer full): a parsed Genicam document
+ *
+ * Wraps a document built by a #ArvDomPushParser.
+ *
+ * Returns: (transfer full): a new #ArvGc, %NULL if @document is not a Genicam document.
+ */
+
+ArvGc *
+arv_gc_new_from_document (ArvDevice *device, ArvDomDocument *document, GError **error)
+{
+	return _document_to_genicam (device, document, error);
+}
+
+/*
+ * arv_gc_new_and_compile:
+ * @device: a #ArvDevice
+ * @xml: Genicam xml data
+ * @size: size of @xml, in bytes
+ * @compiled: (out): placeholder for the compiled Genicam data
+ *
+ * Same as arv_gc_new(), but also returns the compiled form of the Genicam data, as returned by arv_gc_compile().
+ */
+
+ArvGc *
+arv_gc_new_and_compile (ArvDevice *device, const void *xml, size_t size, GBytes **compiled)
+{
+	ArvGc *genicam;
+
+	g_return_val_if_fail (compiled != NULL, NULL);
+
+	genicam = _document_to_genicam (device, arv_dom_document_new_from_memory_compiled (xml, size, compiled, NULL),
+					 NULL);
+	if (genicam == NULL)
+		g_clear_pointer (compiled, g_bytes_unref);
+
+	return genicam;
+}
+
+/*
+ * arv_gc_compile:
+ * @xml: (array length=size) (element-type guint8): Genicam xml data
+ * @size: size of @xml, in bytes
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Compiles Genicam xml data to the binary form stored in the Genicam cache, which can be loaded by
+ * arv_gc_new_from_compiled(). It records the parser events that built the node tree, with interned strings, and
+ * without any text or element ignored by the #ArvGc document. It is not portable across Aravis versions.
+ *
+ * Returns: (transfer full): the compiled Genicam data, %NULL on error.
+ */
+
+GBytes *
+arv_gc_compile (const void *xml, size_t size, GError **error)
+{
+	GBytes *compiled = NULL;
+	ArvGc *genicam;
+
+	g_return_val_if_fail (xml != NULL, NULL);
+
+	genicam = _document_to_genicam (NULL, arv_dom_document_new_from_memory_compiled (xml, size, &compiled,
+											    error), error);
+	if (genicam == NULL) {
+		g_clear_pointer (&compiled, g_bytes_unref);
+		return NULL;
+	}
+
+	g_object_unref (genicam);
+
+	return compiled;
+}
+
+/*
+ * arv_gc_new_from_compiled:
+ * @device: a #ArvDevice
+ * @data: (array length=size) (element-type guint8): compiled Genicam data
+ * @size: size of @data, in bytes
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Instantiates a Genicam document from data produced by arv_gc_compile(). The result is identical to the document
+ * returned by arv_gc_new() for the original xml data.
+ *
+ * Returns: (transfer full): a new #ArvGc, %NULL on error.
+ */
+
+ArvGc *
+arv_gc_new_from_compiled (ArvDevice *device, const void *data, size_t size, GError **error)
+{
+	GError *local_error = NULL;
+	ArvGc *genicam;
+
+	g_return_val_if_fail (data != NULL, NULL);
+
+	genicam = _document_to_genicam (device, arv_dom_document_new_from_compiled (data, size, &local_error),
+					 &local_error);
+	if (local_error != NULL)
+		g_propagate_error (error, local_error);
+
+	return genicam;
+}
+
+/*
+ * arv_gc_new_from_compiled_file:
+ * @device: a #ArvDevice
+ * @filename: path to a file produced by arv_gc_compile()
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Same as arv_gc_new_from_compiled(), for compiled data stored in a file. The file is memory mapped.
+ *
+ * Returns: (transfer full): a new #ArvGc, %NULL on error.
+ */
+
+ArvGc *
+arv_gc_new_from_compiled_file (ArvDevice *device, const char *filename, GError **error)
+{
+	GMappedFile *mapped_file;
+	ArvGc *genicam;
+
+	g_return_val_if_fail (filename != NULL, NULL);
+
+	mapped_file = g_mapped_file_new (filename, FALSE, error);
+	if (mapped_file == NULL)
+		return NULL;
+
+	if (g_mapped_file_get_contents (mapped_file) == NULL) {
+		g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_INVALID_SYNTAX, "Empty compiled Genicam file");
+		g_mapped_file_unref (mapped_file);
+		return NULL;
+	}
+
+	genicam = arv_gc_new_from_compiled (device,
+					    g_mapped_file_get_contents (mapped_file),
+					    g_mapped_file_get_length (mapped_file),
+					    error);
+
+	g_mapped_file_unref (mapped_file);
+
 	return genicam;
 }
 
@@ -32,6 +32,7 @@
 #include <arvgcfloat.h>
 #include <arvgcdefaultsprivate.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdebugprivate.h>
 #include <string.h>
 
@@ -52,6 +53,10 @@ typedef struct {
 
 	ArvEvaluator *formula_to;
 	ArvEvaluator *formula_from;
+	gboolean is_formula_to_set;
+	gboolean is_formula_from_set;
+
+	ArvGcValueCache caches[ARV_GC_CONVERTER_NODE_TYPE_INC + 1];	/* indexed by ArvGcConverterNodeType */
 } ArvGcConverterPrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcConverter, arv_gc_converter, ARV_TYPE_GC_FEATURE_NODE,
@@ -199,17 +204,20 @@ arv_gc_converter_get_is_linear (ArvGcConverter *gc_converter, GError **error)
 	return ARV_GC_IS_LINEAR_NO;
 }
 
+/* Formulas, sub-expressions and constants are static, they are only set once, in order to let the evaluators keep
+ * their compiled programs. */
+
 static gboolean
-arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+_update_formula (ArvGcConverter *gc_converter, ArvEvaluator *evaluator, ArvGcPropertyNode *formula_node,
+		 GError **error)
 {
 	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
-	ArvGcNode *node = NULL;
 	GError *local_error = NULL;
 	GSList *iter;
 	const char *expression;
 
-	if (priv->formula_from_node != NULL)
-		expression = arv_gc_property_node_get_string (priv->formula_from_node, &local_error);
+	if (formula_node != NULL)
+		expression = arv_gc_property_node_get_string (formula_node, &local_error);
 	else
 		expression = "";
 
@@ -218,7 +226,7 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 		return FALSE;
 	}
 
-	arv_evaluator_set_expression (priv->formula_from, expression);
+	arv_evaluator_set_expression (evaluator, expression);
 
 	for (iter = priv->expressions; iter != NULL; iter = iter->next) {
 		const char *expression;
@@ -232,7 +240,7 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 
 		name = arv_gc_property_node_get_name (iter->data);
 
-		arv_evaluator_set_sub_expression (priv->formula_from, name, expression);
+		arv_evaluator_set_sub_expression (evaluator, name, expression);
 	}
 
 	for (iter = priv->constants; iter != NULL; iter = iter->next) {
@@ -247,7 +255,24 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 
 		name = arv_gc_property_node_get_name (iter->data);
 
-		arv_evaluator_set_constant (priv->formula_from, name, constant);
+		arv_evaluator_set_constant (evaluator, name, constant);
+	}
+
+	return TRUE;
+}
+
+static gboolean
+arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+{
+	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
+	ArvGcNode *node = NULL;
+	GError *local_error = NULL;
+	GSList *iter;
+
+	if (!priv->is_formula_from_set) {
+		if (!_update_formula (gc_converter, priv->formula_from, priv->formula_from_node, error))
+			return FALSE;
+		priv->is_formula_from_set = TRUE;
 	}
 
 	for (iter = priv->variables; iter != NULL; iter = iter->next) {
@@ -366,20 +391,56 @@ arv_gc_converter_update_from_variables (ArvGcConverter *gc_converter, ArvGcConve
 	return TRUE;
 }
 
-double
-arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+static double
+_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, gboolean *is_default, GError **error)
 {
 	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
+	ArvGcValueCache *cache = &priv->caches[node_type];
 	GError *local_error = NULL;
+	ArvGc *genicam;
         double value;
 
-	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0.0);
+	*is_default = FALSE;
+
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (gc_converter));
+	if (arv_gc_value_cache_lookup (genicam, cache))
+		return cache->v_double;
+
+	arv_gc_value_cache_begin (genicam, cache);
 
 	if (!arv_gc_converter_update_from_variables (gc_converter, node_type, &local_error)) {
 		if (local_error != NULL)
                         g_propagate_prefixed_error (error, local_error, "[%s] ",
                                                     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_converter)));
 
+		*is_default = TRUE;
+		return 0.0;
+	}
+
+	value = arv_evaluator_evaluate_as_double (priv->formula_from, &local_error);
+
+        if (local_error != NULL) {
+                g_propagate_prefixed_error (error, local_error, "[%s] ",
+                                            arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_converter)));
+		return value;
+	}
+
+	arv_gc_value_cache_set_double (genicam, cache, value);
+
+        return value;
+}
+
+double
+arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
+{
+	gboolean is_default;
+        double value;
+
+	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0.0);
+
+	value = _convert_to_double (gc_converter, node_type, &is_default, error);
+
+	if (is_default) {
 		switch (node_type) {
 			case ARV_GC_CONVERTER_NODE_TYPE_MIN:
 				return -G_MAXDOUBLE;
@@ -390,29 +451,20 @@ arv_gc_converter_convert_to_double (ArvGcConverter *gc_converter, ArvGcConverter
 		}
 	}
 
-	value = arv_evaluator_evaluate_as_double (priv->formula_from, &local_error);
-
-        if (local_error != NULL)
-                g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                            arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_converter)));
-
         return value;
 }
 
 gint64
 arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterNodeType node_type, GError **error)
 {
-	ArvGcConverterPrivate *priv = arv_gc_converter_get_instance_private (gc_converter);
-	GError *local_error = NULL;
-        gint64 value;
+	gboolean is_default;
+        double value;
 
 	g_return_val_if_fail (ARV_IS_GC_CONVERTER (gc_converter), 0);
 
-	if (!arv_gc_converter_update_from_variables (gc_converter, node_type, &local_error)) {
-		if (local_error != NULL)
-                        g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                                    arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_converter)));
+	value = _convert_to_double (gc_converter, node_type, &is_default, error);
 
+	if (is_default) {
 		switch (node_type) {
 			case ARV_GC_CONVERTER_NODE_TYPE_MIN:
 				return G_MININT64;
@@ -423,12 +475,6 @@ arv_gc_converter_convert_to_int64 (ArvGcConverter *gc_converter, ArvGcConverterN
 		}
 	}
 
-	value = arv_evaluator_evaluate_as_double (priv->formula_from, &local_error);
-
-        if (local_error != NULL)
-                g_propagate_prefixed_error (error, local_error, "[%s] ",
-                                            arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (gc_converter)));
-
         return value;
 }
 
@@ -439,48 +485,11 @@ arv_gc_converter_update_to_variables (ArvGcConverter *gc_converter, GError **err
 	ArvGcNode *node;
 	GError *local_error = NULL;
 	GSList *iter;
-	const char *expression;
-
-	if (priv->formula_to_node != NULL)
-		expression = arv_gc_property_node_get_string (priv->formula_to_node, &local_error);
-	else
-		expression = "";
-
-	if (local_error != NULL) {
-                g_propagate_error (error, local_error);
-		return;
-	}
-
-	arv_evaluator_set_expression (priv->formula_to, expression);
 
-	for (iter = priv->expressions; iter != NULL; iter = iter->next) {
-		const char *expression;
-		const char *name;
-
-		expression = arv_gc_property_node_get_string (ARV_GC_PROPERTY_NODE (iter->data), &local_error);
-		if (local_error != NULL) {
-			g_propagate_error (error, local_error);
+	if (!priv->is_formula_to_set) {
+		if (!_update_formula (gc_converter, priv->formula_to, priv->formula_to_node, error))
 			return;
-		}
-
-		name = arv_gc_property_node_get_name (iter->data);
-
-		arv_evaluator_set_sub_expression (priv->formula_to, name, expression);
-	}
-
-	for (iter = priv->constants; iter != NULL; iter = iter->next) {
-		const char *constant;
-		const char *name;
-
-		constant = arv_gc_property_node_get_string (ARV_GC_PROPERTY_NODE (iter->data), &local_error);
-		if (local_error != NULL) {
-			g_propagate_error (error, local_error);
-			return;
-		}
-
-		name = arv_gc_property_node_get_name (iter->data);
-
-		arv_evaluator_set_constant (priv->formula_to, name, constant);
+		priv->is_formula_to_set = TRUE;
 	}
 
 	for (iter = priv->variables; iter != NULL; iter = iter->next) {
@@ -31,6 +31,7 @@
 #include <arvgcfeaturenodeprivate.h>
 #include <arvgcpropertynode.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvgcboolean.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
@@ -568,10 +569,16 @@ void
 arv_gc_feature_node_increment_change_count (ArvGcFeatureNode *self)
 {
 	ArvGcFeatureNodePrivate *priv = arv_gc_feature_node_get_instance_private (self);
+	ArvGc *genicam;
 
 	g_return_if_fail (ARV_IS_GC_FEATURE_NODE (self));
 
 	priv->change_count++;
+
+	/* Invalidate the values of the computed nodes */
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+	if (ARV_IS_GC (genicam))
+		arv_gc_increment_change_count (genicam);
 }
 
 guint64
@@ -25,10 +25,11 @@
  * @short_description: Class for Port nodes
  */
 
-#include <arvgcport.h>
+#include <arvgcportprivate.h>
 #include <arvgcregisterdescriptionnode.h>
 #include <arvgcfeaturenodeprivate.h>
 #include <arvdevice.h>
+#include <arvdeviceprivate.h>
 #include <arvgvdevice.h>
 #include <arvchunkparserprivate.h>
 #include <arvbuffer.h>
@@ -229,6 +230,26 @@ arv_gc_port_read (ArvGcPort *port, void *buffer, guint64 address, guint64 length
 
 void
 arv_gc_port_write (ArvGcPort *port, void *buffer, guint64 address, guint64 length, GError **error)
+{
+	arv_gc_port_write_full (port, buffer, address, length, 0, error);
+}
+
+/*
+ * arv_gc_port_write_full:
+ * @port: a #ArvGcPort
+ * @buffer: data to write
+ * @address: register address
+ * @length: data length
+ * @endianness: byte order of the written register, G_BIG_ENDIAN or G_LITTLE_ENDIAN, 0 if unknown
+ * @error: a #GError placeholder
+ *
+ * Same as arv_gc_port_write(). Inside a batch, the writes of 32 bit big endian registers of GigEVision devices use
+ * register commands, which can be sent along other register writes.
+ */
+
+void
+arv_gc_port_write_full (ArvGcPort *port, void *buffer, guint64 address, guint64 length, guint endianness,
+			GError **error)
 {
 	ArvGc *genicam;
 	ArvDevice *device;
@@ -283,6 +304,17 @@ arv_gc_port_write (ArvGcPort *port, void *buffer, guint64 address, guint64 lengt
 				value = *((guint32 *) buffer);
 				value = GUINT32_FROM_BE (value);
 
+				arv_device_write_register (device, address, value, error);
+			} else if (ARV_IS_GV_DEVICE (device) && endianness == G_BIG_ENDIAN &&
+				   length == 4 && (address & 0x3) == 0 &&
+				   arv_device_is_batch_active (device)) {
+				guint32 value;
+
+				/* Inside a batch, use a register write, which can be sent along other register writes.
+				 * The register is declared big endian, as the register commands data. */
+				value = *((guint32 *) buffer);
+				value = GUINT32_FROM_BE (value);
+
 				arv_device_write_register (device, address, value, error);
 			} else
 				arv_device_write_memory (device, address, length, buffer, error);
@@ -294,6 +326,68 @@ arv_gc_port_write (ArvGcPort *port, void *buffer, guint64 address, guint64 lengt
 	}
 }
 
+/*
+ * arv_gc_port_has_register_reads:
+ * @port: a #ArvGcPort
+ * @endianness: byte order of the registers, G_BIG_ENDIAN or G_LITTLE_ENDIAN
+ *
+ * Returns: %TRUE if several 32 bit registers of @port can be read by a single multi register command. This is only
+ * the case for the device port of GigEVision devices, either for big endian registers, or if the port uses the legacy
+ * endianness mechanism, for which all registers are big endian.
+ */
+
+gboolean
+arv_gc_port_has_register_reads (ArvGcPort *port, guint endianness)
+{
+	g_return_val_if_fail (ARV_IS_GC_PORT (port), FALSE);
+
+	return port->priv->chunk_id == NULL &&
+		port->priv->event_id == NULL &&
+		ARV_IS_GV_DEVICE (arv_gc_get_device (arv_gc_node_get_genicam (ARV_GC_NODE (port)))) &&
+		(endianness == G_BIG_ENDIAN || _use_legacy_endianness_mechanism (port, 4));
+}
+
+/*
+ * arv_gc_port_read_registers:
+ * @port: a #ArvGcPort
+ * @buffer: a 32 bit aligned buffer of @n_registers * 4 bytes
+ * @addresses: (array length=n_registers): register addresses
+ * @n_registers: number of registers
+ * @error: a #GError placeholder
+ *
+ * Reads the 32 bit registers at @addresses, using multi register commands, see arv_device_read_registers(). The
+ * register contents are stored in @buffer in big endian byte order, which is the device memory layout only for the
+ * registers accepted by arv_gc_port_has_register_reads().
+ */
+
+void
+arv_gc_port_read_registers (ArvGcPort *port, void *buffer, const guint64 *addresses, guint n_registers,
+			    GError **error)
+{
+	ArvDevice *device;
+	guint32 *values = buffer;
+	guint i;
+
+	g_return_if_fail (ARV_IS_GC_PORT (port));
+	g_return_if_fail (buffer != NULL);
+	g_return_if_fail (addresses != NULL || n_registers == 0);
+
+	device = arv_gc_get_device (arv_gc_node_get_genicam (ARV_GC_NODE (port)));
+	if (!ARV_IS_DEVICE (device)) {
+		g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_NO_DEVICE_SET,
+			     "[%s] No device set",
+			     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (port)));
+		return;
+	}
+
+	if (!arv_device_read_registers (device, addresses, values, n_registers, error))
+		return;
+
+	/* Register commands data is big endian */
+	for (i = 0; i < n_registers; i++)
+		values[i] = GUINT32_TO_BE (values[i]);
+}
+
 ArvGcNode *
 arv_gc_port_new (void)
 {
@@ -27,4 +27,37 @@
 
 ARV_API guint64            arv_gc_register_cache_error_add         (ArvGc *genicam, guint64 n_errors);
 
+/* Compiled form of the Genicam data, used by the Genicam cache */
+
+ARV_API ArvGc *            arv_gc_new_from_compiled                (ArvDevice *device, const void *data, size_t size,
+                                                                    GError **error);
+ARV_API ArvGc *            arv_gc_new_from_compiled_file           (ArvDevice *device, const char *filename,
+                                                                    GError **error);
+ARV_API GBytes *           arv_gc_compile                          (const void *xml, size_t size, GError **error);
+
+ArvGc *                    arv_gc_new_and_compile                  (ArvDevice *device, const void *xml, size_t size,
+                                                                    GBytes **compiled);
+ArvGc *                    arv_gc_new_from_document                (ArvDevice *device, ArvDomDocument *document,
+                                                                    GError **error);
+
+guint                      arv_gc_get_nodes_revision               (ArvGc *genicam);
+
+typedef struct {
+	gboolean is_valid;
+	guint64 change_count;
+	guint64 n_volatile_reads;
+	union {
+		gint64 v_int64;
+		double v_double;
+	};
+} ArvGcValueCache;
+
+void                       arv_gc_increment_change_count           (ArvGc *genicam);
+void                       arv_gc_volatile_read_add                (ArvGc *genicam);
+
+gboolean                   arv_gc_value_cache_lookup               (ArvGc *genicam, ArvGcValueCache *cache);
+void                       arv_gc_value_cache_begin                (ArvGc *genicam, ArvGcValueCache *cache);
+void                       arv_gc_value_cache_set_int64            (ArvGc *genicam, ArvGcValueCache *cache, gint64 value);
+void                       arv_gc_value_cache_set_double           (ArvGc *genicam, ArvGcValueCache *cache, double value);
+
 #endif
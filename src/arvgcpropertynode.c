@@ -28,13 +28,13 @@
  * types of Genicam property nodes (Value, pValue, Endianness...).
  */
 
-#include <arvgcpropertynode.h>
+#include <arvgcpropertynodeprivate.h>
 #include <arvgcfeaturenode.h>
 #include <arvgcinteger.h>
 #include <arvgcfloat.h>
 #include <arvgcboolean.h>
 #include <arvgcstring.h>
-#include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdomtext.h>
 #include <arvmiscprivate.h>
 #include <arvdebugprivate.h>
@@ -55,6 +55,19 @@ typedef struct {
 
 	gboolean value_data_up_to_date;
 	char *value_data;
+
+	/* Typed caches of value_data, for literal values */
+	gboolean v_int64_up_to_date;
+	guint v_int64_base;
+	gint64 v_int64;
+	gboolean v_double_up_to_date;
+	double v_double;
+
+	/* Node pointed to by value_data, for pointer properties. It is resolved again when the node table of the
+	 * document changes. */
+	gboolean linked_node_up_to_date;
+	guint linked_node_revision;
+	ArvDomNode *linked_node;
 } ArvGcPropertyNodePrivate;
 
 G_DEFINE_TYPE_WITH_CODE (ArvGcPropertyNode, arv_gc_property_node, ARV_TYPE_GC_NODE, G_ADD_PRIVATE (ArvGcPropertyNode))
@@ -182,12 +195,21 @@ _can_append_child (ArvDomNode *self, ArvDomNode *child)
 	return ARV_IS_DOM_TEXT (child);
 }
 
+static void
+_invalidate_value_caches (ArvGcPropertyNodePrivate *priv)
+{
+	priv->v_int64_up_to_date = FALSE;
+	priv->v_double_up_to_date = FALSE;
+	priv->linked_node_up_to_date = FALSE;
+}
+
 static void
 _post_new_child (ArvDomNode *parent, ArvDomNode *child)
 {
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (ARV_GC_PROPERTY_NODE (parent));
 
 	priv->value_data_up_to_date = FALSE;
+	_invalidate_value_caches (priv);
 }
 
 static void
@@ -196,6 +218,7 @@ _pre_remove_child (ArvDomNode *parent, ArvDomNode *child)
 	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (ARV_GC_PROPERTY_NODE (parent));
 
 	priv->value_data_up_to_date = FALSE;
+	_invalidate_value_caches (priv);
 }
 
 /* ArvDomElement implementation */
@@ -268,23 +291,65 @@ _set_value_data (ArvGcPropertyNode *property_node, const char *data)
 	g_free (priv->value_data);
 	priv->value_data = g_strdup (data);
 	priv->value_data_up_to_date = TRUE;
+	_invalidate_value_caches (priv);
+}
+
+static gint64
+_get_int64_value (ArvGcPropertyNode *property_node, guint base)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+
+	if (!priv->v_int64_up_to_date || priv->v_int64_base != base) {
+		priv->v_int64 = g_ascii_strtoll (_get_value_data (property_node), NULL, base);
+		priv->v_int64_base = base;
+		priv->v_int64_up_to_date = TRUE;
+	}
+
+	return priv->v_int64;
+}
+
+static double
+_get_double_value (ArvGcPropertyNode *property_node)
+{
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
+
+	if (!priv->v_double_up_to_date) {
+		priv->v_double = g_ascii_strtod (_get_value_data (property_node), NULL);
+		priv->v_double_up_to_date = TRUE;
+	}
+
+	return priv->v_double;
 }
 
 static ArvDomNode *
-_get_pvalue_node (ArvGcPropertyNode *property_node)
+_get_linked_node (ArvGcPropertyNode *property_node)
 {
-	ArvDomNode *pvalue_node;
-	const char *node_name;
+	ArvGcPropertyNodePrivate *priv = arv_gc_property_node_get_instance_private (property_node);
 	ArvGc *genicam;
+	guint revision;
 
-	if (arv_gc_property_node_get_node_type (property_node) < ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (property_node));
+	if (genicam == NULL)
 		return NULL;
 
-	node_name = _get_value_data (property_node);
-	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (property_node));
-	pvalue_node = ARV_DOM_NODE (arv_gc_get_node (genicam, node_name));
+	revision = arv_gc_get_nodes_revision (genicam);
 
-	return pvalue_node;
+	if (!priv->linked_node_up_to_date || priv->linked_node_revision != revision) {
+		priv->linked_node = ARV_DOM_NODE (arv_gc_get_node (genicam, _get_value_data (property_node)));
+		priv->linked_node_revision = revision;
+		priv->linked_node_up_to_date = TRUE;
+	}
+
+	return priv->linked_node;
+}
+
+static ArvDomNode *
+_get_pvalue_node (ArvGcPropertyNode *property_node)
+{
+	if (arv_gc_property_node_get_node_type (property_node) < ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
+		return NULL;
+
+	return _get_linked_node (property_node);
 }
 
 /**
@@ -375,7 +440,7 @@ arv_gc_property_node_get_int64 (ArvGcPropertyNode *node, GError **error)
 
 	pvalue_node = _get_pvalue_node (node);
 	if (pvalue_node == NULL)
-		return g_ascii_strtoll (_get_value_data (node), NULL, 0);
+		return _get_int64_value (node, 0);
 
 	if (ARV_IS_GC_INTEGER (pvalue_node)) {
 		return arv_gc_integer_get_value (ARV_GC_INTEGER (pvalue_node), error);
@@ -431,7 +496,7 @@ arv_gc_property_node_get_double (ArvGcPropertyNode *node, GError **error)
 
 	pvalue_node = _get_pvalue_node (node);
 	if (pvalue_node == NULL)
-		return g_ascii_strtod (_get_value_data (node), NULL);
+		return _get_double_value (node);
 
 
 	if (ARV_IS_GC_FLOAT (pvalue_node)) {
@@ -495,15 +560,45 @@ arv_gc_property_node_get_node_type (ArvGcPropertyNode *node)
 ArvGcNode *
 arv_gc_property_node_get_linked_node (ArvGcPropertyNode *node)
 {
-	ArvGc *genicam;
-
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (node), NULL);
 
 	if (arv_gc_property_node_get_node_type (node) <= ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW)
 		return NULL;
 
-	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (node));
-	return arv_gc_get_node (genicam, _get_value_data (node));
+	return ARV_GC_NODE (_get_linked_node (node));
+}
+
+/*
+ * arv_gc_property_node_check_link:
+ * @node: a #ArvGcPropertyNode
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Resolves the node pointed to by a pointer property, and keeps it for the subsequent accesses.
+ *
+ * Returns: %FALSE if @node is a pointer property and the pointed node does not exist.
+ */
+
+gboolean
+arv_gc_property_node_check_link (ArvGcPropertyNode *node, GError **error)
+{
+	ArvDomNode *parent;
+
+	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (node), FALSE);
+
+	if (arv_gc_property_node_get_node_type (node) <= ARV_GC_PROPERTY_NODE_TYPE_P_UNKNONW ||
+	    _get_linked_node (node) != NULL)
+		return TRUE;
+
+	parent = arv_dom_node_get_parent_node (ARV_DOM_NODE (node));
+
+	g_set_error (error, ARV_GC_ERROR, ARV_GC_ERROR_NODE_NOT_FOUND,
+		     "[%s] %s node '%s' not found",
+		     ARV_IS_GC_FEATURE_NODE (parent) ?
+		     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (parent)) : "",
+		     arv_dom_node_get_node_name (ARV_DOM_NODE (node)),
+		     _get_value_data (node));
+
+	return FALSE;
 }
 
 static ArvGcNode *
@@ -725,7 +820,7 @@ arv_gc_property_node_get_display_precision (ArvGcPropertyNode *self, gint64 defa
 	g_return_val_if_fail (ARV_IS_GC_PROPERTY_NODE (self), default_value);
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_DISPLAY_PRECISION, default_value);
 
-	return g_ascii_strtoll (_get_value_data (self), NULL, 0);
+	return _get_int64_value (self, 0);
 }
 
 ArvGcNode *
@@ -959,7 +1054,7 @@ arv_gc_property_node_get_lsb (ArvGcPropertyNode *self, guint default_value)
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_LSB ||
 			      priv->type == ARV_GC_PROPERTY_NODE_TYPE_BIT, default_value);
 
-	return g_ascii_strtoll (_get_value_data (self), NULL, 10);
+	return _get_int64_value (self, 10);
 }
 
 ArvGcNode *
@@ -980,7 +1075,7 @@ arv_gc_property_node_get_msb (ArvGcPropertyNode *self, guint default_value)
 	g_return_val_if_fail (priv->type == ARV_GC_PROPERTY_NODE_TYPE_MSB ||
 			      priv->type == ARV_GC_PROPERTY_NODE_TYPE_BIT, default_value);
 
-	return g_ascii_strtoll (_get_value_data (self), NULL, 10);
+	return _get_int64_value (self, 10);
 }
 
 ArvGcNode *
@@ -36,6 +36,7 @@
 #include <arvgcfloat.h>
 #include <arvgcstring.h>
 #include <arvgcport.h>
+#include <arvgcportprivate.h>
 #include <arvgcprivate.h>
 #include <arvmiscprivate.h>
 #include <arvdebugprivate.h>
@@ -382,6 +383,11 @@ _read_from_port (ArvGcRegisterNode *self, gint64 address, gint64 length, void *b
 		priv->cached = TRUE;
 	else
 		priv->cached = FALSE;
+
+	/* A value that will not be served from the register cache on the next read prevents the caching of the
+	 * computed nodes depending on it */
+	if (!priv->cached || cache_policy != ARV_REGISTER_CACHE_POLICY_ENABLE)
+		arv_gc_volatile_read_add (arv_gc_node_get_genicam (ARV_GC_NODE (self)));
 }
 
 static void
@@ -401,7 +407,7 @@ _write_to_port (ArvGcRegisterNode *self, gint64 address, gint64 length, void *bu
 	}
 
 	arv_gc_feature_node_increment_change_count (ARV_GC_FEATURE_NODE (self));
-	arv_gc_port_write (ARV_GC_PORT (port), buffer, address, length, &local_error);
+	arv_gc_port_write_full (ARV_GC_PORT (port), buffer, address, length, _get_endianness (self), &local_error);
 
 	if (local_error != NULL) {
                 g_propagate_prefixed_error (error, local_error, "[%s] ",
@@ -416,6 +422,85 @@ _write_to_port (ArvGcRegisterNode *self, gint64 address, gint64 length, void *bu
 		priv->cached = FALSE;
 }
 
+/*
+ * arv_gc_register_node_get_prefetch_range:
+ * @self: a #ArvGcRegisterNode
+ * @port: (out): the port node
+ * @address: (out): the register address
+ * @length: (out): the register length
+ *
+ * Returns: %TRUE if the register content can be prefetched in the register cache, that is if the register is
+ * readable, cachable, and if its address and port can be resolved.
+ */
+
+gboolean
+arv_gc_register_node_get_prefetch_range (ArvGcRegisterNode *self, ArvGcNode **port, gint64 *address, gint64 *length)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (self);
+	GError *local_error = NULL;
+
+	g_return_val_if_fail (ARV_IS_GC_REGISTER_NODE (self), FALSE);
+	g_return_val_if_fail (port != NULL && address != NULL && length != NULL, FALSE);
+
+	if (_get_cachable (self) == ARV_GC_CACHABLE_NO_CACHE ||
+	    arv_gc_register_node_get_access_mode (ARV_GC_FEATURE_NODE (self)) == ARV_GC_ACCESS_MODE_WO)
+		return FALSE;
+
+	*port = arv_gc_property_node_get_linked_node (priv->port);
+	if (!ARV_IS_GC_PORT (*port))
+		return FALSE;
+
+	*address = _get_address (self, &local_error);
+	if (local_error == NULL)
+		*length = _get_length (self, &local_error);
+
+	if (local_error != NULL) {
+		g_clear_error (&local_error);
+		return FALSE;
+	}
+
+	return *length > 0;
+}
+
+/*
+ * arv_gc_register_node_set_prefetched_data:
+ * @self: a #ArvGcRegisterNode
+ * @address: the register address
+ * @length: the register length
+ * @data: the register content, read from the device
+ *
+ * Fills the register cache with data read by a coalesced transfer.
+ */
+
+void
+arv_gc_register_node_set_prefetched_data (ArvGcRegisterNode *self, gint64 address, gint64 length, const void *data)
+{
+	ArvGcRegisterNodePrivate *priv = arv_gc_register_node_get_instance_private (self);
+	ArvGcCacheKey key;
+	GSList *iter;
+	void *cache;
+
+	g_return_if_fail (ARV_IS_GC_REGISTER_NODE (self));
+	g_return_if_fail (data != NULL);
+
+	key.address = address;
+	key.length = length;
+
+	cache = g_hash_table_lookup (priv->caches, &key);
+	if (cache == NULL) {
+		cache = g_malloc0 (length);
+		g_hash_table_replace (priv->caches, arv_gc_cache_key_new (address, length), cache);
+	}
+
+	memcpy (cache, data, length);
+
+	/* The cache content is up to date with respect to the current invalidator states */
+	for (iter = priv->invalidators; iter != NULL; iter = iter->next)
+		arv_gc_invalidator_has_changed (iter->data);
+
+	priv->cached = TRUE;
+}
+
 ArvGcNode *
 arv_gc_register_node_new (void)
 {
@@ -38,5 +38,10 @@ void 		arv_gc_register_node_set_masked_integer_value 	(ArvGcRegisterNode *gc_reg
 								 gint64 value, GError **error);
 guint 		arv_gc_register_node_get_endianness 		(ArvGcRegisterNode *register_node);
 
+gboolean	arv_gc_register_node_get_prefetch_range		(ArvGcRegisterNode *self, ArvGcNode **port,
+								 gint64 *address, gint64 *length);
+void		arv_gc_register_node_set_prefetched_data	(ArvGcRegisterNode *self, gint64 address, gint64 length,
+								 const void *data);
+
 
 #endif
@@ -31,6 +31,7 @@
 #include <arvgcfloat.h>
 #include <arvgcport.h>
 #include <arvgc.h>
+#include <arvgcprivate.h>
 #include <arvdebug.h>
 #include <string.h>
 
@@ -45,6 +46,10 @@ typedef struct {
 	ArvGcPropertyNode *representation;
 
 	ArvEvaluator *formula;
+	gboolean is_formula_set;
+
+	ArvGcValueCache int64_cache;
+	ArvGcValueCache double_cache;
 } ArvGcSwissKnifePrivate;
 
 G_DEFINE_ABSTRACT_TYPE_WITH_CODE (ArvGcSwissKnife, arv_gc_swiss_knife, ARV_TYPE_GC_FEATURE_NODE, G_ADD_PRIVATE (ArvGcSwissKnife))
@@ -136,11 +141,13 @@ arv_gc_swiss_knife_class_init (ArvGcSwissKnifeClass *this_class)
 
 /* ArvGcInteger interface implementation */
 
-static void
-_update_variables (ArvGcSwissKnife *self, GError **error)
+/* Formula, sub-expressions and constants are static, they are only set once, in order to let the evaluator keep its
+ * compiled program. */
+
+static gboolean
+_update_formula (ArvGcSwissKnife *self, GError **error)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
-	ArvGcNode *node;
 	GError *local_error = NULL;
 	GSList *iter;
 	const char *expression;
@@ -153,7 +160,7 @@ _update_variables (ArvGcSwissKnife *self, GError **error)
 	if (local_error != NULL) {
 		g_propagate_prefixed_error (error, local_error, "[%s] ",
                                             arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (self)));
-		return;
+		return FALSE;
 	}
 
 	arv_evaluator_set_expression (priv->formula, expression);
@@ -166,7 +173,7 @@ _update_variables (ArvGcSwissKnife *self, GError **error)
 		if (local_error != NULL) {
                         g_propagate_prefixed_error (error, local_error, "[%s] ",
                                                     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (self)));
-                        return;
+                        return FALSE;
                 }
 
 		name = arv_gc_property_node_get_name (iter->data);
@@ -182,7 +189,7 @@ _update_variables (ArvGcSwissKnife *self, GError **error)
 		if (local_error != NULL) {
                         g_propagate_prefixed_error (error, local_error, "[%s] ",
                                                     arv_gc_feature_node_get_name (ARV_GC_FEATURE_NODE (self)));
-			return;
+			return FALSE;
 		}
 
 		name = arv_gc_property_node_get_name (iter->data);
@@ -190,6 +197,22 @@ _update_variables (ArvGcSwissKnife *self, GError **error)
 		arv_evaluator_set_constant (priv->formula, name, constant);
 	}
 
+	priv->is_formula_set = TRUE;
+
+	return TRUE;
+}
+
+static void
+_update_variables (ArvGcSwissKnife *self, GError **error)
+{
+	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
+	ArvGcNode *node;
+	GError *local_error = NULL;
+	GSList *iter;
+
+	if (!priv->is_formula_set && !_update_formula (self, error))
+		return;
+
 	for (iter = priv->variables; iter != NULL; iter = iter->next) {
 		ArvGcPropertyNode *variable_node = iter->data;
 
@@ -231,9 +254,17 @@ arv_gc_swiss_knife_get_integer_value (ArvGcSwissKnife *self, GError **error)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
 	GError *local_error = NULL;
+	ArvGc *genicam;
+	gint64 value;
 
 	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0);
 
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+	if (arv_gc_value_cache_lookup (genicam, &priv->int64_cache))
+		return priv->int64_cache.v_int64;
+
+	arv_gc_value_cache_begin (genicam, &priv->int64_cache);
+
 	_update_variables (self, &local_error);
 
 	if (local_error != NULL) {
@@ -242,7 +273,11 @@ arv_gc_swiss_knife_get_integer_value (ArvGcSwissKnife *self, GError **error)
                 return 0;
         }
 
-	return arv_evaluator_evaluate_as_int64 (priv->formula, NULL);
+	value = arv_evaluator_evaluate_as_int64 (priv->formula, NULL);
+
+	arv_gc_value_cache_set_int64 (genicam, &priv->int64_cache, value);
+
+	return value;
 }
 
 double
@@ -250,9 +285,17 @@ arv_gc_swiss_knife_get_float_value (ArvGcSwissKnife *self, GError **error)
 {
 	ArvGcSwissKnifePrivate *priv = arv_gc_swiss_knife_get_instance_private (self);
 	GError *local_error = NULL;
+	ArvGc *genicam;
+	double value;
 
 	g_return_val_if_fail (ARV_IS_GC_SWISS_KNIFE (self), 0.0);
 
+	genicam = arv_gc_node_get_genicam (ARV_GC_NODE (self));
+	if (arv_gc_value_cache_lookup (genicam, &priv->double_cache))
+		return priv->double_cache.v_double;
+
+	arv_gc_value_cache_begin (genicam, &priv->double_cache);
+
 	_update_variables (self, &local_error);
 
 	if (local_error != NULL) {
@@ -261,7 +304,11 @@ arv_gc_swiss_knife_get_float_value (ArvGcSwissKnife *self, GError **error)
 		return 0.0;
 	}
 
-	return arv_evaluator_evaluate_as_double (priv->formula, NULL);
+	value = arv_evaluator_evaluate_as_double (priv->formula, NULL);
+
+	arv_gc_value_cache_set_double (genicam, &priv->double_cache, value);
+
+	return value;
 }
 
 ArvGcRepresentation
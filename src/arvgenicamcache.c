@@ -0,0 +1,287 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/*
+ * Persistent Genicam data cache.
+ *
+ * Entries are stored in $XDG_CACHE_HOME/aravis/genicam, in files named after a hash of the device identity and of the
+ * Genicam URL. Each entry also contains a few bytes read from the start of the Genicam file in the device memory,
+ * which are compared with the device content before the entry is used. For zipped files, they include the zip local
+ * header, with the CRC and modification date of the compressed file.
+ *
+ * The cache also stores the compiled form of the Genicam data (see arv_gc_compile()), in files named after a hash of
+ * the xml data and of the Aravis version.
+ */
+
+#include <arvgenicamcacheprivate.h>
+#include <arvgcprivate.h>
+#include <arvversion.h>
+#include <arvdebugprivate.h>
+#include <string.h>
+
+#define ARV_GENICAM_CACHE_MAGIC		"ARVGCXML"
+#define ARV_GENICAM_CACHE_CHECK_SIZE_MAX	4096
+
+#pragma pack(push,1)
+
+typedef struct {
+	char magic[8];
+	guint32 check_size;
+	guint32 reserved;
+	guint64 xml_size;
+} ArvGenicamCacheHeader;
+
+#pragma pack(pop)
+
+static GMutex arv_genicam_cache_mutex;
+static gboolean arv_genicam_cache_initialized = FALSE;
+static gboolean arv_genicam_cache_enabled = FALSE;
+
+/*
+ * The cache is disabled by default. It can be enabled using arv_enable_genicam_cache(), or by setting the
+ * ARV_GENICAM_CACHE environment variable to a value different from 0.
+ */
+
+void
+arv_genicam_cache_set_enabled (gboolean enabled)
+{
+	g_mutex_lock (&arv_genicam_cache_mutex);
+	arv_genicam_cache_enabled = enabled;
+	arv_genicam_cache_initialized = TRUE;
+	g_mutex_unlock (&arv_genicam_cache_mutex);
+}
+
+gboolean
+arv_genicam_cache_is_enabled (void)
+{
+	gboolean enabled;
+
+	g_mutex_lock (&arv_genicam_cache_mutex);
+	if (!arv_genicam_cache_initialized) {
+		const char *env = g_getenv ("ARV_GENICAM_CACHE");
+
+		arv_genicam_cache_enabled = env != NULL && env[0] != '\0' && g_strcmp0 (env, "0") != 0;
+		arv_genicam_cache_initialized = TRUE;
+	}
+	enabled = arv_genicam_cache_enabled;
+	g_mutex_unlock (&arv_genicam_cache_mutex);
+
+	return enabled;
+}
+
+char *
+arv_genicam_cache_dup_key (const char *vendor, const char *model, const char *version, const char *serial,
+			   const char *url)
+{
+	GChecksum *checksum;
+	char *key;
+
+	g_return_val_if_fail (url != NULL, NULL);
+
+	checksum = g_checksum_new (G_CHECKSUM_SHA256);
+
+	/* Null characters are used as separators */
+	g_checksum_update (checksum, (const guchar *) (vendor != NULL ? vendor : ""), -1);
+	g_checksum_update (checksum, (const guchar *) "", 1);
+	g_checksum_update (checksum, (const guchar *) (model != NULL ? model : ""), -1);
+	g_checksum_update (checksum, (const guchar *) "", 1);
+	g_checksum_update (checksum, (const guchar *) (version != NULL ? version : ""), -1);
+	g_checksum_update (checksum, (const guchar *) "", 1);
+	g_checksum_update (checksum, (const guchar *) (serial != NULL ? serial : ""), -1);
+	g_checksum_update (checksum, (const guchar *) "", 1);
+	g_checksum_update (checksum, (const guchar *) url, -1);
+
+	key = g_strdup (g_checksum_get_string (checksum));
+
+	g_checksum_free (checksum);
+
+	return key;
+}
+
+static char *
+_get_entry_filename (const char *key, const char *extension)
+{
+	char *basename;
+	char *filename;
+
+	basename = g_strdup_printf ("%s.%s", key, extension);
+	filename = g_build_filename (g_get_user_cache_dir (), "aravis", "genicam", basename, NULL);
+	g_free (basename);
+
+	return filename;
+}
+
+char *
+arv_genicam_cache_lookup (const char *key, const void *check_data, size_t check_size, size_t *size)
+{
+	ArvGenicamCacheHeader header;
+	char *filename;
+	char *content = NULL;
+	char *xml = NULL;
+	gsize length;
+
+	g_return_val_if_fail (key != NULL, NULL);
+	g_return_val_if_fail (check_data != NULL || check_size == 0, NULL);
+	g_return_val_if_fail (size != NULL, NULL);
+
+	*size = 0;
+
+	filename = _get_entry_filename (key, "xml");
+
+	if (!g_file_get_contents (filename, &content, &length, NULL)) {
+		arv_info_misc ("[GenicamCache::lookup] No entry for %s", key);
+		g_free (filename);
+		return NULL;
+	}
+
+	if (length < sizeof (header)) {
+		arv_warning_misc ("[GenicamCache::lookup] Truncated entry %s", filename);
+		goto out;
+	}
+
+	memcpy (&header, content, sizeof (header));
+
+	if (memcmp (header.magic, ARV_GENICAM_CACHE_MAGIC, sizeof (header.magic)) != 0 ||
+	    GUINT32_FROM_LE (header.check_size) != check_size ||
+	    GUINT64_FROM_LE (header.xml_size) != length - sizeof (header) - check_size) {
+		arv_warning_misc ("[GenicamCache::lookup] Invalid entry %s", filename);
+		goto out;
+	}
+
+	if (check_size > 0 && memcmp (content + sizeof (header), check_data, check_size) != 0) {
+		arv_info_misc ("[GenicamCache::lookup] Outdated entry %s", filename);
+		goto out;
+	}
+
+	*size = GUINT64_FROM_LE (header.xml_size);
+	xml = g_malloc (*size + 1);
+	memcpy (xml, content + sizeof (header) + check_size, *size);
+	xml[*size] = '\0';
+
+	arv_info_misc ("[GenicamCache::lookup] Use %s (%" G_GSIZE_FORMAT " bytes)", filename, *size);
+
+out:
+	g_free (content);
+	g_free (filename);
+
+	return xml;
+}
+
+gboolean
+arv_genicam_cache_store (const char *key, const void *check_data, size_t check_size, const char *xml, size_t size)
+{
+	ArvGenicamCacheHeader header = {0};
+	GError *error = NULL;
+	char *filename;
+	char *dirname;
+	char *content;
+	gsize length;
+	gboolean success;
+
+	g_return_val_if_fail (key != NULL, FALSE);
+	g_return_val_if_fail (check_data != NULL || check_size == 0, FALSE);
+	g_return_val_if_fail (check_size <= ARV_GENICAM_CACHE_CHECK_SIZE_MAX, FALSE);
+	g_return_val_if_fail (xml != NULL, FALSE);
+
+	filename = _get_entry_filename (key, "xml");
+	dirname = g_path_get_dirname (filename);
+
+	if (g_mkdir_with_parents (dirname, 0700) != 0) {
+		arv_warning_misc ("[GenicamCache::store] Failed to create %s", dirname);
+		g_free (dirname);
+		g_free (filename);
+		return FALSE;
+	}
+
+	memcpy (header.magic, ARV_GENICAM_CACHE_MAGIC, sizeof (header.magic));
+	header.check_size = GUINT32_TO_LE (check_size);
+	header.xml_size = GUINT64_TO_LE (size);
+
+	length = sizeof (header) + check_size + size;
+	content = g_malloc (length);
+	memcpy (content, &header, sizeof (header));
+	if (check_size > 0)
+		memcpy (content + sizeof (header), check_data, check_size);
+	memcpy (content + sizeof (header) + check_size, xml, size);
+
+	/* The file is atomically replaced, concurrent readers see either the old or the new entry */
+	success = g_file_set_contents (filename, content, length, &error);
+	if (!success) {
+		arv_warning_misc ("[GenicamCache::store] Failed to write %s: %s", filename, error->message);
+		g_clear_error (&error);
+	} else
+		arv_info_misc ("[GenicamCache::store] Write %s (%" G_GSIZE_FORMAT " bytes)", filename, size);
+
+	g_free (content);
+	g_free (dirname);
+	g_free (filename);
+
+	return success;
+}
+
+ArvGc *
+arv_genicam_cache_new_gc (ArvDevice *device, const char *xml, size_t size)
+{
+	GChecksum *checksum;
+	GBytes *compiled = NULL;
+	GError *error = NULL;
+	ArvGc *genicam;
+	char *filename;
+	char *dirname;
+
+	g_return_val_if_fail (xml != NULL, NULL);
+
+	/* The compiled form depends on the node types known by this version */
+	checksum = g_checksum_new (G_CHECKSUM_SHA256);
+	g_checksum_update (checksum, (const guchar *) ARAVIS_VERSION, -1);
+	g_checksum_update (checksum, (const guchar *) "", 1);
+	g_checksum_update (checksum, (const guchar *) xml, size);
+	filename = _get_entry_filename (g_checksum_get_string (checksum), "gcc");
+	g_checksum_free (checksum);
+
+	genicam = arv_gc_new_from_compiled_file (device, filename, NULL);
+	if (genicam != NULL) {
+		arv_info_misc ("[GenicamCache::new_gc] Use %s", filename);
+		g_free (filename);
+		return genicam;
+	}
+
+	genicam = arv_gc_new_and_compile (device, xml, size, &compiled);
+	if (compiled != NULL) {
+		dirname = g_path_get_dirname (filename);
+		if (g_mkdir_with_parents (dirname, 0700) != 0 ||
+		    !g_file_set_contents (filename, g_bytes_get_data (compiled, NULL), g_bytes_get_size (compiled),
+					  &error)) {
+			arv_warning_misc ("[GenicamCache::new_gc] Failed to write %s%s%s", filename,
+					  error != NULL ? ": " : "", error != NULL ? error->message : "");
+			g_clear_error (&error);
+		} else
+			arv_info_misc ("[GenicamCache::new_gc] Write %s (%" G_GSIZE_FORMAT " bytes)", filename,
+				       g_bytes_get_size (compiled));
+		g_free (dirname);
+		g_bytes_unref (compiled);
+	}
+
+	g_free (filename);
+
+	return genicam;
+}
@@ -0,0 +1,45 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_GENICAM_CACHE_PRIVATE_H
+#define ARV_GENICAM_CACHE_PRIVATE_H
+
+#include <arvtypes.h>
+#include <arvgc.h>
+
+G_BEGIN_DECLS
+
+void		arv_genicam_cache_set_enabled		(gboolean enabled);
+gboolean	arv_genicam_cache_is_enabled		(void);
+
+char *		arv_genicam_cache_dup_key		(const char *vendor, const char *model, const char *version,
+							 const char *serial, const char *url);
+char *		arv_genicam_cache_lookup		(const char *key, const void *check_data, size_t check_size,
+							 size_t *size);
+gboolean	arv_genicam_cache_store			(const char *key, const void *check_data, size_t check_size,
+							 const char *xml, size_t size);
+
+ArvGc *		arv_genicam_cache_new_gc		(ArvDevice *device, const char *xml, size_t size);
+
+G_END_DECLS
+
+#endif
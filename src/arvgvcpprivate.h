@@ -138,6 +138,9 @@ G_BEGIN_DECLS
 
 #define ARV_GVCP_DATA_SIZE_MAX				512
 
+/* Maximum number of registers in a single read or write register command */
+#define ARV_GVCP_N_REGISTERS_MAX			(ARV_GVCP_DATA_SIZE_MAX / (2 * sizeof (guint32)))
+
 /**
  * ArvGvcpPacketType:
  * @ARV_GVCP_PACKET_TYPE_ACK: acknowledge packet
@@ -328,10 +331,17 @@ ArvGvcpPacket * 	arv_gvcp_packet_new_write_memory_ack	(guint32 address,
 								 guint16 packet_id, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_read_register_cmd 	(guint32 address,
 								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_read_registers_cmd 	(const guint32 *addresses, guint n_addresses,
+								 guint16 packet_id, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_read_register_ack 	(guint32 value,
 								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_read_registers_ack 	(const guint32 *values, guint n_values,
+								 guint16 packet_id, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_write_register_cmd 	(guint32 address, guint32 value,
 								 guint16 packet_id, size_t *packet_size);
+ArvGvcpPacket * 	arv_gvcp_packet_new_write_registers_cmd	(const guint32 *addresses, const guint32 *values,
+								 guint n_registers,
+								 guint16 packet_id, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_write_register_ack 	(guint32 data_index,
 								 guint16 packet_id, size_t *packet_size);
 ArvGvcpPacket * 	arv_gvcp_packet_new_discovery_cmd 	(gboolean allow_broadcast_discovery_ack, size_t *packet_size);
@@ -496,6 +506,36 @@ arv_gvcp_packet_get_read_register_ack_size (void)
 	return sizeof (ArvGvcpHeader) + sizeof (guint32);
 }
 
+static inline guint
+arv_gvcp_packet_get_read_registers_cmd_n_addresses (const ArvGvcpPacket *packet)
+{
+	if (packet == NULL)
+		return 0;
+	return g_ntohs (packet->header.size) / sizeof (guint32);
+}
+
+static inline guint32
+arv_gvcp_packet_get_read_registers_cmd_address (const ArvGvcpPacket *packet, guint index)
+{
+	if (packet == NULL)
+		return 0;
+	return g_ntohl (*((guint32 *) ((char *) packet + sizeof (ArvGvcpPacket) + index * sizeof (guint32))));
+}
+
+static inline guint32
+arv_gvcp_packet_get_read_registers_ack_value (const ArvGvcpPacket *packet, guint index)
+{
+	if (packet == NULL)
+		return 0;
+	return g_ntohl (*((guint32 *) ((char *) packet + sizeof (ArvGvcpPacket) + index * sizeof (guint32))));
+}
+
+static inline size_t
+arv_gvcp_packet_get_read_registers_ack_size (guint n_values)
+{
+	return sizeof (ArvGvcpHeader) + n_values * sizeof (guint32);
+}
+
 static inline void
 arv_gvcp_packet_get_write_register_cmd_infos (const ArvGvcpPacket *packet, guint32 *address, guint32 *value)
 {
@@ -512,12 +552,85 @@ arv_gvcp_packet_get_write_register_cmd_infos (const ArvGvcpPacket *packet, guint
 		*value = g_ntohl (*((guint32 *) ((char *) packet + sizeof (ArvGvcpPacket) + sizeof (guint32))));
 }
 
+static inline guint
+arv_gvcp_packet_get_write_registers_cmd_n_registers (const ArvGvcpPacket *packet)
+{
+	if (packet == NULL)
+		return 0;
+	return g_ntohs (packet->header.size) / (2 * sizeof (guint32));
+}
+
+static inline void
+arv_gvcp_packet_get_write_registers_cmd_infos (const ArvGvcpPacket *packet, guint index,
+					       guint32 *address, guint32 *value)
+{
+	if (packet == NULL) {
+		if (address != NULL)
+			*address = 0;
+		if (value != NULL)
+			*value = 0;
+		return;
+	}
+	if (address != NULL)
+		*address = g_ntohl (*((guint32 *) ((char *) packet + sizeof (ArvGvcpPacket) +
+						   2 * index * sizeof (guint32))));
+	if (value != NULL)
+		*value = g_ntohl (*((guint32 *) ((char *) packet + sizeof (ArvGvcpPacket) +
+						 (2 * index + 1) * sizeof (guint32))));
+}
+
 static inline size_t
 arv_gvcp_packet_get_write_register_ack_size (void)
 {
 	return sizeof (ArvGvcpHeader) + sizeof (guint32);
 }
 
+static inline guint32
+arv_gvcp_packet_get_write_register_ack_index (const ArvGvcpPacket *packet)
+{
+	if (packet == NULL)
+		return 0;
+	return g_ntohl (*((guint32 *) ((char *) packet + sizeof (ArvGvcpPacket))));
+}
+
+static inline void
+arv_gvcp_packet_get_packet_resend_cmd_infos (const ArvGvcpPacket *packet, guint64 *frame_id,
+					     guint32 *first_block, guint32 *last_block, gboolean *extended_ids)
+{
+	const guint32 *data;
+	gboolean extended;
+
+	if (packet == NULL) {
+		if (frame_id != NULL)
+			*frame_id = 0;
+		if (first_block != NULL)
+			*first_block = 0;
+		if (last_block != NULL)
+			*last_block = 0;
+		if (extended_ids != NULL)
+			*extended_ids = FALSE;
+		return;
+	}
+
+	data = (const guint32 *) ((const char *) packet + sizeof (ArvGvcpPacket));
+	extended = (packet->header.packet_flags & ARV_GVCP_CMD_PACKET_FLAGS_EXTENDED_IDS) != 0 &&
+		g_ntohs (packet->header.size) >= 5 * sizeof (guint32);
+
+	if (frame_id != NULL) {
+		if (extended)
+			*frame_id = ((guint64) g_ntohl (data[3]) << 32) | g_ntohl (data[4]);
+		else
+			*frame_id = g_ntohl (data[0]) & 0xffff;
+	}
+	/* With regular ids, only the 24 bits of the block ids are valid */
+	if (first_block != NULL)
+		*first_block = g_ntohl (data[1]) & (extended ? 0xffffffff : 0x00ffffff);
+	if (last_block != NULL)
+		*last_block = g_ntohl (data[2]) & (extended ? 0xffffffff : 0x00ffffff);
+	if (extended_ids != NULL)
+		*extended_ids = extended;
+}
+
 static inline guint16
 arv_gvcp_next_packet_id (guint16 packet_id)
 {
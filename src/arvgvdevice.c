@@ -37,6 +37,10 @@
 #include <arvgvspprivate.h>
 #include <arvnetworkprivate.h>
 #include <arvzip.h>
+#include <arvzipprivate.h>
+#include <arvdomparserprivate.h>
+#include <arvgcprivate.h>
+#include <arvgenicamcacheprivate.h>
 #include <arvstr.h>
 #include <arvmiscprivate.h>
 #include <arvenumtypes.h>
@@ -50,9 +54,12 @@ enum
 	PROP_0,
 	PROP_GV_DEVICE_INTERFACE_ADDRESS,
 	PROP_GV_DEVICE_DEVICE_ADDRESS,
-	PROP_GV_DEVICE_PACKET_SIZE_ADJUSTEMENT
+	PROP_GV_DEVICE_PACKET_SIZE_ADJUSTEMENT,
+	PROP_GV_DEVICE_GVCP_WINDOW_SIZE
 };
 
+typedef struct _ArvGvDeviceAsyncOperation ArvGvDeviceAsyncOperation;
+
 typedef struct {
 	GMutex mutex;
 
@@ -68,8 +75,17 @@ typedef struct {
 
 	unsigned int gvcp_n_retries;
 	unsigned int gvcp_timeout_ms;
+	unsigned int gvcp_window_size;
 
 	gboolean is_controller;
+
+	GMutex async_mutex;
+	ArvGvDeviceAsyncOperation *async_op;
+
+	ArvPcapWriter *pcap_writer;
+	guint32 pcap_interface_ip;
+	guint16 pcap_interface_port;
+	guint32 pcap_device_ip;
 } ArvGvDeviceIOData;
 
 typedef struct {
@@ -93,6 +109,7 @@ typedef struct {
 
 	ArvGvStreamOption stream_options;
 	ArvGvPacketSizeAdjustment packet_size_adjustment;
+	guint gvcp_window_size;
 
 	gboolean first_stream_created;
 
@@ -134,9 +151,37 @@ arv_gvcp_error_to_device_error (ArvGvcpError code)
         return ARV_DEVICE_ERROR_PROTOCOL_ERROR;
 }
 
+/* Must be called with the io mutex locked */
+
+static void
+_capture_packet (ArvGvDeviceIOData *io_data, gboolean is_command, const void *packet, size_t size)
+{
+	if (G_LIKELY (io_data->pcap_writer == NULL))
+		return;
+
+	if (is_command)
+		arv_pcap_writer_push_udp (io_data->pcap_writer,
+					  io_data->pcap_interface_ip, io_data->pcap_interface_port,
+					  io_data->pcap_device_ip, ARV_GVCP_PORT,
+					  packet, size);
+	else
+		arv_pcap_writer_push_udp (io_data->pcap_writer,
+					  io_data->pcap_device_ip, ARV_GVCP_PORT,
+					  io_data->pcap_interface_ip, io_data->pcap_interface_port,
+					  packet, size);
+}
+
+static void _stash_async_ack (ArvGvDeviceIOData *io_data, const ArvGvcpPacket *packet, size_t count);
+
+/*
+ * For memory commands, @address and @size define the memory block. For register commands, @register_addresses
+ * contains size / 4 register addresses, and @buffer the corresponding values.
+ */
+
 static gboolean
 _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
-			   guint64 address, size_t size, void *buffer, GError **error)
+			   guint64 address, const guint32 *register_addresses, size_t size, void *buffer,
+			   GError **error)
 {
 	ArvGvcpCommand expected_ack_command;
 	ArvGvcpPacket *ack_packet = io_data->buffer;
@@ -147,6 +192,8 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 	unsigned int n_retries = 0;
 	gboolean success = FALSE;
 	ArvGvcpError command_error = ARV_GVCP_ERROR_NONE;
+	guint n_registers = size / sizeof (guint32);
+	guint i;
 	int count;
 
 	switch (command) {
@@ -163,7 +210,7 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 		case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
 			operation = "read_register";
 			expected_ack_command = ARV_GVCP_COMMAND_READ_REGISTER_ACK;
-			ack_size = arv_gvcp_packet_get_read_register_ack_size ();
+			ack_size = arv_gvcp_packet_get_read_registers_ack_size (n_registers);
 			break;
 		case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
 			operation = "write_register";
@@ -190,12 +237,12 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 								       io_data->packet_id, &packet_size);
 			break;
 		case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
-			packet = arv_gvcp_packet_new_read_register_cmd (address,
-									io_data->packet_id, &packet_size);
+			packet = arv_gvcp_packet_new_read_registers_cmd (register_addresses, n_registers,
+									 io_data->packet_id, &packet_size);
 			break;
 		case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
-			packet = arv_gvcp_packet_new_write_register_cmd (address, *((guint32 *) buffer),
-									 io_data->packet_id, &packet_size);
+			packet = arv_gvcp_packet_new_write_registers_cmd (register_addresses, buffer, n_registers,
+									  io_data->packet_id, &packet_size);
 			break;
 		default:
 			g_assert_not_reached ();
@@ -216,6 +263,8 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 			gboolean pending_ack;
 			gboolean expected_answer;
 
+			_capture_packet (io_data, TRUE, packet, packet_size);
+
 			timeout_stop_ms = g_get_monotonic_time () / 1000 + io_data->gvcp_timeout_ms;
 
 			do {
@@ -232,6 +281,8 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 					arv_gpollfd_clear_one (&io_data->poll_in_event, io_data->socket);
 					count = g_socket_receive (io_data->socket, io_data->buffer,
 								  ARV_GV_DEVICE_BUFFER_SIZE, NULL, &local_error);
+					if (count > 0)
+						_capture_packet (io_data, FALSE, io_data->buffer, count);
 				} else
 					count = 0;
 				success = success && (count >= sizeof (ArvGvcpHeader));
@@ -248,6 +299,7 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 					packet_id = arv_gvcp_packet_get_packet_id (ack_packet);
 
 					if (ack_command == ARV_GVCP_COMMAND_PENDING_ACK &&
+					    packet_id == io_data->packet_id &&
 					    count >= arv_gvcp_packet_get_pending_ack_size ()) {
 						gint64 pending_ack_timeout_ms = arv_gvcp_packet_get_pending_ack_timeout (ack_packet);
 						pending_ack = TRUE;
@@ -264,6 +316,7 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 						if (!expected_answer) {
 							arv_info_device ("[GvDevice::%s] Unexpected answer (0x%02x)", operation,
 									  packet_type);
+							_stash_async_ack (io_data, ack_packet, count);
 						} else
 							command_error = arv_gvcp_packet_get_packet_flags (ack_packet);
 					} else  {
@@ -274,6 +327,7 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 						if (!expected_answer) {
 							arv_info_device ("[GvDevice::%s] Unexpected answer (0x%02x)", operation,
 									  packet_type);
+							_stash_async_ack (io_data, ack_packet, count);
 						}
 					}
 				} else {
@@ -297,7 +351,9 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 					case ARV_GVCP_COMMAND_WRITE_MEMORY_CMD:
 						break;
 					case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
-						*((gint32 *) buffer) = arv_gvcp_packet_get_read_register_ack_value (ack_packet);
+						for (i = 0; i < n_registers; i++)
+							((guint32 *) buffer)[i] =
+								arv_gvcp_packet_get_read_registers_ack_value (ack_packet, i);
 						break;
 					case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
 						break;
@@ -328,7 +384,7 @@ _send_cmd_and_receive_ack (ArvGvDeviceIOData *io_data, ArvGvcpCommand command,
 			case ARV_GVCP_COMMAND_WRITE_MEMORY_CMD:
 				break;
 			case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
-				*((guint32 *) buffer) = 0;
+				memset (buffer, 0, size);
 				break;
 			case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
 				break;
@@ -352,43 +408,325 @@ static gboolean
 _read_memory (ArvGvDeviceIOData *io_data, guint64 address, guint32 size, void *buffer, GError **error)
 {
 	return _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_READ_MEMORY_CMD,
-					  address, size, buffer, error);
+					  address, NULL, size, buffer, error);
+}
+
+typedef struct {
+	guint16 packet_id;
+	guint64 address;
+	guint32 size;
+	char *data;
+
+	ArvGvcpPacket *packet;
+	size_t packet_size;
+
+	unsigned int n_tries;
+	gint64 timeout_stop_ms;
+	gboolean is_done;
+} ArvGvDeviceReadRequest;
+
+static void
+_send_read_request (ArvGvDeviceIOData *io_data, ArvGvDeviceReadRequest *request)
+{
+	GError *local_error = NULL;
+
+	arv_gvcp_packet_debug (request->packet, ARV_DEBUG_LEVEL_TRACE);
+
+	/* A sending error is handled as a lost command, which will be retried on timeout */
+	if (g_socket_send_to (io_data->socket, io_data->device_address,
+			      (const char *) request->packet, request->packet_size,
+			      NULL, &local_error) < 0) {
+		arv_warning_device ("[GvDevice::read_memory] Command sending error: %s",
+				    local_error != NULL ? local_error->message : "Unknown reason");
+		g_clear_error (&local_error);
+	} else
+		_capture_packet (io_data, TRUE, request->packet, request->packet_size);
+
+	request->n_tries++;
+	request->timeout_stop_ms = g_get_monotonic_time () / 1000 + io_data->gvcp_timeout_ms;
+}
+
+typedef struct {
+	ArvGvDeviceReadRequest requests[ARV_GV_DEVICE_GVCP_N_PIPELINED_BLOCKS];
+	unsigned int n_requests;
+	unsigned int n_sent;
+	unsigned int n_done;
+	unsigned int n_in_flight;
+
+	guint32 size;
+	void *buffer;
+} ArvGvDevicePipelinedRead;
+
+static void
+_pipelined_read_send_window (ArvGvDeviceIOData *io_data, ArvGvDevicePipelinedRead *read)
+{
+	while (read->n_sent < read->n_requests && read->n_in_flight < MAX (io_data->gvcp_window_size, 1)) {
+		_send_read_request (io_data, &read->requests[read->n_sent]);
+		read->n_sent++;
+		read->n_in_flight++;
+	}
+}
+
+/*
+ * Reads up to ARV_GV_DEVICE_GVCP_N_PIPELINED_BLOCKS memory blocks, keeping up to gvcp_window_size read commands in
+ * flight. Acknowledges are matched to their command using the packet id, and each command has its own timeout and
+ * retry counter. If a command times out while others are in flight, the device may not be able to queue commands, and
+ * the window is halved for all the subsequent transfers.
+ *
+ * _pipelined_read_start sends the first window of commands, and _pipelined_read_finish waits for the completion of
+ * the transfer. In between, the caller may do other work while the first acknowledges are on their way, but it must
+ * keep the io lock held from the start to the end of the transfer, as any other transaction would drop the
+ * acknowledges.
+ */
+
+static gboolean
+_pipelined_read_start (ArvGvDeviceIOData *io_data, ArvGvDevicePipelinedRead *read,
+		       guint64 address, guint32 size, void *buffer)
+{
+	unsigned int i;
+
+	g_return_val_if_fail (size <= ARV_GV_DEVICE_GVCP_N_PIPELINED_BLOCKS * ARV_GVCP_DATA_SIZE_MAX, FALSE);
+
+	read->n_requests = (size + ARV_GVCP_DATA_SIZE_MAX - 1) / ARV_GVCP_DATA_SIZE_MAX;
+	read->n_sent = 0;
+	read->n_done = 0;
+	read->n_in_flight = 0;
+	read->size = size;
+	read->buffer = buffer;
+
+	for (i = 0; i < read->n_requests; i++) {
+		ArvGvDeviceReadRequest *request = &read->requests[i];
+
+		io_data->packet_id = arv_gvcp_next_packet_id (io_data->packet_id);
+
+		request->packet_id = io_data->packet_id;
+		request->address = address + i * ARV_GVCP_DATA_SIZE_MAX;
+		request->size = MIN (ARV_GVCP_DATA_SIZE_MAX, size - i * ARV_GVCP_DATA_SIZE_MAX);
+		request->data = ((char *) buffer) + i * ARV_GVCP_DATA_SIZE_MAX;
+		request->packet = arv_gvcp_packet_new_read_memory_cmd (request->address, request->size,
+									request->packet_id, &request->packet_size);
+		request->n_tries = 0;
+		request->timeout_stop_ms = 0;
+		request->is_done = FALSE;
+	}
+
+	_pipelined_read_send_window (io_data, read);
+
+	return TRUE;
+}
+
+static gboolean
+_pipelined_read_finish (ArvGvDeviceIOData *io_data, ArvGvDevicePipelinedRead *read, GError **error)
+{
+	ArvGvDeviceReadRequest *requests = read->requests;
+	ArvGvcpPacket *ack_packet = io_data->buffer;
+	ArvGvcpError command_error = ARV_GVCP_ERROR_NONE;
+	gboolean timeout = FALSE;
+	unsigned int i;
+
+	while (read->n_done < read->n_requests && command_error == ARV_GVCP_ERROR_NONE && !timeout) {
+		gboolean is_window_reduced = FALSE;
+		gint64 time_ms;
+		gint64 timeout_stop_ms = G_MAXINT64;
+		gint timeout_ms;
+		int count = 0;
+
+		_pipelined_read_send_window (io_data, read);
+
+		for (i = 0; i < read->n_sent; i++)
+			if (!requests[i].is_done)
+				timeout_stop_ms = MIN (timeout_stop_ms, requests[i].timeout_stop_ms);
+
+		timeout_ms = CLAMP (timeout_stop_ms - g_get_monotonic_time () / 1000, 0, G_MAXINT);
+
+		if (g_poll (&io_data->poll_in_event, 1, timeout_ms) > 0) {
+			GError *local_error = NULL;
+
+			arv_gpollfd_clear_one (&io_data->poll_in_event, io_data->socket);
+			count = g_socket_receive (io_data->socket, io_data->buffer,
+						  ARV_GV_DEVICE_BUFFER_SIZE, NULL, &local_error);
+			if (local_error != NULL) {
+				arv_warning_device ("[GvDevice::read_memory] Ack reception error: %s",
+						    local_error->message);
+				g_clear_error (&local_error);
+			} else if (count > 0)
+				_capture_packet (io_data, FALSE, io_data->buffer, count);
+		}
+
+		if (count >= (int) sizeof (ArvGvcpHeader)) {
+			ArvGvDeviceReadRequest *request = NULL;
+			ArvGvcpPacketType packet_type;
+			ArvGvcpCommand ack_command;
+			guint16 packet_id;
+
+			arv_gvcp_packet_debug (ack_packet, ARV_DEBUG_LEVEL_TRACE);
+
+			packet_type = arv_gvcp_packet_get_packet_type (ack_packet);
+			ack_command = arv_gvcp_packet_get_command (ack_packet);
+			packet_id = arv_gvcp_packet_get_packet_id (ack_packet);
+
+			for (i = 0; i < read->n_sent && request == NULL; i++)
+				if (!requests[i].is_done && requests[i].packet_id == packet_id)
+					request = &requests[i];
+
+			if (request == NULL) {
+				arv_info_device ("[GvDevice::read_memory] Unexpected answer (0x%02x, packet id %u)",
+						 packet_type, packet_id);
+				_stash_async_ack (io_data, ack_packet, count);
+			} else if (ack_command == ARV_GVCP_COMMAND_PENDING_ACK &&
+				   count >= arv_gvcp_packet_get_pending_ack_size ()) {
+				gint64 pending_ack_timeout_ms = arv_gvcp_packet_get_pending_ack_timeout (ack_packet);
+
+				request->timeout_stop_ms = g_get_monotonic_time () / 1000 + pending_ack_timeout_ms;
+
+				arv_debug_device ("[GvDevice::read_memory] Pending ack timeout = %" G_GINT64_FORMAT,
+						  pending_ack_timeout_ms);
+			} else if (ack_command != ARV_GVCP_COMMAND_READ_MEMORY_ACK) {
+				arv_info_device ("[GvDevice::read_memory] Unexpected answer (0x%02x)", packet_type);
+			} else if (packet_type == ARV_GVCP_PACKET_TYPE_ERROR ||
+				   packet_type == ARV_GVCP_PACKET_TYPE_UNKNOWN_ERROR) {
+				command_error = arv_gvcp_packet_get_packet_flags (ack_packet);
+			} else if (packet_type == ARV_GVCP_PACKET_TYPE_ACK &&
+				   count >= arv_gvcp_packet_get_read_memory_ack_size (request->size)) {
+				memcpy (request->data, arv_gvcp_packet_get_read_memory_ack_data (ack_packet),
+					request->size);
+				request->is_done = TRUE;
+				read->n_in_flight--;
+				read->n_done++;
+			} else {
+				arv_info_device ("[GvDevice::read_memory] Unexpected answer (0x%02x)", packet_type);
+			}
+		}
+
+		time_ms = g_get_monotonic_time () / 1000;
+
+		for (i = 0; i < read->n_sent && command_error == ARV_GVCP_ERROR_NONE && !timeout; i++) {
+			ArvGvDeviceReadRequest *request = &requests[i];
+
+			if (request->is_done || request->timeout_stop_ms > time_ms)
+				continue;
+
+			arv_warning_device ("[GvDevice::read_memory] Ack reception timeout (packet id %u)",
+					    request->packet_id);
+
+			if (request->n_tries >= io_data->gvcp_n_retries) {
+				timeout = TRUE;
+				continue;
+			}
+
+			/* Commands sent together time out together, the window is reduced once per timeout round */
+			if (!is_window_reduced && read->n_in_flight > 1 && io_data->gvcp_window_size > 1) {
+				is_window_reduced = TRUE;
+				io_data->gvcp_window_size /= 2;
+				arv_info_device ("[GvDevice::read_memory] Reduce command window to %u",
+						 io_data->gvcp_window_size);
+			}
+
+			_send_read_request (io_data, request);
+		}
+	}
+
+	for (i = 0; i < read->n_requests; i++)
+		arv_gvcp_packet_free (requests[i].packet);
+
+	if (read->n_done < read->n_requests) {
+		memset (read->buffer, 0, read->size);
+
+		if (command_error != ARV_GVCP_ERROR_NONE)
+			g_set_error (error, ARV_DEVICE_ERROR, arv_gvcp_error_to_device_error (command_error),
+				     "GigEVision read_memory error (%s)",
+				     arv_gvcp_error_to_string (command_error));
+		else
+			g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_TIMEOUT,
+				     "GigEVision read_memory timeout");
+
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/* Drops a started transfer. Late acknowledges will be ignored by the next transactions. */
+
+static void
+_pipelined_read_cancel (ArvGvDevicePipelinedRead *read)
+{
+	unsigned int i;
+
+	for (i = 0; i < read->n_requests; i++)
+		arv_gvcp_packet_free (read->requests[i].packet);
+}
+
+static gboolean
+_read_memory_pipelined (ArvGvDeviceIOData *io_data, guint64 address, guint32 size, void *buffer, GError **error)
+{
+	ArvGvDevicePipelinedRead read;
+	gboolean success;
+
+	g_mutex_lock (&io_data->mutex);
+
+	success = _pipelined_read_start (io_data, &read, address, size, buffer) &&
+		_pipelined_read_finish (io_data, &read, error);
+
+	g_mutex_unlock (&io_data->mutex);
+
+	return success;
 }
 
 static gboolean
 _write_memory (ArvGvDeviceIOData *io_data, guint64 address, guint32 size, void *buffer, GError **error)
 {
 	return  _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_WRITE_MEMORY_CMD,
-					   address, size, buffer, error);
+					   address, NULL, size, buffer, error);
 }
 
 static gboolean
 _read_register (ArvGvDeviceIOData *io_data, guint32 address, guint32 *value_placeholder, GError **error)
 {
 	return _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_READ_REGISTER_CMD,
-					  address, sizeof (guint32), value_placeholder, error);
+					  0, &address, sizeof (guint32), value_placeholder, error);
 }
 
 static gboolean
 _write_register (ArvGvDeviceIOData *io_data, guint32 address, guint32 value, GError **error)
 {
 	return _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_WRITE_REGISTER_CMD,
-					  address, sizeof (guint32), &value, error);
+					  0, &address, sizeof (guint32), &value, error);
+}
+
+static gboolean
+_read_registers (ArvGvDeviceIOData *io_data, const guint32 *addresses, guint32 *values, guint n_registers,
+		 GError **error)
+{
+	return _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_READ_REGISTER_CMD,
+					  0, addresses, n_registers * sizeof (guint32), values, error);
+}
+
+static gboolean
+_write_registers (ArvGvDeviceIOData *io_data, const guint32 *addresses, const guint32 *values, guint n_registers,
+		  GError **error)
+{
+	return _send_cmd_and_receive_ack (io_data, ARV_GVCP_COMMAND_WRITE_REGISTER_CMD,
+					  0, addresses, n_registers * sizeof (guint32), (void *) values, error);
 }
 
 static gboolean
 arv_gv_device_read_memory (ArvDevice *device, guint64 address, guint32 size, void *buffer, GError **error)
 {
 	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (ARV_GV_DEVICE (device));
-	int i;
-	gint32 block_size;
+	guint32 segment_size = ARV_GVCP_DATA_SIZE_MAX * ARV_GV_DEVICE_GVCP_N_PIPELINED_BLOCKS;
+	guint32 offset;
 
-	for (i = 0; i < (size + ARV_GVCP_DATA_SIZE_MAX - 1) / ARV_GVCP_DATA_SIZE_MAX; i++) {
-		block_size = MIN (ARV_GVCP_DATA_SIZE_MAX, size - i * ARV_GVCP_DATA_SIZE_MAX);
-		if (!_read_memory (priv->io_data,
-				   address + i * ARV_GVCP_DATA_SIZE_MAX,
-				   block_size, ((char *) buffer) + i * ARV_GVCP_DATA_SIZE_MAX, error))
+	if (size <= ARV_GVCP_DATA_SIZE_MAX)
+		return _read_memory (priv->io_data, address, size, buffer, error);
+
+	/* The io lock is released between segments, in order to let the heartbeat thread run */
+	for (offset = 0; offset < size; offset += segment_size) {
+		if (!_read_memory_pipelined (priv->io_data, address + offset, MIN (segment_size, size - offset),
+					     ((char *) buffer) + offset, error)) {
+			memset (buffer, 0, size);
 			return FALSE;
+		}
 	}
 
 	return TRUE;
@@ -428,6 +766,532 @@ arv_gv_device_write_register (ArvDevice *device, guint64 address, guint32 value,
 	return _write_register (priv->io_data, address, value, error);
 }
 
+static gboolean
+arv_gv_device_read_registers (ArvDevice *device, const guint64 *addresses, guint32 *values, guint n_registers,
+			      GError **error)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (ARV_GV_DEVICE (device));
+	guint32 packet_addresses[ARV_GVCP_N_REGISTERS_MAX];
+	guint offset;
+	guint i;
+
+	for (offset = 0; offset < n_registers; offset += ARV_GVCP_N_REGISTERS_MAX) {
+		guint n_packet_registers = MIN (ARV_GVCP_N_REGISTERS_MAX, n_registers - offset);
+
+		for (i = 0; i < n_packet_registers; i++)
+			packet_addresses[i] = addresses[offset + i];
+
+		if (!_read_registers (priv->io_data, packet_addresses, values + offset, n_packet_registers, error))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+arv_gv_device_write_registers (ArvDevice *device, const guint64 *addresses, const guint32 *values,
+			       guint n_registers, GError **error)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (ARV_GV_DEVICE (device));
+	guint32 packet_addresses[ARV_GVCP_N_REGISTERS_MAX];
+	guint offset;
+	guint i;
+
+	for (offset = 0; offset < n_registers; offset += ARV_GVCP_N_REGISTERS_MAX) {
+		guint n_packet_registers = MIN (ARV_GVCP_N_REGISTERS_MAX, n_registers - offset);
+
+		for (i = 0; i < n_packet_registers; i++)
+			packet_addresses[i] = addresses[offset + i];
+
+		if (!_write_registers (priv->io_data, packet_addresses, values + offset, n_packet_registers, error))
+			return FALSE;
+	}
+
+	return TRUE;
+}
+
+/* Asynchronous operations
+ *
+ * The memory and register operations queued by the ArvDevice _async functions don't block the caller thread. Commands
+ * are sent from the thread default main context of the caller, and acknowledges are received from a socket source
+ * attached to the same context, with the retry and pending acknowledge handling of _send_cmd_and_receive_ack. The io
+ * mutex is only held while the control socket is used, and taken with a trylock. If the heartbeat thread or a blocking
+ * accessor owns it, sending is retried a bit later, and the socket source is removed until the lock is free again, in
+ * order to not spin on the readable socket. Meanwhile, the owner consumes the incoming packets, and hands over the
+ * ones matching the packet id of the asynchronous operation with _stash_async_ack, which processes them from an idle
+ * source in the context of the caller.
+ */
+
+struct _ArvGvDeviceAsyncOperation {
+	ArvGvDeviceIOData *io_data;
+	ArvDevice *device;
+	GTask *task;
+	ArvDeviceIOOperation *operation;
+	GMainContext *context;
+
+	ArvGvcpCommand command;
+	ArvGvcpCommand expected_ack_command;
+	const char *operation_name;
+	size_t ack_size;
+
+	guint32 size;
+	guint32 offset;
+	guint32 block_size;
+
+	ArvGvcpPacket *packet;
+	size_t packet_size;
+	guint16 packet_id;
+	guint n_retries;
+	gboolean is_sent;
+
+	void *buffer;
+
+	/* Protected by io_data->async_mutex */
+	void *stash;
+	size_t stash_size;
+	GSource *stash_source;
+
+	GSource *socket_source;
+	GSource *rearm_source;
+	GSource *timeout_source;
+};
+
+static gboolean _async_timeout_cb (gpointer user_data);
+static gboolean _async_socket_cb (GSocket *socket, GIOCondition condition, gpointer user_data);
+static gboolean _async_stash_cb (gpointer user_data);
+
+static void
+_async_watch_socket (ArvGvDeviceAsyncOperation *async_op)
+{
+	async_op->socket_source = g_socket_create_source (async_op->io_data->socket, G_IO_IN, NULL);
+	g_source_set_callback (async_op->socket_source, (GSourceFunc) _async_socket_cb, async_op, NULL);
+	g_source_attach (async_op->socket_source, async_op->context);
+}
+
+static gboolean
+_async_rearm_cb (gpointer user_data)
+{
+	ArvGvDeviceAsyncOperation *async_op = user_data;
+
+	g_clear_pointer (&async_op->rearm_source, g_source_unref);
+
+	_async_watch_socket (async_op);
+
+	return G_SOURCE_REMOVE;
+}
+
+/* Called by the owner of the io lock for the acknowledges it doesn't expect */
+
+static void
+_stash_async_ack (ArvGvDeviceIOData *io_data, const ArvGvcpPacket *packet, size_t count)
+{
+	ArvGvDeviceAsyncOperation *async_op;
+
+	g_mutex_lock (&io_data->async_mutex);
+
+	async_op = io_data->async_op;
+
+	/* async_op->packet_id is only changed with the io lock held */
+	if (async_op != NULL &&
+	    count <= ARV_GV_DEVICE_BUFFER_SIZE &&
+	    arv_gvcp_packet_get_packet_id (packet) == async_op->packet_id) {
+		/* Don't replace a final acknowledge by a pending one */
+		if (async_op->stash_size == 0 ||
+		    arv_gvcp_packet_get_command (packet) != ARV_GVCP_COMMAND_PENDING_ACK) {
+			memcpy (async_op->stash, packet, count);
+			async_op->stash_size = count;
+		}
+
+		if (async_op->stash_source == NULL) {
+			async_op->stash_source = g_idle_source_new ();
+			g_source_set_callback (async_op->stash_source, _async_stash_cb, async_op, NULL);
+			g_source_attach (async_op->stash_source, async_op->context);
+		}
+	}
+
+	g_mutex_unlock (&io_data->async_mutex);
+}
+
+static void
+_async_set_timeout (ArvGvDeviceAsyncOperation *async_op, guint timeout_ms)
+{
+	if (async_op->timeout_source != NULL) {
+		g_source_destroy (async_op->timeout_source);
+		g_source_unref (async_op->timeout_source);
+	}
+
+	async_op->timeout_source = g_timeout_source_new (timeout_ms);
+	g_source_set_callback (async_op->timeout_source, _async_timeout_cb, async_op, NULL);
+	g_source_attach (async_op->timeout_source, async_op->context);
+}
+
+static void
+_async_complete (ArvGvDeviceAsyncOperation *async_op, GError *error)
+{
+	ArvGvDeviceIOData *io_data = async_op->io_data;
+	ArvDevice *device = async_op->device;
+	GTask *task = async_op->task;
+
+	g_mutex_lock (&io_data->async_mutex);
+	io_data->async_op = NULL;
+	if (async_op->stash_source != NULL) {
+		g_source_destroy (async_op->stash_source);
+		g_source_unref (async_op->stash_source);
+	}
+	g_mutex_unlock (&io_data->async_mutex);
+
+	if (async_op->socket_source != NULL) {
+		g_source_destroy (async_op->socket_source);
+		g_source_unref (async_op->socket_source);
+	}
+	if (async_op->rearm_source != NULL) {
+		g_source_destroy (async_op->rearm_source);
+		g_source_unref (async_op->rearm_source);
+	}
+	if (async_op->timeout_source != NULL) {
+		g_source_destroy (async_op->timeout_source);
+		g_source_unref (async_op->timeout_source);
+	}
+
+	if (error != NULL) {
+		if (async_op->command == ARV_GVCP_COMMAND_READ_MEMORY_CMD)
+			memset (async_op->operation->buffer, 0, async_op->size);
+		else if (async_op->command == ARV_GVCP_COMMAND_READ_REGISTER_CMD)
+			async_op->operation->register_value = 0;
+	}
+
+	g_clear_pointer (&async_op->packet, arv_gvcp_packet_free);
+	g_free (async_op->buffer);
+	g_free (async_op->stash);
+	g_free (async_op);
+
+	arv_device_complete_io_operation (device, task, error);
+}
+
+static void
+_async_prepare_block (ArvGvDeviceAsyncOperation *async_op)
+{
+	g_clear_pointer (&async_op->packet, arv_gvcp_packet_free);
+
+	async_op->block_size = MIN (ARV_GVCP_DATA_SIZE_MAX, async_op->size - async_op->offset);
+	async_op->n_retries = 0;
+	async_op->is_sent = FALSE;
+
+	if (async_op->command == ARV_GVCP_COMMAND_READ_MEMORY_CMD)
+		async_op->ack_size = arv_gvcp_packet_get_read_memory_ack_size (async_op->block_size);
+}
+
+static void
+_async_send (ArvGvDeviceAsyncOperation *async_op)
+{
+	ArvGvDeviceIOData *io_data = async_op->io_data;
+	ArvDeviceIOOperation *operation = async_op->operation;
+	GError *local_error = NULL;
+	guint32 address;
+
+	if (!g_mutex_trylock (&io_data->mutex)) {
+		_async_set_timeout (async_op, ARV_GV_DEVICE_ASYNC_LOCK_RETRY_MS);
+		return;
+	}
+
+	if (async_op->packet == NULL) {
+		io_data->packet_id = arv_gvcp_next_packet_id (io_data->packet_id);
+		async_op->packet_id = io_data->packet_id;
+
+		address = operation->address + async_op->offset;
+
+		switch (async_op->command) {
+			case ARV_GVCP_COMMAND_READ_MEMORY_CMD:
+				async_op->packet = arv_gvcp_packet_new_read_memory_cmd (address, async_op->block_size,
+											async_op->packet_id,
+											&async_op->packet_size);
+				break;
+			case ARV_GVCP_COMMAND_WRITE_MEMORY_CMD:
+				async_op->packet = arv_gvcp_packet_new_write_memory_cmd (address, async_op->block_size,
+											 ((const char *) operation->buffer) +
+											 async_op->offset,
+											 async_op->packet_id,
+											 &async_op->packet_size);
+				break;
+			case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
+				async_op->packet = arv_gvcp_packet_new_read_registers_cmd (&address, 1,
+											   async_op->packet_id,
+											   &async_op->packet_size);
+				break;
+			case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
+				async_op->packet = arv_gvcp_packet_new_write_registers_cmd (&address,
+											    &operation->register_value, 1,
+											    async_op->packet_id,
+											    &async_op->packet_size);
+				break;
+			default:
+				g_assert_not_reached ();
+		}
+	}
+
+	arv_gvcp_packet_debug (async_op->packet, ARV_DEBUG_LEVEL_TRACE);
+
+	if (g_socket_send_to (io_data->socket, io_data->device_address,
+			      (const char *) async_op->packet, async_op->packet_size,
+			      NULL, &local_error) >= 0)
+		_capture_packet (io_data, TRUE, async_op->packet, async_op->packet_size);
+
+	g_mutex_unlock (&io_data->mutex);
+
+	/* A sending error is handled as a lost acknowledge */
+	if (local_error != NULL)
+		arv_warning_device ("[GvDevice::%s] Command sending error: %s", async_op->operation_name,
+				    local_error->message);
+	g_clear_error (&local_error);
+
+	async_op->is_sent = TRUE;
+
+	_async_set_timeout (async_op, io_data->gvcp_timeout_ms);
+}
+
+static gboolean
+_async_timeout_cb (gpointer user_data)
+{
+	ArvGvDeviceAsyncOperation *async_op = user_data;
+
+	if (async_op->is_sent) {
+		arv_warning_device ("[GvDevice::%s] Ack reception timeout", async_op->operation_name);
+
+		async_op->n_retries++;
+		if (async_op->n_retries >= async_op->io_data->gvcp_n_retries) {
+			_async_complete (async_op, g_error_new (ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_TIMEOUT,
+								"GigEVision %s timeout", async_op->operation_name));
+			return G_SOURCE_REMOVE;
+		}
+		async_op->is_sent = FALSE;
+	}
+
+	_async_send (async_op);
+
+	return G_SOURCE_REMOVE;
+}
+
+/* Processes the acknowledge in async_op->buffer, and returns FALSE if the operation is completed */
+
+static gboolean
+_async_process_ack (ArvGvDeviceAsyncOperation *async_op, gssize count)
+{
+	ArvGvcpPacket *ack_packet = async_op->buffer;
+	ArvGvcpPacketType packet_type;
+	ArvGvcpCommand ack_command;
+	ArvGvcpError command_error;
+	GError *local_error = NULL;
+	guint16 packet_id;
+
+	arv_gvcp_packet_debug (ack_packet, ARV_DEBUG_LEVEL_TRACE);
+
+	packet_type = arv_gvcp_packet_get_packet_type (ack_packet);
+	ack_command = arv_gvcp_packet_get_command (ack_packet);
+	packet_id = arv_gvcp_packet_get_packet_id (ack_packet);
+
+	if (packet_id != async_op->packet_id) {
+		arv_info_device ("[GvDevice::%s] Unexpected answer (0x%02x, packet id %u)", async_op->operation_name,
+				 packet_type, packet_id);
+		return TRUE;
+	}
+
+	if (ack_command == ARV_GVCP_COMMAND_PENDING_ACK &&
+	    count >= arv_gvcp_packet_get_pending_ack_size ()) {
+		gint64 pending_ack_timeout_ms = arv_gvcp_packet_get_pending_ack_timeout (ack_packet);
+
+		arv_debug_device ("[GvDevice::%s] Pending ack timeout = %" G_GINT64_FORMAT,
+				  async_op->operation_name, pending_ack_timeout_ms);
+
+		_async_set_timeout (async_op, pending_ack_timeout_ms);
+
+		return TRUE;
+	}
+
+	if (packet_type == ARV_GVCP_PACKET_TYPE_ERROR ||
+	    packet_type == ARV_GVCP_PACKET_TYPE_UNKNOWN_ERROR) {
+		if (ack_command != async_op->expected_ack_command) {
+			arv_info_device ("[GvDevice::%s] Unexpected answer (0x%02x)", async_op->operation_name,
+					 packet_type);
+			return TRUE;
+		}
+
+		command_error = arv_gvcp_packet_get_packet_flags (ack_packet);
+		_async_complete (async_op, g_error_new (ARV_DEVICE_ERROR,
+							arv_gvcp_error_to_device_error (command_error),
+							"GigEVision %s error (%s)", async_op->operation_name,
+							arv_gvcp_error_to_string (command_error)));
+		return FALSE;
+	}
+
+	if (packet_type != ARV_GVCP_PACKET_TYPE_ACK ||
+	    ack_command != async_op->expected_ack_command ||
+	    count < async_op->ack_size) {
+		arv_info_device ("[GvDevice::%s] Unexpected answer (0x%02x)", async_op->operation_name,
+				 packet_type);
+		return TRUE;
+	}
+
+	switch (async_op->command) {
+		case ARV_GVCP_COMMAND_READ_MEMORY_CMD:
+			memcpy (((char *) async_op->operation->buffer) + async_op->offset,
+				arv_gvcp_packet_get_read_memory_ack_data (ack_packet), async_op->block_size);
+			break;
+		case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
+			async_op->operation->register_value = arv_gvcp_packet_get_read_registers_ack_value (ack_packet, 0);
+			break;
+		default:
+			break;
+	}
+
+	async_op->offset += async_op->block_size;
+
+	if (async_op->offset >= async_op->size) {
+		_async_complete (async_op, NULL);
+		return FALSE;
+	}
+
+	/* Next block of a memory operation */
+	if (g_cancellable_set_error_if_cancelled (g_task_get_cancellable (async_op->task), &local_error)) {
+		_async_complete (async_op, local_error);
+		return FALSE;
+	}
+
+	_async_prepare_block (async_op);
+	_async_send (async_op);
+
+	return TRUE;
+}
+
+static gboolean
+_async_socket_cb (GSocket *socket, GIOCondition condition, gpointer user_data)
+{
+	ArvGvDeviceAsyncOperation *async_op = user_data;
+	ArvGvDeviceIOData *io_data = async_op->io_data;
+	GError *local_error = NULL;
+	gssize count;
+
+	/* The current owner of the io lock consumes the incoming packets and stashes ours. Stop watching the socket
+	 * until the lock is released, instead of being woken up again and again by the same readable socket. */
+	if (!g_mutex_trylock (&io_data->mutex)) {
+		g_clear_pointer (&async_op->socket_source, g_source_unref);
+
+		async_op->rearm_source = g_timeout_source_new (ARV_GV_DEVICE_ASYNC_LOCK_RETRY_MS);
+		g_source_set_callback (async_op->rearm_source, _async_rearm_cb, async_op, NULL);
+		g_source_attach (async_op->rearm_source, async_op->context);
+
+		return G_SOURCE_REMOVE;
+	}
+
+	count = g_socket_receive_with_blocking (socket, async_op->buffer, ARV_GV_DEVICE_BUFFER_SIZE, FALSE,
+						NULL, &local_error);
+	if (count > 0)
+		_capture_packet (io_data, FALSE, async_op->buffer, count);
+
+	g_mutex_unlock (&io_data->mutex);
+
+	if (count < (gssize) sizeof (ArvGvcpHeader)) {
+		if (local_error != NULL && !g_error_matches (local_error, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK))
+			arv_warning_device ("[GvDevice::%s] Ack reception error: %s", async_op->operation_name,
+					    local_error->message);
+		g_clear_error (&local_error);
+		return G_SOURCE_CONTINUE;
+	}
+
+	return _async_process_ack (async_op, count) ? G_SOURCE_CONTINUE : G_SOURCE_REMOVE;
+}
+
+static gboolean
+_async_stash_cb (gpointer user_data)
+{
+	ArvGvDeviceAsyncOperation *async_op = user_data;
+	ArvGvDeviceIOData *io_data = async_op->io_data;
+	size_t count;
+
+	g_mutex_lock (&io_data->async_mutex);
+	count = async_op->stash_size;
+	memcpy (async_op->buffer, async_op->stash, count);
+	async_op->stash_size = 0;
+	g_clear_pointer (&async_op->stash_source, g_source_unref);
+	g_mutex_unlock (&io_data->async_mutex);
+
+	if (count > 0)
+		_async_process_ack (async_op, count);
+
+	return G_SOURCE_REMOVE;
+}
+
+static gboolean
+arv_gv_device_start_io_operation (ArvDevice *device, GTask *task)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (ARV_GV_DEVICE (device));
+	ArvDeviceIOOperation *operation = g_task_get_task_data (task);
+	ArvGvDeviceAsyncOperation *async_op;
+
+	async_op = g_new0 (ArvGvDeviceAsyncOperation, 1);
+
+	switch (operation->type) {
+		case ARV_DEVICE_IO_OPERATION_READ_MEMORY:
+			async_op->command = ARV_GVCP_COMMAND_READ_MEMORY_CMD;
+			async_op->expected_ack_command = ARV_GVCP_COMMAND_READ_MEMORY_ACK;
+			async_op->operation_name = "read_memory_async";
+			async_op->size = operation->size;
+			break;
+		case ARV_DEVICE_IO_OPERATION_WRITE_MEMORY:
+			async_op->command = ARV_GVCP_COMMAND_WRITE_MEMORY_CMD;
+			async_op->expected_ack_command = ARV_GVCP_COMMAND_WRITE_MEMORY_ACK;
+			async_op->operation_name = "write_memory_async";
+			async_op->ack_size = arv_gvcp_packet_get_write_memory_ack_size ();
+			async_op->size = operation->size;
+			break;
+		case ARV_DEVICE_IO_OPERATION_READ_REGISTER:
+			async_op->command = ARV_GVCP_COMMAND_READ_REGISTER_CMD;
+			async_op->expected_ack_command = ARV_GVCP_COMMAND_READ_REGISTER_ACK;
+			async_op->operation_name = "read_register_async";
+			async_op->ack_size = arv_gvcp_packet_get_read_registers_ack_size (1);
+			async_op->size = sizeof (guint32);
+			break;
+		case ARV_DEVICE_IO_OPERATION_WRITE_REGISTER:
+			async_op->command = ARV_GVCP_COMMAND_WRITE_REGISTER_CMD;
+			async_op->expected_ack_command = ARV_GVCP_COMMAND_WRITE_REGISTER_ACK;
+			async_op->operation_name = "write_register_async";
+			async_op->ack_size = arv_gvcp_packet_get_write_register_ack_size ();
+			async_op->size = sizeof (guint32);
+			break;
+		default:
+			g_free (async_op);
+			return FALSE;
+	}
+
+	/* Empty transfers are left to the blocking path */
+	if (async_op->size == 0) {
+		g_free (async_op);
+		return FALSE;
+	}
+
+	async_op->io_data = priv->io_data;
+	async_op->device = device;
+	async_op->task = task;
+	async_op->operation = operation;
+	async_op->context = g_task_get_context (task);
+	async_op->buffer = g_malloc (ARV_GV_DEVICE_BUFFER_SIZE);
+	async_op->stash = g_malloc (ARV_GV_DEVICE_BUFFER_SIZE);
+
+	_async_prepare_block (async_op);
+
+	/* Operations are serialized by ArvDevice, there is at most one at a time */
+	g_mutex_lock (&priv->io_data->async_mutex);
+	g_warn_if_fail (priv->io_data->async_op == NULL);
+	priv->io_data->async_op = async_op;
+	g_mutex_unlock (&priv->io_data->async_mutex);
+
+	_async_watch_socket (async_op);
+
+	/* The first command is sent from the main context of the caller, which may not be the current thread */
+	_async_set_timeout (async_op, 0);
+
+	return TRUE;
+}
+
 /* Heartbeat thread */
 
 typedef struct {
@@ -1257,8 +2121,231 @@ arv_gv_device_is_controller (ArvGvDevice *gv_device)
 	return priv->io_data->is_controller;
 }
 
+/* Device identity used as Genicam cache key, retrieved using a single read memory command */
+
 static char *
-_load_genicam (ArvGvDevice *gv_device, guint32 address, size_t  *size, char **url, GError **error)
+_dup_genicam_cache_key (ArvGvDevice *gv_device, const char *url)
+{
+	char data[ARV_GVBS_SERIAL_NUMBER_OFFSET + ARV_GVBS_SERIAL_NUMBER_SIZE - ARV_GVBS_MANUFACTURER_NAME_OFFSET];
+	char *vendor;
+	char *model;
+	char *version;
+	char *serial;
+	char *key;
+
+	if (!arv_gv_device_read_memory (ARV_DEVICE (gv_device), ARV_GVBS_MANUFACTURER_NAME_OFFSET, sizeof (data),
+					data, NULL))
+		return NULL;
+
+	vendor = g_strndup (data, ARV_GVBS_MANUFACTURER_NAME_SIZE);
+	model = g_strndup (data + ARV_GVBS_MODEL_NAME_OFFSET - ARV_GVBS_MANUFACTURER_NAME_OFFSET,
+			   ARV_GVBS_MODEL_NAME_SIZE);
+	version = g_strndup (data + ARV_GVBS_DEVICE_VERSION_OFFSET - ARV_GVBS_MANUFACTURER_NAME_OFFSET,
+			     ARV_GVBS_DEVICE_VERSION_SIZE);
+	serial = g_strndup (data + ARV_GVBS_SERIAL_NUMBER_OFFSET - ARV_GVBS_MANUFACTURER_NAME_OFFSET,
+			    ARV_GVBS_SERIAL_NUMBER_SIZE);
+
+	key = arv_genicam_cache_dup_key (vendor, model, version, serial, url);
+
+	g_free (vendor);
+	g_free (model);
+	g_free (version);
+	g_free (serial);
+
+	return key;
+}
+
+typedef struct {
+        GByteArray *xml;
+        ArvDomPushParser *parser;
+} ArvGvDeviceGenicamStream;
+
+static void
+_genicam_stream_callback (const void *data, size_t size, void *user_data)
+{
+        ArvGvDeviceGenicamStream *stream = user_data;
+
+        g_byte_array_append (stream->xml, data, size);
+        if (stream->parser != NULL)
+                arv_dom_push_parser_push (stream->parser, data, size);
+}
+
+/* Downloads the Genicam data by segments of pipelined read memory commands. Once a segment is received, the first
+ * commands of the next one are sent, and the segment is inflated and parsed while their acknowledges are on their way.
+ * The io lock is held during the whole download, other transactions would drop the acknowledges of the next segment.
+ * Returns NULL without error if the zip layout does not allow streaming. */
+
+static char *
+_stream_genicam (ArvGvDevice *gv_device, guint64 file_address, guint64 file_size, gboolean is_zipped,
+                 size_t *size, ArvDomDocument **document, GError **error)
+{
+        ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
+        ArvGvDeviceIOData *io_data = priv->io_data;
+        ArvGvDeviceGenicamStream stream;
+        ArvGvDevicePipelinedRead read;
+        ArvZipStream *zip_stream = NULL;
+        guint64 offset;
+        size_t segment_size = ARV_GV_DEVICE_GVCP_N_PIPELINED_BLOCKS * ARV_GVCP_DATA_SIZE_MAX;
+        char *segments[2];
+        unsigned int current = 0;
+        gboolean read_pending;
+        gboolean success = TRUE;
+
+        stream.xml = g_byte_array_sized_new (is_zipped ? 4 * file_size : file_size + 1);
+        stream.parser = document != NULL ? arv_dom_push_parser_new () : NULL;
+
+        if (is_zipped) {
+                arv_info_device ("[GvDevice::load_genicam] Zipped xml data");
+                zip_stream = arv_zip_stream_new (_genicam_stream_callback, &stream);
+        }
+
+        segments[0] = g_malloc (segment_size);
+        segments[1] = g_malloc (segment_size);
+
+        g_mutex_lock (&io_data->mutex);
+
+        read_pending = _pipelined_read_start (io_data, &read, file_address, MIN (segment_size, file_size),
+                                              segments[0]);
+        success = read_pending;
+
+        for (offset = 0; offset < file_size && success; offset += segment_size) {
+                size_t n_bytes = MIN (segment_size, file_size - offset);
+                guint64 next_offset = offset + segment_size;
+                char *segment = segments[current];
+
+                read_pending = FALSE;
+                if (!_pipelined_read_finish (io_data, &read, error)) {
+                        success = FALSE;
+                        break;
+                }
+
+                if (next_offset < file_size) {
+                        current = 1 - current;
+                        read_pending = _pipelined_read_start (io_data, &read, file_address + next_offset,
+                                                              MIN (segment_size, file_size - next_offset),
+                                                              segments[current]);
+                        if (!read_pending) {
+                                success = FALSE;
+                                break;
+                        }
+                }
+
+                if (arv_debug_check (ARV_DEBUG_CATEGORY_MISC, ARV_DEBUG_LEVEL_DEBUG)) {
+                        GString *string = g_string_new ("");
+
+                        g_string_append_printf (string,
+                                                "[GvDevice::load_genicam] Raw data at 0x%" G_GINT64_MODIFIER "x "
+                                                "size = 0x%" G_GSIZE_MODIFIER "x\n", offset, n_bytes);
+                        arv_g_string_append_hex_dump (string, segment, n_bytes);
+
+                        arv_debug_misc ("%s", string->str);
+
+                        g_string_free (string, TRUE);
+                }
+
+                if (zip_stream != NULL) {
+                        if (!arv_zip_stream_push (zip_stream, segment, n_bytes))
+                                success = FALSE;
+                } else
+                        _genicam_stream_callback (segment, n_bytes, &stream);
+        }
+
+        if (read_pending)
+                _pipelined_read_cancel (&read);
+
+        g_mutex_unlock (&io_data->mutex);
+
+        if (success && zip_stream != NULL && !arv_zip_stream_is_done (zip_stream))
+                success = FALSE;
+
+        if (!success && zip_stream != NULL && (error == NULL || *error == NULL))
+                arv_info_device ("[GvDevice::load_genicam] Zip data not streamable, fall back to full download");
+
+        g_free (segments[0]);
+        g_free (segments[1]);
+        if (zip_stream != NULL)
+                arv_zip_stream_free (zip_stream);
+
+        if (stream.parser != NULL) {
+                ArvDomDocument *parsed_document = arv_dom_push_parser_finish (stream.parser, NULL);
+
+                if (success)
+                        *document = parsed_document;
+                else
+                        g_clear_object (&parsed_document);
+        }
+
+        if (!success) {
+                g_byte_array_unref (stream.xml);
+                return NULL;
+        }
+
+        *size = stream.xml->len;
+
+        /* Keep the xml data null terminated */
+        g_byte_array_append (stream.xml, (guint8 *) "", 1);
+
+        return (char *) g_byte_array_free (stream.xml, FALSE);
+}
+
+static char *
+_read_genicam (ArvGvDevice *gv_device, guint64 file_address, guint64 file_size, gboolean is_zipped,
+               size_t *size, GError **error)
+{
+        char *genicam;
+
+        genicam = g_malloc (file_size);
+        if (!arv_gv_device_read_memory (ARV_DEVICE (gv_device), file_address, file_size, genicam, error)) {
+                g_free (genicam);
+                return NULL;
+        }
+
+        if (arv_debug_check (ARV_DEBUG_CATEGORY_MISC, ARV_DEBUG_LEVEL_DEBUG)) {
+                GString *string = g_string_new ("");
+
+                g_string_append_printf (string,
+                                        "[GvDevice::load_genicam] Raw data size = 0x%"
+                                        G_GINT64_MODIFIER "x\n", file_size);
+                arv_g_string_append_hex_dump (string, genicam, file_size);
+
+                arv_debug_misc ("%s", string->str);
+
+                g_string_free (string, TRUE);
+        }
+
+        if (is_zipped) {
+                ArvZip *zip;
+                const GSList *zip_files;
+
+                zip = arv_zip_new (genicam, file_size);
+                zip_files = arv_zip_get_file_list (zip);
+
+                if (zip_files != NULL) {
+                        const char *zip_filename;
+                        void *tmp_buffer;
+                        size_t tmp_buffer_size;
+
+                        zip_filename = arv_zip_file_get_name (zip_files->data);
+                        tmp_buffer = arv_zip_get_file (zip, zip_filename, &tmp_buffer_size);
+
+                        g_free (genicam);
+                        *size = tmp_buffer_size;
+                        genicam = tmp_buffer;
+                } else {
+                        arv_warning_device ("[GvDevice::load_genicam] Invalid format");
+                        g_clear_pointer (&genicam, g_free);
+                }
+                arv_zip_free (zip);
+        } else {
+                *size = file_size;
+        }
+
+        return genicam;
+}
+
+static char *
+_load_genicam (ArvGvDevice *gv_device, guint32 address, size_t  *size, char **url,
+               ArvDomDocument **document, GError **error)
 {
         GError *local_error = NULL;
 	char filename[ARV_GVBS_XML_URL_SIZE];
@@ -1267,12 +2354,17 @@ _load_genicam (ArvGvDevice *gv_device, guint32 address, size_t  *size, char **ur
 	char *path = NULL;
 	guint64 file_address;
 	guint64 file_size;
+	char *cache_key = NULL;
+	char check_data[ARV_GVCP_DATA_SIZE_MAX];
+	size_t check_size = 0;
 
 	g_return_val_if_fail (size != NULL, NULL);
         g_return_val_if_fail (url != NULL, NULL);
 
 	*size = 0;
         *url = NULL;
+        if (document != NULL)
+                *document = NULL;
 
 	if (!arv_gv_device_read_memory (ARV_DEVICE (gv_device), address, ARV_GVBS_XML_URL_SIZE, filename, error))
 		return NULL;
@@ -1297,59 +2389,36 @@ _load_genicam (ArvGvDevice *gv_device, guint32 address, size_t  *size, char **ur
                         arv_info_device ("[GvDevice::load_genicam] Xml address = 0x%" G_GINT64_MODIFIER "x - "
                                          "size = 0x%" G_GINT64_MODIFIER "x - %s", file_address, file_size, path);
 
-                        if (file_size > 0) {
-                                genicam = g_malloc (file_size);
-                                if (arv_gv_device_read_memory (ARV_DEVICE (gv_device), file_address, file_size,
-                                                               genicam, &local_error)) {
-
-                                        if (arv_debug_check (ARV_DEBUG_CATEGORY_MISC, ARV_DEBUG_LEVEL_DEBUG)) {
-                                                GString *string = g_string_new ("");
-
-                                                g_string_append_printf (string,
-                                                                        "[GvDevice::load_genicam] Raw data size = 0x%"
-                                                                        G_GINT64_MODIFIER "x\n", file_size);
-                                                arv_g_string_append_hex_dump (string, genicam, file_size);
-
-                                                arv_debug_misc ("%s", string->str);
-
-                                                g_string_free (string, TRUE);
-                                        }
-
-                                        if (g_str_has_suffix (path, ".zip")) {
-                                                ArvZip *zip;
-                                                const GSList *zip_files;
-
-                                                arv_info_device ("[GvDevice::load_genicam] Zipped xml data");
-
-                                                zip = arv_zip_new (genicam, file_size);
-                                                zip_files = arv_zip_get_file_list (zip);
-
-                                                if (zip_files != NULL) {
-                                                        const char *zip_filename;
-                                                        void *tmp_buffer;
-                                                        size_t tmp_buffer_size;
-
-                                                        zip_filename = arv_zip_file_get_name (zip_files->data);
-                                                        tmp_buffer = arv_zip_get_file (zip, zip_filename,
-                                                                                       &tmp_buffer_size);
-
-                                                        g_free (genicam);
-                                                        *size = tmp_buffer_size;
-                                                        genicam = tmp_buffer;
-                                                } else {
-                                                        arv_warning_device ("[GvDevice::load_genicam] Invalid format");
-                                                        g_clear_pointer (&genicam, g_free);
-                                                }
-                                                arv_zip_free (zip);
-                                        } else {
-                                                *size = file_size;
-                                        }
-
+                        if (file_size > 0 && arv_genicam_cache_is_enabled ()) {
+                                cache_key = _dup_genicam_cache_key (gv_device, filename);
+                                check_size = MIN (file_size, ARV_GVCP_DATA_SIZE_MAX);
+                                if (cache_key != NULL &&
+                                    arv_gv_device_read_memory (ARV_DEVICE (gv_device), file_address, check_size,
+                                                               check_data, NULL)) {
+                                        genicam = arv_genicam_cache_lookup (cache_key, check_data, check_size,
+                                                                            size);
                                         if (genicam != NULL)
                                                 *url = g_strdup_printf ("%s:///%s;%lx;%lx", scheme, path,
                                                                         file_address, file_size);
-                                } else {
-                                        g_clear_pointer (&genicam, g_free);
+                                } else
+                                        g_clear_pointer (&cache_key, g_free);
+                        }
+
+                        if (file_size > 0 && genicam == NULL) {
+                                gboolean is_zipped = g_str_has_suffix (path, ".zip");
+
+                                genicam = _stream_genicam (gv_device, file_address, file_size, is_zipped,
+                                                           size, document, &local_error);
+                                if (genicam == NULL && local_error == NULL)
+                                        genicam = _read_genicam (gv_device, file_address, file_size, is_zipped,
+                                                                 size, &local_error);
+
+                                if (genicam != NULL) {
+                                        *url = g_strdup_printf ("%s:///%s;%lx;%lx", scheme, path,
+                                                                file_address, file_size);
+                                        if (cache_key != NULL)
+                                                arv_genicam_cache_store (cache_key, check_data, check_size,
+                                                                         genicam, *size);
                                 }
                         }
                 } else if (g_ascii_strcasecmp (scheme, "http")) {
@@ -1386,6 +2455,7 @@ _load_genicam (ArvGvDevice *gv_device, guint32 address, size_t  *size, char **ur
 
 	g_free (scheme);
 	g_free (path);
+	g_free (cache_key);
 
 	return genicam;
 }
@@ -1816,6 +2886,8 @@ static void
 arv_gv_device_load_genicam (ArvGvDevice *gv_device, GError **error)
 {
 	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
+        ArvDomDocument *document = NULL;
+        ArvDomDocument **document_ptr;
         GError *local_error = NULL;
         char *url = NULL;
 	char *xml;
@@ -1823,12 +2895,16 @@ arv_gv_device_load_genicam (ArvGvDevice *gv_device, GError **error)
 
 	size = 0;
 
-	xml = _load_genicam (gv_device, ARV_GVBS_XML_URL_0_OFFSET, &size, &url, &local_error);
+        /* The cache has its own compiled form of the Genicam data, parsing during the download is useless */
+        document_ptr = arv_genicam_cache_is_enabled () ? NULL : &document;
+
+	xml = _load_genicam (gv_device, ARV_GVBS_XML_URL_0_OFFSET, &size, &url, document_ptr, &local_error);
 	if (xml == NULL && local_error == NULL)
-		xml = _load_genicam (gv_device, ARV_GVBS_XML_URL_1_OFFSET, &size, &url, &local_error);
+		xml = _load_genicam (gv_device, ARV_GVBS_XML_URL_1_OFFSET, &size, &url, document_ptr, &local_error);
 
 	if (local_error != NULL) {
 		g_propagate_error (error, local_error);
+                g_clear_object (&document);
                 g_free (xml);
                 g_free (url);
 		return;
@@ -1836,7 +2912,12 @@ arv_gv_device_load_genicam (ArvGvDevice *gv_device, GError **error)
 
 	priv->genicam_xml = xml;
 	priv->genicam_xml_size = size;
-        priv->genicam = arv_gc_new (ARV_DEVICE (gv_device), xml, size);
+        if (document != NULL)
+                priv->genicam = arv_gc_new_from_document (ARV_DEVICE (gv_device), document, NULL);
+        else if (arv_genicam_cache_is_enabled ())
+                priv->genicam = arv_genicam_cache_new_gc (ARV_DEVICE (gv_device), xml, size);
+        else
+                priv->genicam = arv_gc_new (ARV_DEVICE (gv_device), xml, size);
         arv_gc_set_default_gv_features(priv->genicam);
         arv_dom_document_set_url (ARV_DOM_DOCUMENT(priv->genicam), url);
 
@@ -1943,6 +3024,46 @@ arv_gv_device_set_stream_options (ArvGvDevice *gv_device, ArvGvStreamOption opti
 	priv->stream_options = options;
 }
 
+/*
+ * Tees the GVCP commands and acknowledges exchanged by the control thread and the heartbeat thread to @writer, or stops
+ * the capture if @writer is %NULL.
+ */
+
+void
+arv_gv_device_set_pcap_writer (ArvGvDevice *gv_device, ArvPcapWriter *writer)
+{
+	ArvGvDevicePrivate *priv = arv_gv_device_get_instance_private (gv_device);
+	ArvGvDeviceIOData *io_data;
+	GSocketAddress *local_address;
+
+	g_return_if_fail (ARV_IS_GV_DEVICE (gv_device));
+	g_return_if_fail (priv->io_data != NULL);
+
+	io_data = priv->io_data;
+
+	g_mutex_lock (&io_data->mutex);
+
+	g_clear_pointer (&io_data->pcap_writer, arv_pcap_writer_unref);
+
+	local_address = g_socket_get_local_address (io_data->socket, NULL);
+	if (writer != NULL && G_IS_INET_SOCKET_ADDRESS (local_address)) {
+		const guint8 *bytes;
+
+		bytes = g_inet_address_to_bytes (priv->interface_address);
+		io_data->pcap_interface_ip = g_ntohl (*((guint32 *) bytes));
+		io_data->pcap_interface_port =
+			g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS (local_address));
+		bytes = g_inet_address_to_bytes (priv->device_address);
+		io_data->pcap_device_ip = g_ntohl (*((guint32 *) bytes));
+
+		io_data->pcap_writer = arv_pcap_writer_ref (writer);
+	}
+
+	g_mutex_unlock (&io_data->mutex);
+
+	g_clear_object (&local_address);
+}
+
 /**
  * arv_gv_device_new:
  * @interface_address: address of the interface connected to the device
@@ -1996,6 +3117,7 @@ arv_gv_device_constructed (GObject *object)
 	io_data = g_new0 (ArvGvDeviceIOData, 1);
 
 	g_mutex_init (&io_data->mutex);
+	g_mutex_init (&io_data->async_mutex);
 
 	io_data->packet_id = 65300; /* Start near the end of the circular counter */
 
@@ -2016,6 +3138,7 @@ arv_gv_device_constructed (GObject *object)
 	io_data->buffer = g_malloc (ARV_GV_DEVICE_BUFFER_SIZE);
 	io_data->gvcp_n_retries = ARV_GV_DEVICE_GVCP_N_RETRIES_DEFAULT;
 	io_data->gvcp_timeout_ms = ARV_GV_DEVICE_GVCP_TIMEOUT_MS_DEFAULT;
+	io_data->gvcp_window_size = priv->gvcp_window_size;
 	io_data->poll_in_event.fd = g_socket_get_fd (io_data->socket);
 	io_data->poll_in_event.events =  G_IO_IN;
 	io_data->poll_in_event.revents = 0;
@@ -2107,11 +3230,13 @@ arv_gv_device_finalize (GObject *object)
 		arv_gv_device_leave_control (gv_device, NULL);
 
 	io_data = priv->io_data;
+	g_clear_pointer (&io_data->pcap_writer, arv_pcap_writer_unref);
 	g_clear_object (&io_data->device_address);
 	g_clear_object (&io_data->interface_address);
 	g_clear_object (&io_data->socket);
 	g_clear_pointer (&io_data->buffer, g_free);
 	g_mutex_clear (&io_data->mutex);
+	g_mutex_clear (&io_data->async_mutex);
 
 	arv_gpollfd_finish_all (&io_data->poll_in_event, 1);
 
@@ -2176,6 +3301,14 @@ arv_gv_device_set_property (GObject *self, guint prop_id, const GValue *value, G
 		case PROP_GV_DEVICE_PACKET_SIZE_ADJUSTEMENT:
 			priv->packet_size_adjustment = g_value_get_enum (value);
 			break;
+		case PROP_GV_DEVICE_GVCP_WINDOW_SIZE:
+			priv->gvcp_window_size = g_value_get_uint (value);
+			if (priv->io_data != NULL) {
+				g_mutex_lock (&priv->io_data->mutex);
+				priv->io_data->gvcp_window_size = priv->gvcp_window_size;
+				g_mutex_unlock (&priv->io_data->mutex);
+			}
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
 			break;
@@ -2191,12 +3324,27 @@ arv_gv_device_get_property (GObject *object, guint prop_id, GValue *value, GPara
 		case PROP_GV_DEVICE_PACKET_SIZE_ADJUSTEMENT:
 			g_value_set_enum (value, priv->packet_size_adjustment);
 			break;
+		case PROP_GV_DEVICE_GVCP_WINDOW_SIZE:
+			/* The window may have been reduced after timeouts */
+			if (priv->io_data != NULL) {
+				g_mutex_lock (&priv->io_data->mutex);
+				g_value_set_uint (value, priv->io_data->gvcp_window_size);
+				g_mutex_unlock (&priv->io_data->mutex);
+			} else
+				g_value_set_uint (value, priv->gvcp_window_size);
+			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
 			break;
 	}
 }
 
+static const ArvDeviceIOFunctions arv_gv_device_io_functions = {
+	.read_registers = arv_gv_device_read_registers,
+	.write_registers = arv_gv_device_write_registers,
+	.start_io_operation = arv_gv_device_start_io_operation,
+};
+
 static void
 arv_gv_device_class_init (ArvGvDeviceClass *gv_device_class)
 {
@@ -2216,6 +3364,8 @@ arv_gv_device_class_init (ArvGvDeviceClass *gv_device_class)
 	device_class->read_register = arv_gv_device_read_register;
 	device_class->write_register = arv_gv_device_write_register;
 
+	arv_device_class_set_io_functions (device_class, &arv_gv_device_io_functions);
+
 	g_object_class_install_property
 		(object_class,
 		 PROP_GV_DEVICE_INTERFACE_ADDRESS,
@@ -2239,4 +3389,21 @@ arv_gv_device_class_init (ArvGvDeviceClass *gv_device_class)
 							    ARV_GV_PACKET_SIZE_ADJUSTMENT_DEFAULT,
 							    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
 								G_PARAM_CONSTRUCT));
+
+	/**
+	 * ArvGvDevice:gvcp-window-size:
+	 *
+	 * Maximum number of read memory commands sent without waiting for their acknowledge, during the transfer of
+	 * large memory blocks. The default of 1 waits for each acknowledge, larger values speed up the transfers on
+	 * devices able to queue commands. The window is halved if commands time out while others are in flight.
+	 *
+	 * Since: 0.8.32
+	 */
+	g_object_class_install_property (object_class, PROP_GV_DEVICE_GVCP_WINDOW_SIZE,
+					 g_param_spec_uint ("gvcp-window-size", "GVCP window size",
+							    "Maximum number of outstanding read memory commands",
+							    1, ARV_GV_DEVICE_GVCP_N_PIPELINED_BLOCKS,
+							    ARV_GV_DEVICE_GVCP_WINDOW_SIZE_DEFAULT,
+							    G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+								G_PARAM_CONSTRUCT));
 }
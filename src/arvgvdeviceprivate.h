@@ -28,6 +28,7 @@
 #endif
 
 #include <arvgvdevice.h>
+#include <arvpcapwriterprivate.h>
 
 G_BEGIN_DECLS
 
@@ -49,9 +50,19 @@ G_BEGIN_DECLS
 
 #define ARV_GV_DEVICE_BUFFER_SIZE	1024
 
+/* Maximum number of outstanding read memory commands, and number of blocks read under a single io lock. Devices are
+ * not required to queue commands, pipelining is only enabled through the gvcp-window-size property. */
+#define ARV_GV_DEVICE_GVCP_WINDOW_SIZE_DEFAULT	1
+#define ARV_GV_DEVICE_GVCP_N_PIPELINED_BLOCKS	32
+
+/* Delay before an asynchronous operation retries to acquire the io lock */
+#define ARV_GV_DEVICE_ASYNC_LOCK_RETRY_MS	1
+
 GRegex * 		arv_gv_device_get_url_regex 			(void);
 void                    arv_gc_set_default_gv_features                  (ArvGc *genicam);
 
+void			arv_gv_device_set_pcap_writer			(ArvGvDevice *gv_device, ArvPcapWriter *writer);
+
 G_END_DECLS
 
 #endif
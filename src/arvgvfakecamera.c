@@ -20,14 +20,26 @@
  * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
  */
 
+/* Needed for sendmmsg */
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
 #include <arvgvfakecamera.h>
+#include <arvgvfakecameraprivate.h>
 #include <arvfakecamera.h>
 #include <arvbufferprivate.h>
 #include <arvgvcpprivate.h>
 #include <arvgvspprivate.h>
+#include <arvgvfakeimpairmentprivate.h>
 #include <arvmisc.h>
 #include <arvmiscprivate.h>
 #include <arvnetworkprivate.h>
+#include <string.h>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <errno.h>
+#endif
 
 /**
  * SECTION: arvgvfakecamera
@@ -38,6 +50,9 @@
 
 #define ARV_GV_FAKE_CAMERA_BUFFER_SIZE	65536
 
+#define ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES	4
+#define ARV_GV_FAKE_CAMERA_SEND_BATCH_SIZE	64
+
 enum {
 	ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GVCP = 0,
 	ARV_GV_FAKE_CAMERA_INPUT_SOCKET_GLOBAL_DISCOVERY,
@@ -52,9 +67,121 @@ enum
   PROP_SERIAL_NUMBER,
   PROP_GENICAM_FILENAME,
   PROP_GVSP_LOST_PACKET_RATIO,
+  PROP_GVSP_HIGH_RATE,
+  PROP_GVSP_BIT_RATE,
+  PROP_GVSP_IMPAIRMENT,
   PROP_CM_DOMAIN
 };
 
+enum {
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_FRAMES = 0,
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_PACKETS,
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_DROPPED_PACKETS,
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_DUPLICATED_PACKETS,
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_REORDERED_PACKETS,
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_TRUNCATED_PACKETS,
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_DELAYED_PACKETS,
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_RESEND_REQUESTS,
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_RESENT_PACKETS,
+	ARV_GV_FAKE_CAMERA_STATISTIC_N_RESENT_FRAMES,
+	ARV_GV_FAKE_CAMERA_STATISTIC_RESEND_RECOVERY_TIME_US,
+	ARV_GV_FAKE_CAMERA_STATISTIC_MAX_RESEND_RECOVERY_TIME_US,
+	ARV_GV_FAKE_CAMERA_N_STATISTICS
+};
+
+static const char *statistic_names[ARV_GV_FAKE_CAMERA_N_STATISTICS] = {
+	"n_frames",
+	"n_packets",
+	"n_dropped_packets",
+	"n_duplicated_packets",
+	"n_reordered_packets",
+	"n_truncated_packets",
+	"n_delayed_packets",
+	"n_resend_requests",
+	"n_resent_packets",
+	"n_resent_frames",
+	"resend_recovery_time_us",
+	"max_resend_recovery_time_us"
+};
+
+static const guint32 frame_cache_key_registers[] = {
+	ARV_FAKE_CAMERA_REGISTER_WIDTH,
+	ARV_FAKE_CAMERA_REGISTER_HEIGHT,
+	ARV_FAKE_CAMERA_REGISTER_X_OFFSET,
+	ARV_FAKE_CAMERA_REGISTER_Y_OFFSET,
+	ARV_FAKE_CAMERA_REGISTER_BINNING_HORIZONTAL,
+	ARV_FAKE_CAMERA_REGISTER_BINNING_VERTICAL,
+	ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT,
+	ARV_FAKE_CAMERA_REGISTER_EXPOSURE_TIME_US,
+	ARV_FAKE_CAMERA_REGISTER_GAIN_RAW,
+	ARV_FAKE_CAMERA_REGISTER_CHUNK_MODE_ACTIVE,
+	ARV_FAKE_CAMERA_REGISTER_CHUNK_ENABLE + 4 * ARV_FAKE_CAMERA_CHUNK_WIDTH,
+	ARV_FAKE_CAMERA_REGISTER_CHUNK_ENABLE + 4 * ARV_FAKE_CAMERA_CHUNK_HEIGHT,
+	ARV_FAKE_CAMERA_REGISTER_MULTIPART,
+	ARV_FAKE_CAMERA_REGISTER_MULTIPART_N_PARTS,
+	ARV_FAKE_CAMERA_REGISTER_EXTENDED_ID_MODE,
+	ARV_GVBS_STREAM_CHANNEL_0_PACKET_SIZE_OFFSET
+};
+
+#define ARV_GV_FAKE_CAMERA_N_FRAME_CACHE_KEYS	G_N_ELEMENTS (frame_cache_key_registers)
+
+typedef struct {
+	guint8 *data;
+	guint32 *sizes;
+	guint n_packets;
+} ArvGvFakeCameraFrame;
+
+/* Packetized frames of the high rate mode, the frame id and the timestamp are patched before each transmission */
+
+typedef struct {
+	ArvGvFakeCameraFrame frames[ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES];
+	guint index;
+	size_t stride;
+	gboolean extended_ids;
+	guint32 keys[ARV_GV_FAKE_CAMERA_N_FRAME_CACHE_KEYS];
+} ArvGvFakeCameraFrameCache;
+
+/* Recently sent frames, kept for the packet resend requests. In high rate mode, they point to the frame cache, which has
+ * the same depth. Otherwise, the packets are generated again from the image buffer of the entry. */
+
+typedef struct {
+	guint64 frame_id;
+	ArvBuffer *buffer;
+	ArvGvFakeCameraFrame *frame;
+	size_t stride;
+	gboolean extended_ids;
+	size_t data_size;
+	size_t frame_size;
+	guint32 n_packets;
+	gint64 end_time_us;
+	gint64 recovery_time_us;
+	gboolean has_resent_packets;
+} ArvGvFakeCameraHistoryEntry;
+
+typedef struct {
+	guint64 frame_id;
+	guint32 first_block;
+	guint32 last_block;
+	gboolean extended_ids;
+	gint64 due_time_us;
+} ArvGvFakeCameraResendRequest;
+
+typedef struct {
+	GSocketAddress *stream_address;
+	GInputVector input_vector;
+	guint8 *packet_buffer;
+	size_t payload;
+	gboolean is_streaming;
+	guint64 next_timestamp_us;
+
+	/* Frame in transmission, sent by batches of due packets */
+	ArvGvFakeCameraHistoryEntry *entry;
+	guint32 block_id;
+	double deadline_us;
+	double packet_delay_us;
+	double bit_rate;
+} ArvGvFakeCameraSender;
+
 typedef struct {
 	char *interface_name;
 	char *serial_number;
@@ -78,6 +205,30 @@ typedef struct {
 	gboolean cancel;
 
 	double gvsp_lost_packet_ratio;
+
+	gboolean gvsp_high_rate;
+	double gvsp_bit_rate;
+	ArvGvFakeCameraFrameCache *frame_cache;
+	guint64 gvsp_frame_id;
+
+	GMutex impairment_mutex;
+	char *gvsp_impairment;
+	ArvGvFakeImpairmentSettings impairment_settings;
+	guint impairment_generation;
+
+	/* Owned by the streaming thread */
+	ArvGvFakeCameraSender sender;
+	ArvGvFakeImpairment *impairment;
+	ArvGvFakeImpairmentCounters impairment_counters;
+	guint thread_impairment_generation;
+	guint trailer_delay_us;
+	guint resend_latency_us;
+	ArvGvFakeCameraHistoryEntry history[ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES];
+	guint history_index;
+	GQueue resend_requests;
+
+	GMutex statistics_mutex;
+	guint64 statistics[ARV_GV_FAKE_CAMERA_N_STATISTICS];
 } ArvGvFakeCameraPrivate;
 
 struct _ArvGvFakeCamera {
@@ -112,6 +263,7 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 			ArvGvcpPacket *packet, size_t size)
 {
 	ArvGvcpPacket *ack_packet = NULL;
+	ArvGvFakeCameraResendRequest *resend_request;
 	size_t ack_packet_size;
 	guint32 block_address;
 	guint32 block_size;
@@ -119,6 +271,9 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 	guint16 packet_type;
 	guint32 register_address;
 	guint32 register_value;
+	guint32 register_values[ARV_GVCP_N_REGISTERS_MAX];
+	guint n_registers;
+	guint i;
 	gboolean write_access;
 	gboolean success = FALSE;
 
@@ -186,31 +341,66 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 									   &ack_packet_size);
 			break;
 		case ARV_GVCP_COMMAND_READ_REGISTER_CMD:
-			arv_gvcp_packet_get_read_register_cmd_infos (packet, &register_address);
-			arv_fake_camera_read_register (gv_fake_camera->priv->camera, register_address, &register_value);
-			arv_info_device ("[GvFakeCamera::handle_control_packet] Read register command %d -> %d",
-					  register_address, register_value);
-			ack_packet = arv_gvcp_packet_new_read_register_ack (register_value, packet_id,
-									    &ack_packet_size);
+			n_registers = arv_gvcp_packet_get_read_registers_cmd_n_addresses (packet);
+			if (n_registers == 0 || n_registers > ARV_GVCP_N_REGISTERS_MAX) {
+				arv_warning_device ("[GvFakeCamera::handle_control_packet] Invalid read register count (%u)",
+						    n_registers);
+				break;
+			}
+
+			for (i = 0; i < n_registers; i++) {
+				register_address = arv_gvcp_packet_get_read_registers_cmd_address (packet, i);
+				arv_fake_camera_read_register (gv_fake_camera->priv->camera, register_address,
+							       &register_values[i]);
+				arv_info_device ("[GvFakeCamera::handle_control_packet] Read register command %d -> %d",
+						 register_address, register_values[i]);
 
-			if (register_address == ARV_GVBS_CONTROL_CHANNEL_PRIVILEGE_OFFSET)
-				gv_fake_camera->priv->controller_time = g_get_real_time ();
+				if (register_address == ARV_GVBS_CONTROL_CHANNEL_PRIVILEGE_OFFSET)
+					gv_fake_camera->priv->controller_time = g_get_real_time ();
+			}
 
+			ack_packet = arv_gvcp_packet_new_read_registers_ack (register_values, n_registers, packet_id,
+									     &ack_packet_size);
 			break;
 		case ARV_GVCP_COMMAND_WRITE_REGISTER_CMD:
-			arv_gvcp_packet_get_write_register_cmd_infos (packet, &register_address, &register_value);
+			n_registers = arv_gvcp_packet_get_write_registers_cmd_n_registers (packet);
 			if (!write_access) {
+				arv_gvcp_packet_get_write_register_cmd_infos (packet, &register_address, &register_value);
 				arv_warning_device("[GvFakeCamera::handle_control_packet] Ignore Write register command %d (%d) not controller",
 					register_address, register_value);
 				break;
 			}
 
-			arv_fake_camera_write_register (gv_fake_camera->priv->camera, register_address, register_value);
-			arv_info_device ("[GvFakeCamera::handle_control_packet] Write register command %d -> %d",
-					  register_address, register_value);
-			ack_packet = arv_gvcp_packet_new_write_register_ack (1, packet_id,
+			for (i = 0; i < n_registers; i++) {
+				arv_gvcp_packet_get_write_registers_cmd_infos (packet, i, &register_address, &register_value);
+				arv_fake_camera_write_register (gv_fake_camera->priv->camera, register_address, register_value);
+				arv_info_device ("[GvFakeCamera::handle_control_packet] Write register command %d -> %d",
+						 register_address, register_value);
+			}
+
+			ack_packet = arv_gvcp_packet_new_write_register_ack (n_registers, packet_id,
 									     &ack_packet_size);
 			break;
+		case ARV_GVCP_COMMAND_PACKET_RESEND_CMD:
+			/* Resend requests are not acknowledged, the packets are sent by the streaming thread after the
+			 * configured latency */
+			resend_request = g_new0 (ArvGvFakeCameraResendRequest, 1);
+			arv_gvcp_packet_get_packet_resend_cmd_infos (packet, &resend_request->frame_id,
+								     &resend_request->first_block,
+								     &resend_request->last_block,
+								     &resend_request->extended_ids);
+			resend_request->due_time_us = g_get_monotonic_time () + gv_fake_camera->priv->resend_latency_us;
+			g_queue_push_tail (&gv_fake_camera->priv->resend_requests, resend_request);
+
+			g_mutex_lock (&gv_fake_camera->priv->statistics_mutex);
+			gv_fake_camera->priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_RESEND_REQUESTS]++;
+			g_mutex_unlock (&gv_fake_camera->priv->statistics_mutex);
+
+			arv_info_device ("[GvFakeCamera::handle_control_packet] Packet resend command %" G_GUINT64_FORMAT
+					 " (%u-%u)", resend_request->frame_id,
+					 resend_request->first_block, resend_request->last_block);
+			success = TRUE;
+			break;
 		default:
 			arv_warning_device ("[GvFakeCamera::handle_control_packet] Unknown command");
 	}
@@ -241,203 +431,928 @@ _handle_control_packet (ArvGvFakeCamera *gv_fake_camera, GSocket *socket,
 	return success;
 }
 
-static void *
-_thread (void *user_data)
+static void
+_frame_cache_free (ArvGvFakeCameraFrameCache *cache)
 {
-	ArvGvFakeCamera *gv_fake_camera = user_data;
-	ArvBuffer *image_buffer = NULL;
-	GError *error = NULL;
-	GSocketAddress *stream_address = NULL;
-	void *packet_buffer;
+	unsigned int i;
+
+	if (cache == NULL)
+		return;
+
+	for (i = 0; i < ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES; i++) {
+		g_free (cache->frames[i].data);
+		g_free (cache->frames[i].sizes);
+	}
+
+	g_free (cache);
+}
+
+/* Multipart frames are forced to extended ids, as the number of parts is given in the extended leader header */
+
+static gboolean
+_use_extended_ids (ArvGvFakeCamera *gv_fake_camera, ArvBuffer *image_buffer)
+{
+	guint32 extended_id_mode;
+
+	if (image_buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_MULTIPART)
+		return TRUE;
+
+	arv_fake_camera_read_register (gv_fake_camera->priv->camera, ARV_FAKE_CAMERA_REGISTER_EXTENDED_ID_MODE,
+				       &extended_id_mode);
+
+	return extended_id_mode != 0;
+}
+
+/* Returns the number of packets of a frame, leader and trailer included, or 0 if the packet size is too small. In
+ * multipart mode, a data packet never spans two parts. */
+
+static guint32
+_frame_layout (ArvBuffer *image_buffer, guint32 gv_packet_size, gboolean extended_ids,
+	       size_t *data_size, size_t *frame_size)
+{
+	guint32 n_packets = 0;
+	unsigned int i;
+
+	/* Replayed frames may be smaller than the allocated buffer */
+	*frame_size = image_buffer->priv->received_size;
+	if (*frame_size == 0 || *frame_size > image_buffer->priv->allocated_size)
+		*frame_size = image_buffer->priv->allocated_size;
+
+	if (image_buffer->priv->payload_type == ARV_BUFFER_PAYLOAD_TYPE_MULTIPART) {
+		if (gv_packet_size <= ARV_GVSP_MULTIPART_PACKET_PROTOCOL_OVERHEAD (extended_ids))
+			return 0;
+
+		*data_size = gv_packet_size - ARV_GVSP_MULTIPART_PACKET_PROTOCOL_OVERHEAD (extended_ids);
+		for (i = 0; i < image_buffer->priv->n_parts; i++)
+			n_packets += (image_buffer->priv->parts[i].size + *data_size - 1) / *data_size;
+	} else {
+		if (gv_packet_size <= ARV_GVSP_PAYLOAD_PACKET_PROTOCOL_OVERHEAD (extended_ids))
+			return 0;
+
+		*data_size = gv_packet_size - ARV_GVSP_PAYLOAD_PACKET_PROTOCOL_OVERHEAD (extended_ids);
+		n_packets = (*frame_size + *data_size - 1) / *data_size;
+	}
+
+	return n_packets + 2;
+}
+
+/* Generates the packet @block_id of an image buffer, block 0 being the leader and the last one the trailer */
+
+static void
+_packetize_block (ArvBuffer *image_buffer, guint64 frame_id, gboolean extended_ids,
+		  guint32 block_id, guint32 n_packets,
+		  size_t data_size, size_t frame_size, void *packet, size_t *packet_size)
+{
+	ArvBufferPayloadType payload_type = image_buffer->priv->payload_type;
+	unsigned int i;
+
+	if (block_id == 0) {
+		if (payload_type == ARV_BUFFER_PAYLOAD_TYPE_MULTIPART) {
+			if (arv_gvsp_packet_new_multipart_leader (frame_id, block_id,
+								  arv_buffer_get_timestamp (image_buffer),
+								  image_buffer->priv->n_parts,
+								  packet, packet_size) == NULL)
+				return;
+
+			for (i = 0; i < image_buffer->priv->n_parts; i++) {
+				ArvBufferPartInfos *part = &image_buffer->priv->parts[i];
+
+				arv_gvsp_multipart_leader_packet_set_part_infos (packet, i, part->component_id,
+										 part->data_type, part->size,
+										 part->pixel_format,
+										 part->width, part->height,
+										 part->x_offset, part->y_offset,
+										 part->x_padding, part->y_padding);
+			}
+		} else {
+			arv_gvsp_packet_new_image_leader (frame_id, block_id, extended_ids, payload_type,
+							  arv_buffer_get_timestamp (image_buffer),
+							  arv_buffer_get_image_pixel_format (image_buffer),
+							  arv_buffer_get_image_width (image_buffer),
+							  arv_buffer_get_image_height (image_buffer),
+							  arv_buffer_get_image_x (image_buffer),
+							  arv_buffer_get_image_y (image_buffer),
+							  0, 0,
+							  packet, packet_size);
+		}
+	} else if (block_id == n_packets - 1) {
+		arv_gvsp_packet_new_data_trailer (frame_id, block_id, extended_ids, payload_type, packet, packet_size);
+	} else if (payload_type == ARV_BUFFER_PAYLOAD_TYPE_MULTIPART) {
+		guint32 part_block_id = block_id - 1;
+
+		for (i = 0; i < image_buffer->priv->n_parts; i++) {
+			ArvBufferPartInfos *part = &image_buffer->priv->parts[i];
+			guint32 n_part_packets = (part->size + data_size - 1) / data_size;
+
+			if (part_block_id < n_part_packets) {
+				ptrdiff_t offset = part->data_offset + part_block_id * data_size;
+
+				arv_gvsp_packet_new_multipart (frame_id, block_id, i, offset,
+							       MIN (data_size, part->size - part_block_id * data_size),
+							       ((char *) image_buffer->priv->data) + offset,
+							       packet, packet_size);
+				return;
+			}
+
+			part_block_id -= n_part_packets;
+		}
+	} else {
+		ptrdiff_t offset = (block_id - 1) * data_size;
+
+		arv_gvsp_packet_new_payload (frame_id, block_id, extended_ids, MIN (data_size, frame_size - offset),
+					     ((char *) image_buffer->priv->data) + offset,
+					     packet, packet_size);
+	}
+}
+
+static gboolean
+_frame_cache_packetize (ArvGvFakeCameraFrameCache *cache, ArvGvFakeCameraFrame *frame,
+			ArvBuffer *image_buffer, guint32 gv_packet_size)
+{
+	size_t frame_size;
+	size_t data_size;
 	size_t packet_size;
-	size_t payload = 0;
-	guint16 block_id;
-	ptrdiff_t offset;
+	size_t stride;
+	guint n_packets;
+	guint i;
+
+	n_packets = _frame_layout (image_buffer, gv_packet_size, cache->extended_ids, &data_size, &frame_size);
+	if (n_packets == 0)
+		return FALSE;
+
+	/* Room for the largest packet, either a data packet or a multipart leader */
+	stride = MAX (gv_packet_size - ARV_GVSP_PACKET_UDP_OVERHEAD,
+		      sizeof (ArvGvspPacket) + sizeof (ArvGvspExtendedHeader) + sizeof (ArvGvspMultipartLeader) +
+		      image_buffer->priv->n_parts * sizeof (ArvGvspPartInfos));
+
+	if (cache->stride == 0)
+		cache->stride = stride;
+	else if (stride > cache->stride)
+		return FALSE;
+
+	frame->n_packets = n_packets;
+	frame->data = g_malloc (n_packets * cache->stride);
+	frame->sizes = g_new (guint32, n_packets);
+
+	for (i = 0; i < n_packets; i++) {
+		packet_size = cache->stride;
+		_packetize_block (image_buffer, 0, cache->extended_ids, i, n_packets, data_size, frame_size,
+				  frame->data + i * cache->stride, &packet_size);
+		frame->sizes[i] = packet_size;
+	}
+
+	return TRUE;
+}
+
+static ArvGvFakeCameraHistoryEntry *
+_history_next (ArvGvFakeCameraPrivate *priv)
+{
+	ArvGvFakeCameraHistoryEntry *entry;
+
+	entry = &priv->history[priv->history_index];
+	priv->history_index = (priv->history_index + 1) % ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES;
+
+	entry->frame = NULL;
+	entry->frame_id = 0;
+	entry->n_packets = 0;
+	entry->recovery_time_us = 0;
+	entry->has_resent_packets = FALSE;
+
+	return entry;
+}
+
+static ArvGvFakeCameraHistoryEntry *
+_history_find (ArvGvFakeCameraPrivate *priv, guint64 frame_id, gboolean extended_ids)
+{
+	unsigned int i;
+
+	for (i = 0; i < ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES; i++) {
+		ArvGvFakeCameraHistoryEntry *entry = &priv->history[i];
+
+		if (entry->n_packets > 0 &&
+		    (extended_ids ? entry->frame_id : entry->frame_id & 0xffff) == frame_id)
+			return entry;
+	}
+
+	return NULL;
+}
+
+static void
+_history_clear (ArvGvFakeCameraPrivate *priv, gboolean free_buffers)
+{
+	unsigned int i;
+
+	for (i = 0; i < ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES; i++) {
+		priv->history[i].frame = NULL;
+		priv->history[i].n_packets = 0;
+		if (free_buffers)
+			g_clear_object (&priv->history[i].buffer);
+	}
+}
+
+static void
+_resend_requests_clear (ArvGvFakeCameraPrivate *priv)
+{
+	ArvGvFakeCameraResendRequest *request;
+
+	while ((request = g_queue_pop_head (&priv->resend_requests)) != NULL)
+		g_free (request);
+}
+
+/* Returns the packetized frames, which are only generated again when the image settings have changed */
+
+static ArvGvFakeCameraFrameCache *
+_frame_cache_update (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraFrameCache *cache = gv_fake_camera->priv->frame_cache;
+	ArvBuffer *image_buffer;
+	guint32 keys[ARV_GV_FAKE_CAMERA_N_FRAME_CACHE_KEYS];
 	guint32 gv_packet_size;
-	GInputVector input_vector;
-	int n_events;
-	gboolean is_streaming = FALSE;
+	unsigned int i;
 
-	input_vector.buffer = g_malloc0 (ARV_GV_FAKE_CAMERA_BUFFER_SIZE);
-	input_vector.size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
+	for (i = 0; i < ARV_GV_FAKE_CAMERA_N_FRAME_CACHE_KEYS; i++)
+		arv_fake_camera_read_register (gv_fake_camera->priv->camera, frame_cache_key_registers[i], &keys[i]);
 
-	packet_buffer = g_malloc (ARV_GV_FAKE_CAMERA_BUFFER_SIZE);
+	if (cache != NULL && memcmp (cache->keys, keys, sizeof (keys)) == 0)
+		return cache;
 
-	do {
-		guint64 next_timestamp_us;
+	_frame_cache_free (cache);
+	gv_fake_camera->priv->frame_cache = NULL;
+	_history_clear (gv_fake_camera->priv, FALSE);
 
-		if (is_streaming) {
-			arv_fake_camera_get_sleep_time_for_next_frame (gv_fake_camera->priv->camera, &next_timestamp_us);
+	cache = g_new0 (ArvGvFakeCameraFrameCache, 1);
+	memcpy (cache->keys, keys, sizeof (keys));
+
+	image_buffer = arv_buffer_new (arv_fake_camera_get_payload (gv_fake_camera->priv->camera), NULL);
+
+	for (i = 0; i < ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES; i++) {
+		arv_fake_camera_fill_buffer (gv_fake_camera->priv->camera, image_buffer, &gv_packet_size);
+
+		if (i == 0)
+			cache->extended_ids = _use_extended_ids (gv_fake_camera, image_buffer);
+
+		if (image_buffer->priv->status != ARV_BUFFER_STATUS_SUCCESS ||
+		    !_frame_cache_packetize (cache, &cache->frames[i], image_buffer, gv_packet_size)) {
+			arv_warning_stream_thread ("[GvFakeCamera::frame_cache_update] Failed to generate frame %u", i);
+			g_object_unref (image_buffer);
+			_frame_cache_free (cache);
+			return NULL;
+		}
+
+		gv_fake_camera->priv->gvsp_frame_id = image_buffer->priv->frame_id;
+	}
+
+	g_object_unref (image_buffer);
+
+	arv_info_stream_thread ("[GvFakeCamera::frame_cache_update] %u frames of %u packets generated",
+				ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES, cache->frames[0].n_packets);
+
+	gv_fake_camera->priv->frame_cache = cache;
+
+	return cache;
+}
+
+#ifdef __linux__
+static void
+_send_packet_batch (GSocket *socket, struct sockaddr_storage *native_address, gsize native_address_size,
+		    guint8 **packets, guint32 *sizes, guint n_packets)
+{
+	struct mmsghdr messages[ARV_GV_FAKE_CAMERA_SEND_BATCH_SIZE];
+	struct iovec iovecs[ARV_GV_FAKE_CAMERA_SEND_BATCH_SIZE];
+	guint n_sent = 0;
+	guint i;
+
+	memset (messages, 0, n_packets * sizeof (struct mmsghdr));
+
+	for (i = 0; i < n_packets; i++) {
+		iovecs[i].iov_base = packets[i];
+		iovecs[i].iov_len = sizes[i];
+		messages[i].msg_hdr.msg_name = native_address;
+		messages[i].msg_hdr.msg_namelen = native_address_size;
+		messages[i].msg_hdr.msg_iov = &iovecs[i];
+		messages[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	while (n_sent < n_packets) {
+		int count;
+
+		count = sendmmsg (g_socket_get_fd (socket), messages + n_sent, n_packets - n_sent, 0);
+		if (count < 0) {
+			if (errno == EINTR)
+				continue;
+			arv_info_stream_thread ("[GvFakeCamera::send_packets] Failed to send %u packets: %s",
+						n_packets - n_sent, g_strerror (errno));
+			break;
+		}
+		n_sent += count;
+	}
+}
+#endif
+
+static void
+_send_packets (GSocket *socket, GSocketAddress *stream_address, guint8 **packets, guint32 *sizes, guint n_packets)
+{
+#ifdef __linux__
+	struct sockaddr_storage native_address;
+	gsize native_address_size;
+	guint i;
+
+	native_address_size = g_socket_address_get_native_size (stream_address);
+	g_socket_address_to_native (stream_address, &native_address, sizeof (native_address), NULL);
+
+	for (i = 0; i < n_packets; i += ARV_GV_FAKE_CAMERA_SEND_BATCH_SIZE)
+		_send_packet_batch (socket, &native_address, native_address_size, packets + i, sizes + i,
+				    MIN (n_packets - i, ARV_GV_FAKE_CAMERA_SEND_BATCH_SIZE));
+#else
+	GError *error = NULL;
+	guint i;
+
+	for (i = 0; i < n_packets; i++) {
+		g_socket_send_to (socket, stream_address, (char *) packets[i], sizes[i], NULL, &error);
+		if (error != NULL) {
+			arv_info_stream_thread ("[GvFakeCamera::send_packets] Failed to send packet: %s", error->message);
+			g_clear_error (&error);
+		}
+	}
+#endif
+}
+
+/* Sends GVSP packets through the impairment filter. Delayed packets are all released when @flush is set, at the end of
+ * a frame or of a resend. */
+
+static void
+_send_gvsp_packets (ArvGvFakeCamera *gv_fake_camera, GSocketAddress *stream_address,
+		    guint8 **packets, guint32 *sizes, guint n_packets, gboolean flush)
+{
+	ArvGvFakeImpairment *impairment = gv_fake_camera->priv->impairment;
+	guint i;
+
+	if (impairment == NULL) {
+		_send_packets (gv_fake_camera->priv->gvsp_socket, stream_address, packets, sizes, n_packets);
+		return;
+	}
+
+	for (i = 0; i < n_packets; i++)
+		arv_gv_fake_impairment_push (impairment, packets[i], sizes[i]);
+	if (flush)
+		arv_gv_fake_impairment_flush (impairment);
+
+	n_packets = arv_gv_fake_impairment_get_output (impairment, &packets, &sizes);
+	if (n_packets > 0)
+		_send_packets (gv_fake_camera->priv->gvsp_socket, stream_address, packets, sizes, n_packets);
+	arv_gv_fake_impairment_clear_output (impairment);
+}
+
+static void
+_impairment_counters_add (ArvGvFakeImpairmentCounters *counters, const ArvGvFakeImpairmentCounters *other)
+{
+	counters->n_packets += other->n_packets;
+	counters->n_dropped_packets += other->n_dropped_packets;
+	counters->n_duplicated_packets += other->n_duplicated_packets;
+	counters->n_reordered_packets += other->n_reordered_packets;
+	counters->n_truncated_packets += other->n_truncated_packets;
+	counters->n_delayed_packets += other->n_delayed_packets;
+}
+
+/* Applies the last impairment settings, from the streaming thread, between two frames */
+
+static void
+_impairment_update (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraPrivate *priv = gv_fake_camera->priv;
+	ArvGvFakeImpairmentSettings settings;
+	double lost_packet_ratio;
+	gboolean has_profile;
+
+	g_mutex_lock (&priv->impairment_mutex);
+	if (priv->impairment_generation == priv->thread_impairment_generation) {
+		g_mutex_unlock (&priv->impairment_mutex);
+		return;
+	}
+	settings = priv->impairment_settings;
+	has_profile = priv->gvsp_impairment != NULL;
+	lost_packet_ratio = priv->gvsp_lost_packet_ratio;
+	priv->thread_impairment_generation = priv->impairment_generation;
+	g_mutex_unlock (&priv->impairment_mutex);
+
+	/* Without impairment profile, the lost packet ratio gives an unseeded uniform loss */
+	if (!has_profile && lost_packet_ratio > 0.0) {
+		settings.loss_ratio = lost_packet_ratio;
+		settings.seed = g_random_int ();
+	}
+
+	if (priv->impairment != NULL) {
+		ArvGvFakeImpairmentCounters counters;
+
+		arv_gv_fake_impairment_get_counters (priv->impairment, &counters);
+		_impairment_counters_add (&priv->impairment_counters, &counters);
+		arv_gv_fake_impairment_free (priv->impairment);
+		priv->impairment = NULL;
+	}
+
+	if (!arv_gv_fake_impairment_settings_is_null (&settings))
+		priv->impairment = arv_gv_fake_impairment_new (&settings);
+
+	priv->trailer_delay_us = settings.trailer_delay_us;
+	priv->resend_latency_us = settings.resend_latency_us;
+
+	arv_info_stream_thread ("[GvFakeCamera::impairment_update] Network impairment %s",
+				priv->impairment != NULL ? "enabled" : "disabled");
+}
+
+static void
+_statistics_frame_sent (ArvGvFakeCamera *gv_fake_camera, guint n_packets)
+{
+	ArvGvFakeCameraPrivate *priv = gv_fake_camera->priv;
+	ArvGvFakeImpairmentCounters counters = priv->impairment_counters;
+
+	if (priv->impairment != NULL) {
+		ArvGvFakeImpairmentCounters current;
+
+		arv_gv_fake_impairment_get_counters (priv->impairment, &current);
+		_impairment_counters_add (&counters, &current);
+	}
+
+	g_mutex_lock (&priv->statistics_mutex);
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_FRAMES]++;
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_PACKETS] += n_packets;
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_DROPPED_PACKETS] = counters.n_dropped_packets;
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_DUPLICATED_PACKETS] = counters.n_duplicated_packets;
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_REORDERED_PACKETS] = counters.n_reordered_packets;
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_TRUNCATED_PACKETS] = counters.n_truncated_packets;
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_DELAYED_PACKETS] = counters.n_delayed_packets;
+	g_mutex_unlock (&priv->statistics_mutex);
+}
+
+/* Prepares the transmission of a pregenerated frame, paced by the GevSCPD packet delay and the bit rate limit */
+
+static ArvGvFakeCameraHistoryEntry *
+_start_cached_frame (ArvGvFakeCamera *gv_fake_camera, ArvGvFakeCameraFrameCache *cache)
+{
+	ArvGvFakeCameraSender *sender = &gv_fake_camera->priv->sender;
+	ArvGvFakeCameraFrame *frame;
+	ArvGvFakeCameraHistoryEntry *entry;
+	ArvGvspLeader *leader;
+	guint64 timestamp_ns;
+	guint32 packet_delay;
+	guint32 tick_frequency;
+	guint64 frame_id;
+	guint i;
+
+	frame = &cache->frames[cache->index];
+	cache->index = (cache->index + 1) % ARV_GV_FAKE_CAMERA_N_CACHED_FRAMES;
+
+	frame_id = gv_fake_camera->priv->gvsp_frame_id + 1;
+	if (!cache->extended_ids)
+		frame_id &= 0xffff;
+	if (frame_id == 0)
+		frame_id = 1;
+	gv_fake_camera->priv->gvsp_frame_id = frame_id;
+
+	for (i = 0; i < frame->n_packets; i++) {
+		ArvGvspPacket *packet = (ArvGvspPacket *) (frame->data + i * cache->stride);
+
+		if (cache->extended_ids)
+			((ArvGvspExtendedHeader *) &packet->header)->frame_id = GUINT64_TO_BE (frame_id);
+		else
+			((ArvGvspHeader *) &packet->header)->frame_id = g_htons (frame_id);
+	}
+
+	timestamp_ns = g_get_real_time () * 1000LL;
+	leader = arv_gvsp_packet_get_data ((ArvGvspPacket *) frame->data);
+	leader->timestamp_high = g_htonl (timestamp_ns >> 32);
+	leader->timestamp_low = g_htonl (timestamp_ns & 0xffffffff);
+
+	entry = _history_next (gv_fake_camera->priv);
+	entry->frame_id = frame_id;
+	entry->frame = frame;
+	entry->stride = cache->stride;
+	entry->extended_ids = cache->extended_ids;
+	entry->n_packets = frame->n_packets;
+
+	arv_fake_camera_read_register (gv_fake_camera->priv->camera, ARV_GVBS_STREAM_CHANNEL_0_PACKET_DELAY_OFFSET,
+				       &packet_delay);
+	arv_fake_camera_read_register (gv_fake_camera->priv->camera, ARV_GVBS_TIMESTAMP_TICK_FREQUENCY_LOW_OFFSET,
+				       &tick_frequency);
+	sender->packet_delay_us = tick_frequency > 0 ? packet_delay * 1e6 / tick_frequency : 0.0;
+	sender->bit_rate = gv_fake_camera->priv->gvsp_bit_rate;
+
+	return entry;
+}
+
+static guint8 *
+_history_get_packet (ArvGvFakeCameraHistoryEntry *entry, guint32 block_id, guint8 *packet_buffer, guint32 *size)
+{
+	size_t packet_size;
+
+	if (entry->frame != NULL) {
+		*size = entry->frame->sizes[block_id];
+		return entry->frame->data + block_id * entry->stride;
+	}
+
+	packet_size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
+	_packetize_block (entry->buffer, entry->frame_id, entry->extended_ids, block_id, entry->n_packets,
+			  entry->data_size, entry->frame_size, packet_buffer, &packet_size);
+	*size = packet_size;
+
+	return packet_buffer;
+}
+
+/*
+ * Sends the packets of the frame in transmission whose deadline is reached, at most one batch. A camera thread or a
+ * pool thread calls it in turn for each of its cameras, which interleaves the frames of the cameras instead of making
+ * them wait for each other. The trailer is sent on its own, once the optional trailer delay is over.
+ */
+
+static void
+_sender_send_due_packets (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraPrivate *priv = gv_fake_camera->priv;
+	ArvGvFakeCameraSender *sender = &priv->sender;
+	ArvGvFakeCameraHistoryEntry *entry = sender->entry;
+	guint8 *packets[ARV_GV_FAKE_CAMERA_SEND_BATCH_SIZE];
+	guint32 sizes[ARV_GV_FAKE_CAMERA_SEND_BATCH_SIZE];
+	guint32 n_data_packets = entry->n_packets - 1;
+	guint n_packets = 0;
+	gint64 time_us;
+
+	time_us = g_get_monotonic_time ();
+	if (sender->deadline_us > time_us)
+		return;
+
+	if (sender->block_id < n_data_packets) {
+		if (entry->frame != NULL) {
+			do {
+				packets[n_packets] = entry->frame->data + sender->block_id * entry->stride;
+				sizes[n_packets] = entry->frame->sizes[sender->block_id];
+
+				sender->deadline_us += MAX (sender->packet_delay_us,
+							    sender->bit_rate > 0.0 ?
+							    sizes[n_packets] * 8e6 / sender->bit_rate : 0.0);
+				n_packets++;
+				sender->block_id++;
+			} while (sender->block_id < n_data_packets &&
+				 n_packets < ARV_GV_FAKE_CAMERA_SEND_BATCH_SIZE &&
+				 sender->deadline_us <= time_us);
+
+			_send_gvsp_packets (gv_fake_camera, sender->stream_address, packets, sizes, n_packets, FALSE);
 		} else {
-			next_timestamp_us = g_get_real_time () + 100000;
+			/* Packets generated on the fly share the packet buffer, they are sent one at a time */
+			do {
+				packets[0] = _history_get_packet (entry, sender->block_id, sender->packet_buffer, &sizes[0]);
+				_send_gvsp_packets (gv_fake_camera, sender->stream_address, packets, sizes, 1, FALSE);
+
+				n_packets++;
+				sender->block_id++;
+			} while (sender->block_id < n_data_packets && n_packets < ARV_GV_FAKE_CAMERA_SEND_BATCH_SIZE);
 		}
 
-		do {
-			gint timeout_ms;
-
-			timeout_ms =  (next_timestamp_us - g_get_real_time ()) / 1000LL;
-			if (timeout_ms < 0)
-				timeout_ms = 0;
-			else if (timeout_ms > 100)
-				timeout_ms = 100;
-
-			n_events = g_poll (gv_fake_camera->priv->socket_fds, gv_fake_camera->priv->n_socket_fds, timeout_ms);
-			if (n_events > 0) {
-				unsigned int i;
-
-				for (i = 0; i < ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS; i++) {
-					GSocket *socket = gv_fake_camera->priv->input_sockets[i];
-					int count;
-
-					if (G_IS_SOCKET (socket)) {
-						GSocketAddress *remote_address = NULL;
-
-						arv_gpollfd_clear_one (&gv_fake_camera->priv->socket_fds[i], socket);
-
-						count = g_socket_receive_message (socket, &remote_address, &input_vector, 1, NULL, NULL,
-										  NULL, NULL, NULL);
-						if (count > 0) {
-							if (_handle_control_packet (gv_fake_camera, socket,
-										    remote_address, input_vector.buffer, count))
-								arv_info_device ("[GvFakeCamera::thread] Control packet received");
-						}
-						g_clear_object (&remote_address);
-					}
-				}
-
-				if (arv_fake_camera_get_control_channel_privilege (gv_fake_camera->priv->camera) == 0 ||
-				    arv_fake_camera_get_acquisition_status (gv_fake_camera->priv->camera) == 0) {
-					if (stream_address != NULL) {
-						g_object_unref (stream_address);
-						stream_address = NULL;
-						g_object_unref (image_buffer);
-						image_buffer = NULL;
-						arv_info_stream_thread ("[GvFakeCamera::thread] Stop stream");
-					}
-					is_streaming = FALSE;
-				}
-			}
-		} while (!g_atomic_int_get (&gv_fake_camera->priv->cancel) && g_get_real_time () < next_timestamp_us);
-
-		if (arv_fake_camera_get_control_channel_privilege (gv_fake_camera->priv->camera) != 0 &&
-		    arv_fake_camera_get_acquisition_status (gv_fake_camera->priv->camera) != 0) {
-			if (stream_address == NULL) {
-				GInetAddress *inet_address;
-				char *inet_address_string;
-
-				stream_address = arv_fake_camera_get_stream_address (gv_fake_camera->priv->camera);
-				inet_address = g_inet_socket_address_get_address
-					(G_INET_SOCKET_ADDRESS (stream_address));
-				inet_address_string = g_inet_address_to_string (inet_address);
-				arv_info_stream_thread ("[GvFakeCamera::thread] Start stream to %s (%d)",
-							 inet_address_string,
-							 g_inet_socket_address_get_port
-							 (G_INET_SOCKET_ADDRESS (stream_address)));
-				g_free (inet_address_string);
-
-				payload = arv_fake_camera_get_payload (gv_fake_camera->priv->camera);
-				image_buffer = arv_buffer_new (payload, NULL);
-			}
+		if (sender->block_id == n_data_packets)
+			sender->deadline_us = MAX (sender->deadline_us, g_get_monotonic_time ()) +
+				priv->trailer_delay_us;
+
+		return;
+	}
+
+	packets[0] = _history_get_packet (entry, n_data_packets, sender->packet_buffer, &sizes[0]);
+	_send_gvsp_packets (gv_fake_camera, sender->stream_address, packets, sizes, 1, TRUE);
+
+	entry->end_time_us = g_get_monotonic_time ();
+
+	_statistics_frame_sent (gv_fake_camera, entry->n_packets);
+
+	sender->entry = NULL;
+}
+
+static void
+_resend_packets (ArvGvFakeCamera *gv_fake_camera, GSocketAddress *stream_address,
+		 ArvGvFakeCameraResendRequest *request, guint8 *packet_buffer)
+{
+	ArvGvFakeCameraPrivate *priv = gv_fake_camera->priv;
+	ArvGvFakeCameraHistoryEntry *entry;
+	guint32 last_block;
+	guint32 block_id;
+	gint64 recovery_time_us;
+
+	entry = _history_find (priv, request->frame_id, request->extended_ids);
+	if (entry == NULL || request->first_block > request->last_block || request->first_block >= entry->n_packets) {
+		arv_info_stream_thread ("[GvFakeCamera::resend_packets] Packets %u-%u of frame %" G_GUINT64_FORMAT
+					" not available", request->first_block, request->last_block, request->frame_id);
+		return;
+	}
+
+	last_block = MIN (request->last_block, entry->n_packets - 1);
+
+	for (block_id = request->first_block; block_id <= last_block; block_id++) {
+		guint8 *packet;
+		guint32 size;
+
+		packet = _history_get_packet (entry, block_id, packet_buffer, &size);
+		_send_gvsp_packets (gv_fake_camera, stream_address, &packet, &size, 1, block_id == last_block);
+	}
+
+	/* Recovery time of a frame: delay between the end of its transmission and its last resent packet */
+	recovery_time_us = g_get_monotonic_time () - entry->end_time_us;
+
+	g_mutex_lock (&priv->statistics_mutex);
+	if (!entry->has_resent_packets)
+		priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_RESENT_FRAMES]++;
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_N_RESENT_PACKETS] += last_block - request->first_block + 1;
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_RESEND_RECOVERY_TIME_US] +=
+		recovery_time_us - entry->recovery_time_us;
+	priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_MAX_RESEND_RECOVERY_TIME_US] =
+		MAX (priv->statistics[ARV_GV_FAKE_CAMERA_STATISTIC_MAX_RESEND_RECOVERY_TIME_US], recovery_time_us);
+	g_mutex_unlock (&priv->statistics_mutex);
+
+	entry->recovery_time_us = recovery_time_us;
+	entry->has_resent_packets = TRUE;
+}
+
+/* Serves the resend requests whose latency is over, and returns the due time of the next one */
+
+static gint64
+_process_resend_requests (ArvGvFakeCamera *gv_fake_camera, GSocketAddress *stream_address, guint8 *packet_buffer)
+{
+	ArvGvFakeCameraResendRequest *request;
+
+	while ((request = g_queue_peek_head (&gv_fake_camera->priv->resend_requests)) != NULL) {
+		if (request->due_time_us > g_get_monotonic_time ())
+			return request->due_time_us;
+
+		g_queue_pop_head (&gv_fake_camera->priv->resend_requests);
+		if (stream_address != NULL)
+			_resend_packets (gv_fake_camera, stream_address, request, packet_buffer);
+		g_free (request);
+	}
+
+	return G_MAXINT64;
+}
+
+/* The sender state of a camera is owned by the thread serving it, either the camera thread or a pool thread */
+
+static void
+_sender_init (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraSender *sender = &gv_fake_camera->priv->sender;
+
+	sender->stream_address = NULL;
+	sender->input_vector.buffer = g_malloc0 (ARV_GV_FAKE_CAMERA_BUFFER_SIZE);
+	sender->input_vector.size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
+	sender->packet_buffer = g_malloc (ARV_GV_FAKE_CAMERA_BUFFER_SIZE);
+	sender->payload = 0;
+	sender->is_streaming = FALSE;
+	sender->next_timestamp_us = 0;
+	sender->entry = NULL;
+}
+
+static void
+_sender_finish (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraPrivate *priv = gv_fake_camera->priv;
+	ArvGvFakeCameraSender *sender = &priv->sender;
+
+	g_clear_object (&sender->stream_address);
+
+	sender->entry = NULL;
+	_history_clear (priv, TRUE);
+	_resend_requests_clear (priv);
+
+	if (priv->impairment != NULL) {
+		ArvGvFakeImpairmentCounters counters;
+
+		arv_gv_fake_impairment_get_counters (priv->impairment, &counters);
+		_impairment_counters_add (&priv->impairment_counters, &counters);
+		g_clear_pointer (&priv->impairment, arv_gv_fake_impairment_free);
+	}
 
-			if (arv_fake_camera_is_in_free_running_mode (gv_fake_camera->priv->camera) ||
-			    (arv_fake_camera_is_in_software_trigger_mode (gv_fake_camera->priv->camera) &&
-			     arv_fake_camera_check_and_acknowledge_software_trigger (gv_fake_camera->priv->camera))) {
-				arv_fake_camera_fill_buffer (gv_fake_camera->priv->camera, image_buffer, &gv_packet_size);
-
-				arv_info_stream_thread ("[GvFakeCamera::thread] Send frame %" G_GUINT64_FORMAT, image_buffer->priv->frame_id);
-
-				block_id = 0;
-
-				packet_size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
-                                arv_gvsp_packet_new_image_leader (image_buffer->priv->frame_id,
-                                                                  block_id,
-                                                                  arv_buffer_get_timestamp(image_buffer),
-                                                                  arv_buffer_get_image_pixel_format(image_buffer),
-                                                                  arv_buffer_get_image_width(image_buffer),
-                                                                  arv_buffer_get_image_height(image_buffer),
-                                                                  arv_buffer_get_image_x(image_buffer),
-                                                                  arv_buffer_get_image_y(image_buffer),
-                                                                  0, 0,
-                                                                  packet_buffer, &packet_size);
-
-				if (g_random_double () >= gv_fake_camera->priv->gvsp_lost_packet_ratio)
-					g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address,
-							packet_buffer, packet_size, NULL, &error);
-				else
-					arv_info_stream_thread ("Drop GVSP leader packet frame: %" G_GUINT64_FORMAT, image_buffer->priv->frame_id);
-
-				if (error != NULL) {
-					arv_warning_stream_thread ("[GvFakeCamera::thread] Failed to send leader for frame %" G_GUINT64_FORMAT
-								": %s", image_buffer->priv->frame_id, error->message);
-					g_clear_error (&error);
-				}
-
-				block_id++;
-
-				offset = 0;
-				while (offset < payload) {
-					size_t data_size;
-
-					data_size = MIN (gv_packet_size - ARV_GVSP_PACKET_PROTOCOL_OVERHEAD (FALSE),
-							payload - offset);
-
-					packet_size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
-                                        arv_gvsp_packet_new_payload (image_buffer->priv->frame_id, block_id,
-                                                                     data_size, ((char *) image_buffer->priv->data) + offset,
-                                                                     packet_buffer, &packet_size);
-
-					if (g_random_double () >= gv_fake_camera->priv->gvsp_lost_packet_ratio)
-						g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address,
-								packet_buffer, packet_size, NULL, &error);
-					else
-						arv_info_stream_thread ("Drop GVSP data packet frame:%" G_GUINT64_FORMAT
-									", block:%u", image_buffer->priv->frame_id, block_id);
-
-					if (error != NULL) {
-						arv_info_stream_thread ("[GvFakeCamera::thread] Failed to send frame block %d for frame"
-									" %" G_GUINT64_FORMAT ": %s",
-									block_id, image_buffer->priv->frame_id, error->message);
-						g_clear_error (&error);
-					}
-
-					offset += data_size;
-					block_id++;
-				}
-
-				packet_size = ARV_GV_FAKE_CAMERA_BUFFER_SIZE;
-				arv_gvsp_packet_new_data_trailer (image_buffer->priv->frame_id, block_id,
-								packet_buffer, &packet_size);
-
-				if (g_random_double () >= gv_fake_camera->priv->gvsp_lost_packet_ratio)
-					g_socket_send_to (gv_fake_camera->priv->gvsp_socket, stream_address,
-							packet_buffer, packet_size, NULL, &error);
-				else
-					arv_info_stream_thread ("Drop GVSP trailer packet frame: %" G_GUINT64_FORMAT,
-								image_buffer->priv->frame_id);
-
-				if (error != NULL) {
-					arv_info_stream_thread ("[GvFakeCamera::thread] Failed to send trailer for frame %" G_GUINT64_FORMAT
-								": %s", image_buffer->priv->frame_id, error->message);
-					g_clear_error (&error);
-				}
-
-				is_streaming = TRUE;
+	/* The next thread serving the camera rebuilds the impairment */
+	g_mutex_lock (&priv->impairment_mutex);
+	priv->impairment_generation++;
+	g_mutex_unlock (&priv->impairment_mutex);
+
+	g_clear_pointer (&sender->packet_buffer, g_free);
+	g_clear_pointer (&sender->input_vector.buffer, g_free);
+}
+
+/* Serves the due resend requests, and returns the poll timeout until the next frame, packet or resend, in ms */
+
+static gint
+_sender_prepare (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraSender *sender = &gv_fake_camera->priv->sender;
+	gint64 resend_time_us;
+	gint64 timeout_ms;
+
+	if (sender->next_timestamp_us == 0) {
+		if (sender->is_streaming) {
+			arv_fake_camera_get_sleep_time_for_next_frame (gv_fake_camera->priv->camera,
+								       &sender->next_timestamp_us);
+		} else {
+			sender->next_timestamp_us = g_get_real_time () + 100000;
+		}
+	}
+
+	resend_time_us = _process_resend_requests (gv_fake_camera, sender->stream_address, sender->packet_buffer);
+
+	timeout_ms = ((gint64) sender->next_timestamp_us - g_get_real_time ()) / 1000LL;
+	if (resend_time_us != G_MAXINT64)
+		timeout_ms = MIN (timeout_ms, (resend_time_us - g_get_monotonic_time () + 999) / 1000LL);
+
+	/* Packet deadlines are rounded down, the last millisecond is spent polling without timeout */
+	if (sender->entry != NULL)
+		timeout_ms = MIN (timeout_ms, (gint64) (sender->deadline_us - g_get_monotonic_time ()) / 1000LL);
+
+	return CLAMP (timeout_ms, 0, 100);
+}
+
+static void
+_sender_receive (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraSender *sender = &gv_fake_camera->priv->sender;
+	unsigned int i;
+
+	for (i = 0; i < ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS; i++) {
+		GSocket *socket = gv_fake_camera->priv->input_sockets[i];
+		int count;
+
+		if (G_IS_SOCKET (socket)) {
+			GSocketAddress *remote_address = NULL;
+
+			arv_gpollfd_clear_one (&gv_fake_camera->priv->socket_fds[i], socket);
+
+			count = g_socket_receive_message (socket, &remote_address, &sender->input_vector, 1, NULL, NULL,
+							  NULL, NULL, NULL);
+			if (count > 0) {
+				if (_handle_control_packet (gv_fake_camera, socket,
+							    remote_address, sender->input_vector.buffer, count))
+					arv_info_device ("[GvFakeCamera::thread] Control packet received");
 			}
+			g_clear_object (&remote_address);
 		}
+	}
 
-	} while (!g_atomic_int_get (&gv_fake_camera->priv->cancel));
+	if (arv_fake_camera_get_control_channel_privilege (gv_fake_camera->priv->camera) == 0 ||
+	    arv_fake_camera_get_acquisition_status (gv_fake_camera->priv->camera) == 0) {
+		if (sender->stream_address != NULL) {
+			g_clear_object (&sender->stream_address);
+			sender->entry = NULL;
+			_history_clear (gv_fake_camera->priv, TRUE);
+			_resend_requests_clear (gv_fake_camera->priv);
+			arv_info_stream_thread ("[GvFakeCamera::thread] Stop stream");
+		}
+		sender->is_streaming = FALSE;
+	}
+}
+
+/* Sends the due packets of the current frame, or starts the next frame once its time has come */
+
+static void
+_sender_dispatch (ArvGvFakeCamera *gv_fake_camera)
+{
+	ArvGvFakeCameraSender *sender = &gv_fake_camera->priv->sender;
+	ArvGvFakeCameraHistoryEntry *entry;
+	ArvBuffer *image_buffer;
+	gboolean extended_ids;
+	size_t frame_size;
+	size_t data_size;
+	guint32 gv_packet_size;
+	guint32 n_packets;
+
+	if (sender->entry != NULL) {
+		_sender_send_due_packets (gv_fake_camera);
+		return;
+	}
+
+	if (g_get_real_time () < (gint64) sender->next_timestamp_us)
+		return;
+
+	sender->next_timestamp_us = 0;
+
+	if (arv_fake_camera_get_control_channel_privilege (gv_fake_camera->priv->camera) == 0 ||
+	    arv_fake_camera_get_acquisition_status (gv_fake_camera->priv->camera) == 0)
+		return;
+
+	if (sender->stream_address == NULL) {
+		GInetAddress *inet_address;
+		char *inet_address_string;
+
+		sender->stream_address = arv_fake_camera_get_stream_address (gv_fake_camera->priv->camera);
+		inet_address = g_inet_socket_address_get_address
+			(G_INET_SOCKET_ADDRESS (sender->stream_address));
+		inet_address_string = g_inet_address_to_string (inet_address);
+		arv_info_stream_thread ("[GvFakeCamera::thread] Start stream to %s (%d)",
+					 inet_address_string,
+					 g_inet_socket_address_get_port
+					 (G_INET_SOCKET_ADDRESS (sender->stream_address)));
+		g_free (inet_address_string);
+
+		sender->payload = arv_fake_camera_get_payload (gv_fake_camera->priv->camera);
+	}
+
+	if (!arv_fake_camera_is_in_free_running_mode (gv_fake_camera->priv->camera) &&
+	    !(arv_fake_camera_is_in_software_trigger_mode (gv_fake_camera->priv->camera) &&
+	      arv_fake_camera_check_and_acknowledge_software_trigger (gv_fake_camera->priv->camera)))
+		return;
+
+	_impairment_update (gv_fake_camera);
+
+	if (g_atomic_int_get (&gv_fake_camera->priv->gvsp_high_rate)) {
+		ArvGvFakeCameraFrameCache *cache;
+
+		cache = _frame_cache_update (gv_fake_camera);
+		if (cache != NULL) {
+			sender->entry = _start_cached_frame (gv_fake_camera, cache);
+			sender->block_id = 0;
+			sender->deadline_us = g_get_monotonic_time ();
+			_sender_send_due_packets (gv_fake_camera);
+		}
+
+		sender->is_streaming = TRUE;
+		return;
+	}
+
+	entry = _history_next (gv_fake_camera->priv);
+	if (entry->buffer == NULL)
+		entry->buffer = arv_buffer_new (sender->payload, NULL);
+	image_buffer = entry->buffer;
+
+	arv_fake_camera_fill_buffer (gv_fake_camera->priv->camera, image_buffer, &gv_packet_size);
+
+	if (image_buffer->priv->status != ARV_BUFFER_STATUS_SUCCESS) {
+		arv_warning_stream_thread ("[GvFakeCamera::thread] Failed to fill frame buffer (status %d)",
+					   image_buffer->priv->status);
+		/* Don't leave a stale frame in the history, it could be picked by a resend request */
+		entry->frame_id = 0;
+		entry->n_packets = 0;
+		return;
+	}
+
+	arv_info_stream_thread ("[GvFakeCamera::thread] Send frame %" G_GUINT64_FORMAT, image_buffer->priv->frame_id);
 
-	if (stream_address != NULL)
-		g_object_unref (stream_address);
-	if (image_buffer != NULL)
-		g_object_unref (image_buffer);
+	extended_ids = _use_extended_ids (gv_fake_camera, image_buffer);
+	n_packets = _frame_layout (image_buffer, gv_packet_size, extended_ids, &data_size, &frame_size);
+	if (n_packets == 0) {
+		arv_warning_stream_thread ("[GvFakeCamera::thread] Packet size too small (%u)", gv_packet_size);
+		entry->frame_id = 0;
+		entry->n_packets = 0;
+		return;
+	}
+
+	entry->frame_id = image_buffer->priv->frame_id;
+	entry->extended_ids = extended_ids;
+	entry->data_size = data_size;
+	entry->frame_size = frame_size;
+	entry->n_packets = n_packets;
+
+	sender->entry = entry;
+	sender->block_id = 0;
+	sender->deadline_us = g_get_monotonic_time ();
+	_sender_send_due_packets (gv_fake_camera);
+
+	sender->is_streaming = TRUE;
+}
+
+static void *
+_thread (void *user_data)
+{
+	ArvGvFakeCamera *gv_fake_camera = user_data;
+
+	_sender_init (gv_fake_camera);
 
-	g_free (packet_buffer);
-	g_free (input_vector.buffer);
+	while (!g_atomic_int_get (&gv_fake_camera->priv->cancel)) {
+		gint timeout_ms;
+
+		timeout_ms = _sender_prepare (gv_fake_camera);
+
+		if (g_poll (gv_fake_camera->priv->socket_fds, gv_fake_camera->priv->n_socket_fds, timeout_ms) > 0)
+			_sender_receive (gv_fake_camera);
+
+		_sender_dispatch (gv_fake_camera);
+	}
+
+	_sender_finish (gv_fake_camera);
 
 	return NULL;
 }
 
+static void
+_start_thread (ArvGvFakeCamera *gv_fake_camera)
+{
+	gv_fake_camera->priv->cancel = FALSE;
+	gv_fake_camera->priv->thread = g_thread_new ("arv_fake_gv_fake_camera", _thread, gv_fake_camera);
+}
+
+static void
+_stop_thread (ArvGvFakeCamera *gv_fake_camera)
+{
+	if (gv_fake_camera->priv->thread == NULL)
+		return;
+
+	g_atomic_int_set (&gv_fake_camera->priv->cancel, TRUE);
+	g_thread_join (gv_fake_camera->priv->thread);
+	gv_fake_camera->priv->thread = NULL;
+}
+
 static gboolean
 _create_and_bind_input_socket (GSocket **socket_out, const char *socket_name,
 			       GInetAddress *inet_address, unsigned int port,
@@ -489,6 +1404,7 @@ arv_gv_fake_camera_start (ArvGvFakeCamera *gv_fake_camera)
 	GSocketAddress *socket_address;
 	GInetAddress *inet_address;
 	GInetAddress *gvcp_inet_address;
+	GInetAddress *alias_address = NULL;
 	unsigned int i;
 	unsigned int n_socket_fds;
 
@@ -502,6 +1418,21 @@ arv_gv_fake_camera_start (ArvGvFakeCamera *gv_fake_camera)
 		if(iface == NULL && g_strcmp0 (gv_fake_camera->priv->interface_name,ARV_GV_FAKE_CAMERA_DEFAULT_INTERFACE) == 0)
 			iface = arv_network_get_fake_ipv4_loopback();
 	#endif
+	if (iface == NULL) {
+		/* Any address of 127.0.0.0/8 is routed through the loopback interface, which allows to run
+		 * several fake cameras on the same host */
+		alias_address = g_inet_address_new_from_string (gv_fake_camera->priv->interface_name);
+		if (alias_address != NULL &&
+		    g_inet_address_get_family (alias_address) == G_SOCKET_FAMILY_IPV4 &&
+		    g_inet_address_get_is_loopback (alias_address))
+			iface = arv_network_get_interface_by_address (ARV_GV_FAKE_CAMERA_DEFAULT_INTERFACE);
+		#ifdef G_OS_WIN32
+			if (iface == NULL && alias_address != NULL)
+				iface = arv_network_get_fake_ipv4_loopback();
+		#endif
+		if (iface == NULL)
+			g_clear_object (&alias_address);
+	}
 	if (iface == NULL) {
 		arv_warning_device ("[GvFakeCamera::start] No network interface with address or name '%s' found.",gv_fake_camera->priv->interface_name);
 		return FALSE;
@@ -509,7 +1440,10 @@ arv_gv_fake_camera_start (ArvGvFakeCamera *gv_fake_camera)
 
 	socket_address = g_socket_address_new_from_native (arv_network_interface_get_addr(iface),
 								sizeof (struct sockaddr));
-	gvcp_inet_address = g_object_ref (g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (socket_address)));
+	if (alias_address != NULL)
+		gvcp_inet_address = alias_address;
+	else
+		gvcp_inet_address = g_object_ref (g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (socket_address)));
 	arv_fake_camera_set_inet_address (gv_fake_camera->priv->camera, gvcp_inet_address);
 
 	_create_and_bind_input_socket (&gv_fake_camera->priv->gvsp_socket,
@@ -529,7 +1463,8 @@ arv_gv_fake_camera_start (ArvGvFakeCamera *gv_fake_camera)
 	socket_address = g_socket_address_new_from_native (arv_network_interface_get_broadaddr(iface),
 								sizeof (struct sockaddr));
 	inet_address = g_object_ref (g_inet_socket_address_get_address (G_INET_SOCKET_ADDRESS (socket_address)));
-	if (!g_inet_address_equal (gvcp_inet_address, inet_address))
+	/* Loopback aliases share the interface, global discovery is enough for them */
+	if (alias_address == NULL && !g_inet_address_equal (gvcp_inet_address, inet_address))
 		_create_and_bind_input_socket
 			(&gv_fake_camera->priv->input_sockets[ARV_GV_FAKE_CAMERA_INPUT_SOCKET_SUBNET_DISCOVERY],
 			 "Subnet discovery", inet_address, ARV_GVCP_PORT, FALSE, FALSE);
@@ -558,8 +1493,7 @@ arv_gv_fake_camera_start (ArvGvFakeCamera *gv_fake_camera)
 
 	arv_gpollfd_prepare_all (gv_fake_camera->priv->socket_fds, n_socket_fds);
 
-	gv_fake_camera->priv->cancel = FALSE;
-	gv_fake_camera->priv->thread = g_thread_new ("arv_fake_gv_fake_camera", _thread, gv_fake_camera);
+	_start_thread (gv_fake_camera);
 
 	return TRUE;
 }
@@ -572,12 +1506,7 @@ arv_gv_fake_camera_stop (ArvGvFakeCamera *gv_fake_camera)
 
 	g_return_if_fail (ARV_IS_GV_FAKE_CAMERA (gv_fake_camera));
 
-	if (gv_fake_camera->priv->thread != NULL) {
-
-		g_atomic_int_set (&gv_fake_camera->priv->cancel, TRUE);
-		g_thread_join (gv_fake_camera->priv->thread);
-		gv_fake_camera->priv->thread = NULL;
-	}
+	_stop_thread (gv_fake_camera);
 
 	arv_gpollfd_finish_all (gv_fake_camera->priv->socket_fds, gv_fake_camera->priv->n_socket_fds);
 
@@ -587,11 +1516,14 @@ arv_gv_fake_camera_stop (ArvGvFakeCamera *gv_fake_camera)
 	g_clear_object (&gv_fake_camera->priv->gvsp_socket);
 
 	g_clear_object (&gv_fake_camera->priv->controller_address);
+
+	g_clear_pointer (&gv_fake_camera->priv->frame_cache, _frame_cache_free);
 }
 
 /**
  * arv_gv_fake_camera_new_full:
- * @interface_name: (nullable): listening network interface, by name or IP address, default is 127.0.0.1
+ * @interface_name: (nullable): listening network interface, by name or IP address, default is 127.0.0.1. Any other
+ * IPv4 loopback address can also be used, in order to run several fake cameras on the same host.
  * @serial_number: (nullable): fake device serial number, default is GV01
  * @genicam_filename: (nullable): path to alternative genicam data
  *
@@ -632,6 +1564,8 @@ static void
 _set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
 {
 	ArvGvFakeCamera *gv_fake_camera = ARV_GV_FAKE_CAMERA (object);
+	ArvGvFakeImpairmentSettings impairment_settings;
+	GError *error = NULL;
 
 	switch (prop_id)
 	{
@@ -648,7 +1582,32 @@ _set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *
 			gv_fake_camera->priv->genicam_filename = g_value_dup_string (value);
 			break;
 		case PROP_GVSP_LOST_PACKET_RATIO:
+			g_mutex_lock (&gv_fake_camera->priv->impairment_mutex);
 			gv_fake_camera->priv->gvsp_lost_packet_ratio = g_value_get_double (value);
+			gv_fake_camera->priv->impairment_generation++;
+			g_mutex_unlock (&gv_fake_camera->priv->impairment_mutex);
+			break;
+		case PROP_GVSP_HIGH_RATE:
+			g_atomic_int_set (&gv_fake_camera->priv->gvsp_high_rate, g_value_get_boolean (value));
+			break;
+		case PROP_GVSP_BIT_RATE:
+			gv_fake_camera->priv->gvsp_bit_rate = g_value_get_double (value);
+			break;
+		case PROP_GVSP_IMPAIRMENT:
+			if (!arv_gv_fake_impairment_settings_parse (&impairment_settings, g_value_get_string (value),
+								    &error)) {
+				arv_warning_device ("[GvFakeCamera::set_property] Invalid impairment profile '%s': %s",
+						    g_value_get_string (value), error->message);
+				g_clear_error (&error);
+				break;
+			}
+
+			g_mutex_lock (&gv_fake_camera->priv->impairment_mutex);
+			g_free (gv_fake_camera->priv->gvsp_impairment);
+			gv_fake_camera->priv->gvsp_impairment = g_value_dup_string (value);
+			gv_fake_camera->priv->impairment_settings = impairment_settings;
+			gv_fake_camera->priv->impairment_generation++;
+			g_mutex_unlock (&gv_fake_camera->priv->impairment_mutex);
 			break;
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -692,20 +1651,226 @@ arv_gv_fake_camera_is_running (ArvGvFakeCamera *gv_fake_camera)
 	return gv_fake_camera->priv->is_running;
 }
 
+/**
+ * arv_gv_fake_camera_get_info_uint64_by_name:
+ * @gv_fake_camera: a #ArvGvFakeCamera
+ * @name: statistic name
+ *
+ * Retrieves a transmission statistic of the simulator. n_frames and n_packets count the sent frames and packets.
+ * n_dropped_packets, n_duplicated_packets, n_reordered_packets, n_truncated_packets and n_delayed_packets count the
+ * effects of the #ArvGvFakeCamera:gvsp-impairment profile. n_resend_requests, n_resent_packets and n_resent_frames
+ * count the packet resend activity, and resend_recovery_time_us and max_resend_recovery_time_us are the sum and the
+ * maximum of the delay between the end of a frame transmission and the last resent packet of the frame.
+ *
+ * Returns: the statistic value, 0 if @name is unknown.
+ *
+ * Since: 0.8.32
+ */
+
+guint64
+arv_gv_fake_camera_get_info_uint64_by_name (ArvGvFakeCamera *gv_fake_camera, const char *name)
+{
+	guint64 value = 0;
+	unsigned int i;
+
+	g_return_val_if_fail (ARV_IS_GV_FAKE_CAMERA (gv_fake_camera), 0);
+	g_return_val_if_fail (name != NULL, 0);
+
+	for (i = 0; i < ARV_GV_FAKE_CAMERA_N_STATISTICS; i++) {
+		if (g_strcmp0 (statistic_names[i], name) == 0) {
+			g_mutex_lock (&gv_fake_camera->priv->statistics_mutex);
+			value = gv_fake_camera->priv->statistics[i];
+			g_mutex_unlock (&gv_fake_camera->priv->statistics_mutex);
+			return value;
+		}
+	}
+
+	arv_warning_device ("[GvFakeCamera::get_info_uint64_by_name] Unknown statistic '%s'", name);
+
+	return value;
+}
+
+/* Sender pool */
+
+typedef struct {
+	ArvGvFakeCamera **cameras;
+	guint n_cameras;
+
+	/* Sockets of all the cameras, the ones of camera i start at first_socket_fds[i] */
+	GPollFD *socket_fds;
+	guint *first_socket_fds;
+	guint n_socket_fds;
+
+	GThread *thread;
+	gboolean cancel;
+} ArvGvFakeCameraPoolWorker;
+
+struct _ArvGvFakeCameraPool {
+	ArvGvFakeCamera **cameras;
+	guint n_cameras;
+
+	ArvGvFakeCameraPoolWorker *workers;
+	guint n_workers;
+};
+
+static gboolean
+_pool_worker_has_events (ArvGvFakeCameraPoolWorker *worker, guint index)
+{
+	ArvGvFakeCamera *gv_fake_camera = worker->cameras[index];
+	guint i;
+
+	for (i = 0; i < gv_fake_camera->priv->n_socket_fds; i++)
+		if (worker->socket_fds[worker->first_socket_fds[index] + i].revents != 0)
+			return TRUE;
+
+	return FALSE;
+}
+
+static void *
+_pool_thread (void *user_data)
+{
+	ArvGvFakeCameraPoolWorker *worker = user_data;
+	guint i;
+
+	for (i = 0; i < worker->n_cameras; i++)
+		_sender_init (worker->cameras[i]);
+
+	while (!g_atomic_int_get (&worker->cancel)) {
+		gint timeout_ms = 100;
+
+		for (i = 0; i < worker->n_cameras; i++) {
+			gint camera_timeout_ms = _sender_prepare (worker->cameras[i]);
+
+			timeout_ms = MIN (timeout_ms, camera_timeout_ms);
+		}
+
+		if (g_poll (worker->socket_fds, worker->n_socket_fds, timeout_ms) > 0)
+			for (i = 0; i < worker->n_cameras; i++)
+				if (_pool_worker_has_events (worker, i))
+					_sender_receive (worker->cameras[i]);
+
+		/* Each camera sends its due packets in turn, a batch at most */
+		for (i = 0; i < worker->n_cameras; i++)
+			_sender_dispatch (worker->cameras[i]);
+	}
+
+	for (i = 0; i < worker->n_cameras; i++)
+		_sender_finish (worker->cameras[i]);
+
+	return NULL;
+}
+
+/*
+ * Serves a set of running fake cameras with a fixed number of threads, instead of one thread per camera. The cameras
+ * are distributed over the threads, each thread polls the control sockets of its cameras, and sends batches of
+ * due packets of their frames in turn, following the pacing deadlines of each camera. The cameras are given back their own thread when the pool is freed.
+ */
+
+ArvGvFakeCameraPool *
+arv_gv_fake_camera_pool_new (ArvGvFakeCamera **cameras, guint n_cameras, guint n_threads)
+{
+	ArvGvFakeCameraPool *pool;
+	guint i, j;
+
+	g_return_val_if_fail (cameras != NULL || n_cameras == 0, NULL);
+
+	for (i = 0; i < n_cameras; i++)
+		g_return_val_if_fail (ARV_IS_GV_FAKE_CAMERA (cameras[i]) &&
+				      cameras[i]->priv->thread != NULL, NULL);
+
+	pool = g_new0 (ArvGvFakeCameraPool, 1);
+	pool->n_cameras = n_cameras;
+	pool->cameras = g_new0 (ArvGvFakeCamera *, MAX (n_cameras, 1));
+	pool->n_workers = CLAMP (n_threads, 1, MAX (n_cameras, 1));
+	pool->workers = g_new0 (ArvGvFakeCameraPoolWorker, pool->n_workers);
+
+	for (i = 0; i < pool->n_workers; i++) {
+		ArvGvFakeCameraPoolWorker *worker = &pool->workers[i];
+
+		worker->cameras = g_new0 (ArvGvFakeCamera *, n_cameras / pool->n_workers + 1);
+		worker->first_socket_fds = g_new0 (guint, n_cameras / pool->n_workers + 1);
+		worker->socket_fds = g_new0 (GPollFD, (n_cameras / pool->n_workers + 1) *
+					     ARV_GV_FAKE_CAMERA_N_INPUT_SOCKETS);
+	}
+
+	for (i = 0; i < n_cameras; i++) {
+		ArvGvFakeCameraPoolWorker *worker = &pool->workers[i % pool->n_workers];
+		ArvGvFakeCamera *gv_fake_camera = g_object_ref (cameras[i]);
+
+		_stop_thread (gv_fake_camera);
+
+		pool->cameras[i] = gv_fake_camera;
+
+		worker->cameras[worker->n_cameras] = gv_fake_camera;
+		worker->first_socket_fds[worker->n_cameras] = worker->n_socket_fds;
+		worker->n_cameras++;
+
+		for (j = 0; j < gv_fake_camera->priv->n_socket_fds; j++)
+			worker->socket_fds[worker->n_socket_fds++] = gv_fake_camera->priv->socket_fds[j];
+	}
+
+	for (i = 0; i < pool->n_workers; i++) {
+		pool->workers[i].cancel = FALSE;
+		pool->workers[i].thread = g_thread_new ("arv_gv_fake_camera_pool", _pool_thread, &pool->workers[i]);
+	}
+
+	arv_info_device ("[GvFakeCamera::pool_new] %u cameras served by %u threads", n_cameras, pool->n_workers);
+
+	return pool;
+}
+
+void
+arv_gv_fake_camera_pool_free (ArvGvFakeCameraPool *pool)
+{
+	guint i;
+
+	if (pool == NULL)
+		return;
+
+	for (i = 0; i < pool->n_workers; i++) {
+		g_atomic_int_set (&pool->workers[i].cancel, TRUE);
+		g_thread_join (pool->workers[i].thread);
+
+		g_free (pool->workers[i].cameras);
+		g_free (pool->workers[i].first_socket_fds);
+		g_free (pool->workers[i].socket_fds);
+	}
+
+	for (i = 0; i < pool->n_cameras; i++) {
+		_start_thread (pool->cameras[i]);
+		g_object_unref (pool->cameras[i]);
+	}
+
+	g_free (pool->workers);
+	g_free (pool->cameras);
+	g_free (pool);
+}
+
 static void
 arv_gv_fake_camera_init (ArvGvFakeCamera *gv_fake_camera)
 {
 	gv_fake_camera->priv = arv_gv_fake_camera_get_instance_private (gv_fake_camera);
+
+	g_mutex_init (&gv_fake_camera->priv->impairment_mutex);
+	g_mutex_init (&gv_fake_camera->priv->statistics_mutex);
+	g_queue_init (&gv_fake_camera->priv->resend_requests);
+	arv_gv_fake_impairment_settings_parse (&gv_fake_camera->priv->impairment_settings, NULL, NULL);
 }
 
 static void
 _constructed (GObject *gobject)
 {
 	ArvGvFakeCamera *gv_fake_camera = ARV_GV_FAKE_CAMERA (gobject);
+	guint32 capabilities = 0;
 
 	G_OBJECT_CLASS (arv_gv_fake_camera_parent_class)->constructed (gobject);
 
 	gv_fake_camera->priv->camera = arv_fake_camera_new_full (gv_fake_camera->priv->serial_number, gv_fake_camera->priv->genicam_filename);
+
+	arv_fake_camera_read_register (gv_fake_camera->priv->camera, ARV_GVBS_GVCP_CAPABILITY_OFFSET, &capabilities);
+	arv_fake_camera_write_register (gv_fake_camera->priv->camera, ARV_GVBS_GVCP_CAPABILITY_OFFSET,
+					capabilities | ARV_GVBS_GVCP_CAPABILITY_PACKET_RESEND);
+
 	gv_fake_camera->priv->is_running = arv_gv_fake_camera_start (gv_fake_camera);
 }
 
@@ -723,6 +1888,10 @@ _finalize (GObject *object)
 	g_clear_pointer (&gv_fake_camera->priv->interface_name, g_free);
 	g_clear_pointer (&gv_fake_camera->priv->serial_number, g_free);
 	g_clear_pointer (&gv_fake_camera->priv->genicam_filename, g_free);
+	g_clear_pointer (&gv_fake_camera->priv->gvsp_impairment, g_free);
+
+	g_mutex_clear (&gv_fake_camera->priv->impairment_mutex);
+	g_mutex_clear (&gv_fake_camera->priv->statistics_mutex);
 
 	G_OBJECT_CLASS (arv_gv_fake_camera_parent_class)->finalize (object);
 }
@@ -772,4 +1941,62 @@ arv_gv_fake_camera_class_init (ArvGvFakeCameraClass *this_class)
 							      G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
 							      G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
 							      G_PARAM_STATIC_BLURB));
+	/**
+	 * ArvGvFakeCamera:gvsp-high-rate:
+	 *
+	 * Send a cycle of pregenerated frames, in batches of packets paced by the GevSCPD packet delay and by the
+	 * #ArvGvFakeCamera:gvsp-bit-rate limit, instead of generating and sending each packet of each frame.
+	 *
+	 * Since: 0.8.32
+	 */
+	g_object_class_install_property (object_class,
+					 PROP_GVSP_HIGH_RATE,
+					 g_param_spec_boolean ("gvsp-high-rate",
+							       "GVSP high rate",
+							       "Send pregenerated frames in paced packet batches",
+							       FALSE,
+							       G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
+							       G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							       G_PARAM_STATIC_BLURB));
+	/**
+	 * ArvGvFakeCamera:gvsp-bit-rate:
+	 *
+	 * Target GVSP bit rate in high rate mode, in bits per second. 0 means no limit other than the GevSCPD packet
+	 * delay.
+	 *
+	 * Since: 0.8.32
+	 */
+	g_object_class_install_property (object_class,
+					 PROP_GVSP_BIT_RATE,
+					 g_param_spec_double ("gvsp-bit-rate",
+							      "GVSP bit rate",
+							      "GVSP bit rate in high rate mode, in bits per second",
+							      0.0, G_MAXDOUBLE, 0.0,
+							      G_PARAM_WRITABLE | G_PARAM_CONSTRUCT |
+							      G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							      G_PARAM_STATIC_BLURB));
+	/**
+	 * ArvGvFakeCamera:gvsp-impairment:
+	 *
+	 * Seeded network impairment profile, applied to the GVSP packets. It is a comma separated list of key=value
+	 * settings, among seed, loss, burst-start, burst-end and burst-loss (Gilbert-Elliott burst loss model, with
+	 * the loss ratio of the good state, the state transition probabilities, and the loss ratio of the burst state),
+	 * reorder and reorder-window (ratio of packets delayed by up to reorder-window packets), duplicate, truncate,
+	 * leader-delay (in packets), trailer-delay and resend-latency (in µs). For example:
+	 * "seed=1,burst-start=0.001,burst-end=0.3,reorder=0.01,resend-latency=500".
+	 *
+	 * A given profile always impairs a given packet sequence the same way. It replaces the
+	 * #ArvGvFakeCamera:gvsp-lost-ratio setting.
+	 *
+	 * Since: 0.8.32
+	 */
+	g_object_class_install_property (object_class,
+					 PROP_GVSP_IMPAIRMENT,
+					 g_param_spec_string ("gvsp-impairment",
+							      "GVSP impairment",
+							      "GVSP network impairment profile",
+							      NULL,
+							      G_PARAM_WRITABLE |
+							      G_PARAM_STATIC_NAME | G_PARAM_STATIC_NICK |
+							      G_PARAM_STATIC_BLURB));
 }
@@ -42,6 +42,8 @@ ARV_API ArvGvFakeCamera *		arv_gv_fake_camera_new			(const char *interface_name,
 ARV_API ArvGvFakeCamera *		arv_gv_fake_camera_new_full		(const char *interface_name, const char *serial_number, const char *genicam_filename);
 ARV_API gboolean			arv_gv_fake_camera_is_running		(ArvGvFakeCamera *gv_fake_camera);
 ARV_API ArvFakeCamera *			arv_gv_fake_camera_get_fake_camera	(ArvGvFakeCamera *gv_fake_camera);
+ARV_API guint64				arv_gv_fake_camera_get_info_uint64_by_name	(ArvGvFakeCamera *gv_fake_camera,
+											 const char *name);
 
 G_END_DECLS
 
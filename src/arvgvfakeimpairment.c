@@ -0,0 +1,395 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/*
+ * Seeded GVSP packet impairment filter of the GigE Vision simulator.
+ *
+ * Packets are pushed in transmission order, and the packets to actually send are appended to an output list. All the
+ * random decisions are taken from a #GRand seeded by the profile, in a fixed order, so that the same profile applied
+ * to the same packet sequence always gives the same output.
+ *
+ * Packets sent without delay are referenced, the caller must send the output before reusing their memory. Delayed
+ * packets are copied, and released after a given number of later packets, or by arv_gv_fake_impairment_flush().
+ */
+
+#include <arvgvfakeimpairmentprivate.h>
+#include <arvgvspprivate.h>
+#include <arvdebugprivate.h>
+#include <gio/gio.h>
+#include <string.h>
+
+typedef struct {
+	guint8 *data;
+	guint32 size;
+	guint countdown;
+} ArvGvFakeImpairmentHeldPacket;
+
+struct _ArvGvFakeImpairment {
+	ArvGvFakeImpairmentSettings settings;
+	GRand *rand;
+	gboolean is_burst;
+
+	GArray *held_packets;
+
+	GArray *output_packets;
+	GArray *output_sizes;
+	GPtrArray *released_packets;
+
+	ArvGvFakeImpairmentCounters counters;
+};
+
+static gboolean
+_parse_ratio (const char *key, const char *value, double *ratio, GError **error)
+{
+	char *end;
+
+	*ratio = g_ascii_strtod (value, &end);
+	if (end == value || *end != '\0' || !(*ratio >= 0.0 && *ratio <= 1.0)) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+			     "Invalid %s value '%s', expecting a number between 0 and 1", key, value);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+_parse_uint (const char *key, const char *value, guint *integer, GError **error)
+{
+	guint64 result;
+	char *end;
+
+	result = g_ascii_strtoull (value, &end, 10);
+	if (end == value || *end != '\0' || result > G_MAXUINT) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+			     "Invalid %s value '%s', expecting a positive integer", key, value);
+		return FALSE;
+	}
+
+	*integer = result;
+
+	return TRUE;
+}
+
+/*
+ * Parses an impairment profile, given as a comma separated list of key=value pairs. Recognized keys are seed, loss,
+ * burst-start, burst-end, burst-loss, reorder, reorder-window, duplicate, truncate, leader-delay (in packets),
+ * trailer-delay (in µs) and resend-latency (in µs). Unspecified settings are 0, except the burst loss ratio and the
+ * reorder window, which default to 1 and 8.
+ */
+
+gboolean
+arv_gv_fake_impairment_settings_parse (ArvGvFakeImpairmentSettings *settings, const char *profile, GError **error)
+{
+	ArvGvFakeImpairmentSettings result = {0};
+	char **pairs;
+	gboolean success = TRUE;
+	guint i;
+
+	g_return_val_if_fail (settings != NULL, FALSE);
+
+	result.burst_loss_ratio = 1.0;
+	result.reorder_window = 8;
+
+	if (profile == NULL) {
+		*settings = result;
+		return TRUE;
+	}
+
+	pairs = g_strsplit (profile, ",", -1);
+
+	for (i = 0; success && pairs[i] != NULL; i++) {
+		char **tokens;
+		const char *key;
+		const char *value;
+
+		g_strstrip (pairs[i]);
+		if (pairs[i][0] == '\0')
+			continue;
+
+		tokens = g_strsplit (pairs[i], "=", 2);
+		key = g_strstrip (tokens[0]);
+		value = tokens[1] != NULL ? g_strstrip (tokens[1]) : NULL;
+
+		if (value == NULL) {
+			g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+				     "Missing value for impairment setting '%s'", key);
+			success = FALSE;
+		} else if (g_strcmp0 (key, "seed") == 0)
+			success = _parse_uint (key, value, &result.seed, error);
+		else if (g_strcmp0 (key, "loss") == 0)
+			success = _parse_ratio (key, value, &result.loss_ratio, error);
+		else if (g_strcmp0 (key, "burst-start") == 0)
+			success = _parse_ratio (key, value, &result.burst_start_probability, error);
+		else if (g_strcmp0 (key, "burst-end") == 0)
+			success = _parse_ratio (key, value, &result.burst_end_probability, error);
+		else if (g_strcmp0 (key, "burst-loss") == 0)
+			success = _parse_ratio (key, value, &result.burst_loss_ratio, error);
+		else if (g_strcmp0 (key, "reorder") == 0)
+			success = _parse_ratio (key, value, &result.reorder_ratio, error);
+		else if (g_strcmp0 (key, "reorder-window") == 0)
+			success = _parse_uint (key, value, &result.reorder_window, error);
+		else if (g_strcmp0 (key, "duplicate") == 0)
+			success = _parse_ratio (key, value, &result.duplicate_ratio, error);
+		else if (g_strcmp0 (key, "truncate") == 0)
+			success = _parse_ratio (key, value, &result.truncate_ratio, error);
+		else if (g_strcmp0 (key, "leader-delay") == 0)
+			success = _parse_uint (key, value, &result.leader_delay, error);
+		else if (g_strcmp0 (key, "trailer-delay") == 0)
+			success = _parse_uint (key, value, &result.trailer_delay_us, error);
+		else if (g_strcmp0 (key, "resend-latency") == 0)
+			success = _parse_uint (key, value, &result.resend_latency_us, error);
+		else {
+			g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+				     "Unknown impairment setting '%s'", key);
+			success = FALSE;
+		}
+
+		g_strfreev (tokens);
+	}
+
+	g_strfreev (pairs);
+
+	if (success)
+		*settings = result;
+
+	return success;
+}
+
+/* Returns %TRUE if the settings leave the packet stream untouched */
+
+gboolean
+arv_gv_fake_impairment_settings_is_null (const ArvGvFakeImpairmentSettings *settings)
+{
+	g_return_val_if_fail (settings != NULL, TRUE);
+
+	return settings->loss_ratio <= 0.0 &&
+		(settings->burst_start_probability <= 0.0 || settings->burst_loss_ratio <= 0.0) &&
+		(settings->reorder_ratio <= 0.0 || settings->reorder_window == 0) &&
+		settings->duplicate_ratio <= 0.0 &&
+		settings->truncate_ratio <= 0.0 &&
+		settings->leader_delay == 0 &&
+		settings->trailer_delay_us == 0;
+}
+
+ArvGvFakeImpairment *
+arv_gv_fake_impairment_new (const ArvGvFakeImpairmentSettings *settings)
+{
+	ArvGvFakeImpairment *impairment;
+
+	g_return_val_if_fail (settings != NULL, NULL);
+
+	impairment = g_new0 (ArvGvFakeImpairment, 1);
+	impairment->settings = *settings;
+	impairment->rand = g_rand_new_with_seed (settings->seed);
+	impairment->held_packets = g_array_new (FALSE, FALSE, sizeof (ArvGvFakeImpairmentHeldPacket));
+	impairment->output_packets = g_array_new (FALSE, FALSE, sizeof (guint8 *));
+	impairment->output_sizes = g_array_new (FALSE, FALSE, sizeof (guint32));
+	impairment->released_packets = g_ptr_array_new_with_free_func (g_free);
+
+	return impairment;
+}
+
+void
+arv_gv_fake_impairment_free (ArvGvFakeImpairment *impairment)
+{
+	guint i;
+
+	if (impairment == NULL)
+		return;
+
+	for (i = 0; i < impairment->held_packets->len; i++)
+		g_free (g_array_index (impairment->held_packets, ArvGvFakeImpairmentHeldPacket, i).data);
+
+	g_array_unref (impairment->held_packets);
+	g_array_unref (impairment->output_packets);
+	g_array_unref (impairment->output_sizes);
+	g_ptr_array_unref (impairment->released_packets);
+	g_rand_free (impairment->rand);
+	g_free (impairment);
+}
+
+const ArvGvFakeImpairmentSettings *
+arv_gv_fake_impairment_get_settings (ArvGvFakeImpairment *impairment)
+{
+	g_return_val_if_fail (impairment != NULL, NULL);
+
+	return &impairment->settings;
+}
+
+void
+arv_gv_fake_impairment_get_counters (ArvGvFakeImpairment *impairment, ArvGvFakeImpairmentCounters *counters)
+{
+	g_return_if_fail (impairment != NULL);
+	g_return_if_fail (counters != NULL);
+
+	*counters = impairment->counters;
+}
+
+static void
+_append_output (ArvGvFakeImpairment *impairment, guint8 *packet, guint32 size)
+{
+	g_array_append_val (impairment->output_packets, packet);
+	g_array_append_val (impairment->output_sizes, size);
+}
+
+static void
+_hold (ArvGvFakeImpairment *impairment, guint8 *packet, guint32 size, guint countdown)
+{
+	ArvGvFakeImpairmentHeldPacket held;
+
+	held.data = g_malloc (size);
+	memcpy (held.data, packet, size);
+	held.size = size;
+	held.countdown = countdown;
+
+	g_array_append_val (impairment->held_packets, held);
+}
+
+/* Releases the held packets whose countdown is over, in the order they were held */
+
+static void
+_release (ArvGvFakeImpairment *impairment, gboolean all)
+{
+	guint i;
+
+	for (i = 0; i < impairment->held_packets->len; ) {
+		ArvGvFakeImpairmentHeldPacket *held;
+
+		held = &g_array_index (impairment->held_packets, ArvGvFakeImpairmentHeldPacket, i);
+
+		if (!all && held->countdown > 1) {
+			held->countdown--;
+			i++;
+			continue;
+		}
+
+		_append_output (impairment, held->data, held->size);
+		g_ptr_array_add (impairment->released_packets, held->data);
+		g_array_remove_index (impairment->held_packets, i);
+	}
+}
+
+void
+arv_gv_fake_impairment_push (ArvGvFakeImpairment *impairment, guint8 *packet, guint32 size)
+{
+	const ArvGvFakeImpairmentSettings *settings;
+	ArvGvspContentType content_type;
+	guint countdown = 0;
+	double loss_ratio;
+
+	g_return_if_fail (impairment != NULL);
+	g_return_if_fail (packet != NULL);
+
+	settings = &impairment->settings;
+	content_type = arv_gvsp_packet_get_content_type ((ArvGvspPacket *) packet);
+
+	impairment->counters.n_packets++;
+
+	if (settings->burst_start_probability > 0.0) {
+		if (impairment->is_burst) {
+			if (g_rand_double (impairment->rand) < settings->burst_end_probability)
+				impairment->is_burst = FALSE;
+		} else if (g_rand_double (impairment->rand) < settings->burst_start_probability)
+			impairment->is_burst = TRUE;
+	}
+
+	loss_ratio = impairment->is_burst ? settings->burst_loss_ratio : settings->loss_ratio;
+	if (loss_ratio > 0.0 && g_rand_double (impairment->rand) < loss_ratio) {
+		impairment->counters.n_dropped_packets++;
+		arv_debug_stream_thread ("[GvFakeImpairment::push] Drop packet %" G_GUINT64_FORMAT,
+					 impairment->counters.n_packets - 1);
+		_release (impairment, FALSE);
+		return;
+	}
+
+	if (content_type == ARV_GVSP_CONTENT_TYPE_PAYLOAD &&
+	    settings->truncate_ratio > 0.0 && g_rand_double (impairment->rand) < settings->truncate_ratio) {
+		guint32 header_size;
+
+		header_size = sizeof (ArvGvspPacket) +
+			(arv_gvsp_packet_has_extended_ids ((ArvGvspPacket *) packet) ?
+			 sizeof (ArvGvspExtendedHeader) : sizeof (ArvGvspHeader));
+		if (size > header_size + 1) {
+			size = g_rand_int_range (impairment->rand, header_size, size);
+			impairment->counters.n_truncated_packets++;
+		}
+	}
+
+	if (content_type == ARV_GVSP_CONTENT_TYPE_LEADER && settings->leader_delay > 0) {
+		countdown = settings->leader_delay;
+		impairment->counters.n_delayed_packets++;
+	} else if (settings->reorder_ratio > 0.0 && settings->reorder_window > 0 &&
+		   g_rand_double (impairment->rand) < settings->reorder_ratio) {
+		countdown = g_rand_int_range (impairment->rand, 1, settings->reorder_window + 1);
+		impairment->counters.n_reordered_packets++;
+	}
+
+	if (countdown == 0) {
+		_append_output (impairment, packet, size);
+
+		if (settings->duplicate_ratio > 0.0 && g_rand_double (impairment->rand) < settings->duplicate_ratio) {
+			_append_output (impairment, packet, size);
+			impairment->counters.n_duplicated_packets++;
+		}
+	}
+
+	_release (impairment, FALSE);
+
+	if (countdown > 0)
+		_hold (impairment, packet, size, countdown);
+}
+
+/* Releases all the held packets, at the end of a frame */
+
+void
+arv_gv_fake_impairment_flush (ArvGvFakeImpairment *impairment)
+{
+	g_return_if_fail (impairment != NULL);
+
+	_release (impairment, TRUE);
+}
+
+guint
+arv_gv_fake_impairment_get_output (ArvGvFakeImpairment *impairment, guint8 ***packets, guint32 **sizes)
+{
+	g_return_val_if_fail (impairment != NULL, 0);
+
+	if (packets != NULL)
+		*packets = (guint8 **) impairment->output_packets->data;
+	if (sizes != NULL)
+		*sizes = (guint32 *) impairment->output_sizes->data;
+
+	return impairment->output_packets->len;
+}
+
+/* Must be called once the output is sent */
+
+void
+arv_gv_fake_impairment_clear_output (ArvGvFakeImpairment *impairment)
+{
+	g_return_if_fail (impairment != NULL);
+
+	g_array_set_size (impairment->output_packets, 0);
+	g_array_set_size (impairment->output_sizes, 0);
+	g_ptr_array_set_size (impairment->released_packets, 0);
+}
@@ -0,0 +1,89 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_GV_FAKE_IMPAIRMENT_PRIVATE_H
+#define ARV_GV_FAKE_IMPAIRMENT_PRIVATE_H
+
+#include <arvapi.h>
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+/*
+ * Network impairment profile of the GigE Vision simulator. Ratios and probabilities are per GVSP packet, the leader
+ * delay is a number of packets, and the trailer delay and resend latency are in µs.
+ */
+
+typedef struct {
+	guint32 seed;
+
+	/* Gilbert-Elliott loss model, the loss ratio applies to the good state */
+	double loss_ratio;
+	double burst_start_probability;
+	double burst_end_probability;
+	double burst_loss_ratio;
+
+	double reorder_ratio;
+	guint reorder_window;
+	double duplicate_ratio;
+	double truncate_ratio;
+
+	guint leader_delay;
+	guint trailer_delay_us;
+
+	guint resend_latency_us;
+} ArvGvFakeImpairmentSettings;
+
+typedef struct {
+	guint64 n_packets;
+	guint64 n_dropped_packets;
+	guint64 n_duplicated_packets;
+	guint64 n_reordered_packets;
+	guint64 n_truncated_packets;
+	guint64 n_delayed_packets;
+} ArvGvFakeImpairmentCounters;
+
+typedef struct _ArvGvFakeImpairment ArvGvFakeImpairment;
+
+/* private, but used by tests */
+ARV_API gboolean		arv_gv_fake_impairment_settings_parse	(ArvGvFakeImpairmentSettings *settings,
+									 const char *profile, GError **error);
+ARV_API gboolean		arv_gv_fake_impairment_settings_is_null	(const ArvGvFakeImpairmentSettings *settings);
+
+ARV_API ArvGvFakeImpairment *	arv_gv_fake_impairment_new		(const ArvGvFakeImpairmentSettings *settings);
+ARV_API void			arv_gv_fake_impairment_free		(ArvGvFakeImpairment *impairment);
+
+ARV_API const ArvGvFakeImpairmentSettings *
+				arv_gv_fake_impairment_get_settings	(ArvGvFakeImpairment *impairment);
+ARV_API void			arv_gv_fake_impairment_get_counters	(ArvGvFakeImpairment *impairment,
+									 ArvGvFakeImpairmentCounters *counters);
+
+ARV_API void			arv_gv_fake_impairment_push		(ArvGvFakeImpairment *impairment,
+									 guint8 *packet, guint32 size);
+ARV_API void			arv_gv_fake_impairment_flush		(ArvGvFakeImpairment *impairment);
+ARV_API guint			arv_gv_fake_impairment_get_output	(ArvGvFakeImpairment *impairment,
+									 guint8 ***packets, guint32 **sizes);
+ARV_API void			arv_gv_fake_impairment_clear_output	(ArvGvFakeImpairment *impairment);
+
+G_END_DECLS
+
+#endif
@@ -228,6 +228,8 @@ typedef struct {
 
 	guchar discovery_data[ARV_GVBS_DISCOVERY_DATA_SIZE];
 
+	gint64 last_seen_time;
+
 	volatile gint ref_count;
 } ArvGvInterfaceDeviceInfos;
 
@@ -283,6 +285,8 @@ arv_gv_interface_device_infos_new (GInetAddress *interface_address,
 
 	infos->interface_address = interface_address;
 
+	infos->last_seen_time = g_get_monotonic_time ();
+
 	infos->ref_count = 1;
 
 	return infos;
@@ -323,7 +327,15 @@ arv_gv_interface_device_infos_unref (ArvGvInterfaceDeviceInfos *infos)
 /* ArvGvInterface implementation */
 
 typedef struct {
+	GMutex devices_mutex;
 	GHashTable *devices;
+
+	GMutex discovery_mutex;
+	GCond discovery_cond;
+	GThread *discovery_thread;
+	GMainContext *discovery_context;
+	guint discovery_period_ms;
+	gboolean discovery_cancel;
 } ArvGvInterfacePrivate;
 
 struct _ArvGvInterface {
@@ -460,12 +472,222 @@ _discover (GHashTable *devices, const char *device_id, gboolean allow_broadcast_
 	} while (1);
 }
 
+typedef struct {
+        ArvInterface *interface;
+        char *device_id;
+        gboolean is_added;
+} ArvGvInterfaceDiscoveryEvent;
+
+static gboolean
+_discovery_event_dispatch (gpointer user_data)
+{
+        ArvGvInterfaceDiscoveryEvent *event = user_data;
+
+        if (event->is_added)
+                arv_interface_emit_device_added_signal (event->interface, event->device_id);
+        else
+                arv_interface_emit_device_removed_signal (event->interface, event->device_id);
+
+        return G_SOURCE_REMOVE;
+}
+
+static void
+_discovery_event_free (gpointer user_data)
+{
+        ArvGvInterfaceDiscoveryEvent *event = user_data;
+
+        g_object_unref (event->interface);
+        g_free (event->device_id);
+        g_free (event);
+}
+
+static void
+_queue_discovery_events (ArvGvInterface *gv_interface, GSList *device_ids, gboolean is_added)
+{
+        GSList *iter;
+
+        for (iter = device_ids; iter != NULL; iter = iter->next) {
+                ArvGvInterfaceDiscoveryEvent *event;
+
+                arv_info_interface ("[GvInterface::discovery] Device '%s' %s", (char *) iter->data,
+                                    is_added ? "added" : "removed");
+
+                event = g_new0 (ArvGvInterfaceDiscoveryEvent, 1);
+                event->interface = g_object_ref (ARV_INTERFACE (gv_interface));
+                event->device_id = g_strdup (iter->data);
+                event->is_added = is_added;
+
+                g_main_context_invoke_full (gv_interface->priv->discovery_context, G_PRIORITY_DEFAULT,
+                                            _discovery_event_dispatch, event, _discovery_event_free);
+        }
+}
+
 static void
-arv_gv_interface_discover (ArvGvInterface *gv_interface)
+arv_gv_interface_discover (ArvGvInterface *gv_interface, gboolean track_changes)
 {
         int flags = arv_interface_get_flags (ARV_INTERFACE(gv_interface));
+        GHashTable *devices;
+        GHashTableIter iter;
+        gpointer key, value;
+        GSList *added_ids = NULL;
+        GSList *removed_ids = NULL;
+
+        /* Discover without holding the device table lock, in order to not block concurrent device openings */
+
+        devices = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
+                                         (GDestroyNotify) arv_gv_interface_device_infos_unref);
+
+	_discover (devices, NULL, flags & ARV_GV_INTERFACE_FLAGS_ALLOW_BROADCAST_DISCOVERY_ACK);
+
+        g_mutex_lock (&gv_interface->priv->devices_mutex);
+
+        /* Without background discovery, the device table is the result of the last discovery */
+
+        if (!track_changes) {
+                GHashTable *old_devices = gv_interface->priv->devices;
+
+                gv_interface->priv->devices = devices;
+                devices = old_devices;
+        } else {
+                gint64 removal_time;
+
+                g_hash_table_iter_init (&iter, devices);
+                while (g_hash_table_iter_next (&iter, &key, &value)) {
+                        ArvGvInterfaceDeviceInfos *infos = value;
+
+                        if (g_strcmp0 (key, infos->id) == 0 &&
+                            !g_hash_table_contains (gv_interface->priv->devices, key))
+                                added_ids = g_slist_prepend (added_ids, g_strdup (key));
+
+                        g_hash_table_replace (gv_interface->priv->devices, key,
+                                              arv_gv_interface_device_infos_ref (value));
+                }
+
+                /* Forget the devices which did not answer to the last discovery rounds */
+
+                removal_time = g_get_monotonic_time () -
+                        (gint64) ARV_GV_INTERFACE_DISCOVERY_N_MISSED_ROUNDS *
+                        (gv_interface->priv->discovery_period_ms + ARV_GV_INTERFACE_DISCOVERY_TIMEOUT_MS) * 1000;
+
+                g_hash_table_iter_init (&iter, gv_interface->priv->devices);
+                while (g_hash_table_iter_next (&iter, &key, &value)) {
+                        ArvGvInterfaceDeviceInfos *infos = value;
+
+                        if (infos->last_seen_time < removal_time) {
+                                if (g_strcmp0 (key, infos->id) == 0)
+                                        removed_ids = g_slist_prepend (removed_ids, g_strdup (key));
+                                g_hash_table_iter_remove (&iter);
+                        }
+                }
+        }
+
+        g_mutex_unlock (&gv_interface->priv->devices_mutex);
+
+        g_hash_table_unref (devices);
+
+        _queue_discovery_events (gv_interface, removed_ids, FALSE);
+        _queue_discovery_events (gv_interface, added_ids, TRUE);
+
+        g_slist_free_full (removed_ids, g_free);
+        g_slist_free_full (added_ids, g_free);
+}
+
+static gpointer
+_discovery_thread (gpointer user_data)
+{
+        ArvGvInterface *gv_interface = user_data;
+        ArvGvInterfacePrivate *priv = gv_interface->priv;
+        gint64 end_time;
+
+        g_mutex_lock (&priv->discovery_mutex);
+
+        while (!priv->discovery_cancel) {
+                g_mutex_unlock (&priv->discovery_mutex);
+
+                arv_gv_interface_discover (gv_interface, TRUE);
+
+                g_mutex_lock (&priv->discovery_mutex);
+
+                end_time = g_get_monotonic_time () + (gint64) priv->discovery_period_ms * 1000;
+                while (!priv->discovery_cancel &&
+                       g_cond_wait_until (&priv->discovery_cond, &priv->discovery_mutex, end_time));
+        }
+
+        g_mutex_unlock (&priv->discovery_mutex);
+
+        return NULL;
+}
+
+static gboolean
+_is_discovery_running (ArvGvInterface *gv_interface)
+{
+        gboolean is_running;
+
+        g_mutex_lock (&gv_interface->priv->discovery_mutex);
+        is_running = gv_interface->priv->discovery_thread != NULL;
+        g_mutex_unlock (&gv_interface->priv->discovery_mutex);
+
+        return is_running;
+}
+
+/*
+ * arv_gv_interface_start_discovery:
+ * @gv_interface: a #ArvGvInterface
+ * @period_ms: delay between two discovery rounds, in ms, clamped to a minimum of 10 ms
+ *
+ * Starts a thread periodically broadcasting discovery requests. While it runs, the device table is kept up to date,
+ * arv_interface_update_device_list() returns immediately, and the #ArvInterface::device-added and
+ * #ArvInterface::device-removed signals are emitted from the thread default main context of the caller.
+ */
+
+void
+arv_gv_interface_start_discovery (ArvGvInterface *gv_interface, guint period_ms)
+{
+        ArvGvInterfacePrivate *priv;
 
-	_discover (gv_interface->priv->devices, NULL, flags & ARV_GV_INTERFACE_FLAGS_ALLOW_BROADCAST_DISCOVERY_ACK);
+        g_return_if_fail (ARV_IS_GV_INTERFACE (gv_interface));
+
+        priv = gv_interface->priv;
+
+        g_mutex_lock (&priv->discovery_mutex);
+
+        /* A null period would flood the network with discovery requests */
+        priv->discovery_period_ms = MAX (period_ms, ARV_GV_INTERFACE_DISCOVERY_MIN_PERIOD_MS);
+
+        if (priv->discovery_thread == NULL) {
+                priv->discovery_cancel = FALSE;
+                priv->discovery_context = g_main_context_ref_thread_default ();
+                priv->discovery_thread = g_thread_new ("arv_gv_discovery", _discovery_thread, gv_interface);
+        }
+
+        g_mutex_unlock (&priv->discovery_mutex);
+}
+
+void
+arv_gv_interface_stop_discovery (ArvGvInterface *gv_interface)
+{
+        ArvGvInterfacePrivate *priv;
+        GThread *thread;
+
+        g_return_if_fail (ARV_IS_GV_INTERFACE (gv_interface));
+
+        priv = gv_interface->priv;
+
+        g_mutex_lock (&priv->discovery_mutex);
+        thread = priv->discovery_thread;
+        priv->discovery_cancel = TRUE;
+        g_cond_signal (&priv->discovery_cond);
+        g_mutex_unlock (&priv->discovery_mutex);
+
+        if (thread == NULL)
+                return;
+
+        g_thread_join (thread);
+
+        g_mutex_lock (&priv->discovery_mutex);
+        priv->discovery_thread = NULL;
+        g_clear_pointer (&priv->discovery_context, g_main_context_unref);
+        g_mutex_unlock (&priv->discovery_mutex);
 }
 
 static GInetAddress *
@@ -491,7 +713,11 @@ arv_gv_interface_update_device_list (ArvInterface *interface, GArray *device_ids
 
 	gv_interface = ARV_GV_INTERFACE (interface);
 
-	arv_gv_interface_discover (gv_interface);
+	/* The background discovery keeps the device table up to date */
+	if (!_is_discovery_running (gv_interface))
+		arv_gv_interface_discover (gv_interface, FALSE);
+
+	g_mutex_lock (&gv_interface->priv->devices_mutex);
 
 	g_hash_table_iter_init (&iter, gv_interface->priv->devices);
 	while (g_hash_table_iter_next (&iter, &key, &value)) {
@@ -517,6 +743,8 @@ arv_gv_interface_update_device_list (ArvInterface *interface, GArray *device_ids
 			g_object_unref (device_address);
 		}
 	}
+
+	g_mutex_unlock (&gv_interface->priv->devices_mutex);
 }
 
 static GInetAddress *
@@ -628,7 +856,7 @@ arv_gv_interface_camera_locate (ArvGvInterface *gv_interface, GInetAddress *devi
 }
 
 static ArvDevice *
-_open_device (ArvInterface *interface, GHashTable *devices, const char *device_id, GError **error)
+_open_device (ArvInterface *interface, const char *device_id, GError **error)
 {
 	ArvGvInterface *gv_interface;
 	ArvDevice *device = NULL;
@@ -637,14 +865,23 @@ _open_device (ArvInterface *interface, GHashTable *devices, const char *device_i
 
 	gv_interface = ARV_GV_INTERFACE (interface);
 
+	/* Only the lookup is serialized, device instantiation can run concurrently */
+
+	g_mutex_lock (&gv_interface->priv->devices_mutex);
+
 	if (device_id == NULL) {
 		GList *device_list;
 
-		device_list = g_hash_table_get_values (devices);
+		device_list = g_hash_table_get_values (gv_interface->priv->devices);
 		device_infos = device_list != NULL ? device_list->data : NULL;
 		g_list_free (device_list);
 	} else
-		device_infos = g_hash_table_lookup (devices, device_id);
+		device_infos = g_hash_table_lookup (gv_interface->priv->devices, device_id);
+
+	if (device_infos != NULL)
+		arv_gv_interface_device_infos_ref (device_infos);
+
+	g_mutex_unlock (&gv_interface->priv->devices_mutex);
 
 	if (device_infos == NULL) {
 		struct addrinfo hints;
@@ -698,6 +935,8 @@ _open_device (ArvInterface *interface, GHashTable *devices, const char *device_i
 	device = arv_gv_device_new (device_infos->interface_address, device_address, error);
 	g_object_unref (device_address);
 
+	arv_gv_interface_device_infos_unref (device_infos);
+
 	return device;
 }
 
@@ -709,7 +948,7 @@ arv_gv_interface_open_device (ArvInterface *interface, const char *device_id, GE
 	GError *local_error = NULL;
         int flags;
 
-	device = _open_device (interface, ARV_GV_INTERFACE (interface)->priv->devices, device_id, &local_error);
+	device = _open_device (interface, device_id, &local_error);
 	if (ARV_IS_DEVICE (device) || local_error != NULL) {
 		if (local_error != NULL)
 			g_propagate_error (error, local_error);
@@ -763,6 +1002,7 @@ arv_gv_interface_destroy_instance (void)
 	g_mutex_lock (&arv_gv_interface_mutex);
 
 	if (arv_gv_interface != NULL) {
+		arv_gv_interface_stop_discovery (ARV_GV_INTERFACE (arv_gv_interface));
 		g_object_unref (arv_gv_interface);
 		arv_gv_interface = NULL;
 	}
@@ -775,6 +1015,9 @@ arv_gv_interface_init (ArvGvInterface *gv_interface)
 {
 	gv_interface->priv = arv_gv_interface_get_instance_private (gv_interface);
 
+	g_mutex_init (&gv_interface->priv->devices_mutex);
+	g_mutex_init (&gv_interface->priv->discovery_mutex);
+	g_cond_init (&gv_interface->priv->discovery_cond);
 	gv_interface->priv->devices = g_hash_table_new_full (g_str_hash, g_str_equal, NULL,
 							     (GDestroyNotify) arv_gv_interface_device_infos_unref);
 }
@@ -784,8 +1027,13 @@ arv_gv_interface_finalize (GObject *object)
 {
 	ArvGvInterface *gv_interface = ARV_GV_INTERFACE (object);
 
+	arv_gv_interface_stop_discovery (gv_interface);
+
 	g_hash_table_unref (gv_interface->priv->devices);
 	gv_interface->priv->devices = NULL;
+	g_mutex_clear (&gv_interface->priv->devices_mutex);
+	g_mutex_clear (&gv_interface->priv->discovery_mutex);
+	g_cond_clear (&gv_interface->priv->discovery_cond);
 
 	G_OBJECT_CLASS (arv_gv_interface_parent_class)->finalize (object);
 }
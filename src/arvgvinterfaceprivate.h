@@ -35,9 +35,14 @@ G_BEGIN_DECLS
 #define ARV_GV_INTERFACE_DISCOVERY_TIMEOUT_MS	1000
 #define ARV_GV_INTERFACE_SOCKET_BUFFER_SIZE	1024
 #define ARV_GV_INTERFACE_DISCOVERY_SOCKET_BUFFER_SIZE	(256*1024)
+#define ARV_GV_INTERFACE_DISCOVERY_N_MISSED_ROUNDS	3
+#define ARV_GV_INTERFACE_DISCOVERY_MIN_PERIOD_MS	10
 
 void 			arv_gv_interface_destroy_instance 	(void);
 
+void			arv_gv_interface_start_discovery	(ArvGvInterface *gv_interface, guint period_ms);
+void			arv_gv_interface_stop_discovery		(ArvGvInterface *gv_interface);
+
 G_END_DECLS
 
 #endif
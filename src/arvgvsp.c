@@ -35,13 +35,15 @@
 
 static ArvGvspPacket *
 arv_gvsp_packet_new (ArvGvspContentType content_type,
-		     guint16 frame_id, guint32 packet_id, size_t data_size, void *buffer, size_t *buffer_size)
+		     guint64 frame_id, guint32 packet_id, gboolean extended_ids, guint32 field_infos,
+		     size_t data_size, void *buffer, size_t *buffer_size)
 {
 	ArvGvspPacket *packet;
-	ArvGvspHeader *header;
 	size_t packet_size;
 
-	packet_size = sizeof (ArvGvspPacket) + sizeof (ArvGvspHeader) + data_size;
+	packet_size = sizeof (ArvGvspPacket) +
+		(extended_ids ? sizeof (ArvGvspExtendedHeader) : sizeof (ArvGvspHeader)) +
+		data_size;
 	if (packet_size == 0 || (buffer != NULL && (buffer_size == NULL || packet_size > *buffer_size)))
 		return NULL;
 
@@ -55,17 +57,34 @@ arv_gvsp_packet_new (ArvGvspContentType content_type,
 
 	packet->packet_type = 0;
 
-	header = (void *) &packet->header;
-	header->frame_id = g_htons (frame_id);
-	header->packet_infos = g_htonl ((packet_id & ARV_GVSP_PACKET_ID_MASK) |
-					((content_type << ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_POS) &
-					 ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_MASK));
+	if (extended_ids) {
+		ArvGvspExtendedHeader *header;
+
+		/* In extended id mode, the low bits of the packet infos hold content specific infos */
+		header = (void *) &packet->header;
+		header->flags = 0;
+		header->packet_infos = g_htonl (((guint32) ARV_GVSP_PACKET_EXTENDED_ID_MODE_MASK << 24) |
+						((content_type << ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_POS) &
+						 ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_MASK) |
+						(field_infos & ARV_GVSP_PACKET_ID_MASK));
+		header->frame_id = GUINT64_TO_BE (frame_id);
+		header->packet_id = g_htonl (packet_id);
+	} else {
+		ArvGvspHeader *header;
+
+		header = (void *) &packet->header;
+		header->frame_id = g_htons (frame_id);
+		header->packet_infos = g_htonl ((packet_id & ARV_GVSP_PACKET_ID_MASK) |
+						((content_type << ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_POS) &
+						 ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_MASK));
+	}
 
 	return packet;
 }
 
 ArvGvspPacket *
-arv_gvsp_packet_new_image_leader (guint16 frame_id, guint32 packet_id,
+arv_gvsp_packet_new_image_leader (guint64 frame_id, guint32 packet_id, gboolean extended_ids,
+				  ArvBufferPayloadType payload_type,
                                   guint64 timestamp, ArvPixelFormat pixel_format,
                                   guint32 width, guint32 height,
                                   guint32 x_offset, guint32 y_offset,
@@ -75,14 +94,15 @@ arv_gvsp_packet_new_image_leader (guint16 frame_id, guint32 packet_id,
         ArvGvspPacket *packet;
 
 	packet = arv_gvsp_packet_new (ARV_GVSP_CONTENT_TYPE_LEADER,
-				      frame_id, packet_id, sizeof (ArvGvspImageLeader), buffer, buffer_size);
+				      frame_id, packet_id, extended_ids, 0,
+				      sizeof (ArvGvspImageLeader), buffer, buffer_size);
 
 	if (packet != NULL) {
 		ArvGvspImageLeader *leader;
 
 		leader = arv_gvsp_packet_get_data (packet);
 		leader->flags = 0;
-		leader->payload_type = g_htons (ARV_BUFFER_PAYLOAD_TYPE_IMAGE);
+		leader->payload_type = g_htons (payload_type);
 		leader->timestamp_high = g_htonl (((guint64) timestamp >> 32));
 		leader->timestamp_low  = g_htonl ((guint64) timestamp & 0xffffffff);
 		leader->infos.pixel_format = g_htonl (pixel_format);
@@ -97,20 +117,83 @@ arv_gvsp_packet_new_image_leader (guint16 frame_id, guint32 packet_id,
 	return packet;
 }
 
+/* The part descriptions are left blank, they are set using arv_gvsp_multipart_leader_packet_set_part_infos(). As the
+ * number of parts is stored in the field specific infos of the header, a multipart leader always uses extended ids. */
+
 ArvGvspPacket *
-arv_gvsp_packet_new_data_trailer (guint16 frame_id, guint32 packet_id,
+arv_gvsp_packet_new_multipart_leader (guint64 frame_id, guint32 packet_id,
+				      guint64 timestamp, guint n_parts,
+				      void *buffer, size_t *buffer_size)
+{
+	ArvGvspPacket *packet;
+
+	packet = arv_gvsp_packet_new (ARV_GVSP_CONTENT_TYPE_LEADER,
+				      frame_id, packet_id, TRUE, n_parts & ARV_GVSP_PACKET_INFOS_N_PARTS_MASK,
+				      sizeof (ArvGvspMultipartLeader) + n_parts * sizeof (ArvGvspPartInfos),
+				      buffer, buffer_size);
+
+	if (packet != NULL) {
+		ArvGvspMultipartLeader *leader;
+
+		leader = arv_gvsp_packet_get_data (packet);
+		leader->flags = 0;
+		leader->payload_type = g_htons (ARV_BUFFER_PAYLOAD_TYPE_MULTIPART);
+		leader->timestamp_high = g_htonl (((guint64) timestamp >> 32));
+		leader->timestamp_low  = g_htonl ((guint64) timestamp & 0xffffffff);
+		memset (leader->parts, 0, n_parts * sizeof (ArvGvspPartInfos));
+	}
+
+	return packet;
+}
+
+gboolean
+arv_gvsp_multipart_leader_packet_set_part_infos (ArvGvspPacket *packet, guint part_id,
+						 guint purpose_id, ArvBufferPartDataType data_type,
+						 guint64 size, ArvPixelFormat pixel_format,
+						 guint32 width, guint32 height,
+						 guint32 x_offset, guint32 y_offset,
+						 guint32 x_padding, guint32 y_padding)
+{
+	ArvGvspMultipartLeader *leader;
+	ArvGvspPartInfos *infos;
+
+	if (part_id >= arv_gvsp_leader_packet_get_multipart_n_parts (packet))
+		return FALSE;
+
+	leader = arv_gvsp_packet_get_data (packet);
+	infos = &leader->parts[part_id];
+
+	infos->data_type = g_htons (data_type);
+	infos->part_length_high = g_htons ((size >> 32) & 0xffff);
+	infos->part_length_low = g_htonl (size & 0xffffffff);
+	infos->pixel_format = g_htonl (pixel_format);
+	infos->data_purpose_id = g_htons (purpose_id);
+	infos->width = g_htonl (width);
+	infos->height = g_htonl (height);
+	infos->x_offset = g_htonl (x_offset);
+	infos->y_offset = g_htonl (y_offset);
+	infos->x_padding = g_htons (x_padding);
+	infos->y_padding = g_htons (y_padding);
+
+	return TRUE;
+}
+
+ArvGvspPacket *
+arv_gvsp_packet_new_data_trailer (guint64 frame_id, guint32 packet_id, gboolean extended_ids,
+				  ArvBufferPayloadType payload_type,
 				  void *buffer, size_t *buffer_size)
 {
 	ArvGvspPacket *packet;
 
 	packet = arv_gvsp_packet_new (ARV_GVSP_CONTENT_TYPE_TRAILER,
-				      frame_id, packet_id, sizeof (ArvGvspTrailer), buffer, buffer_size);
+				      frame_id, packet_id, extended_ids, 0,
+				      sizeof (ArvGvspTrailer), buffer, buffer_size);
 
 	if (packet != NULL) {
 		ArvGvspTrailer *trailer;
 
 		trailer = arv_gvsp_packet_get_data (packet);
-		trailer->payload_type = g_htonl (ARV_BUFFER_PAYLOAD_TYPE_IMAGE);
+		trailer->payload_type = g_htonl (payload_type);
 		trailer->data0 = 0;
 	}
 
@@ -118,14 +201,15 @@ arv_gvsp_packet_new_data_trailer (guint16 frame_id, guint32 packet_id,
 }
 
 ArvGvspPacket *
-arv_gvsp_packet_new_payload (guint16 frame_id, guint32 packet_id,
+arv_gvsp_packet_new_payload (guint64 frame_id, guint32 packet_id, gboolean extended_ids,
                              size_t size, void *data,
                              void *buffer, size_t *buffer_size)
 {
         ArvGvspPacket *packet;
 
 	packet = arv_gvsp_packet_new (ARV_GVSP_CONTENT_TYPE_PAYLOAD,
-				      frame_id, packet_id, size, buffer, buffer_size);
+				      frame_id, packet_id, extended_ids, 0,
+				      size, buffer, buffer_size);
 
 	if (packet != NULL)
 		memcpy (arv_gvsp_packet_get_data (packet), data, size);
@@ -133,6 +217,33 @@ arv_gvsp_packet_new_payload (guint16 frame_id, guint32 packet_id,
 	return packet;
 }
 
+ArvGvspPacket *
+arv_gvsp_packet_new_multipart (guint64 frame_id, guint32 packet_id,
+			       guint part_id, guint64 offset,
+			       size_t size, void *data,
+			       void *buffer, size_t *buffer_size)
+{
+	ArvGvspPacket *packet;
+
+	packet = arv_gvsp_packet_new (ARV_GVSP_CONTENT_TYPE_MULTIPART,
+				      frame_id, packet_id, TRUE, 0,
+				      sizeof (ArvGvspMultipart) + size, buffer, buffer_size);
+
+	if (packet != NULL) {
+		ArvGvspMultipart *multipart;
+
+		multipart = arv_gvsp_packet_get_data (packet);
+		multipart->part_id = part_id;
+		multipart->zone_info = 0;
+		multipart->offset_high = g_htons ((offset >> 32) & 0xffff);
+		multipart->offset_low = g_htonl (offset & 0xffffffff);
+
+		memcpy (arv_gvsp_multipart_packet_get_data (packet), data, size);
+	}
+
+	return packet;
+}
+
 static const char *
 arv_enum_to_string (GType type,
 		    guint enum_value)
@@ -234,15 +234,32 @@ typedef struct {
 
 #pragma pack(pop)
 
-ArvGvspPacket *		arv_gvsp_packet_new_image_leader	(guint16 frame_id, guint32 packet_id,
+/* private, but used by tests */
+ARV_API ArvGvspPacket *	arv_gvsp_packet_new_image_leader	(guint64 frame_id, guint32 packet_id, gboolean extended_ids,
+								 ArvBufferPayloadType payload_type,
 								 guint64 timestamp, ArvPixelFormat pixel_format,
 								 guint32 width, guint32 height,
 								 guint32 x_offset, guint32 y_offset,
 								 guint32 x_padding, guint32 y_padding,
 								 void *buffer, size_t *buffer_size);
-ArvGvspPacket *		arv_gvsp_packet_new_data_trailer	(guint16 frame_id, guint32 packet_id,
+ArvGvspPacket *		arv_gvsp_packet_new_multipart_leader	(guint64 frame_id, guint32 packet_id,
+								 guint64 timestamp, guint n_parts,
 								 void *buffer, size_t *buffer_size);
-ArvGvspPacket *		arv_gvsp_packet_new_payload		(guint16 frame_id, guint32 packet_id,
+gboolean		arv_gvsp_multipart_leader_packet_set_part_infos	(ArvGvspPacket *packet, guint part_id,
+									 guint purpose_id,
+									 ArvBufferPartDataType data_type,
+									 guint64 size, ArvPixelFormat pixel_format,
+									 guint32 width, guint32 height,
+									 guint32 x_offset, guint32 y_offset,
+									 guint32 x_padding, guint32 y_padding);
+ARV_API ArvGvspPacket *	arv_gvsp_packet_new_data_trailer	(guint64 frame_id, guint32 packet_id, gboolean extended_ids,
+								 ArvBufferPayloadType payload_type,
+								 void *buffer, size_t *buffer_size);
+ARV_API ArvGvspPacket *	arv_gvsp_packet_new_payload		(guint64 frame_id, guint32 packet_id, gboolean extended_ids,
+								 size_t size, void *data,
+								 void *buffer, size_t *buffer_size);
+ArvGvspPacket *		arv_gvsp_packet_new_multipart		(guint64 frame_id, guint32 packet_id,
+								 guint part_id, guint64 offset,
 								 size_t size, void *data,
 								 void *buffer, size_t *buffer_size);
 char * 			arv_gvsp_packet_to_string 		(const ArvGvspPacket *packet, size_t packet_size);
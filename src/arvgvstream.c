@@ -34,6 +34,7 @@
 #include <arvparamsprivate.h>
 #include <arvgvspprivate.h>
 #include <arvgvcpprivate.h>
+#include <arvpcapwriterprivate.h>
 #include <arvdebug.h>
 #include <arvmisc.h>
 #include <arvmiscprivate.h>
@@ -160,6 +161,19 @@ struct _ArvGvStreamThreadData {
 
 	gboolean use_packet_socket;
 
+	/* Resend requests and virtual time of a replay stream, replay_requests is NULL for a network stream */
+	GArray *replay_requests;
+	guint64 replay_time_us;
+
+	/* Pcap capture. The writer is changed under pcap_mutex, which the stream thread only tries to lock, in order to
+	 * never wait in the receive path. */
+
+	GMutex pcap_mutex;
+	ArvPcapWriter *pcap_writer;
+	gboolean pcap_gvcp;
+	guint32 pcap_interface_ip;
+	guint32 pcap_device_ip;
+
 	/* Statistics */
 
 	guint64 n_completed_buffers;
@@ -184,6 +198,8 @@ struct _ArvGvStreamThreadData {
         guint64 n_transferred_bytes;
         guint64 n_ignored_bytes;
 
+	guint64 n_capture_dropped_packets;
+
 	ArvHistogram *histogram;
 	guint32 statistic_count;
 
@@ -192,6 +208,37 @@ struct _ArvGvStreamThreadData {
 	int current_socket_buffer_size;
 };
 
+static void
+_capture_packet (ArvGvStreamThreadData *thread_data, gboolean is_gvcp, const void *packet, size_t size)
+{
+	gboolean success = FALSE;
+
+	if (!g_mutex_trylock (&thread_data->pcap_mutex)) {
+		thread_data->n_capture_dropped_packets++;
+		return;
+	}
+
+	if (thread_data->pcap_writer == NULL) {
+		success = TRUE;
+	} else if (is_gvcp) {
+		success = !thread_data->pcap_gvcp ||
+			arv_pcap_writer_push_udp (thread_data->pcap_writer,
+						  thread_data->pcap_interface_ip, thread_data->stream_port,
+						  thread_data->pcap_device_ip, ARV_GVCP_PORT,
+						  packet, size);
+	} else {
+		success = arv_pcap_writer_push_udp (thread_data->pcap_writer,
+						    thread_data->pcap_device_ip, thread_data->source_stream_port,
+						    thread_data->pcap_interface_ip, thread_data->stream_port,
+						    packet, size);
+	}
+
+	g_mutex_unlock (&thread_data->pcap_mutex);
+
+	if (!success)
+		thread_data->n_capture_dropped_packets++;
+}
+
 static void
 _send_packet_request (ArvGvStreamThreadData *thread_data,
 		      guint64 frame_id,
@@ -213,9 +260,20 @@ _send_packet_request (ArvGvStreamThreadData *thread_data,
 
 	arv_gvcp_packet_debug (packet, ARV_DEBUG_LEVEL_DEBUG);
 
+	if (G_UNLIKELY (thread_data->replay_requests != NULL)) {
+		ArvGvStreamReplayRequest request = {frame_id, first_block, last_block};
+
+		g_array_append_val (thread_data->replay_requests, request);
+		arv_gvcp_packet_free (packet);
+		return;
+	}
+
 	g_socket_send_to (thread_data->socket, thread_data->device_socket_address, (const char *) packet, packet_size,
 			  NULL, NULL);
 
+	if (G_UNLIKELY (g_atomic_pointer_get (&thread_data->pcap_writer) != NULL))
+		_capture_packet (thread_data, TRUE, packet, packet_size);
+
 	arv_gvcp_packet_free (packet);
 }
 
@@ -225,8 +283,9 @@ _update_socket (ArvGvStreamThreadData *thread_data, ArvBuffer *buffer)
 	int buffer_size = thread_data->current_socket_buffer_size;
 	int fd;
 
-	if (thread_data->socket_buffer_option == ARV_GV_STREAM_SOCKET_BUFFER_FIXED &&
-	    thread_data->socket_buffer_size <= 0)
+	if (thread_data->socket == NULL ||
+	    (thread_data->socket_buffer_option == ARV_GV_STREAM_SOCKET_BUFFER_FIXED &&
+	     thread_data->socket_buffer_size <= 0))
 		return;
 
 	fd = g_socket_get_fd (thread_data->socket);
@@ -888,6 +947,9 @@ _process_packet (ArvGvStreamThreadData *thread_data, const ArvGvspPacket *packet
 
 	thread_data->n_received_packets++;
 
+	if (G_UNLIKELY (g_atomic_pointer_get (&thread_data->pcap_writer) != NULL))
+		_capture_packet (thread_data, FALSE, packet, packet_size);
+
 	frame_id = arv_gvsp_packet_get_frame_id (packet);
 	packet_id = arv_gvsp_packet_get_packet_id (packet);
 
@@ -1413,6 +1475,7 @@ arv_gv_stream_start_thread (ArvStream *stream)
 
 	g_return_if_fail (priv->thread == NULL);
 	g_return_if_fail (priv->thread_data != NULL);
+	g_return_if_fail (priv->thread_data->replay_requests == NULL);
 
 	thread_data = priv->thread_data;
 
@@ -1493,6 +1556,348 @@ arv_gv_stream_get_statistics (ArvGvStream *gv_stream,
 		*n_missing_packets = thread_data->n_missing_packets;
 }
 
+/**
+ * arv_gv_stream_start_pcap_capture:
+ * @gv_stream: a #ArvGvStream
+ * @filename: pcap file name
+ * @capture_gvcp: also capture the control traffic
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Starts writing the GVSP packets received by the stream thread to a pcap file, with a raw IPv4 link type. If
+ * @capture_gvcp is %TRUE, the packet resend requests of the stream thread, and the GVCP commands and acknowledges of
+ * the device, are captured as well. A capture already running is stopped first.
+ *
+ * The packets are copied into a ring buffer and written to the disk by a separate thread. If the writer thread does
+ * not keep up, packets are left out of the capture, and counted by the n_capture_dropped_packets stream info, but the
+ * acquisition is never slowed down.
+ *
+ * Returns: %TRUE on success.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_gv_stream_start_pcap_capture (ArvGvStream *gv_stream, const char *filename, gboolean capture_gvcp, GError **error)
+{
+	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
+	ArvGvStreamThreadData *thread_data;
+	ArvPcapWriter *writer;
+
+	g_return_val_if_fail (ARV_IS_GV_STREAM (gv_stream), FALSE);
+	g_return_val_if_fail (filename != NULL, FALSE);
+	g_return_val_if_fail (ARV_IS_GV_DEVICE (priv->gv_device), FALSE);
+
+	arv_gv_stream_stop_pcap_capture (gv_stream);
+
+	thread_data = priv->thread_data;
+
+	writer = arv_pcap_writer_new (filename, ARV_PCAP_WRITER_N_SLOTS_DEFAULT,
+				      MAX (thread_data->scps_packet_size, ARV_PCAP_WRITER_SNAP_LENGTH_MIN),
+				      error);
+	if (writer == NULL)
+		return FALSE;
+
+	g_mutex_lock (&thread_data->pcap_mutex);
+	thread_data->pcap_gvcp = capture_gvcp;
+	g_atomic_pointer_set (&thread_data->pcap_writer, writer);
+	g_mutex_unlock (&thread_data->pcap_mutex);
+
+	if (capture_gvcp)
+		arv_gv_device_set_pcap_writer (priv->gv_device, writer);
+
+	arv_info_stream ("[GvStream::start_pcap_capture] Capture to '%s'%s", filename,
+			 capture_gvcp ? " (with GVCP)" : "");
+
+	return TRUE;
+}
+
+/**
+ * arv_gv_stream_stop_pcap_capture:
+ * @gv_stream: a #ArvGvStream
+ *
+ * Stops the capture started by arv_gv_stream_start_pcap_capture(). The pending packets are written and the file is
+ * closed before this function returns.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_gv_stream_stop_pcap_capture (ArvGvStream *gv_stream)
+{
+	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
+	ArvGvStreamThreadData *thread_data;
+	ArvPcapWriter *writer;
+
+	g_return_if_fail (ARV_IS_GV_STREAM (gv_stream));
+
+	thread_data = priv->thread_data;
+
+	g_mutex_lock (&thread_data->pcap_mutex);
+	writer = thread_data->pcap_writer;
+	g_atomic_pointer_set (&thread_data->pcap_writer, NULL);
+	g_mutex_unlock (&thread_data->pcap_mutex);
+
+	if (writer == NULL)
+		return;
+
+	if (thread_data->pcap_gvcp && ARV_IS_GV_DEVICE (priv->gv_device))
+		arv_gv_device_set_pcap_writer (priv->gv_device, NULL);
+
+	arv_pcap_writer_unref (writer);
+}
+
+/* Replay
+ *
+ * A replay stream has no device, no socket and no thread. Packets are fed by the caller, from memory or from a pcap
+ * file, straight into the reassembly state machine, at full speed and with a virtual time given for each packet. The
+ * resend requests are recorded instead of being sent. This allows to measure the reassembly throughput and to check
+ * the resend decisions deterministically. */
+
+#define ARV_GV_STREAM_PCAP_LINKTYPE_ETHERNET	1
+#define ARV_GV_STREAM_PCAP_LINKTYPE_RAW		101
+#define ARV_GV_STREAM_PCAP_LINKTYPE_IPV4	228
+
+/*
+ * Creates a replay stream. @packet_size is the stream channel packet size (SCPS), including the IP and UDP headers,
+ * which the packets to replay have been sent with.
+ */
+
+ArvStream *
+arv_gv_stream_new_replay (guint packet_size, guint64 timestamp_tick_frequency,
+			  ArvStreamCallback callback, void *callback_data,
+			  GError **error)
+{
+	ArvGvStreamPrivate *priv;
+	ArvStream *stream;
+
+	g_return_val_if_fail (packet_size > ARV_GVSP_PACKET_PROTOCOL_OVERHEAD (FALSE), NULL);
+
+	stream = g_initable_new (ARV_TYPE_GV_STREAM, NULL, error,
+				 "callback", callback,
+				 "callback-data", callback_data,
+				 NULL);
+	if (stream == NULL)
+		return NULL;
+
+	priv = arv_gv_stream_get_instance_private (ARV_GV_STREAM (stream));
+
+	priv->thread_data->scps_packet_size = packet_size;
+	priv->thread_data->timestamp_tick_frequency = timestamp_tick_frequency;
+	priv->thread_data->frames = NULL;
+	priv->thread_data->last_frame_id = 0;
+	priv->thread_data->first_packet = TRUE;
+	priv->thread_data->replay_requests = g_array_new (FALSE, FALSE, sizeof (ArvGvStreamReplayRequest));
+
+	return stream;
+}
+
+/*
+ * Processes a GVSP packet received at @time_us, as the stream thread would do. Time is in µs, on any non zero time
+ * base, and must not go backward.
+ */
+
+void
+arv_gv_stream_replay_packet (ArvGvStream *gv_stream, const void *packet, size_t packet_size, guint64 time_us)
+{
+	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
+	ArvGvStreamThreadData *thread_data;
+	ArvGvStreamFrameData *frame;
+
+	g_return_if_fail (ARV_IS_GV_STREAM (gv_stream));
+	g_return_if_fail (priv->thread_data->replay_requests != NULL);
+	g_return_if_fail (packet != NULL);
+
+	thread_data = priv->thread_data;
+	thread_data->replay_time_us = time_us;
+
+	frame = _process_packet (thread_data, packet, packet_size, time_us);
+	_check_frame_completion (thread_data, time_us, frame);
+}
+
+/*
+ * Lets the virtual time advance to @time_us without packet, as a poll timeout of the stream thread would do. Missing
+ * packets may be requested and frames may time out.
+ */
+
+void
+arv_gv_stream_replay_time (ArvGvStream *gv_stream, guint64 time_us)
+{
+	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
+
+	g_return_if_fail (ARV_IS_GV_STREAM (gv_stream));
+	g_return_if_fail (priv->thread_data->replay_requests != NULL);
+
+	priv->thread_data->replay_time_us = time_us;
+
+	_check_frame_completion (priv->thread_data, time_us, NULL);
+}
+
+/*
+ * Aborts the frames still being reassembled, as the end of the stream thread would do.
+ */
+
+void
+arv_gv_stream_replay_flush (ArvGvStream *gv_stream)
+{
+	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
+
+	g_return_if_fail (ARV_IS_GV_STREAM (gv_stream));
+	g_return_if_fail (priv->thread_data->replay_requests != NULL);
+
+	_flush_frames (priv->thread_data, priv->thread_data->replay_time_us);
+}
+
+/*
+ * Returns the resend requests issued since the creation of the replay stream, in order.
+ */
+
+const ArvGvStreamReplayRequest *
+arv_gv_stream_replay_get_resend_requests (ArvGvStream *gv_stream, guint *n_requests)
+{
+	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
+
+	g_return_val_if_fail (ARV_IS_GV_STREAM (gv_stream), NULL);
+	g_return_val_if_fail (priv->thread_data->replay_requests != NULL, NULL);
+
+	if (n_requests != NULL)
+		*n_requests = priv->thread_data->replay_requests->len;
+
+	return (const ArvGvStreamReplayRequest *) priv->thread_data->replay_requests->data;
+}
+
+static guint32
+_pcap_get_uint32 (const guint8 *data, gboolean is_swapped)
+{
+	guint32 value;
+
+	memcpy (&value, data, sizeof (value));
+
+	return is_swapped ? GUINT32_SWAP_LE_BE (value) : value;
+}
+
+/*
+ * Replays the GVSP packets of a pcap file, using the capture timestamps as virtual time. Ethernet, raw IP and IPv4
+ * link types are supported. GVCP packets, non UDP packets and truncated packets are skipped. If @destination_port is
+ * not 0, only the packets sent to this port are replayed.
+ */
+
+gboolean
+arv_gv_stream_replay_pcap (ArvGvStream *gv_stream, const char *filename, guint16 destination_port, guint64 *n_packets,
+			   GError **error)
+{
+	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
+	GMappedFile *file;
+	const guint8 *data;
+	gsize size;
+	gsize offset;
+	guint32 magic;
+	guint32 link_type;
+	gboolean is_swapped;
+	gboolean is_nanosecond;
+	guint64 n_replayed_packets = 0;
+
+	g_return_val_if_fail (ARV_IS_GV_STREAM (gv_stream), FALSE);
+	g_return_val_if_fail (priv->thread_data->replay_requests != NULL, FALSE);
+	g_return_val_if_fail (filename != NULL, FALSE);
+
+	file = g_mapped_file_new (filename, FALSE, error);
+	if (file == NULL)
+		return FALSE;
+
+	data = (const guint8 *) g_mapped_file_get_contents (file);
+	size = g_mapped_file_get_length (file);
+
+	magic = size >= 24 ? _pcap_get_uint32 (data, FALSE) : 0;
+	is_swapped = magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1;
+	is_nanosecond = magic == 0xa1b23c4d || magic == 0x4d3cb2a1;
+	link_type = size >= 24 ? _pcap_get_uint32 (data + 20, is_swapped) & 0xffff : 0;
+
+	if ((magic != 0xa1b2c3d4 && !is_swapped && !is_nanosecond) ||
+	    (link_type != ARV_GV_STREAM_PCAP_LINKTYPE_ETHERNET &&
+	     link_type != ARV_GV_STREAM_PCAP_LINKTYPE_RAW &&
+	     link_type != ARV_GV_STREAM_PCAP_LINKTYPE_IPV4)) {
+		g_set_error (error, G_FILE_ERROR, G_FILE_ERROR_INVAL,
+			     "'%s' is not a pcap file with a supported link type", filename);
+		g_mapped_file_unref (file);
+		return FALSE;
+	}
+
+	for (offset = 24; offset + 16 <= size; ) {
+		const guint8 *ip;
+		const guint8 *udp;
+		guint64 time_us;
+		guint32 captured_size;
+		guint32 original_size;
+		guint ip_header_size;
+		guint udp_size;
+
+		time_us = (guint64) _pcap_get_uint32 (data + offset, is_swapped) * 1000000 +
+			_pcap_get_uint32 (data + offset + 4, is_swapped) / (is_nanosecond ? 1000 : 1);
+		captured_size = _pcap_get_uint32 (data + offset + 8, is_swapped);
+		original_size = _pcap_get_uint32 (data + offset + 12, is_swapped);
+
+		if (offset + 16 + captured_size > size)
+			break;
+
+		ip = data + offset + 16;
+		offset += 16 + captured_size;
+
+		if (captured_size < original_size)
+			continue;
+
+		if (link_type == ARV_GV_STREAM_PCAP_LINKTYPE_ETHERNET) {
+			guint header_size = 14;
+			guint16 ether_type;
+
+			if (captured_size < 18)
+				continue;
+
+			ether_type = (ip[12] << 8) | ip[13];
+			/* 802.1Q tag */
+			if (ether_type == 0x8100) {
+				ether_type = (ip[16] << 8) | ip[17];
+				header_size = 18;
+			}
+
+			if (ether_type != 0x0800)
+				continue;
+
+			ip += header_size;
+			captured_size -= header_size;
+		}
+
+		if (captured_size < 20 || (ip[0] >> 4) != 4 || ip[9] != 17)
+			continue;
+
+		ip_header_size = (ip[0] & 0x0f) * 4;
+		if (captured_size < ip_header_size + 8)
+			continue;
+
+		udp = ip + ip_header_size;
+		udp_size = (udp[4] << 8) | udp[5];
+
+		if (((udp[0] << 8) | udp[1]) == ARV_GVCP_PORT ||
+		    ((udp[2] << 8) | udp[3]) == ARV_GVCP_PORT ||
+		    (destination_port != 0 && ((udp[2] << 8) | udp[3]) != destination_port) ||
+		    udp_size < 8 + sizeof (ArvGvspPacket) + sizeof (ArvGvspHeader) ||
+		    ip_header_size + udp_size > captured_size)
+			continue;
+
+		arv_gv_stream_replay_packet (gv_stream, udp + 8, udp_size - 8, time_us);
+		n_replayed_packets++;
+	}
+
+	g_mapped_file_unref (file);
+
+	arv_info_stream ("[GvStream::replay_pcap] %" G_GUINT64_FORMAT " packet(s) replayed from '%s'",
+			 n_replayed_packets, filename);
+
+	if (n_packets != NULL)
+		*n_packets = n_replayed_packets;
+
+	return TRUE;
+}
+
 static void
 arv_gv_stream_set_property (GObject * object, guint prop_id,
                             const GValue * value, GParamSpec * pspec)
@@ -1573,6 +1978,67 @@ arv_gv_stream_init (ArvGvStream *gv_stream)
 	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
 
 	priv->thread_data = g_new0 (ArvGvStreamThreadData, 1);
+	g_mutex_init (&priv->thread_data->pcap_mutex);
+}
+
+static void
+_init_thread_data (ArvGvStream *gv_stream)
+{
+	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (gv_stream);
+
+	priv->thread_data->stream = ARV_STREAM (gv_stream);
+
+	g_object_get (gv_stream,
+		      "callback", &priv->thread_data->callback,
+		      "callback-data", &priv->thread_data->callback_data,
+		      NULL);
+
+	priv->thread_data->packet_id = 65300;
+
+	priv->thread_data->histogram = arv_histogram_new (3, 100, 2000, 0);
+
+	arv_histogram_set_variable_name (priv->thread_data->histogram, 0, "frame_retention");
+	arv_histogram_set_variable_name (priv->thread_data->histogram, 1, "packet_time");
+	arv_histogram_set_variable_name (priv->thread_data->histogram, 2, "inter_packet");
+
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_completed_buffers",
+                                 G_TYPE_UINT64, &priv->thread_data->n_completed_buffers);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_failures",
+                                 G_TYPE_UINT64, &priv->thread_data->n_failures);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_underruns",
+                                 G_TYPE_UINT64, &priv->thread_data->n_underruns);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_timeouts",
+                                 G_TYPE_UINT64, &priv->thread_data->n_timeouts);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_aborted",
+                                 G_TYPE_UINT64, &priv->thread_data->n_aborted);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_missing_frames",
+                                 G_TYPE_UINT64, &priv->thread_data->n_missing_frames);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_size_mismatch_errors",
+                                 G_TYPE_UINT64, &priv->thread_data->n_size_mismatch_errors);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_received_packets",
+                                 G_TYPE_UINT64, &priv->thread_data->n_received_packets);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_missing_packets",
+                                 G_TYPE_UINT64, &priv->thread_data->n_missing_packets);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_error_packets",
+                                 G_TYPE_UINT64, &priv->thread_data->n_error_packets);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_ignored_packets",
+                                 G_TYPE_UINT64, &priv->thread_data->n_ignored_packets);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resend_requests",
+                                 G_TYPE_UINT64, &priv->thread_data->n_resend_requests);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resent_packets",
+                                 G_TYPE_UINT64, &priv->thread_data->n_resent_packets);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resend_ratio_reached",
+                                 G_TYPE_UINT64, &priv->thread_data->n_resend_ratio_reached);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resend_disabled",
+                                 G_TYPE_UINT64, &priv->thread_data->n_resend_disabled);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_duplicated_packets",
+                                 G_TYPE_UINT64, &priv->thread_data->n_duplicated_packets);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_transferred_bytes",
+                                 G_TYPE_UINT64, &priv->thread_data->n_transferred_bytes);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_ignored_bytes",
+                                 G_TYPE_UINT64, &priv->thread_data->n_ignored_bytes);
+        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_capture_dropped_packets",
+                                 G_TYPE_UINT64, &priv->thread_data->n_capture_dropped_packets);
 }
 
 static void
@@ -1594,6 +2060,12 @@ arv_gv_stream_constructed (GObject *object)
 
 	g_object_get (object, "device", &priv->gv_device, NULL);
 
+	/* Replay stream, see arv_gv_stream_new_replay() */
+	if (priv->gv_device == NULL) {
+		_init_thread_data (gv_stream);
+		return;
+	}
+
         priv->stream_channel = arv_device_get_integer_feature_value(ARV_DEVICE(priv->gv_device),
                                                                     "ArvGevStreamChannelSelector", &error);
         if (error != NULL) {
@@ -1624,25 +2096,12 @@ arv_gv_stream_constructed (GObject *object)
 		return;
 	}
 
-	priv->thread_data->stream = stream;
-
-	g_object_get (object,
-		      "callback", &priv->thread_data->callback,
-		      "callback-data", &priv->thread_data->callback_data,
-		      NULL);
+	_init_thread_data (gv_stream);
 
 	priv->thread_data->timestamp_tick_frequency = timestamp_tick_frequency;
 	priv->thread_data->scps_packet_size = packet_size;
 	priv->thread_data->use_packet_socket = (options & ARV_GV_STREAM_OPTION_PACKET_SOCKET_DISABLED) == 0;
 
-	priv->thread_data->packet_id = 65300;
-
-	priv->thread_data->histogram = arv_histogram_new (3, 100, 2000, 0);
-
-	arv_histogram_set_variable_name (priv->thread_data->histogram, 0, "frame_retention");
-	arv_histogram_set_variable_name (priv->thread_data->histogram, 1, "packet_time");
-	arv_histogram_set_variable_name (priv->thread_data->histogram, 2, "inter_packet");
-
 	interface_address = g_inet_socket_address_get_address
                 (G_INET_SOCKET_ADDRESS (arv_gv_device_get_interface_address (priv->gv_device)));
 	device_address = g_inet_socket_address_get_address
@@ -1653,6 +2112,10 @@ arv_gv_stream_constructed (GObject *object)
 	priv->thread_data->interface_address = g_object_ref (interface_address);
 	priv->thread_data->interface_socket_address = g_inet_socket_address_new (interface_address, 0);
 	priv->thread_data->device_socket_address = g_inet_socket_address_new (device_address, ARV_GVCP_PORT);
+	address_bytes = g_inet_address_to_bytes (interface_address);
+	priv->thread_data->pcap_interface_ip = g_ntohl (*((guint32 *) address_bytes));
+	address_bytes = g_inet_address_to_bytes (device_address);
+	priv->thread_data->pcap_device_ip = g_ntohl (*((guint32 *) address_bytes));
 	g_socket_set_blocking (priv->thread_data->socket, FALSE);
 	g_socket_bind (priv->thread_data->socket, priv->thread_data->interface_socket_address, FALSE, NULL);
 
@@ -1671,43 +2134,6 @@ arv_gv_stream_constructed (GObject *object)
 	arv_info_stream ("[GvStream::stream_new] Destination stream port = %d", priv->thread_data->stream_port);
 	arv_info_stream ("[GvStream::stream_new] Source stream port = %d", priv->thread_data->source_stream_port);
 
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_completed_buffers",
-                                 G_TYPE_UINT64, &priv->thread_data->n_completed_buffers);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_failures",
-                                 G_TYPE_UINT64, &priv->thread_data->n_failures);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_underruns",
-                                 G_TYPE_UINT64, &priv->thread_data->n_underruns);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_timeouts",
-                                 G_TYPE_UINT64, &priv->thread_data->n_timeouts);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_aborted",
-                                 G_TYPE_UINT64, &priv->thread_data->n_aborted);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_missing_frames",
-                                 G_TYPE_UINT64, &priv->thread_data->n_missing_frames);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_size_mismatch_errors",
-                                 G_TYPE_UINT64, &priv->thread_data->n_size_mismatch_errors);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_received_packets",
-                                 G_TYPE_UINT64, &priv->thread_data->n_received_packets);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_missing_packets",
-                                 G_TYPE_UINT64, &priv->thread_data->n_missing_packets);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_error_packets",
-                                 G_TYPE_UINT64, &priv->thread_data->n_error_packets);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_ignored_packets",
-                                 G_TYPE_UINT64, &priv->thread_data->n_ignored_packets);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resend_requests",
-                                 G_TYPE_UINT64, &priv->thread_data->n_resend_requests);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resent_packets",
-                                 G_TYPE_UINT64, &priv->thread_data->n_resent_packets);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resend_ratio_reached",
-                                 G_TYPE_UINT64, &priv->thread_data->n_resend_ratio_reached);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_resend_disabled",
-                                 G_TYPE_UINT64, &priv->thread_data->n_resend_disabled);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_duplicated_packets",
-                                 G_TYPE_UINT64, &priv->thread_data->n_duplicated_packets);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_transferred_bytes",
-                                 G_TYPE_UINT64, &priv->thread_data->n_transferred_bytes);
-        arv_stream_declare_info (ARV_STREAM (gv_stream), "n_ignored_bytes",
-                                 G_TYPE_UINT64, &priv->thread_data->n_ignored_bytes);
-
 	arv_gv_stream_start_thread (ARV_STREAM (gv_stream));
 }
 
@@ -1717,16 +2143,25 @@ arv_gv_stream_finalize (GObject *object)
 	ArvGvStreamPrivate *priv = arv_gv_stream_get_instance_private (ARV_GV_STREAM (object));
         GError *error = NULL;
 
-	arv_gv_stream_stop_thread (ARV_STREAM (object));
+	if (priv->thread != NULL)
+		arv_gv_stream_stop_thread (ARV_STREAM (object));
+	arv_gv_stream_stop_pcap_capture (ARV_GV_STREAM (object));
 
-        /* Stop the stream channel. We use a raw register write here, as the Genicam based access rely on
-         * ArvGevStreamSelector state, and we don't want to change it here. */
-        arv_device_write_register(ARV_DEVICE(priv->gv_device), 0xd00 + 0x40 * priv->stream_channel, 0x0000, &error);
+	if (priv->gv_device != NULL) {
+		/* Stop the stream channel. We use a raw register write here, as the Genicam based access rely on
+		 * ArvGevStreamSelector state, and we don't want to change it here. */
+		arv_device_write_register (ARV_DEVICE (priv->gv_device), 0xd00 + 0x40 * priv->stream_channel, 0x0000,
+					   &error);
 
-        if (error != NULL) {
-                arv_warning_stream ("Failed to stop stream channel %d (%s)", priv->stream_channel, error->message);
-                g_clear_error(&error);
-        }
+		if (error != NULL) {
+			arv_warning_stream ("Failed to stop stream channel %d (%s)", priv->stream_channel,
+					    error->message);
+			g_clear_error (&error);
+		}
+	} else if (priv->thread_data->replay_requests != NULL) {
+		_flush_frames (priv->thread_data, priv->thread_data->replay_time_us);
+		g_array_unref (priv->thread_data->replay_requests);
+	}
 
 	if (priv->thread_data != NULL) {
 		ArvGvStreamThreadData *thread_data;
@@ -1786,6 +2221,8 @@ arv_gv_stream_finalize (GObject *object)
 		g_clear_object (&thread_data->interface_socket_address);
 		g_clear_object (&thread_data->socket);
 
+		g_mutex_clear (&thread_data->pcap_mutex);
+
 		g_clear_pointer (&thread_data, g_free);
 	}
 
@@ -74,6 +74,10 @@ ARV_API void		arv_gv_stream_get_statistics	(ArvGvStream *gv_stream,
 							 guint64 *n_resent_packets,
 							 guint64 *n_missing_packets);
 
+ARV_API gboolean	arv_gv_stream_start_pcap_capture	(ArvGvStream *gv_stream, const char *filename,
+								 gboolean capture_gvcp, GError **error);
+ARV_API void		arv_gv_stream_stop_pcap_capture		(ArvGvStream *gv_stream);
+
 G_END_DECLS
 
 #endif
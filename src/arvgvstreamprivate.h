@@ -37,6 +37,26 @@ G_BEGIN_DECLS
 
 ArvStream * 	arv_gv_stream_new		(ArvGvDevice *gv_device, ArvStreamCallback callback, void *callback_data, GDestroyNotify destroy, GError **error);
 
+typedef struct {
+	guint64 frame_id;
+	guint32 first_block;
+	guint32 last_block;
+} ArvGvStreamReplayRequest;
+
+/* private, but used by tests */
+ARV_API ArvStream *	arv_gv_stream_new_replay		(guint packet_size, guint64 timestamp_tick_frequency,
+								 ArvStreamCallback callback, void *callback_data,
+								 GError **error);
+ARV_API void		arv_gv_stream_replay_packet		(ArvGvStream *gv_stream,
+								 const void *packet, size_t packet_size, guint64 time_us);
+ARV_API void		arv_gv_stream_replay_time		(ArvGvStream *gv_stream, guint64 time_us);
+ARV_API gboolean	arv_gv_stream_replay_pcap		(ArvGvStream *gv_stream, const char *filename,
+								 guint16 destination_port, guint64 *n_packets,
+								 GError **error);
+ARV_API void		arv_gv_stream_replay_flush		(ArvGvStream *gv_stream);
+ARV_API const ArvGvStreamReplayRequest *
+			arv_gv_stream_replay_get_resend_requests	(ArvGvStream *gv_stream, guint *n_requests);
+
 G_END_DECLS
 
 #endif
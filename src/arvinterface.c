@@ -33,6 +33,14 @@
 
 #include <arvinterfaceprivate.h>
 
+enum {
+	ARV_INTERFACE_SIGNAL_DEVICE_ADDED,
+	ARV_INTERFACE_SIGNAL_DEVICE_REMOVED,
+	ARV_INTERFACE_SIGNAL_LAST
+};
+
+static guint arv_interface_signals[ARV_INTERFACE_SIGNAL_LAST] = {0};
+
 typedef struct {
 	GArray *device_ids;
         int flags;
@@ -385,6 +393,22 @@ arv_interface_open_device (ArvInterface *iface, const char *device_id, GError **
 	return ARV_INTERFACE_GET_CLASS (iface)->open_device (iface, device_id, error);
 }
 
+void
+arv_interface_emit_device_added_signal (ArvInterface *iface, const char *device_id)
+{
+	g_return_if_fail (ARV_IS_INTERFACE (iface));
+
+	g_signal_emit (iface, arv_interface_signals[ARV_INTERFACE_SIGNAL_DEVICE_ADDED], 0, device_id);
+}
+
+void
+arv_interface_emit_device_removed_signal (ArvInterface *iface, const char *device_id)
+{
+	g_return_if_fail (ARV_IS_INTERFACE (iface));
+
+	g_signal_emit (iface, arv_interface_signals[ARV_INTERFACE_SIGNAL_DEVICE_REMOVED], 0, device_id);
+}
+
 static void
 arv_interface_init (ArvInterface *iface)
 {
@@ -412,4 +436,43 @@ arv_interface_class_init (ArvInterfaceClass *interface_class)
 	GObjectClass *object_class = G_OBJECT_CLASS (interface_class);
 
 	object_class->finalize = arv_interface_finalize;
+
+	/**
+	 * ArvInterface::device-added:
+	 * @iface: a #ArvInterface
+	 * @device_id: the id of the new device
+	 *
+	 * Signal that a new device was found by the background discovery, see arv_start_device_discovery().
+	 *
+	 * This signal is emitted from the thread default main context of the thread which started the discovery.
+	 *
+	 * Since: 0.8.32
+	 */
+
+	arv_interface_signals[ARV_INTERFACE_SIGNAL_DEVICE_ADDED] =
+		g_signal_new ("device-added",
+			      G_TYPE_FROM_CLASS (interface_class),
+			      G_SIGNAL_RUN_LAST,
+			      0, NULL, NULL,
+			      g_cclosure_marshal_VOID__STRING, G_TYPE_NONE, 1, G_TYPE_STRING);
+
+	/**
+	 * ArvInterface::device-removed:
+	 * @iface: a #ArvInterface
+	 * @device_id: the id of the removed device
+	 *
+	 * Signal that a device did not answer to the last background discovery broadcasts, see
+	 * arv_start_device_discovery().
+	 *
+	 * This signal is emitted from the thread default main context of the thread which started the discovery.
+	 *
+	 * Since: 0.8.32
+	 */
+
+	arv_interface_signals[ARV_INTERFACE_SIGNAL_DEVICE_REMOVED] =
+		g_signal_new ("device-removed",
+			      G_TYPE_FROM_CLASS (interface_class),
+			      G_SIGNAL_RUN_LAST,
+			      0, NULL, NULL,
+			      g_cclosure_marshal_VOID__STRING, G_TYPE_NONE, 1, G_TYPE_STRING);
 }
@@ -48,6 +48,9 @@ typedef struct {
 void            arv_interface_set_flags         (ArvInterface *iface, int flags);
 int             arv_interface_get_flags         (ArvInterface *iface);
 
+void		arv_interface_emit_device_added_signal		(ArvInterface *iface, const char *device_id);
+void		arv_interface_emit_device_removed_signal	(ArvInterface *iface, const char *device_id);
+
 G_END_DECLS
 
 #endif
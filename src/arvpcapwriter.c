@@ -0,0 +1,343 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/*
+ * Pcap capture of the UDP traffic seen by the library.
+ *
+ * Captured payloads are copied into a bounded ring of fixed size slots, which can be filled concurrently by the
+ * stream, control and heartbeat threads. Each slot has a sequence number telling whether it is free or ready, so that
+ * a producer only needs a compare and swap on the ring head to claim a slot. When the ring is full, the packet is
+ * dropped and counted, a producer never waits for the disk.
+ *
+ * A writer thread empties the ring into a pcap file, with a raw IPv4 link type. IPv4 and UDP headers are synthesized
+ * from the addresses given by the producer, the UDP checksum is left to zero.
+ */
+
+#include <arvpcapwriterprivate.h>
+#include <arvdebugprivate.h>
+#include <glib/gstdio.h>
+#include <string.h>
+#include <stdio.h>
+#include <errno.h>
+
+#define ARV_PCAP_WRITER_IDLE_US		1000
+#define ARV_PCAP_WRITER_LINKTYPE_RAW	101
+
+typedef struct {
+	gint sequence;
+	guint32 size;
+	guint32 original_size;
+	gint64 time_us;
+	guint8 *data;
+} ArvPcapWriterSlot;
+
+struct _ArvPcapWriter {
+	gint ref_count;
+
+	FILE *file;
+	char *filename;
+
+	guint n_slots;
+	guint snap_length;
+	ArvPcapWriterSlot *slots;
+	guint8 *slot_data;
+
+	gint head;
+	guint tail;
+
+	gint n_dropped_packets;
+	guint64 n_written_packets;
+
+	gint cancel;
+	GThread *thread;
+};
+
+static guint16
+_ip_checksum (const guint8 *header, size_t size)
+{
+	guint32 sum = 0;
+	size_t i;
+
+	for (i = 0; i + 1 < size; i += 2)
+		sum += (header[i] << 8) | header[i + 1];
+
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
+static void
+_write_headers (guint8 *data, guint32 source_ip, guint16 source_port, guint32 destination_ip, guint16 destination_port,
+		size_t size)
+{
+	guint16 ip_size = MIN (size + ARV_PCAP_WRITER_HEADER_SIZE, G_MAXUINT16);
+	guint16 udp_size = MIN (size + 8, G_MAXUINT16);
+	guint16 checksum;
+
+	memset (data, 0, ARV_PCAP_WRITER_HEADER_SIZE);
+
+	/* IPv4, 20 bytes header, don't fragment, UDP */
+	data[0] = 0x45;
+	data[2] = ip_size >> 8;
+	data[3] = ip_size & 0xff;
+	data[6] = 0x40;
+	data[8] = 64;
+	data[9] = 17;
+	data[12] = source_ip >> 24;
+	data[13] = (source_ip >> 16) & 0xff;
+	data[14] = (source_ip >> 8) & 0xff;
+	data[15] = source_ip & 0xff;
+	data[16] = destination_ip >> 24;
+	data[17] = (destination_ip >> 16) & 0xff;
+	data[18] = (destination_ip >> 8) & 0xff;
+	data[19] = destination_ip & 0xff;
+
+	checksum = _ip_checksum (data, 20);
+	data[10] = checksum >> 8;
+	data[11] = checksum & 0xff;
+
+	data[20] = source_port >> 8;
+	data[21] = source_port & 0xff;
+	data[22] = destination_port >> 8;
+	data[23] = destination_port & 0xff;
+	data[24] = udp_size >> 8;
+	data[25] = udp_size & 0xff;
+}
+
+/*
+ * Claims a free slot at the ring head. A slot is free for the position p when its sequence is p, and ready for the
+ * writer thread when its sequence is p + 1.
+ */
+
+gboolean
+arv_pcap_writer_push_udp (ArvPcapWriter *writer,
+			  guint32 source_ip, guint16 source_port,
+			  guint32 destination_ip, guint16 destination_port,
+			  const void *payload, size_t size)
+{
+	ArvPcapWriterSlot *slot;
+	guint position;
+	size_t captured_size;
+
+	g_return_val_if_fail (writer != NULL, FALSE);
+	g_return_val_if_fail (payload != NULL || size == 0, FALSE);
+
+	for (;;) {
+		gint difference;
+
+		position = g_atomic_int_get (&writer->head);
+		slot = &writer->slots[position % writer->n_slots];
+		difference = (gint) ((guint) g_atomic_int_get (&slot->sequence) - position);
+
+		if (difference < 0) {
+			g_atomic_int_inc (&writer->n_dropped_packets);
+			return FALSE;
+		}
+
+		/* Otherwise another producer claimed this position first */
+		if (difference == 0 &&
+		    g_atomic_int_compare_and_exchange (&writer->head, position, position + 1))
+			break;
+	}
+
+	captured_size = MIN (size, writer->snap_length - ARV_PCAP_WRITER_HEADER_SIZE);
+
+	_write_headers (slot->data, source_ip, source_port, destination_ip, destination_port, size);
+	memcpy (slot->data + ARV_PCAP_WRITER_HEADER_SIZE, payload, captured_size);
+
+	slot->size = captured_size + ARV_PCAP_WRITER_HEADER_SIZE;
+	slot->original_size = size + ARV_PCAP_WRITER_HEADER_SIZE;
+	slot->time_us = g_get_real_time ();
+
+	g_atomic_int_set (&slot->sequence, position + 1);
+
+	return TRUE;
+}
+
+static guint
+_write_slots (ArvPcapWriter *writer)
+{
+	guint n_slots = 0;
+
+	for (;;) {
+		ArvPcapWriterSlot *slot = &writer->slots[writer->tail % writer->n_slots];
+		guint32 record[4];
+
+		if ((guint) g_atomic_int_get (&slot->sequence) != writer->tail + 1)
+			break;
+
+		record[0] = slot->time_us / 1000000;
+		record[1] = slot->time_us % 1000000;
+		record[2] = slot->size;
+		record[3] = slot->original_size;
+
+		if (fwrite (record, sizeof (record), 1, writer->file) != 1 ||
+		    fwrite (slot->data, slot->size, 1, writer->file) != 1)
+			arv_warning_misc ("[PcapWriter::write_slots] Failed to write to '%s'", writer->filename);
+		else
+			writer->n_written_packets++;
+
+		g_atomic_int_set (&slot->sequence, writer->tail + writer->n_slots);
+		writer->tail++;
+		n_slots++;
+	}
+
+	return n_slots;
+}
+
+static void *
+_writer_thread (void *data)
+{
+	ArvPcapWriter *writer = data;
+
+	while (!g_atomic_int_get (&writer->cancel)) {
+		if (_write_slots (writer) > 0)
+			fflush (writer->file);
+		else
+			g_usleep (ARV_PCAP_WRITER_IDLE_US);
+	}
+
+	_write_slots (writer);
+
+	return NULL;
+}
+
+/*
+ * Creates @filename, writes the pcap file header, and starts the writer thread. @snap_length is the maximum size of
+ * a captured packet, including the synthesized IPv4 and UDP headers, and the ring holds @n_slots packets, rounded up
+ * to a power of two.
+ */
+
+ArvPcapWriter *
+arv_pcap_writer_new (const char *filename, guint n_slots, guint snap_length, GError **error)
+{
+	ArvPcapWriter *writer;
+	FILE *file;
+	guint32 header[6];
+	guint i;
+
+	g_return_val_if_fail (filename != NULL, NULL);
+	g_return_val_if_fail (n_slots > 0, NULL);
+	g_return_val_if_fail (snap_length > ARV_PCAP_WRITER_HEADER_SIZE, NULL);
+
+	file = g_fopen (filename, "wb");
+	if (file == NULL) {
+		int errsv = errno;
+
+		g_set_error (error, G_FILE_ERROR, g_file_error_from_errno (errsv),
+			     "Failed to create '%s' (%s)", filename, g_strerror (errsv));
+		return NULL;
+	}
+
+	/* Native byte order, the magic number tells it to the readers */
+	header[0] = 0xa1b2c3d4;
+	header[1] = 2 | (4 << 16);
+	header[2] = 0;
+	header[3] = 0;
+	header[4] = snap_length;
+	header[5] = ARV_PCAP_WRITER_LINKTYPE_RAW;
+
+	if (G_BYTE_ORDER == G_BIG_ENDIAN)
+		header[1] = (2 << 16) | 4;
+
+	if (fwrite (header, sizeof (header), 1, file) != 1) {
+		g_set_error (error, G_FILE_ERROR, G_FILE_ERROR_IO, "Failed to write to '%s'", filename);
+		fclose (file);
+		return NULL;
+	}
+
+	/* Ring positions wrap around at 2^32, which must be a multiple of the ring size */
+	if (n_slots > 1)
+		n_slots = 1U << g_bit_storage (n_slots - 1);
+
+	writer = g_new0 (ArvPcapWriter, 1);
+	writer->ref_count = 1;
+	writer->file = file;
+	writer->filename = g_strdup (filename);
+	writer->n_slots = n_slots;
+	writer->snap_length = snap_length;
+	writer->slots = g_new0 (ArvPcapWriterSlot, n_slots);
+	writer->slot_data = g_malloc ((gsize) n_slots * snap_length);
+
+	for (i = 0; i < n_slots; i++) {
+		writer->slots[i].sequence = i;
+		writer->slots[i].data = writer->slot_data + (gsize) i * snap_length;
+	}
+
+	writer->thread = g_thread_new ("arv_pcap_writer", _writer_thread, writer);
+
+	arv_info_misc ("[PcapWriter::new] Capture to '%s' (%u slots of %u bytes)", filename, n_slots, snap_length);
+
+	return writer;
+}
+
+ArvPcapWriter *
+arv_pcap_writer_ref (ArvPcapWriter *writer)
+{
+	g_return_val_if_fail (writer != NULL, NULL);
+
+	g_atomic_int_inc (&writer->ref_count);
+
+	return writer;
+}
+
+/*
+ * The last reference stops the writer thread once all the pushed packets are written, and closes the file.
+ */
+
+void
+arv_pcap_writer_unref (ArvPcapWriter *writer)
+{
+	g_return_if_fail (writer != NULL);
+
+	if (g_atomic_int_dec_and_test (&writer->ref_count)) {
+		g_atomic_int_set (&writer->cancel, TRUE);
+		g_thread_join (writer->thread);
+
+		arv_info_misc ("[PcapWriter::unref] %" G_GUINT64_FORMAT " packet(s) written to '%s', %u dropped",
+			       writer->n_written_packets, writer->filename,
+			       (guint) g_atomic_int_get (&writer->n_dropped_packets));
+
+		fclose (writer->file);
+		g_free (writer->filename);
+		g_free (writer->slot_data);
+		g_free (writer->slots);
+		g_free (writer);
+	}
+}
+
+guint64
+arv_pcap_writer_get_n_written_packets (ArvPcapWriter *writer)
+{
+	g_return_val_if_fail (writer != NULL, 0);
+
+	return writer->n_written_packets;
+}
+
+guint64
+arv_pcap_writer_get_n_dropped_packets (ArvPcapWriter *writer)
+{
+	g_return_val_if_fail (writer != NULL, 0);
+
+	return (guint) g_atomic_int_get (&writer->n_dropped_packets);
+}
@@ -0,0 +1,55 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_PCAP_WRITER_PRIVATE_H
+#define ARV_PCAP_WRITER_PRIVATE_H
+
+#include <arvapi.h>
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+#define ARV_PCAP_WRITER_N_SLOTS_DEFAULT		4096
+#define ARV_PCAP_WRITER_SNAP_LENGTH_MIN		1500
+
+/* IPv4 and UDP headers synthesized in front of each captured payload */
+#define ARV_PCAP_WRITER_HEADER_SIZE		28
+
+typedef struct _ArvPcapWriter ArvPcapWriter;
+
+/* private, but used by tests */
+ARV_API ArvPcapWriter *	arv_pcap_writer_new			(const char *filename, guint n_slots, guint snap_length,
+								 GError **error);
+ARV_API ArvPcapWriter *	arv_pcap_writer_ref			(ArvPcapWriter *writer);
+ARV_API void		arv_pcap_writer_unref			(ArvPcapWriter *writer);
+
+ARV_API gboolean	arv_pcap_writer_push_udp		(ArvPcapWriter *writer,
+								 guint32 source_ip, guint16 source_port,
+								 guint32 destination_ip, guint16 destination_port,
+								 const void *payload, size_t size);
+
+ARV_API guint64		arv_pcap_writer_get_n_written_packets	(ArvPcapWriter *writer);
+ARV_API guint64		arv_pcap_writer_get_n_dropped_packets	(ArvPcapWriter *writer);
+
+G_END_DECLS
+
+#endif
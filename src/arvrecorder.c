@@ -0,0 +1,867 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/* Needed for O_DIRECT and fallocate */
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/**
+ * SECTION: arvrecorder
+ * @short_description: Stream to disk recorder
+ *
+ * #ArvRecorder appends the buffers of an #ArvStream to a raw recording file. Each buffer is serialized by a writer
+ * thread into an aligned block, together with a frame header storing the frame id, the timestamps, the payload type
+ * and the part geometries. The buffer data, including the chunk data, is written unmodified. Once serialized, the
+ * buffer is given back to the stream, and the block is written to the disk by a pool of I/O threads, using direct I/O
+ * when the platform and the file system support it. The file is preallocated by large steps in order to avoid
+ * fragmentation. An index of the recorded frames is appended to the file on close, allowing a random access using
+ * #ArvRecordingReader.
+ *
+ * Buffers can either be pushed by the application using arv_recorder_push_buffer(), or directly popped from the
+ * stream output queue after a call to arv_recorder_start().
+ */
+
+#include <arvrecorder.h>
+#include <arvrecordingprivate.h>
+#include <arvbufferprivate.h>
+#include <arvdebugprivate.h>
+#include <glib/gstdio.h>
+#include <gio/gio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+
+#ifdef G_OS_WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#define ARV_RECORDER_N_BLOCKS			8
+#define ARV_RECORDER_N_WRITE_THREADS		2
+#define ARV_RECORDER_PREALLOCATION_SIZE		(256 * 1024 * 1024)
+#define ARV_RECORDER_POP_TIMEOUT_US		100000
+
+enum {
+	PROP_0,
+	PROP_STREAM,
+	PROP_FILENAME
+};
+
+typedef struct {
+	char *allocation;
+	char *data;
+	gsize allocated_size;
+
+	gsize size;
+	guint64 offset;
+} ArvRecorderBlock;
+
+typedef struct {
+	ArvStream *stream;
+	char *filename;
+
+	int fd;
+	gboolean direct_io;
+	gboolean is_closed;
+
+	guint64 write_offset;
+	guint64 preallocated_size;
+
+	GArray *index;
+
+	GAsyncQueue *input_queue;
+	GAsyncQueue *free_blocks;
+	GThreadPool *write_pool;
+	gint n_pending_writes;
+
+#ifdef G_OS_WIN32
+	GMutex write_mutex;
+#endif
+
+	GThread *writer_thread;
+	gint writer_cancel;
+
+	GThread *consumer_thread;
+	gint consumer_cancel;
+
+	GMutex statistics_mutex;
+	guint64 n_written_frames;
+	guint64 n_written_bytes;
+	guint64 n_skipped_frames;
+	guint64 n_write_errors;
+	gint64 start_time_us;
+	gint64 last_write_time_us;
+	GError *write_error;
+} ArvRecorderPrivate;
+
+struct _ArvRecorder {
+	GObject	object;
+};
+
+struct _ArvRecorderClass {
+	GObjectClass parent_class;
+};
+
+static void arv_recorder_initable_iface_init (GInitableIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (ArvRecorder, arv_recorder, G_TYPE_OBJECT,
+			 G_ADD_PRIVATE (ArvRecorder)
+			 G_IMPLEMENT_INTERFACE (G_TYPE_INITABLE, arv_recorder_initable_iface_init))
+
+static void
+_block_reserve (ArvRecorderBlock *block, gsize size)
+{
+	if (size <= block->allocated_size)
+		return;
+
+	/* Direct I/O requires the memory to be aligned on the file system block size */
+	g_free (block->allocation);
+	block->allocation = g_malloc (size + ARV_RECORDING_ALIGNMENT);
+	block->data = (char *) (guintptr) ARV_RECORDING_ALIGN ((guintptr) block->allocation, ARV_RECORDING_ALIGNMENT);
+	block->allocated_size = size;
+}
+
+static void
+_block_free (ArvRecorderBlock *block)
+{
+	if (block == NULL)
+		return;
+
+	g_free (block->allocation);
+	g_free (block);
+}
+
+static int
+_open_file (const char *filename, gboolean *direct_io)
+{
+	int flags = O_WRONLY | O_CREAT | O_TRUNC | O_BINARY;
+#ifdef O_DIRECT
+	int fd;
+
+	fd = g_open (filename, flags | O_DIRECT, 0644);
+	if (fd >= 0) {
+		*direct_io = TRUE;
+		return fd;
+	}
+
+	/* Some file systems, like tmpfs, don't support direct I/O */
+	if (errno != EINVAL)
+		return -1;
+#endif
+	*direct_io = FALSE;
+
+	return g_open (filename, flags, 0644);
+}
+
+static gboolean
+_write_at (ArvRecorderPrivate *priv, const char *data, gsize size, guint64 offset, GError **error)
+{
+	while (size > 0) {
+		gssize n_written;
+		int errsv;
+
+#ifdef G_OS_WIN32
+		g_mutex_lock (&priv->write_mutex);
+		if (_lseeki64 (priv->fd, offset, SEEK_SET) < 0)
+			n_written = -1;
+		else
+			n_written = _write (priv->fd, data, MIN (size, G_MAXINT));
+		errsv = errno;
+		g_mutex_unlock (&priv->write_mutex);
+#else
+		n_written = pwrite (priv->fd, data, size, offset);
+		errsv = errno;
+#endif
+		if (n_written < 0) {
+			if (errsv == EINTR)
+				continue;
+
+			g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+				     "Failed to write to '%s': %s", priv->filename, g_strerror (errsv));
+			return FALSE;
+		}
+
+		data += n_written;
+		size -= n_written;
+		offset += n_written;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+_truncate (ArvRecorderPrivate *priv, guint64 size, GError **error)
+{
+	int result;
+
+#ifdef G_OS_WIN32
+	result = _chsize_s (priv->fd, size) == 0 ? 0 : -1;
+#else
+	result = ftruncate (priv->fd, size);
+#endif
+	if (result != 0) {
+		int errsv = errno;
+
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+			     "Failed to truncate '%s': %s", priv->filename, g_strerror (errsv));
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+static gboolean
+_write_file_header (ArvRecorderPrivate *priv, guint64 index_offset, guint64 n_frames, GError **error)
+{
+	ArvRecordingFileHeader *header;
+	ArvRecorderBlock block = {0};
+	gboolean success;
+
+	_block_reserve (&block, ARV_RECORDING_ALIGNMENT);
+	memset (block.data, 0, ARV_RECORDING_ALIGNMENT);
+
+	header = (ArvRecordingFileHeader *) block.data;
+	memcpy (header->magic, ARV_RECORDING_MAGIC, sizeof (header->magic));
+	header->version = GUINT32_TO_LE (ARV_RECORDING_VERSION);
+	header->alignment = GUINT32_TO_LE (ARV_RECORDING_ALIGNMENT);
+	header->index_offset = GUINT64_TO_LE (index_offset);
+	header->n_frames = GUINT64_TO_LE (n_frames);
+
+	success = _write_at (priv, block.data, ARV_RECORDING_ALIGNMENT, 0, error);
+
+	g_free (block.allocation);
+
+	return success;
+}
+
+static gboolean
+_write_index (ArvRecorderPrivate *priv, GError **error)
+{
+	ArvRecorderBlock block = {0};
+	gsize index_size;
+	gsize size;
+	gboolean success;
+
+	index_size = priv->index->len * sizeof (ArvRecordingIndexEntry);
+	size = ARV_RECORDING_ALIGN (index_size, ARV_RECORDING_ALIGNMENT);
+
+	if (size > 0) {
+		_block_reserve (&block, size);
+		memcpy (block.data, priv->index->data, index_size);
+		memset (block.data + index_size, 0, size - index_size);
+
+		success = _write_at (priv, block.data, size, priv->write_offset, error);
+
+		g_free (block.allocation);
+
+		if (!success)
+			return FALSE;
+	}
+
+	if (!_write_file_header (priv, priv->write_offset, priv->index->len, error))
+		return FALSE;
+
+	priv->write_offset += size;
+
+	return TRUE;
+}
+
+static void
+_preallocate (ArvRecorderPrivate *priv, guint64 size)
+{
+	if (size <= priv->preallocated_size)
+		return;
+
+	size = ARV_RECORDING_ALIGN (size, ARV_RECORDER_PREALLOCATION_SIZE);
+
+#ifdef __linux__
+	if (fallocate (priv->fd, 0, priv->preallocated_size, size - priv->preallocated_size) != 0)
+		arv_debug_stream ("[Recorder::preallocate] Failed to preallocate %" G_GUINT64_FORMAT " bytes (%s)",
+				  size - priv->preallocated_size, g_strerror (errno));
+#endif
+
+	priv->preallocated_size = size;
+}
+
+static void
+_serialize_buffer (ArvRecorderBlock *block, ArvBuffer *buffer, guint64 offset)
+{
+	ArvRecordingFrameHeader *header;
+	ArvRecordingPartInfos *parts;
+	guint64 data_size;
+	guint32 data_offset;
+	gsize header_size;
+	guint n_parts;
+	guint i;
+
+	n_parts = buffer->priv->n_parts;
+	data_size = buffer->priv->received_size;
+	data_offset = arv_recording_frame_get_data_offset (n_parts);
+	header_size = sizeof (ArvRecordingFrameHeader) + n_parts * sizeof (ArvRecordingPartInfos);
+
+	block->offset = offset;
+	block->size = arv_recording_frame_get_record_size (n_parts, data_size);
+	_block_reserve (block, block->size);
+
+	header = (ArvRecordingFrameHeader *) block->data;
+	header->magic = GUINT32_TO_LE (ARV_RECORDING_FRAME_MAGIC);
+	header->data_offset = GUINT32_TO_LE (data_offset);
+	header->record_size = GUINT64_TO_LE (block->size);
+	header->data_size = GUINT64_TO_LE (data_size);
+	header->frame_id = GUINT64_TO_LE (buffer->priv->frame_id);
+	header->timestamp_ns = GUINT64_TO_LE (buffer->priv->timestamp_ns);
+	header->system_timestamp_ns = GUINT64_TO_LE (buffer->priv->system_timestamp_ns);
+	header->status = GUINT32_TO_LE (buffer->priv->status);
+	header->payload_type = GUINT32_TO_LE (buffer->priv->payload_type);
+	header->has_chunks = GUINT32_TO_LE (buffer->priv->has_chunks ? 1 : 0);
+	header->chunk_endianness = GUINT32_TO_LE (buffer->priv->chunk_endianness);
+	header->n_parts = GUINT32_TO_LE (n_parts);
+	header->reserved = 0;
+
+	parts = (ArvRecordingPartInfos *) (block->data + sizeof (ArvRecordingFrameHeader));
+	for (i = 0; i < n_parts; i++) {
+		ArvBufferPartInfos *part = &buffer->priv->parts[i];
+
+		parts[i].data_offset = GUINT64_TO_LE (part->data_offset);
+		parts[i].size = GUINT64_TO_LE (part->size);
+		parts[i].component_id = GUINT32_TO_LE (part->component_id);
+		parts[i].data_type = GUINT32_TO_LE (part->data_type);
+		parts[i].pixel_format = GUINT32_TO_LE (part->pixel_format);
+		parts[i].width = GUINT32_TO_LE (part->width);
+		parts[i].height = GUINT32_TO_LE (part->height);
+		parts[i].x_offset = GUINT32_TO_LE (part->x_offset);
+		parts[i].y_offset = GUINT32_TO_LE (part->y_offset);
+		parts[i].x_padding = GUINT32_TO_LE (part->x_padding);
+		parts[i].y_padding = GUINT32_TO_LE (part->y_padding);
+		parts[i].reserved = 0;
+	}
+
+	memset (block->data + header_size, 0, data_offset - header_size);
+	memcpy (block->data + data_offset, buffer->priv->data, data_size);
+	memset (block->data + data_offset + data_size, 0, block->size - data_offset - data_size);
+}
+
+static void
+_write_block (gpointer data, gpointer user_data)
+{
+	ArvRecorderBlock *block = data;
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (ARV_RECORDER (user_data));
+	GError *error = NULL;
+	gint64 time_us;
+
+	_write_at (priv, block->data, block->size, block->offset, &error);
+
+	time_us = g_get_monotonic_time ();
+
+	g_mutex_lock (&priv->statistics_mutex);
+	if (error == NULL) {
+		priv->n_written_frames++;
+		priv->n_written_bytes += block->size;
+		priv->last_write_time_us = time_us;
+	} else {
+		priv->n_write_errors++;
+		if (priv->write_error == NULL) {
+			arv_warning_stream ("[Recorder::write_block] %s", error->message);
+			priv->write_error = error;
+			error = NULL;
+		}
+	}
+	g_mutex_unlock (&priv->statistics_mutex);
+
+	g_clear_error (&error);
+
+	g_async_queue_push (priv->free_blocks, block);
+	g_atomic_int_add (&priv->n_pending_writes, -1);
+}
+
+static void *
+_writer_thread (void *data)
+{
+	ArvRecorder *recorder = data;
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+
+	for (;;) {
+		ArvRecordingIndexEntry entry;
+		ArvRecorderBlock *block;
+		ArvBuffer *buffer;
+
+		buffer = g_async_queue_timeout_pop (priv->input_queue, ARV_RECORDER_POP_TIMEOUT_US);
+		if (buffer == NULL) {
+			/* Only leave once the input queue is drained */
+			if (g_atomic_int_get (&priv->writer_cancel))
+				break;
+			continue;
+		}
+
+		g_mutex_lock (&priv->statistics_mutex);
+		if (priv->start_time_us == 0)
+			priv->start_time_us = g_get_monotonic_time ();
+		g_mutex_unlock (&priv->statistics_mutex);
+
+		/* Blocks until one of the pending writes is done */
+		block = g_async_queue_pop (priv->free_blocks);
+
+		_serialize_buffer (block, buffer, priv->write_offset);
+
+		entry.frame_id = GUINT64_TO_LE (buffer->priv->frame_id);
+		entry.timestamp_ns = GUINT64_TO_LE (buffer->priv->timestamp_ns);
+		entry.system_timestamp_ns = GUINT64_TO_LE (buffer->priv->system_timestamp_ns);
+		entry.offset = GUINT64_TO_LE (priv->write_offset);
+		g_array_append_val (priv->index, entry);
+
+		arv_stream_push_buffer (priv->stream, buffer);
+
+		priv->write_offset += block->size;
+		_preallocate (priv, priv->write_offset);
+
+		g_atomic_int_inc (&priv->n_pending_writes);
+		g_thread_pool_push (priv->write_pool, block, NULL);
+	}
+
+	return NULL;
+}
+
+static void *
+_consumer_thread (void *data)
+{
+	ArvRecorder *recorder = data;
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+
+	while (!g_atomic_int_get (&priv->consumer_cancel)) {
+		ArvBuffer *buffer;
+
+		buffer = arv_stream_timeout_pop_buffer (priv->stream, ARV_RECORDER_POP_TIMEOUT_US);
+		if (buffer != NULL)
+			arv_recorder_push_buffer (recorder, buffer);
+	}
+
+	return NULL;
+}
+
+/**
+ * arv_recorder_new:
+ * @stream: a #ArvStream
+ * @filename: recording file name
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Creates a new recorder, writing the buffers of @stream to @filename. An existing file is overwritten.
+ *
+ * Returns: (transfer full): a new #ArvRecorder, %NULL on error
+ *
+ * Since: 0.8.32
+ */
+
+ArvRecorder *
+arv_recorder_new (ArvStream *stream, const char *filename, GError **error)
+{
+	g_return_val_if_fail (ARV_IS_STREAM (stream), NULL);
+	g_return_val_if_fail (filename != NULL, NULL);
+
+	return g_initable_new (ARV_TYPE_RECORDER, NULL, error, "stream", stream, "filename", filename, NULL);
+}
+
+/**
+ * arv_recorder_push_buffer:
+ * @recorder: a #ArvRecorder
+ * @buffer: (transfer full): a buffer popped from the recorder stream
+ *
+ * Queues @buffer for writing. The recorder takes ownership of @buffer, and pushes it back to the stream input queue
+ * as soon as its content is copied. Buffers with a status different from %ARV_BUFFER_STATUS_SUCCESS are not recorded,
+ * and are directly pushed back to the stream.
+ *
+ * This method is thread safe.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_recorder_push_buffer (ArvRecorder *recorder, ArvBuffer *buffer)
+{
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+
+	g_return_if_fail (ARV_IS_RECORDER (recorder));
+	g_return_if_fail (ARV_IS_BUFFER (buffer));
+
+	if (g_atomic_int_get (&priv->is_closed) ||
+	    buffer->priv->status != ARV_BUFFER_STATUS_SUCCESS) {
+		g_mutex_lock (&priv->statistics_mutex);
+		priv->n_skipped_frames++;
+		g_mutex_unlock (&priv->statistics_mutex);
+
+		arv_stream_push_buffer (priv->stream, buffer);
+		return;
+	}
+
+	g_async_queue_push (priv->input_queue, buffer);
+}
+
+/**
+ * arv_recorder_start:
+ * @recorder: a #ArvRecorder
+ *
+ * Starts a thread popping all the buffers from the stream output queue and recording them. This is an alternative to
+ * arv_recorder_push_buffer(), for applications which don't need to access the image data.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_recorder_start (ArvRecorder *recorder)
+{
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+
+	g_return_if_fail (ARV_IS_RECORDER (recorder));
+	g_return_if_fail (!g_atomic_int_get (&priv->is_closed));
+
+	if (priv->consumer_thread != NULL)
+		return;
+
+	g_atomic_int_set (&priv->consumer_cancel, FALSE);
+	priv->consumer_thread = g_thread_new ("arv_recorder_consumer", _consumer_thread, recorder);
+}
+
+/**
+ * arv_recorder_stop:
+ * @recorder: a #ArvRecorder
+ *
+ * Stops the thread started by arv_recorder_start(). Already queued buffers are still recorded.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_recorder_stop (ArvRecorder *recorder)
+{
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+
+	g_return_if_fail (ARV_IS_RECORDER (recorder));
+
+	if (priv->consumer_thread == NULL)
+		return;
+
+	g_atomic_int_set (&priv->consumer_cancel, TRUE);
+	g_thread_join (priv->consumer_thread);
+	priv->consumer_thread = NULL;
+}
+
+/**
+ * arv_recorder_close:
+ * @recorder: a #ArvRecorder
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Stops the recording, waits for the completion of the pending writes and closes the recording file. Buffers pushed
+ * after this call are directly given back to the stream. This function is called on @recorder finalization if it was
+ * not done before.
+ *
+ * Returns: %TRUE if all the buffers were successfully written.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_recorder_close (ArvRecorder *recorder, GError **error)
+{
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+	GError *local_error = NULL;
+	ArvBuffer *buffer;
+	double bandwidth;
+
+	g_return_val_if_fail (ARV_IS_RECORDER (recorder), FALSE);
+
+	if (g_atomic_int_get (&priv->is_closed))
+		return TRUE;
+
+	/* From now on, arv_recorder_push_buffer gives the buffers back to the stream */
+	g_atomic_int_set (&priv->is_closed, TRUE);
+
+	arv_recorder_stop (recorder);
+
+	g_atomic_int_set (&priv->writer_cancel, TRUE);
+	g_thread_join (priv->writer_thread);
+	priv->writer_thread = NULL;
+
+	g_thread_pool_free (priv->write_pool, FALSE, TRUE);
+	priv->write_pool = NULL;
+
+	/* Buffers pushed concurrently with the closing, after the writer thread exit */
+	while ((buffer = g_async_queue_try_pop (priv->input_queue)) != NULL) {
+		g_mutex_lock (&priv->statistics_mutex);
+		priv->n_skipped_frames++;
+		g_mutex_unlock (&priv->statistics_mutex);
+
+		arv_stream_push_buffer (priv->stream, buffer);
+	}
+
+	if (priv->write_error != NULL)
+		local_error = g_error_copy (priv->write_error);
+	else if (_write_index (priv, &local_error))
+		/* Release the preallocated space */
+		_truncate (priv, priv->write_offset, &local_error);
+
+	close (priv->fd);
+	priv->fd = -1;
+
+	arv_recorder_get_statistics (recorder, NULL, NULL, &bandwidth, NULL);
+
+	arv_info_stream ("[Recorder::close] n_written_frames = %" G_GUINT64_FORMAT, priv->n_written_frames);
+	arv_info_stream ("[Recorder::close] n_written_bytes  = %" G_GUINT64_FORMAT, priv->n_written_bytes);
+	arv_info_stream ("[Recorder::close] n_skipped_frames = %" G_GUINT64_FORMAT, priv->n_skipped_frames);
+	arv_info_stream ("[Recorder::close] n_write_errors   = %" G_GUINT64_FORMAT, priv->n_write_errors);
+	arv_info_stream ("[Recorder::close] bandwidth        = %g MB/s", bandwidth / 1e6);
+
+	if (local_error != NULL) {
+		g_propagate_error (error, local_error);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/**
+ * arv_recorder_get_statistics:
+ * @recorder: a #ArvRecorder
+ * @n_written_frames: (out) (allow-none): number of frames written to the disk
+ * @n_written_bytes: (out) (allow-none): number of bytes written to the disk
+ * @bandwidth: (out) (allow-none): mean write bandwidth since the first buffer, in bytes per second
+ * @backlog: (out) (allow-none): number of buffers waiting for being serialized or written
+ *
+ * An accessor to the recorder statistics. A growing backlog means the storage can not keep up with the stream.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_recorder_get_statistics (ArvRecorder *recorder,
+			     guint64 *n_written_frames,
+			     guint64 *n_written_bytes,
+			     double *bandwidth,
+			     guint *backlog)
+{
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+
+	g_return_if_fail (ARV_IS_RECORDER (recorder));
+
+	g_mutex_lock (&priv->statistics_mutex);
+
+	if (n_written_frames != NULL)
+		*n_written_frames = priv->n_written_frames;
+	if (n_written_bytes != NULL)
+		*n_written_bytes = priv->n_written_bytes;
+	if (bandwidth != NULL)
+		*bandwidth = priv->last_write_time_us > priv->start_time_us ?
+			(double) priv->n_written_bytes * 1e6 / (double) (priv->last_write_time_us - priv->start_time_us) :
+			0.0;
+
+	g_mutex_unlock (&priv->statistics_mutex);
+
+	if (backlog != NULL)
+		*backlog = MAX (g_async_queue_length (priv->input_queue), 0) +
+			g_atomic_int_get (&priv->n_pending_writes);
+}
+
+static void
+arv_recorder_set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+{
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (ARV_RECORDER (object));
+
+	switch (prop_id) {
+		case PROP_STREAM:
+			g_clear_object (&priv->stream);
+			priv->stream = g_value_dup_object (value);
+			break;
+		case PROP_FILENAME:
+			g_free (priv->filename);
+			priv->filename = g_value_dup_string (value);
+			break;
+		default:
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+			break;
+	}
+}
+
+static void
+arv_recorder_get_property (GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (ARV_RECORDER (object));
+
+	switch (prop_id) {
+		case PROP_STREAM:
+			g_value_set_object (value, priv->stream);
+			break;
+		case PROP_FILENAME:
+			g_value_set_string (value, priv->filename);
+			break;
+		default:
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+			break;
+	}
+}
+
+static void
+arv_recorder_init (ArvRecorder *recorder)
+{
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+	unsigned int i;
+
+	priv->fd = -1;
+	priv->is_closed = TRUE;
+
+	g_mutex_init (&priv->statistics_mutex);
+#ifdef G_OS_WIN32
+	g_mutex_init (&priv->write_mutex);
+#endif
+
+	priv->input_queue = g_async_queue_new ();
+	priv->free_blocks = g_async_queue_new ();
+	priv->index = g_array_new (FALSE, FALSE, sizeof (ArvRecordingIndexEntry));
+
+	for (i = 0; i < ARV_RECORDER_N_BLOCKS; i++)
+		g_async_queue_push (priv->free_blocks, g_new0 (ArvRecorderBlock, 1));
+}
+
+static void
+arv_recorder_finalize (GObject *object)
+{
+	ArvRecorder *recorder = ARV_RECORDER (object);
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+	ArvRecorderBlock *block;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+
+	if (!arv_recorder_close (recorder, &error)) {
+		arv_warning_stream ("[Recorder::finalize] %s", error->message);
+		g_clear_error (&error);
+	}
+
+	if (priv->fd >= 0)
+		close (priv->fd);
+
+	while ((buffer = g_async_queue_try_pop (priv->input_queue)) != NULL)
+		arv_stream_push_buffer (priv->stream, buffer);
+	g_async_queue_unref (priv->input_queue);
+
+	while ((block = g_async_queue_try_pop (priv->free_blocks)) != NULL)
+		_block_free (block);
+	g_async_queue_unref (priv->free_blocks);
+
+	g_array_unref (priv->index);
+
+	g_clear_error (&priv->write_error);
+	g_clear_object (&priv->stream);
+	g_clear_pointer (&priv->filename, g_free);
+
+	g_mutex_clear (&priv->statistics_mutex);
+#ifdef G_OS_WIN32
+	g_mutex_clear (&priv->write_mutex);
+#endif
+
+	G_OBJECT_CLASS (arv_recorder_parent_class)->finalize (object);
+}
+
+static void
+arv_recorder_class_init (ArvRecorderClass *recorder_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (recorder_class);
+
+	object_class->finalize = arv_recorder_finalize;
+	object_class->set_property = arv_recorder_set_property;
+	object_class->get_property = arv_recorder_get_property;
+
+	g_object_class_install_property
+		(object_class,
+		 PROP_STREAM,
+		 g_param_spec_object ("stream",
+				      "Stream",
+				      "Recorded stream",
+				      ARV_TYPE_STREAM,
+				      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+	g_object_class_install_property
+		(object_class,
+		 PROP_FILENAME,
+		 g_param_spec_string ("filename",
+				      "Filename",
+				      "Recording file name",
+				      NULL,
+				      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+}
+
+static gboolean
+arv_recorder_initable_init (GInitable     *initable,
+			    GCancellable  *cancellable,
+			    GError       **error)
+{
+	ArvRecorder *recorder = ARV_RECORDER (initable);
+	ArvRecorderPrivate *priv = arv_recorder_get_instance_private (recorder);
+
+	g_return_val_if_fail (ARV_IS_RECORDER (initable), FALSE);
+
+	if (cancellable != NULL) {
+		g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+				     "Cancellable initialization not supported");
+		return FALSE;
+	}
+
+	if (!ARV_IS_STREAM (priv->stream) || priv->filename == NULL) {
+		g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+				     "Missing stream or file name");
+		return FALSE;
+	}
+
+	priv->fd = _open_file (priv->filename, &priv->direct_io);
+	if (priv->fd < 0) {
+		int errsv = errno;
+
+		g_set_error (error, G_IO_ERROR, g_io_error_from_errno (errsv),
+			     "Failed to open '%s': %s", priv->filename, g_strerror (errsv));
+		return FALSE;
+	}
+
+	arv_info_stream ("[Recorder::init] Recording to '%s'%s", priv->filename,
+			 priv->direct_io ? " using direct I/O" : "");
+
+	if (!_write_file_header (priv, 0, 0, error))
+		return FALSE;
+
+	priv->write_offset = ARV_RECORDING_ALIGNMENT;
+	_preallocate (priv, priv->write_offset);
+
+	priv->write_pool = g_thread_pool_new (_write_block, recorder, ARV_RECORDER_N_WRITE_THREADS, TRUE, error);
+	if (priv->write_pool == NULL)
+		return FALSE;
+
+	priv->writer_thread = g_thread_new ("arv_recorder", _writer_thread, recorder);
+	g_atomic_int_set (&priv->is_closed, FALSE);
+
+	return TRUE;
+}
+
+static void
+arv_recorder_initable_iface_init (GInitableIface *iface)
+{
+	iface->init = arv_recorder_initable_init;
+}
@@ -0,0 +1,55 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_RECORDER_H
+#define ARV_RECORDER_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvapi.h>
+#include <arvtypes.h>
+#include <arvstream.h>
+
+G_BEGIN_DECLS
+
+#define ARV_TYPE_RECORDER             (arv_recorder_get_type ())
+ARV_API G_DECLARE_FINAL_TYPE (ArvRecorder, arv_recorder, ARV, RECORDER, GObject)
+
+ARV_API ArvRecorder *	arv_recorder_new		(ArvStream *stream, const char *filename, GError **error);
+
+ARV_API void		arv_recorder_push_buffer	(ArvRecorder *recorder, ArvBuffer *buffer);
+
+ARV_API void		arv_recorder_start		(ArvRecorder *recorder);
+ARV_API void		arv_recorder_stop		(ArvRecorder *recorder);
+ARV_API gboolean	arv_recorder_close		(ArvRecorder *recorder, GError **error);
+
+ARV_API void		arv_recorder_get_statistics	(ArvRecorder *recorder,
+							 guint64 *n_written_frames,
+							 guint64 *n_written_bytes,
+							 double *bandwidth,
+							 guint *backlog);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,128 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_RECORDING_PRIVATE_H
+#define ARV_RECORDING_PRIVATE_H
+
+#include <arvtypes.h>
+
+G_BEGIN_DECLS
+
+/*
+ * Recording file layout. All integers are stored in little endian.
+ *
+ * +-----------------------------+ 0
+ * | ArvRecordingFileHeader      |
+ * | (padded to alignment)       |
+ * +-----------------------------+ alignment
+ * | ArvRecordingFrameHeader     |
+ * | ArvRecordingPartInfos[n]    |
+ * | (padded to data_offset)     |
+ * | buffer data (with chunks)   |
+ * | (padded to alignment)       |
+ * +-----------------------------+
+ * | next frame...               |
+ * +-----------------------------+ index_offset
+ * | ArvRecordingIndexEntry[n]   |
+ * | (padded to alignment)       |
+ * +-----------------------------+
+ *
+ * The index is written when the recording is closed. A file without index (index_offset == 0) can still be read by
+ * walking the frame records.
+ */
+
+#define ARV_RECORDING_MAGIC			"ARVREC\0\0"
+#define ARV_RECORDING_FRAME_MAGIC		0x46565241	/* "ARVF" */
+#define ARV_RECORDING_VERSION			1
+
+#define ARV_RECORDING_ALIGNMENT			4096
+#define ARV_RECORDING_DATA_ALIGNMENT		64
+
+#define ARV_RECORDING_ALIGN(size,alignment)	((((guint64) (size)) + (alignment) - 1) & ~((guint64) (alignment) - 1))
+
+#pragma pack(push,1)
+
+typedef struct {
+	char magic[8];
+	guint32 version;
+	guint32 alignment;
+	guint64 index_offset;
+	guint64 n_frames;
+	guint64 reserved[4];
+} ArvRecordingFileHeader;
+
+typedef struct {
+	guint64 data_offset;
+	guint64 size;
+	guint32 component_id;
+	guint32 data_type;
+	guint32 pixel_format;
+	guint32 width;
+	guint32 height;
+	guint32 x_offset;
+	guint32 y_offset;
+	guint32 x_padding;
+	guint32 y_padding;
+	guint32 reserved;
+} ArvRecordingPartInfos;
+
+typedef struct {
+	guint32 magic;
+	guint32 data_offset;
+	guint64 record_size;
+	guint64 data_size;
+	guint64 frame_id;
+	guint64 timestamp_ns;
+	guint64 system_timestamp_ns;
+	guint32 status;
+	guint32 payload_type;
+	guint32 has_chunks;
+	guint32 chunk_endianness;
+	guint32 n_parts;
+	guint32 reserved;
+} ArvRecordingFrameHeader;
+
+typedef struct {
+	guint64 frame_id;
+	guint64 timestamp_ns;
+	guint64 system_timestamp_ns;
+	guint64 offset;
+} ArvRecordingIndexEntry;
+
+#pragma pack(pop)
+
+static inline guint32
+arv_recording_frame_get_data_offset (guint n_parts)
+{
+	return ARV_RECORDING_ALIGN (sizeof (ArvRecordingFrameHeader) + n_parts * sizeof (ArvRecordingPartInfos),
+				    ARV_RECORDING_DATA_ALIGNMENT);
+}
+
+static inline guint64
+arv_recording_frame_get_record_size (guint n_parts, guint64 data_size)
+{
+	return ARV_RECORDING_ALIGN (arv_recording_frame_get_data_offset (n_parts) + data_size, ARV_RECORDING_ALIGNMENT);
+}
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,462 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+/**
+ * SECTION: arvrecordingreader
+ * @short_description: Random access to a raw recording file
+ *
+ * #ArvRecordingReader gives access to the frames of a file written by #ArvRecorder. The file is mapped in memory, and
+ * the frame offsets are retrieved from the index stored at the end of the file, allowing to jump to any frame without
+ * parsing the whole recording. If the recording was not properly closed, and the index is missing, the frame records
+ * are walked once at the reader creation.
+ *
+ * The buffers returned by arv_recording_reader_get_buffer() don't copy the frame data, they point directly into the
+ * file mapping, which stays valid as long as a buffer is alive, even after the reader destruction. Their data must not
+ * be modified.
+ */
+
+#include <arvrecordingreader.h>
+#include <arvrecordingprivate.h>
+#include <arvbufferprivate.h>
+#include <arvdebugprivate.h>
+#include <gio/gio.h>
+#include <string.h>
+
+enum {
+	PROP_0,
+	PROP_FILENAME
+};
+
+typedef struct {
+	char *filename;
+
+	GMappedFile *mapped_file;
+	const char *data;
+	guint64 size;
+
+	const ArvRecordingIndexEntry *index;
+	guint64 n_frames;
+
+	GArray *scanned_index;
+} ArvRecordingReaderPrivate;
+
+struct _ArvRecordingReader {
+	GObject	object;
+};
+
+struct _ArvRecordingReaderClass {
+	GObjectClass parent_class;
+};
+
+static void arv_recording_reader_initable_iface_init (GInitableIface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (ArvRecordingReader, arv_recording_reader, G_TYPE_OBJECT,
+			 G_ADD_PRIVATE (ArvRecordingReader)
+			 G_IMPLEMENT_INTERFACE (G_TYPE_INITABLE, arv_recording_reader_initable_iface_init))
+
+static const ArvRecordingFrameHeader *
+_get_frame_header (ArvRecordingReaderPrivate *priv, guint64 offset)
+{
+	const ArvRecordingFrameHeader *header;
+
+	if (offset > priv->size ||
+	    priv->size - offset < sizeof (ArvRecordingFrameHeader))
+		return NULL;
+
+	header = (const ArvRecordingFrameHeader *) (priv->data + offset);
+
+	if (GUINT32_FROM_LE (header->magic) != ARV_RECORDING_FRAME_MAGIC ||
+	    GUINT64_FROM_LE (header->record_size) < sizeof (ArvRecordingFrameHeader) ||
+	    GUINT64_FROM_LE (header->record_size) > priv->size - offset)
+		return NULL;
+
+	return header;
+}
+
+static void
+_scan_records (ArvRecordingReaderPrivate *priv, guint64 offset)
+{
+	const ArvRecordingFrameHeader *header;
+
+	priv->scanned_index = g_array_new (FALSE, FALSE, sizeof (ArvRecordingIndexEntry));
+
+	while ((header = _get_frame_header (priv, offset)) != NULL) {
+		ArvRecordingIndexEntry entry;
+
+		entry.frame_id = header->frame_id;
+		entry.timestamp_ns = header->timestamp_ns;
+		entry.system_timestamp_ns = header->system_timestamp_ns;
+		entry.offset = GUINT64_TO_LE (offset);
+		g_array_append_val (priv->scanned_index, entry);
+
+		offset += GUINT64_FROM_LE (header->record_size);
+	}
+
+	priv->index = (const ArvRecordingIndexEntry *) priv->scanned_index->data;
+	priv->n_frames = priv->scanned_index->len;
+}
+
+/**
+ * arv_recording_reader_new:
+ * @filename: recording file name
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Opens a recording written by #ArvRecorder.
+ *
+ * Returns: (transfer full): a new #ArvRecordingReader, %NULL on error
+ *
+ * Since: 0.8.32
+ */
+
+ArvRecordingReader *
+arv_recording_reader_new (const char *filename, GError **error)
+{
+	g_return_val_if_fail (filename != NULL, NULL);
+
+	return g_initable_new (ARV_TYPE_RECORDING_READER, NULL, error, "filename", filename, NULL);
+}
+
+/**
+ * arv_recording_reader_get_n_frames:
+ * @reader: a #ArvRecordingReader
+ *
+ * Returns: the number of frames in the recording
+ *
+ * Since: 0.8.32
+ */
+
+guint64
+arv_recording_reader_get_n_frames (ArvRecordingReader *reader)
+{
+	ArvRecordingReaderPrivate *priv = arv_recording_reader_get_instance_private (reader);
+
+	g_return_val_if_fail (ARV_IS_RECORDING_READER (reader), 0);
+
+	return priv->n_frames;
+}
+
+/**
+ * arv_recording_reader_get_frame_infos:
+ * @reader: a #ArvRecordingReader
+ * @index: frame index
+ * @frame_id: (out) (allow-none): frame id
+ * @timestamp_ns: (out) (allow-none): device timestamp, in nanoseconds
+ * @system_timestamp_ns: (out) (allow-none): host timestamp, in nanoseconds
+ *
+ * Retrieves the frame informations from the recording index, without accessing the frame data.
+ *
+ * Returns: %TRUE if @index is valid
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_recording_reader_get_frame_infos (ArvRecordingReader *reader, guint64 index,
+				      guint64 *frame_id,
+				      guint64 *timestamp_ns,
+				      guint64 *system_timestamp_ns)
+{
+	ArvRecordingReaderPrivate *priv = arv_recording_reader_get_instance_private (reader);
+
+	g_return_val_if_fail (ARV_IS_RECORDING_READER (reader), FALSE);
+
+	if (index >= priv->n_frames)
+		return FALSE;
+
+	if (frame_id != NULL)
+		*frame_id = GUINT64_FROM_LE (priv->index[index].frame_id);
+	if (timestamp_ns != NULL)
+		*timestamp_ns = GUINT64_FROM_LE (priv->index[index].timestamp_ns);
+	if (system_timestamp_ns != NULL)
+		*system_timestamp_ns = GUINT64_FROM_LE (priv->index[index].system_timestamp_ns);
+
+	return TRUE;
+}
+
+/**
+ * arv_recording_reader_find_frame:
+ * @reader: a #ArvRecordingReader
+ * @frame_id: a frame id
+ *
+ * Returns: the index of the first frame with the given @frame_id, -1 if not found
+ *
+ * Since: 0.8.32
+ */
+
+gint64
+arv_recording_reader_find_frame (ArvRecordingReader *reader, guint64 frame_id)
+{
+	ArvRecordingReaderPrivate *priv = arv_recording_reader_get_instance_private (reader);
+	guint64 i;
+
+	g_return_val_if_fail (ARV_IS_RECORDING_READER (reader), -1);
+
+	/* Frame ids may wrap around during a long recording, a binary search is not possible */
+	for (i = 0; i < priv->n_frames; i++)
+		if (GUINT64_FROM_LE (priv->index[i].frame_id) == frame_id)
+			return i;
+
+	return -1;
+}
+
+/**
+ * arv_recording_reader_get_buffer:
+ * @reader: a #ArvRecordingReader
+ * @index: frame index
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Creates a buffer for the frame at @index. The buffer data points directly into the file mapping, and must not be
+ * modified.
+ *
+ * Returns: (transfer full): a new #ArvBuffer, %NULL on error
+ *
+ * Since: 0.8.32
+ */
+
+ArvBuffer *
+arv_recording_reader_get_buffer (ArvRecordingReader *reader, guint64 index, GError **error)
+{
+	ArvRecordingReaderPrivate *priv = arv_recording_reader_get_instance_private (reader);
+	const ArvRecordingFrameHeader *header;
+	const ArvRecordingPartInfos *parts;
+	ArvBuffer *buffer;
+	guint64 offset;
+	guint64 record_size;
+	guint64 data_size;
+	guint32 data_offset;
+	guint n_parts;
+	guint i;
+
+	g_return_val_if_fail (ARV_IS_RECORDING_READER (reader), NULL);
+
+	if (index >= priv->n_frames) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT,
+			     "Invalid frame index %" G_GUINT64_FORMAT " (%" G_GUINT64_FORMAT " frames)",
+			     index, priv->n_frames);
+		return NULL;
+	}
+
+	offset = GUINT64_FROM_LE (priv->index[index].offset);
+	header = _get_frame_header (priv, offset);
+	if (header == NULL) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+			     "Invalid frame record at offset %" G_GUINT64_FORMAT, offset);
+		return NULL;
+	}
+
+	record_size = GUINT64_FROM_LE (header->record_size);
+	data_size = GUINT64_FROM_LE (header->data_size);
+	data_offset = GUINT32_FROM_LE (header->data_offset);
+	n_parts = GUINT32_FROM_LE (header->n_parts);
+
+	if (data_offset < sizeof (ArvRecordingFrameHeader) ||
+	    data_offset > record_size ||
+	    data_size > record_size - data_offset ||
+	    (data_offset - sizeof (ArvRecordingFrameHeader)) / sizeof (ArvRecordingPartInfos) < n_parts) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+			     "Invalid frame header at offset %" G_GUINT64_FORMAT, offset);
+		return NULL;
+	}
+
+	buffer = arv_buffer_new_full (data_size, (void *) (priv->data + offset + data_offset),
+				      g_mapped_file_ref (priv->mapped_file),
+				      (GDestroyNotify) g_mapped_file_unref);
+
+	buffer->priv->status = GUINT32_FROM_LE (header->status);
+	buffer->priv->received_size = data_size;
+	buffer->priv->payload_type = GUINT32_FROM_LE (header->payload_type);
+	buffer->priv->has_chunks = GUINT32_FROM_LE (header->has_chunks) != 0;
+	buffer->priv->chunk_endianness = GUINT32_FROM_LE (header->chunk_endianness);
+	buffer->priv->frame_id = GUINT64_FROM_LE (header->frame_id);
+	buffer->priv->timestamp_ns = GUINT64_FROM_LE (header->timestamp_ns);
+	buffer->priv->system_timestamp_ns = GUINT64_FROM_LE (header->system_timestamp_ns);
+
+	arv_buffer_set_n_parts (buffer, n_parts);
+
+	parts = (const ArvRecordingPartInfos *) ((const char *) header + sizeof (ArvRecordingFrameHeader));
+	for (i = 0; i < n_parts; i++) {
+		ArvBufferPartInfos *part = &buffer->priv->parts[i];
+
+		part->data_offset = GUINT64_FROM_LE (parts[i].data_offset);
+		part->size = GUINT64_FROM_LE (parts[i].size);
+		part->component_id = GUINT32_FROM_LE (parts[i].component_id);
+		part->data_type = GUINT32_FROM_LE (parts[i].data_type);
+		part->pixel_format = GUINT32_FROM_LE (parts[i].pixel_format);
+		part->width = GUINT32_FROM_LE (parts[i].width);
+		part->height = GUINT32_FROM_LE (parts[i].height);
+		part->x_offset = GUINT32_FROM_LE (parts[i].x_offset);
+		part->y_offset = GUINT32_FROM_LE (parts[i].y_offset);
+		part->x_padding = GUINT32_FROM_LE (parts[i].x_padding);
+		part->y_padding = GUINT32_FROM_LE (parts[i].y_padding);
+
+		if (part->data_offset < 0 ||
+		    (guint64) part->data_offset > data_size ||
+		    part->size > data_size - part->data_offset) {
+			g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+				     "Invalid part %u in frame record at offset %" G_GUINT64_FORMAT, i, offset);
+			g_object_unref (buffer);
+			return NULL;
+		}
+	}
+
+	return buffer;
+}
+
+static void
+arv_recording_reader_set_property (GObject *object, guint prop_id, const GValue *value, GParamSpec *pspec)
+{
+	ArvRecordingReaderPrivate *priv = arv_recording_reader_get_instance_private (ARV_RECORDING_READER (object));
+
+	switch (prop_id) {
+		case PROP_FILENAME:
+			g_free (priv->filename);
+			priv->filename = g_value_dup_string (value);
+			break;
+		default:
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+			break;
+	}
+}
+
+static void
+arv_recording_reader_get_property (GObject *object, guint prop_id, GValue *value, GParamSpec *pspec)
+{
+	ArvRecordingReaderPrivate *priv = arv_recording_reader_get_instance_private (ARV_RECORDING_READER (object));
+
+	switch (prop_id) {
+		case PROP_FILENAME:
+			g_value_set_string (value, priv->filename);
+			break;
+		default:
+			G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+			break;
+	}
+}
+
+static void
+arv_recording_reader_init (ArvRecordingReader *reader)
+{
+}
+
+static void
+arv_recording_reader_finalize (GObject *object)
+{
+	ArvRecordingReaderPrivate *priv = arv_recording_reader_get_instance_private (ARV_RECORDING_READER (object));
+
+	g_clear_pointer (&priv->scanned_index, g_array_unref);
+	g_clear_pointer (&priv->mapped_file, g_mapped_file_unref);
+	g_clear_pointer (&priv->filename, g_free);
+
+	G_OBJECT_CLASS (arv_recording_reader_parent_class)->finalize (object);
+}
+
+static void
+arv_recording_reader_class_init (ArvRecordingReaderClass *reader_class)
+{
+	GObjectClass *object_class = G_OBJECT_CLASS (reader_class);
+
+	object_class->finalize = arv_recording_reader_finalize;
+	object_class->set_property = arv_recording_reader_set_property;
+	object_class->get_property = arv_recording_reader_get_property;
+
+	g_object_class_install_property
+		(object_class,
+		 PROP_FILENAME,
+		 g_param_spec_string ("filename",
+				      "Filename",
+				      "Recording file name",
+				      NULL,
+				      G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+}
+
+static gboolean
+arv_recording_reader_initable_init (GInitable     *initable,
+				    GCancellable  *cancellable,
+				    GError       **error)
+{
+	ArvRecordingReaderPrivate *priv = arv_recording_reader_get_instance_private (ARV_RECORDING_READER (initable));
+	const ArvRecordingFileHeader *header;
+	guint64 index_offset;
+	guint64 n_frames;
+	guint32 alignment;
+
+	g_return_val_if_fail (ARV_IS_RECORDING_READER (initable), FALSE);
+
+	if (cancellable != NULL) {
+		g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_NOT_SUPPORTED,
+				     "Cancellable initialization not supported");
+		return FALSE;
+	}
+
+	if (priv->filename == NULL) {
+		g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_INVALID_ARGUMENT, "Missing file name");
+		return FALSE;
+	}
+
+	priv->mapped_file = g_mapped_file_new (priv->filename, FALSE, error);
+	if (priv->mapped_file == NULL)
+		return FALSE;
+
+	priv->data = g_mapped_file_get_contents (priv->mapped_file);
+	priv->size = g_mapped_file_get_length (priv->mapped_file);
+
+	header = (const ArvRecordingFileHeader *) priv->data;
+	if (priv->size < sizeof (ArvRecordingFileHeader) ||
+	    memcmp (header->magic, ARV_RECORDING_MAGIC, sizeof (header->magic)) != 0) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+			     "'%s' is not an aravis recording", priv->filename);
+		return FALSE;
+	}
+
+	alignment = GUINT32_FROM_LE (header->alignment);
+	if (GUINT32_FROM_LE (header->version) != ARV_RECORDING_VERSION ||
+	    alignment < sizeof (ArvRecordingFileHeader) ||
+	    (alignment & (alignment - 1)) != 0) {
+		g_set_error (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA,
+			     "Unsupported recording version or alignment in '%s'", priv->filename);
+		return FALSE;
+	}
+
+	index_offset = GUINT64_FROM_LE (header->index_offset);
+	n_frames = GUINT64_FROM_LE (header->n_frames);
+
+	if (index_offset >= alignment &&
+	    index_offset <= priv->size &&
+	    n_frames <= (priv->size - index_offset) / sizeof (ArvRecordingIndexEntry)) {
+		priv->index = (const ArvRecordingIndexEntry *) (priv->data + index_offset);
+		priv->n_frames = n_frames;
+	} else {
+		_scan_records (priv, alignment);
+		arv_warning_misc ("[RecordingReader::init] Missing index in '%s', %" G_GUINT64_FORMAT " frames found",
+				  priv->filename, priv->n_frames);
+	}
+
+	arv_info_misc ("[RecordingReader::init] %" G_GUINT64_FORMAT " frames in '%s'", priv->n_frames, priv->filename);
+
+	return TRUE;
+}
+
+static void
+arv_recording_reader_initable_iface_init (GInitableIface *iface)
+{
+	iface->init = arv_recording_reader_initable_init;
+}
@@ -0,0 +1,52 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_RECORDING_READER_H
+#define ARV_RECORDING_READER_H
+
+#if !defined (ARV_H_INSIDE) && !defined (ARAVIS_COMPILATION)
+#error "Only <arv.h> can be included directly."
+#endif
+
+#include <arvapi.h>
+#include <arvtypes.h>
+#include <arvbuffer.h>
+
+G_BEGIN_DECLS
+
+#define ARV_TYPE_RECORDING_READER             (arv_recording_reader_get_type ())
+ARV_API G_DECLARE_FINAL_TYPE (ArvRecordingReader, arv_recording_reader, ARV, RECORDING_READER, GObject)
+
+ARV_API ArvRecordingReader *	arv_recording_reader_new		(const char *filename, GError **error);
+
+ARV_API guint64			arv_recording_reader_get_n_frames	(ArvRecordingReader *reader);
+ARV_API gboolean		arv_recording_reader_get_frame_infos	(ArvRecordingReader *reader, guint64 index,
+									 guint64 *frame_id,
+									 guint64 *timestamp_ns,
+									 guint64 *system_timestamp_ns);
+ARV_API gint64			arv_recording_reader_find_frame		(ArvRecordingReader *reader, guint64 frame_id);
+ARV_API ArvBuffer *		arv_recording_reader_get_buffer		(ArvRecordingReader *reader, guint64 index,
+									 GError **error);
+
+G_END_DECLS
+
+#endif
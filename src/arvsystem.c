@@ -29,6 +29,7 @@
 #include <arvfakeinterfaceprivate.h>
 #include <arvdevice.h>
 #include <arvdebugprivate.h>
+#include <arvgenicamcacheprivate.h>
 #include <string.h>
 #include <arvmisc.h>
 #include <arvdomimplementation.h>
@@ -180,6 +181,44 @@ arv_set_interface_flags(const char *interface_id, int flags)
 	g_warning ("[Arv::enable_interface] Unknown interface '%s'", interface_id);
 }
 
+/**
+ * arv_enable_genicam_cache:
+ *
+ * Enable the persistent cache of the Genicam data downloaded from the devices. The cache is stored in
+ * `$XDG_CACHE_HOME/aravis/genicam`, and its entries are keyed by the device vendor, model, version and serial number,
+ * and by the Genicam data URL. Before an entry is used, it is validated against the start of the Genicam file in the
+ * device memory.
+ *
+ * The cache also stores a compiled form of the Genicam data, which is used in place of the xml parsing on the next
+ * connections.
+ *
+ * The cache is disabled by default, unless the `ARV_GENICAM_CACHE` environment variable is set to a value different
+ * from `0`. It is only used by GigE Vision devices, and the download is only skipped for Genicam data stored in the
+ * device memory (`local:` URLs).
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_enable_genicam_cache (void)
+{
+	arv_genicam_cache_set_enabled (TRUE);
+}
+
+/**
+ * arv_disable_genicam_cache:
+ *
+ * Disable the persistent cache of the Genicam data. See arv_enable_genicam_cache().
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_disable_genicam_cache (void)
+{
+	arv_genicam_cache_set_enabled (FALSE);
+}
+
 /**
  * arv_update_device_list:
  *
@@ -205,6 +244,77 @@ arv_update_device_list (void)
 	g_mutex_unlock (&arv_system_mutex);
 }
 
+static ArvGvInterface *
+_get_gv_interface (void)
+{
+	unsigned int i;
+
+	for (i = 0; i < G_N_ELEMENTS (interfaces); i++)
+		if (interfaces[i].get_interface_instance == arv_gv_interface_get_instance &&
+		    interfaces[i].is_available)
+			return ARV_GV_INTERFACE (arv_gv_interface_get_instance ());
+
+	return NULL;
+}
+
+/**
+ * arv_start_device_discovery:
+ * @period_ms: delay between two discovery rounds, in ms
+ *
+ * Starts a background discovery of the GigE Vision devices, periodically broadcasting discovery requests on all
+ * the network interfaces. While the discovery runs, the device table is kept up to date and
+ * arv_update_device_list() returns immediately, without waiting for discovery answers. @period_ms is clamped to a
+ * minimum of 10 ms.
+ *
+ * The #ArvInterface::device-added and #ArvInterface::device-removed signals of the interface instance are emitted
+ * from the thread default main context of the caller when a device appears, or does not answer to the last
+ * discovery rounds.
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_start_device_discovery (guint period_ms)
+{
+	ArvGvInterface *gv_interface;
+
+	g_mutex_lock (&arv_system_mutex);
+
+	gv_interface = _get_gv_interface ();
+	if (gv_interface != NULL)
+		arv_gv_interface_start_discovery (gv_interface, period_ms);
+
+	g_mutex_unlock (&arv_system_mutex);
+}
+
+/**
+ * arv_stop_device_discovery:
+ *
+ * Stops the background device discovery started by arv_start_device_discovery().
+ *
+ * Since: 0.8.32
+ */
+
+void
+arv_stop_device_discovery (void)
+{
+	ArvGvInterface *gv_interface;
+
+	g_mutex_lock (&arv_system_mutex);
+
+	gv_interface = _get_gv_interface ();
+	if (gv_interface != NULL)
+		g_object_ref (gv_interface);
+
+	g_mutex_unlock (&arv_system_mutex);
+
+	/* Waits for the end of the current discovery round */
+	if (gv_interface != NULL) {
+		arv_gv_interface_stop_discovery (gv_interface);
+		g_object_unref (gv_interface);
+	}
+}
+
 /**
  * arv_get_n_devices:
  *
@@ -440,29 +550,34 @@ arv_get_device_protocol	(unsigned int index)
 ArvDevice *
 arv_open_device (const char *device_id, GError **error)
 {
+	ArvInterface *available_interfaces[G_N_ELEMENTS (interfaces)];
+	ArvDevice *device = NULL;
+	GError *local_error = NULL;
+	unsigned int n_interfaces = 0;
 	unsigned int i;
 
+	/* The system mutex only protects the interface list. Device instantiation, which includes the control access
+	 * request and the Genicam data download, is done without holding it, allowing concurrent device openings. */
+
 	g_mutex_lock (&arv_system_mutex);
 
-	for (i = 0; i < G_N_ELEMENTS (interfaces); i++) {
-		ArvInterface *interface;
-		ArvDevice *device;
+	for (i = 0; i < G_N_ELEMENTS (interfaces); i++)
+		if (interfaces[i].is_available)
+			available_interfaces[n_interfaces++] = g_object_ref (interfaces[i].get_interface_instance ());
 
-		if (interfaces[i].is_available) {
-			GError *local_error = NULL;
+	g_mutex_unlock (&arv_system_mutex);
 
-			interface = interfaces[i].get_interface_instance ();
-			device = arv_interface_open_device (interface, device_id, &local_error);
-			if (ARV_IS_DEVICE (device) || local_error != NULL) {
-				if (local_error != NULL)
-					g_propagate_error (error, local_error);
-				g_mutex_unlock (&arv_system_mutex);
-				return device;
-			}
-		}
-	}
+	for (i = 0; i < n_interfaces && device == NULL && local_error == NULL; i++)
+		device = arv_interface_open_device (available_interfaces[i], device_id, &local_error);
 
-	g_mutex_unlock (&arv_system_mutex);
+	for (i = 0; i < n_interfaces; i++)
+		g_object_unref (available_interfaces[i]);
+
+	if (ARV_IS_DEVICE (device) || local_error != NULL) {
+		if (local_error != NULL)
+			g_propagate_error (error, local_error);
+		return device;
+	}
 
 	if (device_id != NULL)
 		g_set_error (error, ARV_DEVICE_ERROR, ARV_DEVICE_ERROR_NOT_FOUND,
@@ -474,6 +589,89 @@ arv_open_device (const char *device_id, GError **error)
 	return NULL;
 }
 
+typedef struct {
+	const char *device_id;
+	ArvDevice *device;
+	GError *error;
+	gint64 duration_us;
+} ArvOpenDevicesData;
+
+static gpointer
+_open_devices_thread (gpointer user_data)
+{
+	ArvOpenDevicesData *data = user_data;
+	gint64 start_time;
+
+	start_time = g_get_monotonic_time ();
+	data->device = arv_open_device (data->device_id, &data->error);
+	data->duration_us = g_get_monotonic_time () - start_time;
+
+	return NULL;
+}
+
+/**
+ * arv_open_devices:
+ * @n_devices: number of devices to open
+ * @device_ids: (array length=n_devices): device identifier strings
+ * @devices: (array length=n_devices) (out caller-allocates): placeholder for the opened devices
+ * @durations_us: (array length=n_devices) (out caller-allocates) (allow-none): placeholder for the time spent
+ * opening each device, in µs, %NULL to ignore
+ * @error: a #GError placeholder, %NULL to ignore
+ *
+ * Opens a set of devices concurrently, using one thread per device. The elements of @devices corresponding to
+ * the devices which failed to open are set to %NULL, and @error is set to the first encountered error.
+ *
+ * Returns: %TRUE if all the devices were opened.
+ *
+ * Since: 0.8.32
+ */
+
+gboolean
+arv_open_devices (guint n_devices, const char **device_ids, ArvDevice **devices, gint64 *durations_us,
+		  GError **error)
+{
+	ArvOpenDevicesData *data;
+	GThread **threads;
+	gboolean success = TRUE;
+	guint i;
+
+	g_return_val_if_fail (n_devices == 0 || device_ids != NULL, FALSE);
+	g_return_val_if_fail (n_devices == 0 || devices != NULL, FALSE);
+
+	data = g_new0 (ArvOpenDevicesData, n_devices);
+	threads = g_new0 (GThread *, n_devices);
+
+	for (i = 0; i < n_devices; i++) {
+		data[i].device_id = device_ids[i];
+		threads[i] = g_thread_new ("arv_open_device", _open_devices_thread, &data[i]);
+	}
+
+	for (i = 0; i < n_devices; i++) {
+		g_thread_join (threads[i]);
+
+		devices[i] = data[i].device;
+		if (durations_us != NULL)
+			durations_us[i] = data[i].duration_us;
+
+		if (data[i].error != NULL) {
+			arv_info_misc ("[Arv::open_devices] Failed to open '%s' in %" G_GINT64_FORMAT " us: %s",
+				       device_ids[i], data[i].duration_us, data[i].error->message);
+			if (success)
+				g_propagate_error (error, data[i].error);
+			else
+				g_error_free (data[i].error);
+			success = FALSE;
+		} else
+			arv_info_misc ("[Arv::open_devices] '%s' opened in %" G_GINT64_FORMAT " us",
+				       device_ids[i], data[i].duration_us);
+	}
+
+	g_free (threads);
+	g_free (data);
+
+	return success;
+}
+
 /**
  * arv_shutdown:
  *
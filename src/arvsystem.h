@@ -38,7 +38,12 @@ ARV_API void		arv_enable_interface		        (const char *interface_id);
 ARV_API void		arv_disable_interface		        (const char *interface_id);
 ARV_API void		arv_set_interface_flags                 (const char *interface_id, int flags);
 
+ARV_API void		arv_enable_genicam_cache		(void);
+ARV_API void		arv_disable_genicam_cache		(void);
+
 ARV_API void		arv_update_device_list		        (void);
+ARV_API void		arv_start_device_discovery		(guint period_ms);
+ARV_API void		arv_stop_device_discovery		(void);
 ARV_API unsigned int	arv_get_n_devices		        (void);
 ARV_API const char *	arv_get_device_id		        (unsigned int index);
 ARV_API const char *	arv_get_device_physical_id	        (unsigned int index);
@@ -50,6 +55,9 @@ ARV_API const char *	arv_get_device_serial_nbr	        (unsigned int index);
 ARV_API const char *	arv_get_device_protocol		        (unsigned int index);
 
 ARV_API ArvDevice *	arv_open_device			        (const char *device_id, GError **error);
+ARV_API gboolean	arv_open_devices			(guint n_devices, const char **device_ids,
+								 ArvDevice **devices, gint64 *durations_us,
+								 GError **error);
 
 ARV_API void		arv_shutdown			        (void);
 
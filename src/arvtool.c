@@ -33,6 +33,7 @@ static char *arv_option_debug_domains = NULL;
 static char *arv_option_register_cache = NULL;
 static char *arv_option_range_check = NULL;
 static char *arv_option_access_check = NULL;
+static gboolean arv_option_prefetch = FALSE;
 static gboolean arv_option_gv_allow_broadcast_discovery_ack = FALSE;
 static gboolean arv_option_show_time = FALSE;
 static gboolean arv_option_show_version = FALSE;
@@ -64,6 +65,12 @@ static const GOptionEntry arv_option_entries[] =
 		&arv_option_access_check,	"Feature access check policy",
 		"{disable|enable}"
 	},
+	{
+		"prefetch",			'\0', 0, G_OPTION_ARG_NONE,
+		&arv_option_prefetch,		"Prefetch the registers of values and description, "
+						"enables the register cache unless --register-cache is given",
+		NULL
+	},
 	{
 		"gv-allow-broadcast-discovery-ack",
                 '\0', 0, G_OPTION_ARG_NONE,
@@ -260,6 +267,22 @@ arv_tool_list_features (ArvGc *genicam, const char *feature, ArvToolListMode lis
 	}
 }
 
+static void
+arv_tool_prefetch_features (ArvDevice *device, ArvGc *genicam)
+{
+	const char *root = "Root";
+
+	if (!arv_option_prefetch)
+		return;
+
+	/* The prefetched registers are served from the register cache, which is enabled unless a specific policy was
+	 * requested */
+	if (arv_option_register_cache == NULL)
+		arv_device_set_register_cache_policy (device, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	arv_gc_prefetch_features (genicam, &root, 1);
+}
+
 static void
 arv_tool_control (int argc, char **argv, ArvDevice *device)
 {
@@ -643,6 +666,7 @@ arv_tool_execute_command (int argc, char **argv, ArvDevice *device,
                         GRegex *regex;
 
                         regex = arv_regex_new_from_glob_pattern (argc == 3 ? argv[2] : "*", TRUE);
+                        arv_tool_prefetch_features (device, genicam);
                         arv_tool_list_features (genicam, "Root", ARV_TOOL_LIST_MODE_VALUES, regex, 0);
                         g_regex_unref (regex);
                 }
@@ -653,6 +677,7 @@ arv_tool_execute_command (int argc, char **argv, ArvDevice *device,
                         GRegex *regex;
 
                         regex = arv_regex_new_from_glob_pattern (argc == 3 ? argv[2] : "*", TRUE);
+                        arv_tool_prefetch_features (device, genicam);
                         arv_tool_list_features (genicam, "Root", ARV_TOOL_LIST_MODE_DESCRIPTIONS, regex, 0);
                         g_regex_unref (regex);
                 }
@@ -108,6 +108,7 @@ arv_uv_interface_device_infos_unref (ArvUvInterfaceDeviceInfos *infos)
 }
 
 typedef struct {
+	GMutex devices_mutex;
 	GHashTable *devices;
 	libusb_context *usb;
 } ArvUvInterfacePrivate;
@@ -293,6 +294,8 @@ _discover (ArvUvInterface *uv_interface,  GArray *device_ids)
 		return;
 	}
 
+	g_mutex_lock (&uv_interface->priv->devices_mutex);
+
 	g_hash_table_remove_all (uv_interface->priv->devices);
 
 	for (i = 0; i < result; i++) {
@@ -316,6 +319,8 @@ _discover (ArvUvInterface *uv_interface,  GArray *device_ids)
 		}
 	}
 
+	g_mutex_unlock (&uv_interface->priv->devices_mutex);
+
 	arv_info_interface ("Found %d USB3Vision device%s (among %" G_GSSIZE_FORMAT " USB device%s)",
 			     uv_count , uv_count > 1 ? "s" : "",
 			     result, result > 1 ? "s" : "");
@@ -338,9 +343,13 @@ _open_device (ArvInterface *interface, const char *device_id, GError **error)
 {
 	ArvUvInterface *uv_interface;
 	ArvUvInterfaceDeviceInfos *device_infos;
+	ArvDevice *device;
+	char *guid;
 
 	uv_interface = ARV_UV_INTERFACE (interface);
 
+	g_mutex_lock (&uv_interface->priv->devices_mutex);
+
 	if (device_id == NULL) {
 		GList *device_list;
 
@@ -350,10 +359,18 @@ _open_device (ArvInterface *interface, const char *device_id, GError **error)
 	} else
 		device_infos = g_hash_table_lookup (uv_interface->priv->devices, device_id);
 
-	if (device_infos == NULL)
+	guid = device_infos != NULL ? g_strdup (device_infos->guid) : NULL;
+
+	g_mutex_unlock (&uv_interface->priv->devices_mutex);
+
+	if (guid == NULL)
 		return NULL;
 
-	return arv_uv_device_new_from_guid (device_infos->guid, error);
+	device = arv_uv_device_new_from_guid (guid, error);
+
+	g_free (guid);
+
+	return device;
 }
 
 static ArvDevice *
@@ -417,6 +434,8 @@ arv_uv_interface_init (ArvUvInterface *uv_interface)
 
 	uv_interface->priv = arv_uv_interface_get_instance_private (uv_interface);
 
+	g_mutex_init (&uv_interface->priv->devices_mutex);
+
 	result = libusb_init (&uv_interface->priv->usb);
         if (result != 0)
 		arv_warning_interface ("Failed to initialize USB library: %s",
@@ -432,6 +451,7 @@ arv_uv_interface_finalize (GObject *object)
 	ArvUvInterface *uv_interface = ARV_UV_INTERFACE (object);
 
 	g_hash_table_unref (uv_interface->priv->devices);
+	g_mutex_clear (&uv_interface->priv->devices_mutex);
 
 	G_OBJECT_CLASS (arv_uv_interface_parent_class)->finalize (object);
 
@@ -271,3 +271,194 @@ arv_zip_get_file (ArvZip *zip, const char *name, size_t *size)
 
         return output_buffer;
 }
+
+/*
+ * Streaming extraction of the first file of a zip archive, from the local file header at the start of the archive.
+ * It allows to decompress the data while it is transferred, without the central directory stored at the end of the
+ * archive.
+ */
+
+#define ARV_ZIP_LOCAL_HEADER_SIZE	30
+#define ARV_ZIP_STREAM_CHUNK_SIZE	65536
+
+struct _ArvZipStream {
+	ArvZipStreamCallback callback;
+	void *user_data;
+
+	guint8 header[ARV_ZIP_LOCAL_HEADER_SIZE];
+	size_t header_offset;
+	size_t skip_size;
+
+	guint16 method;
+	guint64 remaining_size;
+
+	z_stream zs;
+	gboolean is_inflate_initialized;
+	guint8 *output;
+
+	gboolean is_done;
+	gboolean is_failed;
+};
+
+ArvZipStream *
+arv_zip_stream_new (ArvZipStreamCallback callback, void *user_data)
+{
+	ArvZipStream *stream;
+
+	g_return_val_if_fail (callback != NULL, NULL);
+
+	stream = g_new0 (ArvZipStream, 1);
+	stream->callback = callback;
+	stream->user_data = user_data;
+
+	return stream;
+}
+
+static gboolean
+arv_zip_stream_parse_header (ArvZipStream *stream)
+{
+	guint16 flags;
+
+	if (ARV_GUINT32_FROM_LE_PTR (stream->header, 0) != 0x04034b50) {
+		arv_info_misc ("[ZipStream::push] Magic number for file header not found (0x04034b50)");
+		return FALSE;
+	}
+
+	flags = ARV_GUINT16_FROM_LE_PTR (stream->header, 6);
+	stream->method = ARV_GUINT16_FROM_LE_PTR (stream->header, 8);
+	stream->remaining_size = ARV_GUINT32_FROM_LE_PTR (stream->header, 18);
+	stream->skip_size = ARV_GUINT16_FROM_LE_PTR (stream->header, 26) + ARV_GUINT16_FROM_LE_PTR (stream->header, 28);
+
+	if ((flags & 0x0001) != 0) {
+		arv_info_misc ("[ZipStream::push] Encrypted data not supported");
+		return FALSE;
+	}
+
+	/* Stored data size may only be known from the data descriptor, after the data */
+	if (stream->method == 0 && (flags & 0x0008) != 0) {
+		arv_info_misc ("[ZipStream::push] Stored data with data descriptor not supported");
+		return FALSE;
+	}
+
+	if (stream->method == 8) {
+		stream->zs.zalloc = NULL;
+		stream->zs.zfree = NULL;
+		stream->zs.opaque = NULL;
+		stream->zs.next_in = NULL;
+		stream->zs.avail_in = 0;
+		if (inflateInit2 (&stream->zs, -MAX_WBITS) != Z_OK)
+			return FALSE;
+		stream->is_inflate_initialized = TRUE;
+		stream->output = g_malloc (ARV_ZIP_STREAM_CHUNK_SIZE);
+	} else if (stream->method != 0) {
+		arv_info_misc ("[ZipStream::push] Compression method %d not supported", stream->method);
+		return FALSE;
+	}
+
+	return TRUE;
+}
+
+/*
+ * arv_zip_stream_push:
+ * @stream: a #ArvZipStream
+ * @data: a chunk of zipped data
+ * @size: size of @data, in bytes
+ *
+ * Decompresses a chunk of the archive. The callback is called for each chunk of uncompressed data.
+ *
+ * Returns: %FALSE if the archive can not be decompressed.
+ */
+
+gboolean
+arv_zip_stream_push (ArvZipStream *stream, const void *data, size_t size)
+{
+	const guint8 *ptr = data;
+
+	g_return_val_if_fail (stream != NULL, FALSE);
+	g_return_val_if_fail (data != NULL || size == 0, FALSE);
+
+	while (size > 0 && !stream->is_done && !stream->is_failed) {
+		size_t n;
+
+		if (stream->header_offset < ARV_ZIP_LOCAL_HEADER_SIZE) {
+			n = MIN (size, ARV_ZIP_LOCAL_HEADER_SIZE - stream->header_offset);
+			memcpy (stream->header + stream->header_offset, ptr, n);
+			stream->header_offset += n;
+			ptr += n;
+			size -= n;
+
+			if (stream->header_offset == ARV_ZIP_LOCAL_HEADER_SIZE &&
+			    !arv_zip_stream_parse_header (stream))
+				stream->is_failed = TRUE;
+		} else if (stream->skip_size > 0) {
+			/* File name and extra field */
+			n = MIN (size, stream->skip_size);
+			stream->skip_size -= n;
+			ptr += n;
+			size -= n;
+		} else if (stream->method == 0) {
+			n = MIN (size, stream->remaining_size);
+			if (n > 0)
+				stream->callback (ptr, n, stream->user_data);
+			stream->remaining_size -= n;
+			ptr += n;
+			size -= n;
+			stream->is_done = stream->remaining_size == 0;
+		} else {
+			int status;
+
+			stream->zs.next_in = (Bytef *) ptr;
+			stream->zs.avail_in = size;
+
+			do {
+				stream->zs.next_out = stream->output;
+				stream->zs.avail_out = ARV_ZIP_STREAM_CHUNK_SIZE;
+
+				status = inflate (&stream->zs, Z_NO_FLUSH);
+
+				if (stream->zs.avail_out < ARV_ZIP_STREAM_CHUNK_SIZE)
+					stream->callback (stream->output,
+							  ARV_ZIP_STREAM_CHUNK_SIZE - stream->zs.avail_out,
+							  stream->user_data);
+
+				if (status == Z_STREAM_END)
+					stream->is_done = TRUE;
+				else if (status != Z_OK && status != Z_BUF_ERROR) {
+					arv_info_misc ("[ZipStream::push] Inflate error %d", status);
+					stream->is_failed = TRUE;
+				}
+			} while (stream->zs.avail_out == 0 && !stream->is_done && !stream->is_failed);
+
+			/* Remaining data after the end of the compressed stream belongs to the rest of the archive */
+			size = 0;
+		}
+	}
+
+	return !stream->is_failed;
+}
+
+/*
+ * arv_zip_stream_is_done:
+ * @stream: a #ArvZipStream
+ *
+ * Returns: %TRUE if the whole file was decompressed.
+ */
+
+gboolean
+arv_zip_stream_is_done (ArvZipStream *stream)
+{
+	g_return_val_if_fail (stream != NULL, FALSE);
+
+	return stream->is_done;
+}
+
+void
+arv_zip_stream_free (ArvZipStream *stream)
+{
+	g_return_if_fail (stream != NULL);
+
+	if (stream->is_inflate_initialized)
+		inflateEnd (&stream->zs);
+	g_free (stream->output);
+	g_free (stream);
+}
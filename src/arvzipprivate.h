@@ -0,0 +1,48 @@
+/* Aravis - Digital camera library
+ *
+ * Copyright © 2009-2022 Emmanuel Pacaud
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General
+ * Public License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ *
+ * Author: Emmanuel Pacaud <emmanuel.pacaud@free.fr>
+ */
+
+#ifndef ARV_ZIP_PRIVATE_H
+#define ARV_ZIP_PRIVATE_H
+
+#include <arvzip.h>
+
+G_BEGIN_DECLS
+
+typedef struct _ArvZipStream ArvZipStream;
+
+/*
+ * ArvZipStreamCallback:
+ * @data: a chunk of uncompressed data
+ * @size: size of @data, in bytes
+ * @user_data: callback user data
+ */
+
+typedef void (*ArvZipStreamCallback) (const void *data, size_t size, void *user_data);
+
+ArvZipStream *	arv_zip_stream_new	(ArvZipStreamCallback callback, void *user_data);
+gboolean	arv_zip_stream_push	(ArvZipStream *stream, const void *data, size_t size);
+gboolean	arv_zip_stream_is_done	(ArvZipStream *stream);
+void		arv_zip_stream_free	(ArvZipStream *stream);
+
+G_END_DECLS
+
+#endif
@@ -3,6 +3,14 @@
 
 static char **arv_option_expressions = NULL;
 static char *arv_option_debug_domains = NULL;
+static int arv_option_n_iterations = 0;
+
+/* Same expressions as the evaluator benchmark of the benchmark suite */
+static const char *arv_benchmark_expressions[] = {
+	"(TINT * 3 + 7) / 2 + (TINT > 100 ? TINT & 255 : 1)",
+	"(TDBL * 1.5 + TINT) / 3.0 - (TINT > 100 ? TDBL : 0.5)",
+	NULL
+};
 
 static const GOptionEntry arv_option_entries[] =
 {
@@ -10,9 +18,43 @@ static const GOptionEntry arv_option_entries[] =
 		&arv_option_expressions,		NULL, NULL},
 	{ "debug", 		'd', 0, G_OPTION_ARG_STRING,
 		&arv_option_debug_domains, 	"Debug mode", NULL },
+	{ "benchmark",		'b', 0, G_OPTION_ARG_INT,
+		&arv_option_n_iterations,	"Measure evaluation time over n iterations", "<n_iterations>" },
 	{ NULL }
 };
 
+static void
+benchmark (ArvEvaluator *evaluator, const char *expression)
+{
+	gint64 start;
+	gint64 v_int64 = 0;
+	double v_double = 0.0;
+	double int64_time;
+	double double_time;
+	int i;
+
+	/* Variable update included, as done by the Genicam nodes before each evaluation */
+
+	start = g_get_monotonic_time ();
+	for (i = 0; i < arv_option_n_iterations; i++) {
+		arv_evaluator_set_int64_variable (evaluator, "TINT", i);
+		v_int64 += arv_evaluator_evaluate_as_int64 (evaluator, NULL);
+	}
+	int64_time = 1e3 * (g_get_monotonic_time () - start) / arv_option_n_iterations;
+
+	start = g_get_monotonic_time ();
+	for (i = 0; i < arv_option_n_iterations; i++) {
+		arv_evaluator_set_int64_variable (evaluator, "TINT", i);
+		v_double += arv_evaluator_evaluate_as_double (evaluator, NULL);
+	}
+	double_time = 1e3 * (g_get_monotonic_time () - start) / arv_option_n_iterations;
+
+	arv_evaluator_set_int64_variable (evaluator, "TINT", 3200);
+
+	g_print ("%s: int64 %.1f ns, double %.1f ns per evaluation, %d iterations (checksums %" G_GINT64_FORMAT
+		 " %g)\n", expression, int64_time, double_time, arv_option_n_iterations, v_int64, v_double);
+}
+
 int
 main (int argc, char **argv)
 {
@@ -41,6 +83,11 @@ main (int argc, char **argv)
 	arv_evaluator_set_double_variable (evaluator, "TDBL", 124.2);
 	arv_evaluator_set_int64_variable (evaluator, "TINT", 3200);
 
+	/* Benchmark without expression uses the reference ones, the program only relies on the public API and can be
+	 * built against older versions in order to compare the evaluation times */
+	if (arv_option_expressions == NULL && arv_option_n_iterations > 0)
+		arv_option_expressions = g_strdupv ((char **) arv_benchmark_expressions);
+
 	if (arv_option_expressions == NULL) {
 		g_print ("Missing expression.\n");
 		return EXIT_FAILURE;
@@ -55,8 +102,12 @@ main (int argc, char **argv)
 				 error->message);
 			g_error_free (error);
 			error = NULL;
-		} else
+		} else {
 			g_print ("%s = %g\n", arv_option_expressions[i], value);
+
+			if (arv_option_n_iterations > 0)
+				benchmark (evaluator, arv_option_expressions[i]);
+		}
 	}
 
 	g_object_unref (evaluator);
@@ -0,0 +1,735 @@
+#include <glib.h>
+#include <arv.h>
+#include <stdlib.h>
+#include <string.h>
+#include <arvbufferprivate.h>
+#include <arvgcprivate.h>
+#include <arvgvspprivate.h>
+#include <arvgvstreamprivate.h>
+#include <arvmiscprivate.h>
+#include <arvstreamprivate.h>
+
+/* Microbenchmarks of the library hot paths.
+ *
+ * Each benchmark runs a fixed number of iterations of an operation, on fixed input data, after a warm up pass. The
+ * measurement is repeated and the minimum, median and maximum time per iteration are reported as a JSON document on
+ * the standard output, and optionally in a file, in order to allow the comparison between releases. */
+
+static char **arv_option_groups = NULL;
+static char *arv_option_output = NULL;
+static int arv_option_n_repetitions = 5;
+static gboolean arv_option_list = FALSE;
+static char *arv_option_debug_domains = NULL;
+
+static const GOptionEntry arv_option_entries[] =
+{
+	{ G_OPTION_REMAINING,	' ', 0, G_OPTION_ARG_STRING_ARRAY,
+		&arv_option_groups,			NULL, "[<group>...]"},
+	{ "output",		'o', 0, G_OPTION_ARG_FILENAME,
+		&arv_option_output,			"Also write the JSON results to a file", "<filename>"},
+	{ "repetitions",	'r', 0, G_OPTION_ARG_INT,
+		&arv_option_n_repetitions,		"Number of measurements per benchmark", "<n>"},
+	{ "list",		'l', 0, G_OPTION_ARG_NONE,
+		&arv_option_list,			"List the benchmark groups", NULL},
+	{ "debug", 		'd', 0, G_OPTION_ARG_STRING,
+		&arv_option_debug_domains, 		NULL, "{<category>[:<level>][,...]|help}"},
+	{ NULL }
+};
+
+typedef void (*ArvBenchmarkFunc) (gpointer data, guint n_iterations);
+
+static GString *json_results = NULL;
+static guint n_json_results = 0;
+
+static int
+_compare_double (const void *a, const void *b)
+{
+	double da = *((const double *) a);
+	double db = *((const double *) b);
+
+	return da < db ? -1 : (da > db ? 1 : 0);
+}
+
+static void
+measure (const char *name, guint n_iterations, size_t n_bytes_per_iteration, ArvBenchmarkFunc func, gpointer data)
+{
+	double *times;
+	double median;
+	int n_repetitions = MAX (arv_option_n_repetitions, 1);
+	int i;
+
+	/* Warm up caches and lazy initializations */
+	func (data, MAX (n_iterations / 10, 1));
+
+	times = g_new (double, n_repetitions);
+
+	for (i = 0; i < n_repetitions; i++) {
+		gint64 start;
+
+		start = g_get_monotonic_time ();
+		func (data, n_iterations);
+		times[i] = 1e3 * (double) (g_get_monotonic_time () - start) / n_iterations;
+	}
+
+	qsort (times, n_repetitions, sizeof (double), _compare_double);
+	median = times[n_repetitions / 2];
+
+	g_string_append_printf (json_results,
+				"%s\n    {\"name\": \"%s\", \"iterations\": %u, \"repetitions\": %d, "
+				"\"min_ns\": %.1f, \"median_ns\": %.1f, \"max_ns\": %.1f",
+				n_json_results > 0 ? "," : "",
+				name, n_iterations, n_repetitions,
+				times[0], median, times[n_repetitions - 1]);
+	if (n_bytes_per_iteration > 0)
+		g_string_append_printf (json_results, ", \"bytes\": %" G_GSIZE_FORMAT ", \"median_mb_s\": %.1f",
+					n_bytes_per_iteration,
+					median > 0.0 ? 1e3 * n_bytes_per_iteration / median : 0.0);
+	g_string_append (json_results, "}");
+	n_json_results++;
+
+	g_printerr ("%-32s %12.1f ns (min %.1f, max %.1f)\n", name, median, times[0], times[n_repetitions - 1]);
+
+	g_free (times);
+}
+
+/* Evaluator */
+
+static void
+evaluator_int64_func (gpointer data, guint n_iterations)
+{
+	ArvEvaluator *evaluator = data;
+	gint64 checksum = 0;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++) {
+		arv_evaluator_set_int64_variable (evaluator, "TINT", i);
+		checksum += arv_evaluator_evaluate_as_int64 (evaluator, NULL);
+	}
+
+	g_assert (checksum != 1);
+}
+
+static void
+evaluator_double_func (gpointer data, guint n_iterations)
+{
+	ArvEvaluator *evaluator = data;
+	double checksum = 0.0;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++) {
+		arv_evaluator_set_int64_variable (evaluator, "TINT", i);
+		checksum += arv_evaluator_evaluate_as_double (evaluator, NULL);
+	}
+
+	g_assert (checksum != 1.0);
+}
+
+static void
+evaluator_benchmark (void)
+{
+	ArvEvaluator *evaluator;
+
+	evaluator = arv_evaluator_new ("(TINT * 3 + 7) / 2 + (TINT > 100 ? TINT & 255 : 1)");
+	arv_evaluator_set_int64_variable (evaluator, "TINT", 0);
+	measure ("evaluator/int64", 200000, 0, evaluator_int64_func, evaluator);
+	g_object_unref (evaluator);
+
+	evaluator = arv_evaluator_new ("(TDBL * 1.5 + TINT) / 3.0 - (TINT > 100 ? TDBL : 0.5)");
+	arv_evaluator_set_double_variable (evaluator, "TDBL", 124.2);
+	arv_evaluator_set_int64_variable (evaluator, "TINT", 0);
+	measure ("evaluator/double", 200000, 0, evaluator_double_func, evaluator);
+	g_object_unref (evaluator);
+}
+
+/* Genicam document loading */
+
+typedef struct {
+	const char *data;
+	size_t size;
+} GenicamData;
+
+static void
+genicam_xml_func (gpointer data, guint n_iterations)
+{
+	GenicamData *genicam_data = data;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++) {
+		ArvGc *genicam;
+
+		genicam = arv_gc_new (NULL, genicam_data->data, genicam_data->size);
+		g_assert (ARV_IS_GC (genicam));
+		g_object_unref (genicam);
+	}
+}
+
+static void
+genicam_compiled_func (gpointer data, guint n_iterations)
+{
+	GenicamData *genicam_data = data;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++) {
+		ArvGc *genicam;
+
+		genicam = arv_gc_new_from_compiled (NULL, genicam_data->data, genicam_data->size, NULL);
+		g_assert (ARV_IS_GC (genicam));
+		g_object_unref (genicam);
+	}
+}
+
+static void
+genicam_benchmark (void)
+{
+	GenicamData genicam_data;
+	GBytes *compiled;
+	char *xml = NULL;
+	gsize size;
+	gboolean success;
+
+	success = g_file_get_contents (GENICAM_FILENAME, &xml, &size, NULL);
+	g_assert (success);
+
+	genicam_data.data = xml;
+	genicam_data.size = size;
+	measure ("genicam/xml-load", 50, size, genicam_xml_func, &genicam_data);
+
+	compiled = arv_gc_compile (xml, size, NULL);
+	g_assert (compiled != NULL);
+
+	genicam_data.data = g_bytes_get_data (compiled, &genicam_data.size);
+	measure ("genicam/compiled-load", 50, genicam_data.size, genicam_compiled_func, &genicam_data);
+
+	g_bytes_unref (compiled);
+	g_free (xml);
+}
+
+/* Feature access on the fake device */
+
+static void
+feature_get_integer_func (gpointer data, guint n_iterations)
+{
+	gint64 checksum = 0;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++)
+		checksum += arv_device_get_integer_feature_value (data, "Width", NULL);
+
+	g_assert (checksum > 0);
+}
+
+static void
+feature_set_integer_func (gpointer data, guint n_iterations)
+{
+	guint i;
+
+	for (i = 0; i < n_iterations; i++)
+		arv_device_set_integer_feature_value (data, "Width", (i & 1) ? 512 : 256, NULL);
+}
+
+static void
+feature_get_float_func (gpointer data, guint n_iterations)
+{
+	double checksum = 0.0;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++)
+		checksum += arv_device_get_float_feature_value (data, "ExposureTimeAbs", NULL);
+
+	g_assert (checksum > 0.0);
+}
+
+static void
+feature_get_float_bounds_func (gpointer data, guint n_iterations)
+{
+	double min, max;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++)
+		arv_device_get_float_feature_bounds (data, "ExposureTimeAbs", &min, &max, NULL);
+}
+
+static void
+feature_benchmark (void)
+{
+	ArvDevice *device;
+
+	device = arv_fake_device_new ("TEST0", NULL);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+
+	measure ("feature/get-integer", 20000, 0, feature_get_integer_func, device);
+	measure ("feature/set-integer", 20000, 0, feature_set_integer_func, device);
+	measure ("feature/get-float", 20000, 0, feature_get_float_func, device);
+	measure ("feature/get-float-bounds", 20000, 0, feature_get_float_bounds_func, device);
+
+	g_object_unref (device);
+}
+
+/* Chunk data extraction */
+
+#if defined (__GNUC__)
+#define ARV_PACK(_structure) _structure __attribute__((__packed__))
+#elif defined (_MSC_VER) && (_MSC_VER >= 1500)
+#define ARV_PACK(_structure) __pragma(pack(push, 1)) _structure __pragma(pack(pop))
+#else
+#error "Structure packing is not defined for this compiler!"
+#endif
+
+ARV_PACK(typedef struct {
+	guint32 id;
+	guint32 size;
+}) ArvChunkInfos;
+
+typedef struct {
+	ArvChunkParser *parser;
+	ArvBuffer *buffer;
+} ChunkData;
+
+static ArvBuffer *
+create_buffer_with_chunk_data (void)
+{
+	ArvBuffer *buffer;
+	ArvChunkInfos *chunk_infos;
+	char *data;
+	size_t size;
+	guint32 *int_value;
+	guint64 *float_value;
+	guint offset;
+
+	size = 64 + 8 + 8 + 3 * sizeof (ArvChunkInfos);
+
+	buffer = arv_buffer_new (size, NULL);
+	buffer->priv->payload_type = ARV_BUFFER_PAYLOAD_TYPE_CHUNK_DATA;
+	buffer->priv->has_chunks = TRUE;
+	buffer->priv->received_size = size;
+	buffer->priv->status = ARV_BUFFER_STATUS_SUCCESS;
+	data = (char *) arv_buffer_get_data (buffer, NULL);
+
+	memset (data, '\0', size);
+
+	offset = size - sizeof (ArvChunkInfos);
+	chunk_infos = (ArvChunkInfos *) &data[offset];
+	chunk_infos->id = GUINT32_TO_BE (0x12345678);
+	chunk_infos->size = GUINT32_TO_BE (8);
+
+	int_value = (guint32 *) &data[offset - 8];
+	*int_value = GUINT32_TO_BE (0x11223344);
+
+	offset -= 8 + sizeof (ArvChunkInfos);
+	chunk_infos = (ArvChunkInfos *) &data[offset];
+	chunk_infos->id = GUINT32_TO_BE (0x12345679);
+	chunk_infos->size = GUINT32_TO_BE (8);
+
+	float_value = (guint64 *) &data[offset - 8];
+	*float_value = GUINT64_TO_BE (0x3FF199999999999A); /* 1.1 */
+
+	/* Image data */
+	offset -= 8 + sizeof (ArvChunkInfos);
+	chunk_infos = (ArvChunkInfos *) &data[offset];
+	chunk_infos->id = GUINT32_TO_BE (0x44444444);
+	chunk_infos->size = GUINT32_TO_BE (64);
+
+	g_assert_cmpint (offset, ==, 64);
+
+	return buffer;
+}
+
+static void
+chunk_func (gpointer data, guint n_iterations)
+{
+	ChunkData *chunk_data = data;
+	double checksum = 0.0;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++) {
+		checksum += arv_chunk_parser_get_integer_value (chunk_data->parser, chunk_data->buffer, "ChunkInt", NULL);
+		checksum += arv_chunk_parser_get_float_value (chunk_data->parser, chunk_data->buffer, "ChunkFloat", NULL);
+	}
+
+	g_assert (checksum > 0.0);
+}
+
+static void
+chunk_benchmark (void)
+{
+	ChunkData chunk_data;
+	char *xml = NULL;
+	gsize size;
+	gboolean success;
+
+	success = g_file_get_contents (CHUNK_GENICAM_FILENAME, &xml, &size, NULL);
+	g_assert (success);
+
+	chunk_data.parser = arv_chunk_parser_new (xml, size);
+	g_assert (ARV_IS_CHUNK_PARSER (chunk_data.parser));
+	chunk_data.buffer = create_buffer_with_chunk_data ();
+
+	measure ("chunk/get-values", 20000, 0, chunk_func, &chunk_data);
+
+	g_object_unref (chunk_data.buffer);
+	g_object_unref (chunk_data.parser);
+	g_free (xml);
+}
+
+/* Stream buffer queues */
+
+static void
+queue_func (gpointer data, guint n_iterations)
+{
+	ArvStream *stream = data;
+	ArvBuffer *buffer;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++) {
+		arv_stream_push_buffer (stream, arv_stream_try_pop_buffer (stream));
+		buffer = arv_stream_pop_input_buffer (stream);
+		arv_stream_push_output_buffer (stream, buffer);
+	}
+}
+
+static void
+queue_benchmark (void)
+{
+	ArvDevice *device;
+	ArvStream *stream;
+	int i;
+
+	device = arv_fake_device_new ("TEST0", NULL);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+
+	stream = arv_device_create_stream (device, NULL, NULL, NULL);
+	g_assert (ARV_IS_STREAM (stream));
+
+	/* Only measure the queues, without the fake stream thread */
+	arv_stream_stop_thread (stream, FALSE);
+
+	for (i = 0; i < 16; i++)
+		arv_stream_push_output_buffer (stream, arv_buffer_new (1024, NULL));
+
+	measure ("queue/push-pop", 200000, 0, queue_func, stream);
+
+	g_object_unref (stream);
+	g_object_unref (device);
+}
+
+/* Memory copy with endianness conversion */
+
+typedef struct {
+	guint8 *from;
+	guint8 *to;
+	size_t size;
+	guint from_endianness;
+	guint to_endianness;
+} MemoryData;
+
+static void
+memory_func (gpointer data, guint n_iterations)
+{
+	MemoryData *memory_data = data;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++)
+		arv_copy_memory_with_endianness (memory_data->to, memory_data->size, memory_data->to_endianness,
+						 memory_data->from, memory_data->size, memory_data->from_endianness);
+}
+
+static void
+memory_benchmark (void)
+{
+	MemoryData memory_data;
+	guint8 from[8];
+	guint8 to[8];
+	guint i;
+
+	for (i = 0; i < sizeof (from); i++)
+		from[i] = i;
+
+	memory_data.from = from;
+	memory_data.to = to;
+	memory_data.size = 4;
+	memory_data.from_endianness = G_BIG_ENDIAN;
+	memory_data.to_endianness = G_LITTLE_ENDIAN;
+	measure ("memory/swap-32", 1000000, 0, memory_func, &memory_data);
+
+	memory_data.size = 8;
+	measure ("memory/swap-64", 1000000, 0, memory_func, &memory_data);
+
+	memory_data.to_endianness = G_BIG_ENDIAN;
+	measure ("memory/copy-64", 1000000, 0, memory_func, &memory_data);
+}
+
+/* Test pattern generation of the fake camera */
+
+#define FILL_BENCHMARK_WIDTH	2048
+#define FILL_BENCHMARK_HEIGHT	1536
+
+typedef struct {
+	ArvFakeCamera *camera;
+	ArvBuffer *buffer;
+} FillData;
+
+static void
+fill_func (gpointer data, guint n_iterations)
+{
+	FillData *fill_data = data;
+	guint i;
+
+	for (i = 0; i < n_iterations; i++)
+		arv_fake_camera_fill_buffer (fill_data->camera, fill_data->buffer, NULL);
+}
+
+static void
+fill_benchmark (void)
+{
+	static const struct {
+		const char *name;
+		ArvPixelFormat pixel_format;
+	} formats[] = {
+		{"fill/mono8",		ARV_PIXEL_FORMAT_MONO_8},
+		{"fill/mono16",		ARV_PIXEL_FORMAT_MONO_16},
+		{"fill/bayer-bg8",	ARV_PIXEL_FORMAT_BAYER_BG_8},
+		{"fill/mono12p",		ARV_PIXEL_FORMAT_MONO_12P},
+		{"fill/rgb8",		ARV_PIXEL_FORMAT_RGB_8_PACKED},
+		{"fill/yuv422",		ARV_PIXEL_FORMAT_YUV_422_PACKED}
+	};
+	FillData fill_data;
+	guint i;
+
+	fill_data.camera = arv_fake_camera_new ("TEST0");
+	arv_fake_camera_write_register (fill_data.camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, FILL_BENCHMARK_WIDTH);
+	arv_fake_camera_write_register (fill_data.camera, ARV_FAKE_CAMERA_REGISTER_HEIGHT, FILL_BENCHMARK_HEIGHT);
+	fill_data.buffer = arv_buffer_new (3 * FILL_BENCHMARK_WIDTH * FILL_BENCHMARK_HEIGHT, NULL);
+
+	for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+		arv_fake_camera_write_register (fill_data.camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT,
+						formats[i].pixel_format);
+		measure (formats[i].name, 50, arv_fake_camera_get_payload (fill_data.camera), fill_func, &fill_data);
+	}
+
+	g_object_unref (fill_data.buffer);
+	g_object_unref (fill_data.camera);
+}
+
+/* Offline GVSP reassembly, without network nor stream thread */
+
+#define REPLAY_BENCHMARK_WIDTH		512
+#define REPLAY_BENCHMARK_HEIGHT		512
+#define REPLAY_BENCHMARK_PACKET_SIZE	1500
+#define REPLAY_BENCHMARK_DROP_PERIOD	16
+
+typedef struct {
+	ArvStream *stream;
+	guint8 *packets;
+	size_t *sizes;
+	guint n_packets;
+	guint16 frame_id;
+	guint64 time_us;
+	guint n_handled_requests;
+	guint drop_period;
+} ReplayData;
+
+static void
+replay_set_frame_id (ReplayData *replay_data, guint packet_id)
+{
+	ArvGvspPacket *packet;
+	ArvGvspHeader *header;
+
+	packet = (ArvGvspPacket *) (replay_data->packets + packet_id * REPLAY_BENCHMARK_PACKET_SIZE);
+	header = (ArvGvspHeader *) &packet->header;
+	header->frame_id = g_htons (replay_data->frame_id);
+}
+
+static void
+replay_packet (ReplayData *replay_data, guint packet_id)
+{
+	replay_set_frame_id (replay_data, packet_id);
+	arv_gv_stream_replay_packet (ARV_GV_STREAM (replay_data->stream),
+				     replay_data->packets + packet_id * REPLAY_BENCHMARK_PACKET_SIZE,
+				     replay_data->sizes[packet_id], replay_data->time_us++);
+}
+
+static void
+replay_func (gpointer data, guint n_iterations)
+{
+	ReplayData *replay_data = data;
+	guint i, j;
+
+	for (i = 0; i < n_iterations; i++) {
+		const ArvGvStreamReplayRequest *requests;
+		ArvBuffer *buffer;
+		guint n_requests;
+		gboolean dropped = FALSE;
+
+		/* Frame id 0 is not valid */
+		replay_data->frame_id = replay_data->frame_id == G_MAXUINT16 ? 1 : replay_data->frame_id + 1;
+
+		for (j = 0; j < replay_data->n_packets; j++) {
+			if (replay_data->drop_period > 0 &&
+			    j > 0 && j < replay_data->n_packets - 1 &&
+			    j % replay_data->drop_period == 0) {
+				dropped = TRUE;
+				continue;
+			}
+			replay_packet (replay_data, j);
+		}
+
+		if (dropped) {
+			/* Let the packet timeout expire, and answer the resend requests */
+			replay_data->time_us += ARV_GV_STREAM_PACKET_TIMEOUT_US_DEFAULT;
+			arv_gv_stream_replay_time (ARV_GV_STREAM (replay_data->stream), replay_data->time_us);
+
+			requests = arv_gv_stream_replay_get_resend_requests (ARV_GV_STREAM (replay_data->stream),
+									     &n_requests);
+			for (; replay_data->n_handled_requests < n_requests; replay_data->n_handled_requests++) {
+				const ArvGvStreamReplayRequest *request = &requests[replay_data->n_handled_requests];
+
+				for (j = request->first_block; j <= request->last_block; j++)
+					replay_packet (replay_data, j);
+			}
+		}
+
+		buffer = arv_stream_try_pop_buffer (replay_data->stream);
+		g_assert (ARV_IS_BUFFER (buffer));
+		g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+		arv_stream_push_buffer (replay_data->stream, buffer);
+	}
+}
+
+static void
+replay_benchmark (void)
+{
+	ReplayData replay_data;
+	guint8 *image;
+	size_t payload;
+	size_t data_size;
+	guint i;
+
+	payload = REPLAY_BENCHMARK_WIDTH * REPLAY_BENCHMARK_HEIGHT;
+	data_size = REPLAY_BENCHMARK_PACKET_SIZE - ARV_GVSP_PAYLOAD_PACKET_PROTOCOL_OVERHEAD (FALSE);
+
+	image = g_malloc (payload);
+	for (i = 0; i < payload; i++)
+		image[i] = i;
+
+	/* Leader, payload packets and trailer of a Mono8 frame */
+	replay_data.n_packets = (payload + data_size - 1) / data_size + 2;
+	replay_data.packets = g_malloc0 (replay_data.n_packets * REPLAY_BENCHMARK_PACKET_SIZE);
+	replay_data.sizes = g_new (size_t, replay_data.n_packets);
+
+	for (i = 0; i < replay_data.n_packets; i++) {
+		void *packet = replay_data.packets + i * REPLAY_BENCHMARK_PACKET_SIZE;
+
+		replay_data.sizes[i] = REPLAY_BENCHMARK_PACKET_SIZE;
+		if (i == 0)
+			arv_gvsp_packet_new_image_leader (1, i, FALSE, ARV_BUFFER_PAYLOAD_TYPE_IMAGE, 0,
+							  ARV_PIXEL_FORMAT_MONO_8,
+							  REPLAY_BENCHMARK_WIDTH, REPLAY_BENCHMARK_HEIGHT, 0, 0, 0, 0,
+							  packet, &replay_data.sizes[i]);
+		else if (i == replay_data.n_packets - 1)
+			arv_gvsp_packet_new_data_trailer (1, i, FALSE, ARV_BUFFER_PAYLOAD_TYPE_IMAGE,
+							  packet, &replay_data.sizes[i]);
+		else
+			arv_gvsp_packet_new_payload (1, i, FALSE, MIN (data_size, payload - (i - 1) * data_size),
+						     image + (i - 1) * data_size, packet, &replay_data.sizes[i]);
+	}
+
+	replay_data.stream = arv_gv_stream_new_replay (REPLAY_BENCHMARK_PACKET_SIZE, 0, NULL, NULL, NULL);
+	g_assert (ARV_IS_GV_STREAM (replay_data.stream));
+
+	for (i = 0; i < 4; i++)
+		arv_stream_push_buffer (replay_data.stream, arv_buffer_new (payload, NULL));
+
+	replay_data.frame_id = 0;
+	replay_data.time_us = 1;
+	replay_data.n_handled_requests = 0;
+
+	replay_data.drop_period = 0;
+	measure ("replay/frame", 2000, payload, replay_func, &replay_data);
+
+	replay_data.drop_period = REPLAY_BENCHMARK_DROP_PERIOD;
+	measure ("replay/resend", 2000, payload, replay_func, &replay_data);
+
+	g_object_unref (replay_data.stream);
+	g_free (replay_data.sizes);
+	g_free (replay_data.packets);
+	g_free (image);
+}
+
+static const struct {
+	const char *name;
+	void (*run) (void);
+} groups[] = {
+	{"evaluator",	evaluator_benchmark},
+	{"genicam",	genicam_benchmark},
+	{"feature",	feature_benchmark},
+	{"chunk",	chunk_benchmark},
+	{"queue",	queue_benchmark},
+	{"memory",	memory_benchmark},
+	{"fill",	fill_benchmark},
+	{"replay",	replay_benchmark}
+};
+
+int
+main (int argc, char **argv)
+{
+	GOptionContext *context;
+	GError *error = NULL;
+	char *json;
+	guint i, j;
+
+	context = g_option_context_new (NULL);
+	g_option_context_set_summary (context, "Aravis microbenchmarks, results are printed as JSON.");
+	g_option_context_add_main_entries (context, arv_option_entries, NULL);
+
+	if (!g_option_context_parse (context, &argc, &argv, &error)) {
+		g_option_context_free (context);
+		g_print ("Option parsing failed: %s\n", error->message);
+		g_error_free (error);
+		return EXIT_FAILURE;
+	}
+
+	g_option_context_free (context);
+
+	if (arv_option_list) {
+		for (i = 0; i < G_N_ELEMENTS (groups); i++)
+			g_print ("%s\n", groups[i].name);
+		return EXIT_SUCCESS;
+	}
+
+	arv_debug_enable (arv_option_debug_domains);
+
+	arv_set_fake_camera_genicam_filename (GENICAM_FILENAME);
+
+	json_results = g_string_new (NULL);
+
+	for (i = 0; i < G_N_ELEMENTS (groups); i++) {
+		gboolean selected = arv_option_groups == NULL;
+
+		for (j = 0; arv_option_groups != NULL && arv_option_groups[j] != NULL; j++)
+			if (g_strcmp0 (arv_option_groups[j], groups[i].name) == 0)
+				selected = TRUE;
+
+		if (selected)
+			groups[i].run ();
+	}
+
+	json = g_strdup_printf ("{\n  \"aravis_version\": \"%d.%d.%d\",\n  \"repetitions\": %d,\n"
+				"  \"benchmarks\": [%s\n  ]\n}\n",
+				ARAVIS_MAJOR_VERSION, ARAVIS_MINOR_VERSION, ARAVIS_MICRO_VERSION,
+				MAX (arv_option_n_repetitions, 1), json_results->str);
+	g_string_free (json_results, TRUE);
+
+	g_print ("%s", json);
+
+	if (arv_option_output != NULL &&
+	    !g_file_set_contents (arv_option_output, json, -1, &error)) {
+		g_printerr ("Failed to write '%s': %s\n", arv_option_output, error->message);
+		g_clear_error (&error);
+	}
+
+	g_free (json);
+
+	arv_shutdown ();
+
+	return EXIT_SUCCESS;
+}
@@ -328,6 +328,64 @@ error_test (void)
 	g_object_unref (evaluator);
 }
 
+static void
+compiled_program_test (void)
+{
+	ArvEvaluator *evaluator;
+	GError *error = NULL;
+	gint64 v_int64;
+	double v_double;
+
+	/* Variable assigned after the expression compilation */
+
+	evaluator = arv_evaluator_new ("2*3+X");
+
+	arv_evaluator_evaluate_as_double (evaluator, &error);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	arv_evaluator_evaluate_as_int64 (evaluator, &error);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	arv_evaluator_set_int64_variable (evaluator, "X", 4);
+	v_int64 = arv_evaluator_evaluate_as_int64 (evaluator, &error);
+	g_assert_cmpint (v_int64, ==, 10);
+	g_assert (error == NULL);
+	v_double = arv_evaluator_evaluate_as_double (evaluator, &error);
+	g_assert_cmpfloat (v_double, ==, 10.0);
+	g_assert (error == NULL);
+
+	arv_evaluator_set_double_variable (evaluator, "X", 1.5);
+	v_int64 = arv_evaluator_evaluate_as_int64 (evaluator, &error);
+	g_assert_cmpint (v_int64, ==, 7);
+	g_assert (error == NULL);
+	v_double = arv_evaluator_evaluate_as_double (evaluator, &error);
+	g_assert_cmpfloat (v_double, ==, 7.5);
+	g_assert (error == NULL);
+
+	/* Constant division by zero must not be folded away */
+
+	arv_evaluator_set_expression (evaluator, "1/0+X");
+
+	arv_evaluator_evaluate_as_double (evaluator, &error);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	arv_evaluator_evaluate_as_int64 (evaluator, &error);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	/* Folding before a round function with precision */
+
+	arv_evaluator_set_expression (evaluator, "2*ROUND(1.26,1)+3*4");
+	v_double = arv_evaluator_evaluate_as_double (evaluator, &error);
+	g_assert_cmpfloat (fabs (v_double - 14.6), <, 1e-9);
+	g_assert (error == NULL);
+
+	g_object_unref (evaluator);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -348,6 +406,7 @@ main (int argc, char *argv[])
 	g_test_add_func ("/evaluator/constant", constant_test);
 	g_test_add_func ("/evaluator/empty", empty_test);
 	g_test_add_func ("/evaluator/error", error_test);
+	g_test_add_func ("/evaluator/compiled-program", compiled_program_test);
 
 	result = g_test_run();
 
@@ -1,5 +1,7 @@
 #include <glib.h>
+#include <glib/gstdio.h>
 #include <arv.h>
+#include <string.h>
 
 static void
 discovery_test (void)
@@ -537,19 +539,19 @@ camera_api_test (void)
 	ptr = arv_camera_dup_available_pixel_formats (camera, &n, &error);
 	g_assert (error == NULL);
 	g_assert (ptr != NULL);
-	g_assert_cmpint (n, ==, 7);
+	g_assert_cmpint (n, ==, 13);
 	g_clear_pointer (&ptr, g_free);
 
 	ptr = arv_camera_dup_available_pixel_formats_as_strings (camera, &n, &error);
 	g_assert (error == NULL);
 	g_assert (ptr != NULL);
-	g_assert_cmpint (n, ==, 7);
+	g_assert_cmpint (n, ==, 13);
 	g_clear_pointer (&ptr, g_free);
 
 	ptr = arv_camera_dup_available_pixel_formats_as_display_names (camera, &n, &error);
 	g_assert (error == NULL);
 	g_assert (ptr != NULL);
-	g_assert_cmpint (n, ==, 7);
+	g_assert_cmpint (n, ==, 13);
 	g_clear_pointer (&ptr, g_free);
 
 	b = arv_camera_is_frame_rate_available (camera, &error);
@@ -727,6 +729,410 @@ set_features_from_string_test (void)
 	g_object_unref (device);
 }
 
+static void
+recorder_test (void)
+{
+	ArvCamera *camera;
+	ArvStream *stream;
+	ArvRecorder *recorder;
+	ArvRecordingReader *reader;
+	ArvFakeCamera *fake_camera;
+	ArvBuffer *buffer;
+	ArvBuffer *missing_buffer;
+	ArvBuffer *replay_buffer;
+	GError *error = NULL;
+	GStatBuf stat_buf;
+	const void *recorded_data;
+	const void *replay_data;
+	size_t recorded_size;
+	size_t replay_size;
+	char *filename;
+	guint64 frame_ids[3];
+	guint64 frame_id;
+	guint64 n_written_frames;
+	guint64 n_written_bytes;
+	gint payload;
+	gboolean success;
+	int fd;
+	int i;
+
+	fd = g_file_open_tmp ("arv-recording-XXXXXX.raw", &filename, &error);
+	g_assert (fd >= 0);
+	g_assert (error == NULL);
+	g_close (fd, NULL);
+
+	camera = arv_camera_new ("Fake_1", &error);
+	g_assert (ARV_IS_CAMERA (camera));
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	recorder = arv_recorder_new (stream, filename, &error);
+	g_assert (ARV_IS_RECORDER (recorder));
+	g_assert (error == NULL);
+
+	payload = arv_camera_get_payload (camera, NULL);
+	for (i = 0; i < 2; i++)
+		arv_stream_push_buffer (stream,  arv_buffer_new (payload, NULL));
+
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_CONTINUOUS, NULL);
+	arv_camera_start_acquisition (camera, NULL);
+	for (i = 0; i < 3; i++) {
+		buffer = arv_stream_pop_buffer (stream);
+		g_assert (ARV_IS_BUFFER (buffer));
+		g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+		frame_ids[i] = arv_buffer_get_frame_id (buffer);
+		arv_recorder_push_buffer (recorder, buffer);
+	}
+	arv_camera_stop_acquisition (camera, NULL);
+
+	success = arv_recorder_close (recorder, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	arv_recorder_get_statistics (recorder, &n_written_frames, &n_written_bytes, NULL, NULL);
+	g_assert_cmpint (n_written_frames, ==, 3);
+	g_assert_cmpint (n_written_bytes, >=, 3 * payload);
+
+	/* The preallocated space is truncated on close */
+	g_assert (g_stat (filename, &stat_buf) == 0);
+	g_assert_cmpint (stat_buf.st_size, >=, n_written_bytes);
+	g_assert_cmpint (stat_buf.st_size, <, n_written_bytes + 256 * 1024 * 1024);
+
+	g_clear_object (&recorder);
+
+	reader = arv_recording_reader_new (filename, &error);
+	g_assert (ARV_IS_RECORDING_READER (reader));
+	g_assert (error == NULL);
+
+	g_assert_cmpint (arv_recording_reader_get_n_frames (reader), ==, 3);
+	g_assert_cmpint (arv_recording_reader_find_frame (reader, frame_ids[1]), ==, 1);
+
+	success = arv_recording_reader_get_frame_infos (reader, 2, &frame_id, NULL, NULL);
+	g_assert (success);
+	g_assert_cmpint (frame_id, ==, frame_ids[2]);
+
+	buffer = arv_recording_reader_get_buffer (reader, 1, &error);
+	g_assert (ARV_IS_BUFFER (buffer));
+	g_assert (error == NULL);
+
+	missing_buffer = arv_recording_reader_get_buffer (reader, 3, &error);
+	g_assert (missing_buffer == NULL);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	/* The buffer keeps the file mapping alive */
+	g_clear_object (&reader);
+
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	g_assert_cmpint (arv_buffer_get_frame_id (buffer), ==, frame_ids[1]);
+	g_assert_cmpint (arv_buffer_get_image_width (buffer), ==, arv_camera_get_integer (camera, "Width", NULL));
+	g_assert_cmpint (arv_buffer_get_image_height (buffer), ==, arv_camera_get_integer (camera, "Height", NULL));
+
+	/* Replay of the recording by a fake camera */
+	fake_camera = arv_fake_camera_new ("TEST0");
+	success = arv_fake_camera_set_replay (fake_camera, filename, FALSE, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	recorded_data = arv_buffer_get_data (buffer, &recorded_size);
+	g_assert_cmpint (arv_fake_camera_get_payload (fake_camera), ==, recorded_size);
+	g_assert_cmpint (arv_fake_camera_get_sleep_time_for_next_frame (fake_camera, NULL), ==, 0);
+
+	replay_buffer = arv_buffer_new (arv_fake_camera_get_payload (fake_camera), NULL);
+	for (i = 0; i < 2; i++)
+		arv_fake_camera_fill_buffer (fake_camera, replay_buffer, NULL);
+
+	g_assert_cmpint (arv_buffer_get_status (replay_buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	g_assert_cmpint (arv_buffer_get_image_width (replay_buffer), ==, arv_buffer_get_image_width (buffer));
+	replay_data = arv_buffer_get_data (replay_buffer, &replay_size);
+	g_assert_cmpint (replay_size, ==, recorded_size);
+	g_assert (memcmp (replay_data, recorded_data, recorded_size) == 0);
+
+	success = arv_fake_camera_set_replay (fake_camera, NULL, FALSE, &error);
+	g_assert (success);
+
+	g_clear_object (&replay_buffer);
+	g_clear_object (&fake_camera);
+
+	g_clear_object (&buffer);
+	g_clear_object (&stream);
+	g_clear_object (&camera);
+
+	g_unlink (filename);
+	g_free (filename);
+}
+
+/* Start of the fake camera jet colormap, from dark blue to cyan */
+
+static void
+_jet_colormap_rgb (unsigned int index, guint8 *rgb)
+{
+	g_assert_cmpint (index, <, 95);
+
+	rgb[0] = 0;
+	rgb[1] = index < 32 ? 0 : 4 * (index - 31);
+	rgb[2] = index < 31 ? 132 + 4 * index : 255;
+}
+
+static void
+_jet_colormap_yuv (unsigned int index, guint8 *y, guint8 *u, guint8 *v)
+{
+	guint8 rgb[3];
+
+	_jet_colormap_rgb (index, rgb);
+
+	*y = CLAMP (0.299 * rgb[0] + 0.587 * rgb[1] + 0.114 * rgb[2] + 0.5, 0, 255);
+	*u = CLAMP (128.5 - 0.168736 * rgb[0] - 0.331264 * rgb[1] + 0.5 * rgb[2], 0, 255);
+	*v = CLAMP (128.5 + 0.5 * rgb[0] - 0.418688 * rgb[1] - 0.081312 * rgb[2], 0, 255);
+}
+
+/* Returns the nth pixel of a packed frame */
+
+static guint16
+_unpack_pixel (ArvPixelFormat pixel_format, const guint8 *data, guint32 n)
+{
+	const guint8 *group;
+	guint32 bit;
+
+	switch (pixel_format) {
+		case ARV_PIXEL_FORMAT_MONO_10P:
+			bit = 10 * n;
+			return ((data[bit / 8] | data[bit / 8 + 1] << 8) >> (bit % 8)) & 0x3ff;
+		case ARV_PIXEL_FORMAT_MONO_12P:
+			bit = 12 * n;
+			return ((data[bit / 8] | data[bit / 8 + 1] << 8) >> (bit % 8)) & 0xfff;
+		case ARV_PIXEL_FORMAT_MONO_10_PACKED:
+			group = &data[3 * (n / 2)];
+			return n % 2 == 0 ?
+				group[0] << 2 | (group[1] & 0x03) :
+				group[2] << 2 | ((group[1] >> 4) & 0x03);
+		case ARV_PIXEL_FORMAT_MONO_12_PACKED:
+			group = &data[3 * (n / 2)];
+			return n % 2 == 0 ?
+				group[0] << 4 | (group[1] & 0x0f) :
+				group[2] << 4 | group[1] >> 4;
+		default:
+			g_assert_not_reached ();
+	}
+
+	return 0;
+}
+
+static void
+diagonal_ramp_test (void)
+{
+	static const struct {
+		ArvPixelFormat pixel_format;
+		guint depth;
+		guint pixel_group;
+	} packed_formats[] = {
+		{ARV_PIXEL_FORMAT_MONO_10P,		10, 4},
+		{ARV_PIXEL_FORMAT_MONO_12P,		12, 2},
+		{ARV_PIXEL_FORMAT_MONO_10_PACKED,	10, 2},
+		{ARV_PIXEL_FORMAT_MONO_12_PACKED,	12, 2}
+	};
+	static const ArvPixelFormat yuv_formats[] = {
+		ARV_PIXEL_FORMAT_YUV_422_PACKED,
+		ARV_PIXEL_FORMAT_YUV_422_YUYV_PACKED
+	};
+	ArvFakeCamera *fake_camera;
+	ArvBuffer *buffer;
+	const guint8 *data;
+	size_t size;
+	guint64 frame_id;
+	guint32 width = 67;
+	guint32 height = 13;
+	guint32 x, y;
+	int i;
+
+	fake_camera = arv_fake_camera_new ("TEST0");
+	g_assert (ARV_IS_FAKE_CAMERA (fake_camera));
+
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_WIDTH, width);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_HEIGHT, height);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT, ARV_PIXEL_FORMAT_MONO_8);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_EXPOSURE_TIME_US, 10000);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_GAIN_RAW, 0);
+
+	buffer = arv_buffer_new (3 * width * height, NULL);
+
+	/* Unit scale, the ramp is shifted by one pixel at each frame */
+	for (i = 0; i < 3; i++) {
+		arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+		g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+
+		frame_id = arv_buffer_get_frame_id (buffer);
+		data = arv_buffer_get_data (buffer, &size);
+		g_assert_cmpint (size, ==, width * height);
+
+		for (y = 0; y < height; y++)
+			for (x = 0; x < width; x++)
+				g_assert_cmpint (data[y * width + x], ==, (x + y + frame_id) % 255);
+	}
+
+	/* The ramp is rebuilt on exposure change */
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_EXPOSURE_TIME_US, 100000);
+	arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+	frame_id = arv_buffer_get_frame_id (buffer);
+	data = arv_buffer_get_data (buffer, &size);
+	for (y = 0; y < height; y++)
+		for (x = 0; x < width; x++)
+			g_assert_cmpint (data[y * width + x], ==, MIN (2 * ((x + y + frame_id) % 255), 255));
+
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_EXPOSURE_TIME_US, 10000);
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT, ARV_PIXEL_FORMAT_MONO_16);
+	arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+	frame_id = arv_buffer_get_frame_id (buffer);
+	data = arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, 2 * width * height);
+	for (y = 0; y < height; y++)
+		for (x = 0; x < width; x++)
+			g_assert_cmpint (((guint16 *) data)[y * width + x], ==, (256 * (x + y + frame_id)) % 65535);
+
+	/* Packed format, with rows not aligned on the pixel pairs */
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT, ARV_PIXEL_FORMAT_MONO_12P);
+	arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+	frame_id = arv_buffer_get_frame_id (buffer);
+	data = arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, width * height * 12 / 8);
+	for (i = 0; i < 2; i++) {
+		guint16 value = i == 0 ? data[0] | (data[1] & 0x0f) << 8 : data[1] >> 4 | data[2] << 4;
+
+		g_assert_cmpint (value, ==, ((256 * (i + frame_id)) % 65535) >> 4);
+	}
+	/* With an odd width, the second row starts with the second pixel of a pair */
+	g_assert_cmpint (data[3 * width / 2] >> 4 | data[3 * width / 2 + 1] << 4, ==, ((256 * (1 + frame_id)) % 65535) >> 4);
+
+	/* First pixel group of the first two rows of the packed formats */
+	for (i = 0; i < G_N_ELEMENTS (packed_formats); i++) {
+		guint32 n;
+
+		arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT,
+						packed_formats[i].pixel_format);
+		arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+		g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+		frame_id = arv_buffer_get_frame_id (buffer);
+		data = arv_buffer_get_data (buffer, &size);
+		g_assert_cmpint (size, ==,
+				 width * height * ARV_PIXEL_FORMAT_BIT_PER_PIXEL (packed_formats[i].pixel_format) / 8);
+
+		for (y = 0; y < 2; y++) {
+			for (x = 0; x < packed_formats[i].pixel_group; x++) {
+				n = y * width + x;
+				g_assert_cmpint (_unpack_pixel (packed_formats[i].pixel_format, data, n), ==,
+						 ((256 * (x + y + frame_id)) % 65535) >> (16 - packed_formats[i].depth));
+			}
+		}
+	}
+
+	/* The pixel pairs share the chroma of the even pixel */
+	for (i = 0; i < G_N_ELEMENTS (yuv_formats); i++) {
+		arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT, yuv_formats[i]);
+		arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+		g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+		frame_id = arv_buffer_get_frame_id (buffer);
+		data = arv_buffer_get_data (buffer, &size);
+		g_assert_cmpint (size, ==, 2 * width * height);
+
+		for (y = 0; y < 2; y++) {
+			for (x = 0; x < 2; x++) {
+				const guint8 *pixel = &data[2 * (y * width + x)];
+				guint8 luma, even_luma, u, v;
+
+				_jet_colormap_yuv ((x + y + frame_id) % 255, &luma, &u, &v);
+				_jet_colormap_yuv ((y + frame_id) % 255, &even_luma, &u, &v);
+
+				if (yuv_formats[i] == ARV_PIXEL_FORMAT_YUV_422_PACKED) {
+					g_assert_cmpint (pixel[0], ==, x == 0 ? u : v);
+					g_assert_cmpint (pixel[1], ==, luma);
+				} else {
+					g_assert_cmpint (pixel[0], ==, luma);
+					g_assert_cmpint (pixel[1], ==, x == 0 ? u : v);
+				}
+			}
+		}
+	}
+
+	/* Color formats, checked against the per pixel formula, for the pixels in the known part of the colormap */
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT,
+					ARV_PIXEL_FORMAT_RGB_8_PACKED);
+	arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	frame_id = arv_buffer_get_frame_id (buffer);
+	data = arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, 3 * width * height);
+	for (y = 0; y < height; y++) {
+		for (x = 0; x < width; x++) {
+			unsigned int index = (x + y + frame_id) % 255;
+			guint8 rgb[3];
+
+			if (index >= 95)
+				continue;
+
+			_jet_colormap_rgb (index, rgb);
+			g_assert_cmpint (data[3 * (y * width + x)], ==, rgb[0]);
+			g_assert_cmpint (data[3 * (y * width + x) + 1], ==, rgb[1]);
+			g_assert_cmpint (data[3 * (y * width + x) + 2], ==, rgb[2]);
+		}
+	}
+
+	arv_fake_camera_write_register (fake_camera, ARV_FAKE_CAMERA_REGISTER_PIXEL_FORMAT,
+					ARV_PIXEL_FORMAT_BAYER_RG_8);
+	arv_fake_camera_fill_buffer (fake_camera, buffer, NULL);
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	frame_id = arv_buffer_get_frame_id (buffer);
+	data = arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, width * height);
+	for (y = 0; y < height; y++) {
+		for (x = 0; x < width; x++) {
+			unsigned int index = (x + y + frame_id) % 255;
+			guint8 rgb[3];
+			guint channel;
+
+			if (index >= 95)
+				continue;
+
+			_jet_colormap_rgb (index, rgb);
+			if (x & 1)
+				channel = (y & 1) ? 0 : 1;
+			else
+				channel = (y & 1) ? 1 : 2;
+			g_assert_cmpint (data[y * width + x], ==, rgb[channel]);
+		}
+	}
+
+	g_clear_object (&buffer);
+	g_clear_object (&fake_camera);
+}
+
+static void
+open_devices_test (void)
+{
+	const char *device_ids[] = {"Fake_1", "Fake_1", "Fake_1", "Fake_1"};
+	ArvDevice *devices[G_N_ELEMENTS (device_ids)];
+	gint64 durations_us[G_N_ELEMENTS (device_ids)];
+	GError *error = NULL;
+	gboolean success;
+	unsigned int i;
+
+	success = arv_open_devices (G_N_ELEMENTS (device_ids), device_ids, devices, durations_us, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	for (i = 0; i < G_N_ELEMENTS (device_ids); i++) {
+		g_assert (ARV_IS_FAKE_DEVICE (devices[i]));
+		g_assert_cmpint (durations_us[i], >=, 0);
+		if (i > 0)
+			g_assert (devices[i] != devices[i - 1]);
+	}
+
+	for (i = 0; i < G_N_ELEMENTS (device_ids); i++)
+		g_object_unref (devices[i]);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -740,6 +1146,8 @@ main (int argc, char *argv[])
 
 	arv_update_device_list ();
 
+	/* Must be the first test creating a Genicam document */
+	g_test_add_func ("/fake/open-devices", open_devices_test);
 	g_test_add_func ("/fake/discovery-test", discovery_test);
 	g_test_add_func ("/fake/trigger-registers", trigger_registers_test);
 	g_test_add_func ("/fake/registers", registers_test);
@@ -750,6 +1158,8 @@ main (int argc, char *argv[])
 	g_test_add_func ("/fake/camera-device", camera_device_test);
 	g_test_add_func ("/fake/camera-trigger-selector", camera_trigger_selector_test);
 	g_test_add_func ("/fake/set-features-from-string", set_features_from_string_test);
+	g_test_add_func ("/fake/recorder", recorder_test);
+	g_test_add_func ("/fake/diagonal-ramp", diagonal_ramp_test);
 
 	result = g_test_run();
 
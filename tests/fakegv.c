@@ -1,7 +1,15 @@
 #include <glib.h>
 #include <arv.h>
+#include <arvgvspprivate.h>
+#include <arvgvcpprivate.h>
+#include <arvgvstreamprivate.h>
+#include <arvgvfakeimpairmentprivate.h>
+#include <arvgvfakecameraprivate.h>
+#include <string.h>
+#include <glib/gstdio.h>
 
 static ArvCamera *camera = NULL;
+static ArvGvFakeCamera *simulator = NULL;
 
 static void
 discovery_test (void)
@@ -24,6 +32,91 @@ discovery_test (void)
         g_assert_not_reached ();
 }
 
+static void
+background_discovery_device_removed_cb (ArvInterface *interface, const char *device_id, gpointer user_data)
+{
+	if (g_strcmp0 (device_id, "Aravis-Fake-GVTest") == 0)
+		(*((int *) user_data))++;
+}
+
+typedef struct {
+	GMainLoop *main_loop;
+	int n_added;
+} BackgroundDiscoveryData;
+
+static void
+background_discovery_device_added_cb (ArvInterface *interface, const char *device_id, gpointer user_data)
+{
+	BackgroundDiscoveryData *data = user_data;
+
+	if (g_strcmp0 (device_id, "Aravis-Fake-GVDiscovery") == 0) {
+		data->n_added++;
+		g_main_loop_quit (data->main_loop);
+	}
+}
+
+static gboolean
+background_discovery_timeout_cb (gpointer user_data)
+{
+	g_main_loop_quit (user_data);
+
+	return G_SOURCE_REMOVE;
+}
+
+static void
+background_discovery_test (void)
+{
+	ArvInterface *interface;
+	ArvGvFakeCamera *new_simulator;
+	BackgroundDiscoveryData data = {0};
+	gint64 start_time;
+	int n_removed = 0;
+	gulong removed_handler_id;
+	gulong added_handler_id;
+	guint timeout_id;
+
+	interface = arv_gv_interface_get_instance ();
+	removed_handler_id = g_signal_connect (interface, "device-removed",
+					       G_CALLBACK (background_discovery_device_removed_cb), &n_removed);
+	added_handler_id = g_signal_connect (interface, "device-added",
+					     G_CALLBACK (background_discovery_device_added_cb), &data);
+
+	arv_start_device_discovery (100);
+
+	/* A camera appearing while the discovery runs */
+	new_simulator = arv_gv_fake_camera_new ("127.0.0.3", "GVDiscovery");
+	g_assert (arv_gv_fake_camera_is_running (new_simulator));
+
+	data.main_loop = g_main_loop_new (NULL, FALSE);
+	timeout_id = g_timeout_add (10000, background_discovery_timeout_cb, data.main_loop);
+	g_main_loop_run (data.main_loop);
+	if (data.n_added > 0)
+		g_source_remove (timeout_id);
+
+	g_assert_cmpint (data.n_added, ==, 1);
+
+	/* Let a few more discovery rounds run */
+	g_timeout_add (2500, background_discovery_timeout_cb, data.main_loop);
+	g_main_loop_run (data.main_loop);
+	g_main_loop_unref (data.main_loop);
+
+	/* The device list is updated from the background discovery table, without waiting for answers */
+	start_time = g_get_monotonic_time ();
+	arv_update_device_list ();
+	g_assert_cmpint (g_get_monotonic_time () - start_time, <, 500000);
+
+	discovery_test ();
+
+	arv_stop_device_discovery ();
+
+	g_assert_cmpint (n_removed, ==, 0);
+
+	g_signal_handler_disconnect (interface, removed_handler_id);
+	g_signal_handler_disconnect (interface, added_handler_id);
+
+	g_object_unref (new_simulator);
+}
+
 static void
 register_test (void)
 {
@@ -84,6 +177,275 @@ register_test (void)
 	g_assert_cmpint (int_value, ==, 321);
 }
 
+static void
+register_batch_test (void)
+{
+	ArvDevice *device;
+	GError *error = NULL;
+	guint64 addresses[2] = {ARV_FAKE_CAMERA_REGISTER_WIDTH, ARV_FAKE_CAMERA_REGISTER_HEIGHT};
+	guint32 values[2] = {256, 128};
+	guint32 read_values[2] = {0, 0};
+	gboolean success;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	/* Multiple register commands */
+	success = arv_device_write_registers (device, addresses, values, 2, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	success = arv_device_read_registers (device, addresses, read_values, 2, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+	g_assert_cmpint (read_values[0], ==, 256);
+	g_assert_cmpint (read_values[1], ==, 128);
+
+	/* Batched writes are flushed before any read */
+	arv_device_begin_batch (device);
+	arv_device_write_register (device, ARV_FAKE_CAMERA_REGISTER_WIDTH, 512, &error);
+	g_assert (error == NULL);
+	success = arv_device_read_registers (device, addresses, read_values, 1, &error);
+	g_assert (success);
+	g_assert_cmpint (read_values[0], ==, 512);
+	success = arv_device_end_batch (device, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	/* Restore the values expected by the other tests, with batched Genicam feature writes */
+	success = arv_device_set_features_from_string (device, "Width=1024 Height=1024", &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	success = arv_device_read_registers (device, addresses, read_values, 2, &error);
+	g_assert (success);
+	g_assert_cmpint (read_values[0], ==, 1024);
+	g_assert_cmpint (read_values[1], ==, 1024);
+}
+
+static void
+register_prefetch_test (void)
+{
+	ArvDevice *device;
+	GError *error = NULL;
+	const char *features[] = {"Width", "Height", "OffsetX", "OffsetY"};
+	guint64 addresses[4] = {ARV_FAKE_CAMERA_REGISTER_WIDTH, ARV_FAKE_CAMERA_REGISTER_HEIGHT,
+		ARV_FAKE_CAMERA_REGISTER_X_OFFSET, ARV_FAKE_CAMERA_REGISTER_Y_OFFSET};
+	guint32 values[4];
+	guint32 modified_values[4];
+	gboolean success;
+	unsigned i;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	success = arv_device_read_registers (device, addresses, values, 4, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	arv_device_set_register_cache_policy (device, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	/* The two register pairs are read by a multi register command */
+	arv_gc_prefetch_features (arv_device_get_genicam (device), features, G_N_ELEMENTS (features));
+
+	/* Modify the registers behind the cache, the features must keep the prefetched values */
+	for (i = 0; i < 4; i++)
+		modified_values[i] = values[i] + 2;
+	success = arv_device_write_registers (device, addresses, modified_values, 4, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+
+	for (i = 0; i < 4; i++) {
+		g_assert_cmpint (arv_device_get_integer_feature_value (device, features[i], &error), ==, values[i]);
+		g_assert (error == NULL);
+	}
+
+	arv_device_set_register_cache_policy (device, ARV_REGISTER_CACHE_POLICY_DEFAULT);
+
+	success = arv_device_write_registers (device, addresses, values, 4, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+}
+
+static void
+read_memory_test (void)
+{
+	ArvDevice *device;
+	ArvFakeCamera *fake_camera;
+	GError *error = NULL;
+	const char *genicam_xml;
+	size_t genicam_xml_size;
+	char *data;
+	gboolean success;
+	guint window_size;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_GV_DEVICE (device));
+
+	fake_camera = arv_gv_fake_camera_get_fake_camera (simulator);
+	genicam_xml = arv_fake_camera_get_genicam_xml (fake_camera, &genicam_xml_size);
+	g_assert (genicam_xml != NULL);
+
+	/* Pipelining is opt-in */
+	g_object_get (device, "gvcp-window-size", &window_size, NULL);
+	g_assert_cmpint (window_size, ==, 1);
+
+	/* Larger than the command window, with a partial last block */
+	g_assert_cmpint (genicam_xml_size, >, 4 * 512);
+
+	data = g_malloc (genicam_xml_size);
+
+	success = arv_device_read_memory (device, ARV_FAKE_CAMERA_MEMORY_SIZE, genicam_xml_size, data, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+	g_assert (memcmp (data, genicam_xml, genicam_xml_size) == 0);
+
+	g_object_set (device, "gvcp-window-size", 4, NULL);
+
+	memset (data, 0, genicam_xml_size);
+	success = arv_device_read_memory (device, ARV_FAKE_CAMERA_MEMORY_SIZE, genicam_xml_size, data, &error);
+	g_assert (success);
+	g_assert (error == NULL);
+	g_assert (memcmp (data, genicam_xml, genicam_xml_size) == 0);
+
+	g_object_get (device, "gvcp-window-size", &window_size, NULL);
+	g_assert_cmpint (window_size, ==, 4);
+
+	g_object_set (device, "gvcp-window-size", 1, NULL);
+
+	g_free (data);
+}
+
+typedef struct {
+	GMainLoop *loop;
+	guint n_pending;
+	guint32 register_value;
+	gint64 width;
+	gboolean width_set;
+	char *vendor_name;
+	gboolean memory_read;
+	GError *error;
+} AsyncTestData;
+
+static void
+_async_test_done (AsyncTestData *data)
+{
+	data->n_pending--;
+	if (data->n_pending == 0)
+		g_main_loop_quit (data->loop);
+}
+
+static void
+_async_read_register_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	AsyncTestData *data = user_data;
+
+	arv_device_read_register_finish (ARV_DEVICE (source), result, &data->register_value,
+					 data->error == NULL ? &data->error : NULL);
+	_async_test_done (data);
+}
+
+static void
+_async_read_memory_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	AsyncTestData *data = user_data;
+
+	data->memory_read = arv_device_read_memory_finish (ARV_DEVICE (source), result,
+							   data->error == NULL ? &data->error : NULL);
+	_async_test_done (data);
+}
+
+static void
+_async_set_width_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	AsyncTestData *data = user_data;
+
+	data->width_set = arv_device_set_integer_feature_value_finish (ARV_DEVICE (source), result,
+								       data->error == NULL ? &data->error : NULL);
+	_async_test_done (data);
+}
+
+static void
+_async_get_width_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	AsyncTestData *data = user_data;
+
+	data->width = arv_device_get_integer_feature_value_finish (ARV_DEVICE (source), result,
+								   data->error == NULL ? &data->error : NULL);
+	_async_test_done (data);
+}
+
+static void
+_async_get_vendor_cb (GObject *source, GAsyncResult *result, gpointer user_data)
+{
+	AsyncTestData *data = user_data;
+
+	data->vendor_name = arv_device_get_string_feature_value_finish (ARV_DEVICE (source), result,
+									data->error == NULL ? &data->error : NULL);
+	_async_test_done (data);
+}
+
+static void
+async_test (void)
+{
+	ArvDevice *device;
+	AsyncTestData data = {0};
+	guint8 memory[3 * ARV_GVCP_DATA_SIZE_MAX / 2];
+	guint8 async_memory[3 * ARV_GVCP_DATA_SIZE_MAX / 2];
+	gboolean success;
+
+	device = arv_camera_get_device (camera);
+	g_assert (ARV_IS_DEVICE (device));
+
+	data.loop = g_main_loop_new (NULL, FALSE);
+
+	/* Operations are executed in order */
+	arv_device_set_integer_feature_value_async (device, "Width", 512, NULL, _async_set_width_cb, &data);
+	arv_device_read_register_async (device, ARV_FAKE_CAMERA_REGISTER_WIDTH, NULL,
+					_async_read_register_cb, &data);
+	arv_device_get_integer_feature_value_async (device, "Width", NULL, _async_get_width_cb, &data);
+	arv_device_get_string_feature_value_async (device, "DeviceVendorName", NULL, _async_get_vendor_cb, &data);
+	data.n_pending = 4;
+
+	g_main_loop_run (data.loop);
+
+	g_assert (data.error == NULL);
+	g_assert (data.width_set);
+	g_assert_cmpint (data.register_value, ==, 512);
+	g_assert_cmpint (data.width, ==, 512);
+	g_assert_cmpstr (data.vendor_name, ==, "Aravis");
+
+	data.n_pending = 1;
+	arv_device_set_integer_feature_value_async (device, "Width", 1024, NULL, _async_set_width_cb, &data);
+	g_main_loop_run (data.loop);
+
+	g_assert (data.error == NULL);
+
+	/* Errors are reported by the finish functions */
+	data.n_pending = 1;
+	arv_device_get_integer_feature_value_async (device, "Unknown", NULL, _async_get_width_cb, &data);
+	g_main_loop_run (data.loop);
+
+	g_assert (data.error != NULL);
+	g_clear_error (&data.error);
+
+	/* Memory operations larger than a GVCP packet are split */
+	success = arv_device_read_memory (device, 0, sizeof (memory), memory, NULL);
+	g_assert (success);
+
+	data.n_pending = 1;
+	arv_device_read_memory_async (device, 0, sizeof (async_memory), async_memory, NULL,
+				      _async_read_memory_cb, &data);
+	g_main_loop_run (data.loop);
+
+	g_assert (data.error == NULL);
+	g_assert (data.memory_read);
+	g_assert (memcmp (memory, async_memory, sizeof (memory)) == 0);
+
+	g_free (data.vendor_name);
+	g_main_loop_unref (data.loop);
+}
+
 static void
 acquisition_test (void)
 {
@@ -179,6 +541,460 @@ stream_test (void)
 	g_usleep (2000000);
 }
 
+static void
+high_rate_test (void)
+{
+	ArvStream *stream;
+	GError *error = NULL;
+	size_t payload;
+	guint64 last_frame_id = 0;
+	unsigned n_completed = 0;
+	unsigned i;
+
+	g_object_set (simulator, "gvsp-high-rate", TRUE, "gvsp-bit-rate", 1e9, NULL);
+	arv_camera_gv_set_packet_delay (camera, 1000, &error);
+	g_assert (error == NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	payload = arv_camera_get_payload (camera, NULL);
+
+	for (i = 0; i < 5; i++)
+		arv_stream_push_buffer (stream, arv_buffer_new (payload, NULL));
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < 10; i++) {
+		ArvBuffer *buffer;
+
+		buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+
+		if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+			g_assert_cmpint (arv_buffer_get_image_width (buffer), ==, 1024);
+			g_assert_cmpint (arv_buffer_get_frame_id (buffer), !=, last_frame_id);
+			last_frame_id = arv_buffer_get_frame_id (buffer);
+			n_completed++;
+		}
+
+		arv_stream_push_buffer (stream, buffer);
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	g_assert_cmpint (n_completed, >, 0);
+
+	g_clear_object (&stream);
+
+	arv_camera_gv_set_packet_delay (camera, 0, NULL);
+	g_object_set (simulator, "gvsp-high-rate", FALSE, "gvsp-bit-rate", 0.0, NULL);
+}
+
+/* Returns the first successfully received buffer of a short acquisition */
+
+static ArvBuffer *
+_acquire_buffer (ArvCamera *acquisition_camera)
+{
+	ArvStream *stream;
+	ArvBuffer *buffer = NULL;
+	GError *error = NULL;
+	size_t payload;
+	unsigned i;
+
+	stream = arv_camera_create_stream (acquisition_camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	payload = arv_camera_get_payload (acquisition_camera, NULL);
+
+	for (i = 0; i < 5; i++)
+		arv_stream_push_buffer (stream, arv_buffer_new (payload, NULL));
+
+	arv_camera_start_acquisition (acquisition_camera, NULL);
+
+	for (i = 0; i < 10 && buffer == NULL; i++) {
+		buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+
+		if (arv_buffer_get_status (buffer) != ARV_BUFFER_STATUS_SUCCESS) {
+			arv_stream_push_buffer (stream, buffer);
+			buffer = NULL;
+		}
+	}
+
+	arv_camera_stop_acquisition (acquisition_camera, NULL);
+
+	g_clear_object (&stream);
+
+	g_assert (ARV_IS_BUFFER (buffer));
+
+	return buffer;
+}
+
+static void
+stream_format_test (void)
+{
+	ArvChunkParser *parser;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	const void *part_0_data;
+	size_t part_0_size;
+	int width, height;
+	unsigned i, j;
+
+	arv_camera_get_region (camera, NULL, NULL, &width, &height, &error);
+	g_assert (error == NULL);
+
+	/* GVSP 2.0 extended ids */
+	arv_camera_set_boolean (camera, "GevGVSPExtendedIDMode", TRUE, &error);
+	g_assert (error == NULL);
+
+	buffer = _acquire_buffer (camera);
+	g_assert_cmpint (arv_buffer_get_payload_type (buffer), ==, ARV_BUFFER_PAYLOAD_TYPE_IMAGE);
+	g_assert_cmpint (arv_buffer_get_image_width (buffer), ==, width);
+	g_assert_cmpint (arv_buffer_get_image_height (buffer), ==, height);
+	g_object_unref (buffer);
+
+	arv_camera_set_boolean (camera, "GevGVSPExtendedIDMode", FALSE, &error);
+	g_assert (error == NULL);
+
+	/* Image followed by chunk data */
+	arv_camera_set_chunks (camera, "Width,Height", &error);
+	g_assert (error == NULL);
+
+	parser = arv_camera_create_chunk_parser (camera);
+	g_assert (ARV_IS_CHUNK_PARSER (parser));
+
+	buffer = _acquire_buffer (camera);
+	g_assert_cmpint (arv_buffer_get_payload_type (buffer), ==, ARV_BUFFER_PAYLOAD_TYPE_EXTENDED_CHUNK_DATA);
+	g_assert (arv_buffer_has_chunks (buffer));
+	g_assert_cmpint (arv_buffer_get_image_width (buffer), ==, width);
+	g_assert_cmpint (arv_chunk_parser_get_integer_value (parser, buffer, "ChunkWidth", &error), ==, width);
+	g_assert (error == NULL);
+	g_assert_cmpint (arv_chunk_parser_get_integer_value (parser, buffer, "ChunkHeight", &error), ==, height);
+	g_assert (error == NULL);
+	g_object_unref (buffer);
+
+	g_object_unref (parser);
+
+	arv_camera_set_chunks (camera, NULL, &error);
+	g_assert (error == NULL);
+
+	/* Multipart, which implies extended ids, through the standard and the high rate senders */
+	arv_camera_set_boolean (camera, "GevSCCFGMultiPartEnabled", TRUE, &error);
+	g_assert (error == NULL);
+	arv_camera_set_integer (camera, "MultipartPartCount", 3, &error);
+	g_assert (error == NULL);
+
+	for (j = 0; j < 2; j++) {
+		g_object_set (simulator, "gvsp-high-rate", j == 1, NULL);
+
+		buffer = _acquire_buffer (camera);
+		g_assert_cmpint (arv_buffer_get_payload_type (buffer), ==, ARV_BUFFER_PAYLOAD_TYPE_MULTIPART);
+		g_assert_cmpint (arv_buffer_get_n_parts (buffer), ==, 3);
+
+		part_0_data = arv_buffer_get_part_data (buffer, 0, &part_0_size);
+		g_assert_cmpint (part_0_size, ==, arv_camera_get_payload (camera, NULL) / 3);
+
+		for (i = 0; i < 3; i++) {
+			const void *part_data;
+			size_t part_size;
+
+			g_assert_cmpint (arv_buffer_get_part_width (buffer, i), ==, width);
+			g_assert_cmpint (arv_buffer_get_part_height (buffer, i), ==, height);
+
+			part_data = arv_buffer_get_part_data (buffer, i, &part_size);
+			g_assert_cmpint (part_size, ==, part_0_size);
+			g_assert (memcmp (part_data, part_0_data, part_size) == 0);
+		}
+
+		g_object_unref (buffer);
+	}
+
+	g_object_set (simulator, "gvsp-high-rate", FALSE, NULL);
+
+	arv_camera_set_boolean (camera, "GevSCCFGMultiPartEnabled", FALSE, &error);
+	g_assert (error == NULL);
+}
+
+#define IMPAIRMENT_N_PACKETS	1000
+#define IMPAIRMENT_PACKET_SIZE	64
+
+static GArray *
+impair_packets (const ArvGvFakeImpairmentSettings *settings, guint8 *packets, ArvGvFakeImpairmentCounters *counters)
+{
+	ArvGvFakeImpairment *impairment;
+	GArray *output;
+	unsigned int i;
+
+	impairment = arv_gv_fake_impairment_new (settings);
+	output = g_array_new (FALSE, FALSE, sizeof (guint32));
+
+	for (i = 0; i < IMPAIRMENT_N_PACKETS; i++) {
+		guint8 **output_packets;
+		guint32 *output_sizes;
+		guint n_output_packets;
+		unsigned int j;
+
+		arv_gv_fake_impairment_push (impairment, packets + i * IMPAIRMENT_PACKET_SIZE, IMPAIRMENT_PACKET_SIZE);
+		if (i == IMPAIRMENT_N_PACKETS - 1)
+			arv_gv_fake_impairment_flush (impairment);
+
+		/* Record the block id and the size of the output packets */
+		n_output_packets = arv_gv_fake_impairment_get_output (impairment, &output_packets, &output_sizes);
+		for (j = 0; j < n_output_packets; j++) {
+			ArvGvspHeader *header = (ArvGvspHeader *) &((ArvGvspPacket *) output_packets[j])->header;
+			guint32 value;
+
+			value = g_ntohl (header->packet_infos) & 0xffffff;
+			g_array_append_val (output, value);
+			g_array_append_val (output, output_sizes[j]);
+		}
+		arv_gv_fake_impairment_clear_output (impairment);
+	}
+
+	arv_gv_fake_impairment_get_counters (impairment, counters);
+	arv_gv_fake_impairment_free (impairment);
+
+	return output;
+}
+
+static gboolean
+_is_device_listed (const char *serial_nbr)
+{
+	unsigned int n_devices;
+	unsigned int i;
+
+	n_devices = arv_get_n_devices ();
+	for (i = 0; i < n_devices; i++)
+		if (g_strcmp0 (arv_get_device_serial_nbr (i), serial_nbr) == 0)
+			return TRUE;
+
+	return FALSE;
+}
+
+static void
+sender_pool_test (void)
+{
+	ArvGvFakeCamera *simulators[2];
+	ArvGvFakeCameraPool *pool;
+	ArvCamera *pool_camera;
+	ArvCamera *cameras[2];
+	ArvStream *streams[2];
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	unsigned int n_completed[2] = {0, 0};
+	unsigned int i, j;
+
+	simulators[0] = simulator;
+	simulators[1] = arv_gv_fake_camera_new ("127.0.0.2", "GVPool");
+	g_assert (arv_gv_fake_camera_is_running (simulators[1]));
+
+	pool_camera = arv_camera_new ("127.0.0.2", &error);
+	g_assert (ARV_IS_CAMERA (pool_camera));
+	g_assert (error == NULL);
+
+	arv_camera_set_acquisition_mode (camera, ARV_ACQUISITION_MODE_CONTINUOUS, NULL);
+	arv_camera_set_acquisition_mode (pool_camera, ARV_ACQUISITION_MODE_CONTINUOUS, NULL);
+
+	/* Both cameras served by a single thread */
+	pool = arv_gv_fake_camera_pool_new (simulators, 2, 1);
+	g_assert (pool != NULL);
+
+	buffer = _acquire_buffer (camera);
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	g_clear_object (&buffer);
+
+	buffer = _acquire_buffer (pool_camera);
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	g_clear_object (&buffer);
+
+	g_assert_cmpint (arv_camera_get_integer (pool_camera, "Width", &error), >, 0);
+	g_assert (error == NULL);
+
+	/* The pool thread answers the discovery requests of both cameras */
+	arv_update_device_list ();
+	g_assert_true (_is_device_listed ("GVTest"));
+	g_assert_true (_is_device_listed ("GVPool"));
+
+	/* Simultaneous acquisitions on both cameras */
+	cameras[0] = camera;
+	cameras[1] = pool_camera;
+	for (i = 0; i < 2; i++) {
+		size_t payload;
+
+		streams[i] = arv_camera_create_stream (cameras[i], NULL, NULL, &error);
+		g_assert (ARV_IS_STREAM (streams[i]));
+		g_assert (error == NULL);
+
+		payload = arv_camera_get_payload (cameras[i], NULL);
+		for (j = 0; j < 5; j++)
+			arv_stream_push_buffer (streams[i], arv_buffer_new (payload, NULL));
+	}
+
+	for (i = 0; i < 2; i++)
+		arv_camera_start_acquisition (cameras[i], NULL);
+
+	for (j = 0; j < 20 && (n_completed[0] < 2 || n_completed[1] < 2); j++) {
+		for (i = 0; i < 2; i++) {
+			if (n_completed[i] >= 2)
+				continue;
+
+			buffer = arv_stream_timeout_pop_buffer (streams[i], 2000000);
+			g_assert (ARV_IS_BUFFER (buffer));
+			if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS)
+				n_completed[i]++;
+			arv_stream_push_buffer (streams[i], buffer);
+		}
+	}
+
+	for (i = 0; i < 2; i++) {
+		arv_camera_stop_acquisition (cameras[i], NULL);
+		g_clear_object (&streams[i]);
+	}
+
+	g_assert_cmpint (n_completed[0], ==, 2);
+	g_assert_cmpint (n_completed[1], ==, 2);
+
+	/* Back to one thread per camera */
+	arv_gv_fake_camera_pool_free (pool);
+
+	buffer = _acquire_buffer (pool_camera);
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	g_clear_object (&buffer);
+
+	g_object_unref (pool_camera);
+	g_object_unref (simulators[1]);
+}
+
+static void
+impairment_test (void)
+{
+	ArvGvFakeImpairmentSettings settings;
+	ArvGvFakeImpairmentCounters counters_a, counters_b;
+	GError *error = NULL;
+	GArray *output_a, *output_b;
+	guint8 *packets;
+	unsigned int i;
+
+	g_assert_false (arv_gv_fake_impairment_settings_parse (&settings, "loss=2", &error));
+	g_clear_error (&error);
+	g_assert_false (arv_gv_fake_impairment_settings_parse (&settings, "loss", &error));
+	g_clear_error (&error);
+	g_assert_false (arv_gv_fake_impairment_settings_parse (&settings, "jitter=1", &error));
+	g_clear_error (&error);
+
+	g_assert_true (arv_gv_fake_impairment_settings_parse (&settings, "", NULL));
+	g_assert_true (arv_gv_fake_impairment_settings_is_null (&settings));
+
+	g_assert_true (arv_gv_fake_impairment_settings_parse (&settings,
+							      "seed=42, loss=0.01, burst-start=0.01, burst-end=0.3,"
+							      "reorder=0.05, reorder-window=4, duplicate=0.02,"
+							      "truncate=0.02, leader-delay=3, resend-latency=100",
+							      &error));
+	g_assert_no_error (error);
+	g_assert_false (arv_gv_fake_impairment_settings_is_null (&settings));
+	g_assert_cmpint (settings.seed, ==, 42);
+	g_assert_cmpint (settings.reorder_window, ==, 4);
+	g_assert_cmpint (settings.resend_latency_us, ==, 100);
+	g_assert_cmpfloat (settings.burst_loss_ratio, ==, 1.0);
+
+	/* A leader, payload packets and a trailer */
+	packets = g_malloc0 (IMPAIRMENT_N_PACKETS * IMPAIRMENT_PACKET_SIZE);
+	for (i = 0; i < IMPAIRMENT_N_PACKETS; i++) {
+		ArvGvspHeader *header = (ArvGvspHeader *) &((ArvGvspPacket *) (packets + i * IMPAIRMENT_PACKET_SIZE))->header;
+		ArvGvspContentType content_type;
+
+		content_type = i == 0 ? ARV_GVSP_CONTENT_TYPE_LEADER :
+			(i == IMPAIRMENT_N_PACKETS - 1 ? ARV_GVSP_CONTENT_TYPE_TRAILER : ARV_GVSP_CONTENT_TYPE_PAYLOAD);
+		header->frame_id = g_htons (1);
+		header->packet_infos = g_htonl ((content_type << ARV_GVSP_PACKET_INFOS_CONTENT_TYPE_POS) | i);
+	}
+
+	/* The same profile gives the same impairment */
+	output_a = impair_packets (&settings, packets, &counters_a);
+	output_b = impair_packets (&settings, packets, &counters_b);
+
+	g_assert_cmpint (output_a->len, ==, output_b->len);
+	g_assert_cmpint (memcmp (output_a->data, output_b->data, output_a->len * sizeof (guint32)), ==, 0);
+	g_assert_cmpint (memcmp (&counters_a, &counters_b, sizeof (counters_a)), ==, 0);
+
+	g_assert_cmpint (counters_a.n_packets, ==, IMPAIRMENT_N_PACKETS);
+	g_assert_cmpint (counters_a.n_dropped_packets, >, 0);
+	g_assert_cmpint (counters_a.n_reordered_packets, >, 0);
+	g_assert_cmpint (counters_a.n_delayed_packets, <=, 1);
+	g_assert_cmpint (output_a->len / 2, ==,
+			 counters_a.n_packets - counters_a.n_dropped_packets + counters_a.n_duplicated_packets);
+
+	/* The delayed leader is not the first output packet */
+	if (counters_a.n_delayed_packets == 1)
+		g_assert_cmpint (g_array_index (output_a, guint32, 0), !=, 0);
+
+	g_array_unref (output_a);
+
+	/* Another seed gives another impairment */
+	settings.seed = 43;
+	output_a = impair_packets (&settings, packets, &counters_a);
+	g_assert_true (output_a->len != output_b->len ||
+		       memcmp (output_a->data, output_b->data, output_a->len * sizeof (guint32)) != 0);
+
+	g_array_unref (output_a);
+	g_array_unref (output_b);
+	g_free (packets);
+}
+
+static void
+resend_test (void)
+{
+	ArvStream *stream;
+	GError *error = NULL;
+	size_t payload;
+	unsigned n_completed = 0;
+	unsigned i;
+
+	g_object_set (simulator, "gvsp-impairment", "seed=1,loss=0.005,resend-latency=200", NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_STREAM (stream));
+	g_assert (error == NULL);
+
+	payload = arv_camera_get_payload (camera, NULL);
+
+	for (i = 0; i < 5; i++)
+		arv_stream_push_buffer (stream, arv_buffer_new (payload, NULL));
+
+	arv_camera_start_acquisition (camera, NULL);
+
+	for (i = 0; i < 10; i++) {
+		ArvBuffer *buffer;
+
+		buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+		g_assert (ARV_IS_BUFFER (buffer));
+
+		if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS)
+			n_completed++;
+
+		arv_stream_push_buffer (stream, buffer);
+	}
+
+	arv_camera_stop_acquisition (camera, NULL);
+
+	g_assert_cmpint (n_completed, >, 0);
+
+	g_assert_cmpint (arv_gv_fake_camera_get_info_uint64_by_name (simulator, "n_frames"), >=, 10);
+	g_assert_cmpint (arv_gv_fake_camera_get_info_uint64_by_name (simulator, "n_dropped_packets"), >, 0);
+	g_assert_cmpint (arv_gv_fake_camera_get_info_uint64_by_name (simulator, "n_resend_requests"), >, 0);
+	g_assert_cmpint (arv_gv_fake_camera_get_info_uint64_by_name (simulator, "n_resent_packets"), >, 0);
+	g_assert_cmpint (arv_gv_fake_camera_get_info_uint64_by_name (simulator, "max_resend_recovery_time_us"), >=,
+			 200);
+
+	g_clear_object (&stream);
+
+	g_object_set (simulator, "gvsp-impairment", NULL, NULL);
+}
+
 #define N_BUFFERS	5
 
 static struct {
@@ -244,12 +1060,282 @@ dynamic_roi_test (void)
 	g_clear_object (&stream);
 }
 
+static void
+pcap_capture_test (void)
+{
+	ArvStream *stream;
+	ArvStream *replay_stream;
+	ArvBuffer *buffer;
+	ArvBuffer *replay_buffer;
+	GError *error = NULL;
+	char *filename;
+	char *contents;
+	gsize length;
+	gsize offset;
+	guint32 header[6];
+	guint16 stream_port;
+	guint n_gvsp_packets = 0;
+	guint n_gvcp_packets = 0;
+	guint64 n_replayed_packets;
+	unsigned i;
+	int fd;
+
+	fd = g_file_open_tmp ("arv-capture-XXXXXX.pcap", &filename, &error);
+	g_assert (fd >= 0);
+	g_assert (error == NULL);
+	g_close (fd, NULL);
+
+	stream = arv_camera_create_stream (camera, NULL, NULL, &error);
+	g_assert (ARV_IS_GV_STREAM (stream));
+	g_assert (error == NULL);
+
+	stream_port = arv_gv_stream_get_port (ARV_GV_STREAM (stream));
+
+	g_assert (arv_gv_stream_start_pcap_capture (ARV_GV_STREAM (stream), filename, TRUE, &error));
+	g_assert (error == NULL);
+
+	arv_stream_push_buffer (stream, arv_buffer_new (arv_camera_get_payload (camera, NULL), NULL));
+	arv_camera_start_acquisition (camera, NULL);
+	buffer = arv_stream_timeout_pop_buffer (stream, 2000000);
+	g_assert (ARV_IS_BUFFER (buffer));
+	arv_camera_stop_acquisition (camera, NULL);
+
+	/* Pending packets are written before the file is closed */
+	arv_gv_stream_stop_pcap_capture (ARV_GV_STREAM (stream));
+
+	g_assert (g_file_get_contents (filename, &contents, &length, NULL));
+	g_assert_cmpint (length, >=, sizeof (header));
+
+	memcpy (header, contents, sizeof (header));
+	g_assert_cmphex (header[0], ==, 0xa1b2c3d4);
+	g_assert_cmpint (header[5], ==, 101);
+
+	for (offset = sizeof (header); offset + 16 <= length; ) {
+		const guint8 *ip;
+		guint32 record[4];
+		guint16 source_port;
+		guint16 destination_port;
+
+		memcpy (record, contents + offset, sizeof (record));
+		g_assert_cmpint (record[2], <=, record[3]);
+		g_assert_cmpint (offset + 16 + record[2], <=, length);
+
+		ip = (const guint8 *) contents + offset + 16;
+		g_assert_cmpint (ip[0], ==, 0x45);
+		g_assert_cmpint (ip[9], ==, 17);
+
+		source_port = (ip[20] << 8) | ip[21];
+		destination_port = (ip[22] << 8) | ip[23];
+		if (destination_port == stream_port)
+			n_gvsp_packets++;
+		else if (source_port == ARV_GVCP_PORT || destination_port == ARV_GVCP_PORT)
+			n_gvcp_packets++;
+
+		offset += 16 + record[2];
+	}
+
+	g_assert_cmpint (offset, ==, length);
+	g_assert_cmpint (n_gvsp_packets, >, 0);
+	g_assert_cmpint (n_gvcp_packets, >, 0);
+
+	/* The capture reassembles into the same first frame */
+	replay_stream = arv_gv_stream_new_replay (arv_camera_gv_get_packet_size (camera, NULL), 0, NULL, NULL, &error);
+	g_assert (ARV_IS_GV_STREAM (replay_stream));
+	g_assert (error == NULL);
+
+	for (i = 0; i < 4; i++)
+		arv_stream_push_buffer (replay_stream, arv_buffer_new (arv_camera_get_payload (camera, NULL), NULL));
+
+	g_assert (arv_gv_stream_replay_pcap (ARV_GV_STREAM (replay_stream), filename, stream_port,
+					     &n_replayed_packets, &error));
+	g_assert (error == NULL);
+	g_assert_cmpint (n_replayed_packets, ==, n_gvsp_packets);
+
+	arv_gv_stream_replay_flush (ARV_GV_STREAM (replay_stream));
+
+	replay_buffer = arv_stream_try_pop_buffer (replay_stream);
+	g_assert (ARV_IS_BUFFER (replay_buffer));
+	g_assert_cmpint (arv_buffer_get_frame_id (replay_buffer), ==, arv_buffer_get_frame_id (buffer));
+	g_assert_cmpint (arv_buffer_get_status (replay_buffer), ==, arv_buffer_get_status (buffer));
+	if (arv_buffer_get_status (buffer) == ARV_BUFFER_STATUS_SUCCESS) {
+		const void *data;
+		const void *replay_data;
+		size_t size;
+		size_t replay_size;
+
+		data = arv_buffer_get_data (buffer, &size);
+		replay_data = arv_buffer_get_data (replay_buffer, &replay_size);
+		g_assert_cmpint (size, ==, replay_size);
+		g_assert (memcmp (data, replay_data, size) == 0);
+	}
+
+	g_object_unref (replay_buffer);
+	g_object_unref (replay_stream);
+
+	g_free (contents);
+	g_remove (filename);
+	g_free (filename);
+
+	g_object_unref (buffer);
+	g_object_unref (stream);
+}
+
+#define REPLAY_PACKET_SIZE	256
+#define REPLAY_PAYLOAD		1024
+#define REPLAY_N_PACKETS	7
+
+static void
+replay_test (void)
+{
+	ArvStream *stream;
+	ArvBuffer *buffer;
+	GError *error = NULL;
+	const ArvGvStreamReplayRequest *requests;
+	const void *data;
+	guint8 packets[REPLAY_N_PACKETS][REPLAY_PACKET_SIZE];
+	size_t packet_sizes[REPLAY_N_PACKETS];
+	guint8 image[REPLAY_PAYLOAD];
+	size_t data_size;
+	size_t size;
+	guint n_requests;
+	guint64 time_us = 1000;
+	unsigned i;
+
+	for (i = 0; i < REPLAY_PAYLOAD; i++)
+		image[i] = i * 7;
+
+	/* Leader, 5 payload packets and trailer, for a 64x16 Mono8 frame */
+	data_size = REPLAY_PACKET_SIZE - ARV_GVSP_PAYLOAD_PACKET_PROTOCOL_OVERHEAD (FALSE);
+	for (i = 0; i < REPLAY_N_PACKETS; i++)
+		packet_sizes[i] = REPLAY_PACKET_SIZE;
+	arv_gvsp_packet_new_image_leader (1, 0, FALSE, ARV_BUFFER_PAYLOAD_TYPE_IMAGE, 0, ARV_PIXEL_FORMAT_MONO_8,
+					  64, 16, 0, 0, 0, 0, packets[0], &packet_sizes[0]);
+	for (i = 1; i < REPLAY_N_PACKETS - 1; i++)
+		arv_gvsp_packet_new_payload (1, i, FALSE, MIN (data_size, REPLAY_PAYLOAD - (i - 1) * data_size),
+					     image + (i - 1) * data_size, packets[i], &packet_sizes[i]);
+	arv_gvsp_packet_new_data_trailer (1, REPLAY_N_PACKETS - 1, FALSE, ARV_BUFFER_PAYLOAD_TYPE_IMAGE,
+					  packets[REPLAY_N_PACKETS - 1], &packet_sizes[REPLAY_N_PACKETS - 1]);
+
+	stream = arv_gv_stream_new_replay (REPLAY_PACKET_SIZE, 0, NULL, NULL, &error);
+	g_assert (ARV_IS_GV_STREAM (stream));
+	g_assert (error == NULL);
+
+	arv_stream_push_buffer (stream, arv_buffer_new (REPLAY_PAYLOAD, NULL));
+
+	/* Lose packets 2 and 4 */
+	for (i = 0; i < REPLAY_N_PACKETS; i++) {
+		if (i != 2 && i != 4)
+			arv_gv_stream_replay_packet (ARV_GV_STREAM (stream), packets[i], packet_sizes[i], time_us);
+		time_us += 10;
+	}
+
+	arv_gv_stream_replay_get_resend_requests (ARV_GV_STREAM (stream), &n_requests);
+	g_assert_cmpint (n_requests, ==, 0);
+
+	/* The missing packets are requested after the packet timeout */
+	time_us += ARV_GV_STREAM_PACKET_TIMEOUT_US_DEFAULT;
+	arv_gv_stream_replay_time (ARV_GV_STREAM (stream), time_us);
+
+	requests = arv_gv_stream_replay_get_resend_requests (ARV_GV_STREAM (stream), &n_requests);
+	g_assert_cmpint (n_requests, ==, 2);
+	g_assert_cmpint (requests[0].frame_id, ==, 1);
+	g_assert_cmpint (requests[0].first_block, ==, 2);
+	g_assert_cmpint (requests[0].last_block, ==, 2);
+	g_assert_cmpint (requests[1].frame_id, ==, 1);
+	g_assert_cmpint (requests[1].first_block, ==, 4);
+	g_assert_cmpint (requests[1].last_block, ==, 4);
+
+	g_assert (arv_stream_try_pop_buffer (stream) == NULL);
+
+	arv_gv_stream_replay_packet (ARV_GV_STREAM (stream), packets[4], packet_sizes[4], time_us + 10);
+	arv_gv_stream_replay_packet (ARV_GV_STREAM (stream), packets[2], packet_sizes[2], time_us + 20);
+
+	buffer = arv_stream_try_pop_buffer (stream);
+	g_assert (ARV_IS_BUFFER (buffer));
+	g_assert_cmpint (arv_buffer_get_status (buffer), ==, ARV_BUFFER_STATUS_SUCCESS);
+	g_assert_cmpint (arv_buffer_get_frame_id (buffer), ==, 1);
+
+	data = arv_buffer_get_data (buffer, &size);
+	g_assert_cmpint (size, ==, REPLAY_PAYLOAD);
+	g_assert (memcmp (data, image, REPLAY_PAYLOAD) == 0);
+
+	g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "n_resend_requests"), ==, 2);
+	g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "n_resent_packets"), ==, 2);
+	g_assert_cmpint (arv_stream_get_info_uint64_by_name (stream, "n_completed_buffers"), ==, 1);
+
+	g_object_unref (buffer);
+	g_object_unref (stream);
+}
+
+static void
+genicam_cache_test (void)
+{
+	ArvDevice *device;
+	GError *error = NULL;
+	const char *reference_xml;
+	const char *xml;
+	char *cache_dir;
+	GDir *dir;
+	const char *name;
+	size_t reference_size;
+	size_t size;
+	guint n_entries = 0;
+
+	reference_xml = arv_device_get_genicam_xml (arv_camera_get_device (camera), &reference_size);
+	g_assert (reference_xml != NULL);
+
+	arv_enable_genicam_cache ();
+
+	/* First connection populates the cache */
+	device = arv_open_device ("Aravis-GVTest", &error);
+	g_assert (ARV_IS_GV_DEVICE (device));
+	g_assert (error == NULL);
+	g_object_unref (device);
+
+	cache_dir = g_build_filename (g_get_user_cache_dir (), "aravis", "genicam", NULL);
+	dir = g_dir_open (cache_dir, 0, NULL);
+	g_assert (dir != NULL);
+	while ((name = g_dir_read_name (dir)) != NULL)
+		n_entries++;
+	g_dir_close (dir);
+	g_assert_cmpint (n_entries, ==, 1);
+
+	/* Second connection uses it */
+	device = arv_open_device ("Aravis-GVTest", &error);
+	g_assert (ARV_IS_GV_DEVICE (device));
+	g_assert (error == NULL);
+
+	xml = arv_device_get_genicam_xml (device, &size);
+	g_assert_cmpint (size, ==, reference_size);
+	g_assert (memcmp (xml, reference_xml, size) == 0);
+	g_assert (ARV_IS_GC_FEATURE_NODE (arv_device_get_feature (device, "Width")));
+
+	g_object_unref (device);
+
+	arv_disable_genicam_cache ();
+
+	dir = g_dir_open (cache_dir, 0, NULL);
+	while ((name = g_dir_read_name (dir)) != NULL) {
+		char *filename = g_build_filename (cache_dir, name, NULL);
+		g_remove (filename);
+		g_free (filename);
+	}
+	g_dir_close (dir);
+	g_free (cache_dir);
+}
+
 int
 main (int argc, char *argv[])
 {
-	ArvGvFakeCamera *simulator;
+	char *cache_home;
+	char *path;
 	int result;
 
+	/* Keep the Genicam cache test away from the user cache */
+	cache_home = g_dir_make_tmp ("arv-fakegv-XXXXXX", NULL);
+	g_assert (cache_home != NULL);
+	g_setenv ("XDG_CACHE_HOME", cache_home, TRUE);
+
 	g_test_init (&argc, &argv, NULL);
 
 	arv_set_fake_camera_genicam_filename (GENICAM_FILENAME);
@@ -263,10 +1349,23 @@ main (int argc, char *argv[])
 	arv_update_device_list ();
 
 	g_test_add_func ("/fakegv/discovery", discovery_test);
+	g_test_add_func ("/fakegv/background_discovery", background_discovery_test);
 	g_test_add_func ("/fakegv/device_registers", register_test);
+	g_test_add_func ("/fakegv/register_batch", register_batch_test);
+	g_test_add_func ("/fakegv/register_prefetch", register_prefetch_test);
+	g_test_add_func ("/fakegv/read_memory", read_memory_test);
+	g_test_add_func ("/fakegv/async", async_test);
 	g_test_add_func ("/fakegv/acquisition", acquisition_test);
 	g_test_add_func ("/fakegv/stream", stream_test);
+	g_test_add_func ("/fakegv/high_rate", high_rate_test);
+	g_test_add_func ("/fakegv/stream_format", stream_format_test);
+	g_test_add_func ("/fakegv/sender_pool", sender_pool_test);
+	g_test_add_func ("/fakegv/impairment", impairment_test);
+	g_test_add_func ("/fakegv/resend", resend_test);
 	g_test_add_func ("/fakegv/dynamic_roi", dynamic_roi_test);
+	g_test_add_func ("/fakegv/pcap_capture", pcap_capture_test);
+	g_test_add_func ("/fakegv/replay", replay_test);
+	g_test_add_func ("/fakegv/genicam_cache", genicam_cache_test);
 
 	result = g_test_run();
 
@@ -276,6 +1375,15 @@ main (int argc, char *argv[])
 
 	arv_shutdown ();
 
+	path = g_build_filename (cache_home, "aravis", "genicam", NULL);
+	g_rmdir (path);
+	g_free (path);
+	path = g_build_filename (cache_home, "aravis", NULL);
+	g_rmdir (path);
+	g_free (path);
+	g_rmdir (cache_home);
+	g_free (cache_home);
+
 	return result;
 }
 
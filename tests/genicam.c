@@ -3,6 +3,8 @@
 #include <string.h>
 
 #include <arvbufferprivate.h>
+#include <arvfakecameraprivate.h>
+#include <arvgcprivate.h>
 #include <arvmiscprivate.h>
 
 typedef struct {
@@ -1420,6 +1422,336 @@ access_mode_test (void)
 	g_object_unref (device);
 }
 
+static void
+compiled_test (void)
+{
+	ArvDevice *device;
+	ArvGc *genicam;
+	ArvGc *compiled_genicam;
+	ArvGcNode *node;
+	ArvGcNode *compiled_node;
+	GBytes *compiled;
+	GError *error = NULL;
+	const char *xml;
+	size_t size;
+	int i;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	genicam = arv_device_get_genicam (device);
+	xml = arv_device_get_genicam_xml (device, &size);
+	g_assert (xml != NULL);
+
+	compiled = arv_gc_compile (xml, size, &error);
+	g_assert (compiled != NULL);
+	g_assert (error == NULL);
+
+	compiled_genicam = arv_gc_new_from_compiled (device, g_bytes_get_data (compiled, NULL),
+						     g_bytes_get_size (compiled), &error);
+	g_assert (ARV_IS_GC (compiled_genicam));
+	g_assert (error == NULL);
+
+	for (i = 0; i < G_N_ELEMENTS (node_types); i++) {
+		node = arv_gc_get_node (genicam, node_types[i].name);
+		compiled_node = arv_gc_get_node (compiled_genicam, node_types[i].name);
+		g_assert (compiled_node != NULL);
+		g_assert_cmpstr (G_OBJECT_TYPE_NAME (compiled_node), ==, G_OBJECT_TYPE_NAME (node));
+	}
+
+	node = arv_gc_get_node (compiled_genicam, "RWInteger");
+	g_assert (ARV_IS_GC_INTEGER (node));
+	g_assert_cmpint (arv_gc_integer_get_value (ARV_GC_INTEGER (node), NULL), ==,
+			 arv_gc_integer_get_value (ARV_GC_INTEGER (arv_gc_get_node (genicam, "RWInteger")), NULL));
+
+	node = arv_gc_get_node (compiled_genicam, "Enumeration");
+	g_assert (ARV_IS_GC_ENUMERATION (node));
+	g_assert_cmpstr (arv_gc_enumeration_get_string_value (ARV_GC_ENUMERATION (node), NULL), ==,
+			 arv_gc_enumeration_get_string_value (ARV_GC_ENUMERATION (arv_gc_get_node (genicam,
+												   "Enumeration")),
+							      NULL));
+
+	g_object_unref (compiled_genicam);
+
+	/* Truncated data */
+	compiled_genicam = arv_gc_new_from_compiled (device, g_bytes_get_data (compiled, NULL),
+						     g_bytes_get_size (compiled) / 2, &error);
+	g_assert (compiled_genicam == NULL);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	/* Not compiled data */
+	compiled_genicam = arv_gc_new_from_compiled (device, xml, size, &error);
+	g_assert (compiled_genicam == NULL);
+	g_assert (error != NULL);
+	g_clear_error (&error);
+
+	g_bytes_unref (compiled);
+	g_object_unref (device);
+}
+
+static void
+linked_node_test (void)
+{
+	const char *xml =
+		"<?xml version=\"1.0\"?>\n"
+		"<RegisterDescription>\n"
+		"<Integer Name=\"Pointer\"><pValue>Target</pValue><pMin>Missing</pMin></Integer>\n"
+		"<Integer Name=\"Target\"><Value>10</Value></Integer>\n"
+		"</RegisterDescription>\n";
+	ArvGc *genicam;
+	ArvGcNode *node;
+	ArvGcNode *target;
+	GError *error = NULL;
+	gint64 value;
+
+	genicam = arv_gc_new (NULL, xml, strlen (xml));
+	g_assert (ARV_IS_GC (genicam));
+
+	node = arv_gc_get_node (genicam, "Pointer");
+	target = arv_gc_get_node (genicam, "Target");
+	g_assert (ARV_IS_GC_INTEGER (node));
+	g_assert (ARV_IS_GC_INTEGER (target));
+
+	/* Pointer to a node declared later in the document */
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 10);
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (target), 20, &error);
+	g_assert (error == NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 20);
+
+	/* Dangling pointer, resolved by a node added after the document load */
+	value = arv_gc_integer_get_min (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 0);
+
+	arv_gc_set_default_node_data (genicam, "Missing", "<Integer Name=\"Missing\"><Value>5</Value></Integer>", NULL);
+	value = arv_gc_integer_get_min (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 5);
+
+	g_object_unref (genicam);
+}
+
+static void
+computed_value_cache_test (void)
+{
+	ArvDevice *device;
+	ArvGc *genicam;
+	ArvGcNode *node;
+	ArvGcNode *reg;
+	ArvGcNode *offset;
+	GError *error = NULL;
+	gint64 value;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	genicam = arv_device_get_genicam (device);
+	g_assert (ARV_IS_GC (genicam));
+
+	arv_gc_set_default_node_data (genicam, "CacheTestRegister",
+				      "<IntReg Name=\"CacheTestRegister\">"
+				      "<Address>0x1100</Address>"
+				      "<Length>4</Length>"
+				      "<AccessMode>RW</AccessMode>"
+				      "<Cachable>WriteThrough</Cachable>"
+				      "<Endianess>BigEndian</Endianess>"
+				      "<pPort>Device</pPort>"
+				      "</IntReg>", NULL);
+	arv_gc_set_default_node_data (genicam, "CacheTestOffset",
+				      "<Integer Name=\"CacheTestOffset\"><Value>1</Value></Integer>", NULL);
+	arv_gc_set_default_node_data (genicam, "CacheTestKnife",
+				      "<IntSwissKnife Name=\"CacheTestKnife\">"
+				      "<pVariable Name=\"R\">CacheTestRegister</pVariable>"
+				      "<pVariable Name=\"O\">CacheTestOffset</pVariable>"
+				      "<Formula>R + O</Formula>"
+				      "</IntSwissKnife>", NULL);
+
+	node = arv_gc_get_node (genicam, "CacheTestKnife");
+	reg = arv_gc_get_node (genicam, "CacheTestRegister");
+	offset = arv_gc_get_node (genicam, "CacheTestOffset");
+	g_assert (ARV_IS_GC_SWISS_KNIFE (node));
+	g_assert (ARV_IS_GC_INTEGER (reg));
+	g_assert (ARV_IS_GC_INTEGER (offset));
+
+	/* Without register cache, a register modified behind the genicam back must be seen */
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_DISABLE);
+
+	arv_device_write_register (device, 0x1100, 41, &error);
+	g_assert (error == NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 42);
+
+	arv_device_write_register (device, 0x1100, 99, &error);
+	g_assert (error == NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 100);
+
+	/* Literal dependencies */
+	arv_gc_integer_set_value (ARV_GC_INTEGER (offset), 2, &error);
+	g_assert (error == NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 101);
+
+	/* With register cache, the computed value is reused until a dependency is written */
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (reg), 7, &error);
+	g_assert (error == NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 9);
+
+	arv_device_write_register (device, 0x1100, 20, &error);
+	g_assert (error == NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 9);
+
+	arv_gc_integer_set_value (ARV_GC_INTEGER (offset), 3, &error);
+	g_assert (error == NULL);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 10);
+
+	/* A change of the cache policy invalidates the computed values */
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_DISABLE);
+
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 23);
+
+	g_object_unref (device);
+}
+
+static void
+prefetch_test (void)
+{
+	ArvDevice *device;
+	ArvGc *genicam;
+	ArvGcNode *node;
+	ArvGcNode *reg;
+	ArvFakeCamera *fake_camera;
+	GError *error = NULL;
+	const char *features[] = {"PrefetchTestSum", "PrefetchTestC", "PrefetchTestUnknown"};
+	gint64 value;
+	guint n_reads;
+
+	device = arv_fake_device_new ("TEST0", &error);
+	g_assert (ARV_IS_FAKE_DEVICE (device));
+	g_assert (error == NULL);
+
+	genicam = arv_device_get_genicam (device);
+	g_assert (ARV_IS_GC (genicam));
+
+	fake_camera = arv_fake_device_get_fake_camera (ARV_FAKE_DEVICE (device));
+
+	arv_gc_set_default_node_data (genicam, "PrefetchTestA",
+				      "<IntReg Name=\"PrefetchTestA\">"
+				      "<Address>0x1200</Address>"
+				      "<Length>4</Length>"
+				      "<AccessMode>RW</AccessMode>"
+				      "<Cachable>WriteThrough</Cachable>"
+				      "<Endianess>BigEndian</Endianess>"
+				      "<pPort>Device</pPort>"
+				      "</IntReg>", NULL);
+	arv_gc_set_default_node_data (genicam, "PrefetchTestB",
+				      "<IntReg Name=\"PrefetchTestB\">"
+				      "<Address>0x1204</Address>"
+				      "<Length>4</Length>"
+				      "<AccessMode>RW</AccessMode>"
+				      "<Cachable>WriteThrough</Cachable>"
+				      "<Endianess>BigEndian</Endianess>"
+				      "<pPort>Device</pPort>"
+				      "</IntReg>", NULL);
+	arv_gc_set_default_node_data (genicam, "PrefetchTestSum",
+				      "<IntSwissKnife Name=\"PrefetchTestSum\">"
+				      "<pVariable Name=\"A\">PrefetchTestA</pVariable>"
+				      "<pVariable Name=\"B\">PrefetchTestB</pVariable>"
+				      "<Formula>A + B</Formula>"
+				      "</IntSwissKnife>", NULL);
+	arv_gc_set_default_node_data (genicam, "PrefetchTestC",
+				      "<IntReg Name=\"PrefetchTestC\">"
+				      "<Address>0x1210</Address>"
+				      "<Length>4</Length>"
+				      "<AccessMode>RW</AccessMode>"
+				      "<Cachable>WriteThrough</Cachable>"
+				      "<Endianess>BigEndian</Endianess>"
+				      "<pPort>Device</pPort>"
+				      "</IntReg>", NULL);
+
+	node = arv_gc_get_node (genicam, "PrefetchTestSum");
+	reg = arv_gc_get_node (genicam, "PrefetchTestA");
+	g_assert (ARV_IS_GC_SWISS_KNIFE (node));
+	g_assert (ARV_IS_GC_INTEGER (reg));
+
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_ENABLE);
+
+	arv_device_write_register (device, 0x1200, 5, &error);
+	g_assert (error == NULL);
+	arv_device_write_register (device, 0x1204, 6, &error);
+	g_assert (error == NULL);
+	arv_device_write_register (device, 0x1210, 3, &error);
+	g_assert (error == NULL);
+
+	/* A and B are contiguous and read at once, C is read separately */
+	n_reads = arv_fake_camera_get_n_memory_reads (fake_camera);
+	arv_gc_prefetch_features (genicam, features, G_N_ELEMENTS (features));
+	g_assert_cmpint (arv_fake_camera_get_n_memory_reads (fake_camera) - n_reads, ==, 2);
+
+	n_reads = arv_fake_camera_get_n_memory_reads (fake_camera);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 11);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (arv_gc_get_node (genicam, "PrefetchTestC")), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 3);
+	g_assert_cmpint (arv_fake_camera_get_n_memory_reads (fake_camera), ==, n_reads);
+
+	/* Values are served from the register cache until the next prefetch */
+	arv_device_write_register (device, 0x1200, 7, &error);
+	g_assert (error == NULL);
+	arv_device_write_register (device, 0x1204, 8, &error);
+	g_assert (error == NULL);
+
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 11);
+
+	arv_gc_prefetch_features (genicam, features, G_N_ELEMENTS (features));
+
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 15);
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (reg), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 7);
+
+	/* No prefetch without register cache */
+	arv_gc_set_register_cache_policy (genicam, ARV_REGISTER_CACHE_POLICY_DISABLE);
+
+	arv_device_write_register (device, 0x1200, 9, &error);
+	g_assert (error == NULL);
+
+	arv_gc_prefetch_features (genicam, features, G_N_ELEMENTS (features));
+
+	value = arv_gc_integer_get_value (ARV_GC_INTEGER (node), &error);
+	g_assert (error == NULL);
+	g_assert_cmpint (value, ==, 17);
+
+	g_object_unref (device);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -1446,6 +1778,10 @@ main (int argc, char *argv[])
 	g_test_add_func ("/genicam/category", category_test);
 	g_test_add_func ("/genicam/lock", lock_test);
 	g_test_add_func ("/genicam/access-mode", access_mode_test);
+	g_test_add_func ("/genicam/compiled", compiled_test);
+	g_test_add_func ("/genicam/linked-node", linked_node_test);
+	g_test_add_func ("/genicam/computed-value-cache", computed_value_cache_test);
+	g_test_add_func ("/genicam/prefetch", prefetch_test);
 
 	result = g_test_run();
 
@@ -3,6 +3,8 @@
 #include <arvstr.h>
 #include <string.h>
 #include "../src/arvmiscprivate.h"
+#include "../src/arvzipprivate.h"
+#include <zlib.h>
 
 #if !ARAVIS_CHECK_VERSION (ARAVIS_MAJOR_VERSION, ARAVIS_MINOR_VERSION, ARAVIS_MICRO_VERSION)
 #error
@@ -269,6 +271,99 @@ match_test (void)
 	}
 }
 
+static void
+zip_stream_callback (const void *data, size_t size, void *user_data)
+{
+	g_byte_array_append (user_data, data, size);
+}
+
+static guint8 *
+zip_stream_build_entry (const char *data, size_t size, gboolean deflate, size_t *entry_size)
+{
+	guint8 *entry;
+	size_t compressed_size = size;
+
+	entry = g_malloc0 (30 + 4 + compressed_size + 64);
+
+	if (deflate) {
+		z_stream z = {0};
+
+		g_assert_cmpint (deflateInit2 (&z, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+					       Z_DEFAULT_STRATEGY), ==, Z_OK);
+		z.next_in = (Bytef *) data;
+		z.avail_in = size;
+		z.next_out = entry + 30 + 4;
+		z.avail_out = size + 64;
+		g_assert_cmpint (deflate (&z, Z_FINISH), ==, Z_STREAM_END);
+		compressed_size = z.total_out;
+		deflateEnd (&z);
+	} else
+		memcpy (entry + 30 + 4, data, size);
+
+	entry[0] = 0x50; entry[1] = 0x4b; entry[2] = 0x03; entry[3] = 0x04;
+	entry[8] = deflate ? 8 : 0;
+	entry[18] = compressed_size & 0xff;
+	entry[19] = (compressed_size >> 8) & 0xff;
+	entry[22] = size & 0xff;
+	entry[23] = (size >> 8) & 0xff;
+	entry[26] = 4;
+	memcpy (entry + 30, "test", 4);
+
+	*entry_size = 30 + 4 + compressed_size;
+
+	return entry;
+}
+
+static void
+zip_stream_test (void)
+{
+	GString *string;
+	unsigned i;
+
+	string = g_string_new ("<?xml version=\"1.0\"?>\n<RegisterDescription>\n");
+	for (i = 0; i < 200; i++)
+		g_string_append_printf (string, "<Integer Name=\"Integer%u\"><Value>%u</Value></Integer>\n", i, i);
+	g_string_append (string, "</RegisterDescription>\n");
+
+	for (i = 0; i < 2; i++) {
+		ArvZipStream *stream;
+		GByteArray *output;
+		guint8 *entry;
+		size_t entry_size;
+		size_t offset;
+
+		entry = zip_stream_build_entry (string->str, string->len, i == 1, &entry_size);
+
+		output = g_byte_array_new ();
+		stream = arv_zip_stream_new (zip_stream_callback, output);
+
+		/* Chunks smaller than the local header */
+		for (offset = 0; offset < entry_size; offset += 7) {
+			g_assert (!arv_zip_stream_is_done (stream));
+			g_assert (arv_zip_stream_push (stream, entry + offset, MIN (7, entry_size - offset)));
+		}
+
+		g_assert (arv_zip_stream_is_done (stream));
+		g_assert_cmpint (output->len, ==, string->len);
+		g_assert (memcmp (output->data, string->str, string->len) == 0);
+
+		arv_zip_stream_free (stream);
+		g_byte_array_unref (output);
+
+		/* Invalid signature */
+		entry[0] = 0;
+		output = g_byte_array_new ();
+		stream = arv_zip_stream_new (zip_stream_callback, output);
+		g_assert (!arv_zip_stream_push (stream, entry, entry_size));
+		arv_zip_stream_free (stream);
+		g_byte_array_unref (output);
+
+		g_free (entry);
+	}
+
+	g_string_free (string, TRUE);
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -285,6 +380,7 @@ main (int argc, char *argv[])
 	g_test_add_func ("/gstreamer/caps-string", caps_string_test);
 	g_test_add_func ("/misc/globs", glob_test);
 	g_test_add_func ("/misc/matches", match_test);
+	g_test_add_func ("/misc/zip-stream", zip_stream_test);
 
 
 	result = g_test_run();
@@ -254,6 +254,16 @@ typedef enum {
 
 static void 	select_mode 	(ArvViewer *viewer, ArvViewerMode mode);
 
+static const char *viewer_prefetched_features[] = {
+	"Width", "Height", "OffsetX", "OffsetY",
+	"BinningHorizontal", "BinningVertical",
+	"PixelFormat",
+	"AcquisitionFrameRate", "AcquisitionFrameRateAbs",
+	"ExposureTime", "ExposureTimeAbs", "ExposureAuto",
+	"Gain", "GainRaw", "GainAbs", "GainAuto",
+	"BlackLevel", "BlackLevelRaw", "BlackLevelAuto"
+};
+
 void
 arv_viewer_set_options (ArvViewer *viewer,
 			gboolean auto_socket_buffer,
@@ -1630,6 +1640,12 @@ start_camera (ArvViewer *viewer, const char *camera_id)
 	arv_device_set_range_check_policy (arv_camera_get_device (viewer->camera),
 					   viewer->range_check_policy);
 
+	/* Fill the register cache of the features displayed by the camera controls, which is only useful when the
+	 * register cache is enabled on the command line */
+	if (viewer->register_cache_policy != ARV_REGISTER_CACHE_POLICY_DISABLE)
+		arv_gc_prefetch_features (arv_device_get_genicam (arv_camera_get_device (viewer->camera)),
+					  viewer_prefetched_features, G_N_ELEMENTS (viewer_prefetched_features));
+
         if (arv_camera_is_uv_device (viewer->camera))
                 arv_camera_uv_set_usb_mode (viewer->camera, viewer->usb_mode);
 